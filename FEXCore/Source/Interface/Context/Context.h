@@ -4,6 +4,7 @@
 #include "Common/JitSymbols.h"
 #include "Interface/Core/CPUBackend.h"
 #include "Interface/Core/CPUID.h"
+#include "Interface/Core/IRCache.h"
 #include <Interface/IR/IntrusiveIRList.h>
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Core/Context.h>
@@ -18,6 +19,7 @@
 #include <FEXCore/fextl/unordered_map.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
@@ -190,6 +192,12 @@ public:
   void ClearCodeCache(FEXCore::Core::InternalThreadState* Thread, bool NewCodeBuffer = true) override;
   void InvalidateCodeBuffersCodeRange(uint64_t Start, uint64_t Length) override;
   void InvalidateThreadCachedCodeRange(FEXCore::Core::InternalThreadState* Thread, uint64_t Start, uint64_t Length) override;
+  void TrimThreadLocalCaches(FEXCore::Core::InternalThreadState* Thread) override;
+  void InvalidateCachedIR(uint64_t Start, uint64_t Length) override {
+    if (IRCache) {
+      IRCache->InvalidateRange(Start, Length);
+    }
+  }
   FEXCore::ForkableSharedMutex& GetCodeInvalidationMutex() override {
     return CodeInvalidationMutex;
   }
@@ -204,12 +212,32 @@ public:
 
   void AddThunkTrampolineIRHandler(uintptr_t Entrypoint, uintptr_t GuestThunkEntrypoint) override;
 
+  void AddHostFunctionIRHandler(uintptr_t Entrypoint, const IR::SHA256Sum& HostFunction, HostFunctionABI ABI) override;
+  void RemoveHostFunctionIRHandler(FEXCore::Core::InternalThreadState* Thread, uintptr_t Entrypoint) override;
+
   void AddForceTSOInformation(const IntervalList<uint64_t>& ValidRanges, fextl::set<uint64_t>&& Instructions) override;
 
   void RemoveForceTSOInformation(uint64_t Address, uint64_t Size) override;
 
+  void AddTSOFreeInstructions(fextl::set<uint64_t>&& Instructions) override;
+  void RemoveTSOFreeInstructions(const fextl::set<uint64_t>& Instructions) override;
+
+  void AddUnalignedAtomicInformation(fextl::set<uint64_t>&& Instructions) override;
+
+  /**
+   * @brief Records the guest instruction at the host PC as performing unaligned atomic accesses.
+   *
+   * Called from the SIGBUS handler when JIT code gets backpatched, so this only queues the instruction.
+   * The next compilation adds it to the known unaligned atomics and hands it to the syscall handler to persist.
+   */
+  void MarkUnalignedAtomic(FEXCore::Core::InternalThreadState* Thread, uint64_t HostPC);
+
   void MarkMonoDetected() override {
     MonoDetected = true;
+    if (IRCache) {
+      // Mono hacks change how blocks get decoded.
+      IRCache->Clear();
+    }
   }
 
   void MarkMonoBackpatcherBlock(uint64_t BlockEntry) override;
@@ -223,6 +251,7 @@ public:
     bool NeedsPendingInterruptFaultCheck {false};
 
     FEX_CONFIG_OPT(Multiblock, MULTIBLOCK);
+    FEX_CONFIG_OPT(SpinLoopWait, SPINLOOPWAIT);
     FEX_CONFIG_OPT(SingleStepConfig, SINGLESTEP);
     FEX_CONFIG_OPT(GdbServer, GDBSERVER);
     FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
@@ -241,7 +270,9 @@ public:
     FEX_CONFIG_OPT(DisableVixlIndirectCalls, DISABLE_VIXL_INDIRECT_RUNTIME_CALLS);
     FEX_CONFIG_OPT(SmallTSCScale, SMALLTSCSCALE);
     FEX_CONFIG_OPT(StrictInProcessSplitLocks, STRICTINPROCESSSPLITLOCKS);
+    FEX_CONFIG_OPT(HalfBarrierTSOEnabled, HALFBARRIERTSOENABLED);
     FEX_CONFIG_OPT(MonoHacks, MONOHACKS);
+    FEX_CONFIG_OPT(IRCacheSize, IRCACHESIZE);
   } Config;
 
   FEXCore::ForkableSharedMutex CodeInvalidationMutex;
@@ -257,6 +288,8 @@ public:
   fextl::unique_ptr<FEXCore::CPU::Dispatcher> Dispatcher;
   CodeCache CodeCache;
   fextl::unique_ptr<CodeMapWriter> CodeMapWriter;
+  // Only allocated if enabled.
+  fextl::unique_ptr<FEXCore::IRCache> IRCache;
 
   SignalDelegator* SignalDelegation {};
 
@@ -282,12 +315,17 @@ public:
   [[nodiscard]]
   GenerateIRResult GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP, bool ExtendedDebugInfo, uint64_t MaxInst);
 
+  // Number of known unaligned atomics in the guest code, UnalignedAtomicMutex needs to be locked.
+  size_t CountUnalignedAtomics(const fextl::vector<FEXCore::IRCache::CodeRange>& GuestCode) const;
+
   struct CompileCodeResult {
     CPU::CPUBackend::CompiledCode CompiledCode;
     fextl::unique_ptr<FEXCore::Core::DebugData> DebugData;
     uint64_t StartAddr;
     uint64_t Length;
     bool NeedsAddGuestCodeRanges;
+    // Set if the IR came from the IR cache instead of the frontend.
+    fextl::shared_ptr<FEXCore::IRCache::Entry> CachedIR;
   };
   [[nodiscard]]
   CompileCodeResult CompileCode(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP, uint64_t MaxInst = 0);
@@ -374,6 +412,20 @@ private:
   fextl::unordered_map<uint64_t, CustomIRHandlerEntry> CustomIRHandlers;
   IntervalList<uint64_t> ForceTSOValidRanges; // The ranges for which ForceTSOInstructions has populated data
   fextl::set<uint64_t> ForceTSOInstructions;
+  // Instructions outside of ForceTSOValidRanges that don't need TSO emulation.
+  fextl::set<uint64_t> TSOFreeInstructions;
+  // Instructions known to perform unaligned atomic accesses.
+  std::shared_mutex UnalignedAtomicMutex;
+  fextl::set<uint64_t> UnalignedAtomicInstructions;
+  // Instructions queued by the SIGBUS handler, a slot holding 0 is free.
+  std::array<std::atomic<uint64_t>, 64> PendingUnalignedAtomics {};
+  std::atomic<bool> HasPendingUnalignedAtomics {};
+  // Moves the queued instructions to UnalignedAtomicInstructions, must not be called from a signal handler.
+  void AddPendingUnalignedAtomics(FEXCore::Core::InternalThreadState* Thread);
+  // Entrypoints of multiblocks whose code changed after they were compiled, with SMCChecks=fullblock these get
+  // validated per instruction.
+  std::shared_mutex SelfModifyingBlocksMutex;
+  fextl::set<uint64_t> SelfModifyingBlocks;
 
   bool MonoDetected = false;
   std::atomic<uint64_t> MonoBackpatcherBlock;
@@ -100,6 +100,10 @@ ContextImpl::ContextImpl(const FEXCore::HostFeatures& Features)
 
   // Track atomic TSO emulation configuration.
   UpdateAtomicTSOEmulationConfig();
+
+  if (Config.IRCacheSize()) {
+    IRCache = fextl::make_unique<FEXCore::IRCache>(uint64_t {Config.IRCacheSize()} * 1024 * 1024);
+  }
 }
 
 struct GetFrameBlockInfoResult {
@@ -378,6 +382,7 @@ void ContextImpl::InitializeCompiler(FEXCore::Core::InternalThreadState* Thread)
 
   Thread->CurrentFrame->State.L1Pointer = Thread->LookupCache->GetL1Pointer();
   Thread->CurrentFrame->State.L1Mask = Thread->LookupCache->GetScaledL1PointerMask();
+  Thread->CurrentFrame->State.L1GenerationPointer = Thread->LookupCache->GetL1GenerationPointer();
 
   Thread->CurrentFrame->Pointers.Common.L2Pointer = Thread->LookupCache->GetPagePointer();
 
@@ -536,6 +541,28 @@ ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t Gue
 
     const auto GPRSize = Thread->OpDispatcher->GetGPROpSize();
 
+    // Known unaligned atomics in the decoded code, sorted.
+    fextl::vector<uint64_t> UnalignedAtomics;
+    {
+      std::shared_lock lk(UnalignedAtomicMutex);
+      for (const auto& Block : *CodeBlocks) {
+        auto It = UnalignedAtomicInstructions.lower_bound(Block.Entry);
+        auto End = UnalignedAtomicInstructions.lower_bound(Block.Entry + Block.Size);
+        UnalignedAtomics.insert(UnalignedAtomics.end(), It, End);
+      }
+    }
+    std::sort(UnalignedAtomics.begin(), UnalignedAtomics.end());
+
+    // With fullblock SMC checks, blocks only get validated once on entry unless they were seen changing before.
+    // Stores don't re-validate, so a block that patches its own later instructions runs them stale once. The next entry
+    // catches the change and the block gets recompiled with per-instruction checks.
+    bool ValidateEveryInstruction = Config.SMCChecks == FEXCore::Config::CONFIG_SMC_FULL;
+    const bool ValidateBlockEntry = Config.SMCChecks == FEXCore::Config::CONFIG_SMC_FULL_BLOCK;
+    if (ValidateBlockEntry) {
+      std::shared_lock lk(SelfModifyingBlocksMutex);
+      ValidateEveryInstruction = SelfModifyingBlocks.contains(GuestRIP);
+    }
+
     for (size_t j = 0; j < CodeBlocks->size(); ++j) {
       const FEXCore::Frontend::Decoder::DecodedBlocks& Block = CodeBlocks->at(j);
 
@@ -556,6 +583,10 @@ ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t Gue
       // Reset any block-specific state
       Thread->OpDispatcher->StartNewBlock();
 
+      if (Block.IsSpinLoop) {
+        Thread->OpDispatcher->StartSpinLoop(Block.Entry);
+      }
+
       uint64_t InstsInBlock = Block.NumInstructions;
 
       if (InstsInBlock == 0) {
@@ -581,21 +612,32 @@ ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t Gue
         // RA generates bad code in common cases with tied registers otherwise.
         //
         // However, it makes our exception handling behaviour more predictable.
-        // It is potentially correctness bearing in that sense, but that is a
-        // side effect here and (if that behaviour is required) we should handle
-        // that more explicitly later.
+        // Asynchronous signals can arrive at any instruction, and SpillSRA with
+        // RestoreRIPFromHostPC only recover the static registers, so results
+        // that are still cached in SSA values would be lost. Only drop this
+        // flush together with recording which guest registers are stale for
+        // each host PC range and rebuilding them in the signal path.
         Thread->OpDispatcher->FlushRegisterCache(true);
 
         if (ExtendedDebugInfo || Thread->OpDispatcher->CanHaveSideEffects(TableInfo, DecodedInfo)) {
           Thread->OpDispatcher->_GuestOpcode(InstAddress - GuestRIP);
         }
 
-        if (Config.SMCChecks == FEXCore::Config::CONFIG_SMC_FULL || Block.ForceFullSMCDetection) {
-          auto ExistingCodePtr = reinterpret_cast<uint8_t*>(Block.Entry + BlockInstructionsLength);
+        const bool ValidateInstruction = ValidateEveryInstruction || Block.ForceFullSMCDetection;
+        if (ValidateInstruction || (ValidateBlockEntry && i == 0)) {
           auto InstAddressReg = Thread->OpDispatcher->_EntrypointOffset(GPRSize, InstAddress - GuestRIP);
-          std::array<uint8_t, 0x10> CodeOriginal;
-          memcpy(CodeOriginal.data(), ExistingCodePtr, DecodedInfo->InstSize);
-          auto CodeChanged = Thread->OpDispatcher->_ValidateCode(CodeOriginal, InstAddressReg, DecodedInfo->InstSize);
+          IR::Ref CodeChanged {};
+          // Validate against the bytes the decoder read, guest memory might have changed since.
+          const auto DecodedCode = &BlockInfo->CodeBytes[Block.CodeOffset];
+          if (ValidateInstruction) {
+            std::array<uint8_t, 0x10> CodeOriginal;
+            memcpy(CodeOriginal.data(), DecodedCode + BlockInstructionsLength, DecodedInfo->InstSize);
+            CodeChanged = Thread->OpDispatcher->_ValidateCode(CodeOriginal, InstAddressReg, DecodedInfo->InstSize);
+          } else {
+            // The whole decoded block gets compared in one go against a copy of its bytes kept with the IR.
+            const auto CodeDataOffset = Thread->OpDispatcher->AllocateInlineData(DecodedCode, Block.Size);
+            CodeChanged = Thread->OpDispatcher->_ValidateCodeBlock(InstAddressReg, CodeDataOffset, Block.Size);
+          }
 
           auto InvalidateCodeCond = Thread->OpDispatcher->CondJump(CodeChanged);
 
@@ -626,9 +668,18 @@ ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t Gue
             }
           } else if (DecodedInfo->Flags & X86Tables::DecodeFlags::FLAG_FORCE_TSO) {
             ForceTSO = IR::ForceTSOMode::ForceEnabled;
+          } else if (!TSOFreeInstructions.empty() && TSOFreeInstructions.contains(InstAddress)) {
+            ForceTSO = IR::ForceTSOMode::ForceDisabled;
+          }
+
+          // Known to be unaligned from an earlier backpatch, skip the SIGBUS round-trip.
+          const bool UnalignedAtomic = std::binary_search(UnalignedAtomics.begin(), UnalignedAtomics.end(), InstAddress);
+          if (UnalignedAtomic) {
+            FEXCORE_PROFILE_INSTANT_INCREMENT(Thread, AccumulatedUnalignedAtomicCount, 1);
           }
 
           Thread->OpDispatcher->SetForceTSO(ForceTSO);
+          Thread->OpDispatcher->SetUnalignedAtomic(UnalignedAtomic);
           std::invoke(Fn, Thread->OpDispatcher, DecodedInfo);
           if (Thread->OpDispatcher->HadDecodeFailure()) {
             HadDispatchError = true;
@@ -720,7 +771,55 @@ ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState* Thread, uint64_t Gue
   };
 }
 
+size_t ContextImpl::CountUnalignedAtomics(const fextl::vector<FEXCore::IRCache::CodeRange>& GuestCode) const {
+  size_t Count {};
+  for (const auto& Range : GuestCode) {
+    auto Begin = UnalignedAtomicInstructions.lower_bound(Range.Start);
+    Count += std::distance(Begin, UnalignedAtomicInstructions.lower_bound(Range.Start + Range.Size));
+  }
+  return Count;
+}
+
 ContextImpl::CompileCodeResult ContextImpl::CompileCode(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP, uint64_t MaxInst) {
+  if (HasPendingUnalignedAtomics.load(std::memory_order_acquire)) {
+    AddPendingUnalignedAtomics(Thread);
+  }
+
+  // The IR of the mono backpatcher block depends on more than its guest code.
+  const bool IsMonoBackpatcherBlock = AreMonoHacksActive() && MonoBackpatcherBlock.load(std::memory_order_relaxed) == GuestRIP;
+  // Single instruction blocks, AOT generation and extended debug info always go through the frontend.
+  const bool UseIRCache = IRCache && MaxInst == 0 && !IsMonoBackpatcherBlock && !CodeCache.IsGeneratingCache && !Config.GDBSymbols();
+
+  if (UseIRCache) {
+    auto CachedIR = IRCache->Find(Thread, SyscallHandler, GuestRIP);
+    if (CachedIR) {
+      // Instructions that were recorded as unaligned atomics since need new IR.
+      std::shared_lock lk(UnalignedAtomicMutex);
+      if (CountUnalignedAtomics(CachedIR->GuestCode) != CachedIR->UnalignedAtomics) {
+        CachedIR.reset();
+      }
+    }
+
+    if (CachedIR) {
+      FEXCORE_PROFILE_SCOPED("CompileCachedIR");
+      auto IRView = CachedIR->GetView();
+      auto DebugData = fextl::make_unique<FEXCore::Core::DebugData>();
+      bool TFSet = Thread->CurrentFrame->State.flags[X86State::RFLAG_TF_RAW_LOC];
+
+      auto CompiledCode =
+        Thread->CPUBackend->CompileCode(GuestRIP, CachedIR->Length, CachedIR->TotalInstructions == 1, &IRView, DebugData.get(), TFSet);
+
+      return {
+        .CompiledCode = std::move(CompiledCode),
+        .DebugData = std::move(DebugData),
+        .StartAddr = CachedIR->StartAddr,
+        .Length = CachedIR->Length,
+        .NeedsAddGuestCodeRanges = true,
+        .CachedIR = std::move(CachedIR),
+      };
+    }
+  }
+
   if (SourcecodeResolver && Config.GDBSymbols()) {
     auto MappedSection = SyscallHandler->LookupExecutableFileSection(*Thread, GuestRIP);
     if (MappedSection) {
@@ -752,6 +851,15 @@ ContextImpl::CompileCodeResult ContextImpl::CompileCode(FEXCore::Core::InternalT
     }
   }
 
+  if (UseIRCache && NeedsAddGuestCodeRanges) {
+    auto BlockInfo = Thread->FrontendDecoder->GetDecodedBlockInfo();
+    if (auto CachedIR = FEXCore::IRCache::CreateEntry(*IRView, *BlockInfo, TotalInstructions, StartAddr, Length)) {
+      std::shared_lock lk(UnalignedAtomicMutex);
+      CachedIR->UnalignedAtomics = CountUnalignedAtomics(CachedIR->GuestCode);
+      IRCache->Insert(GuestRIP, std::move(CachedIR));
+    }
+  }
+
   auto DebugData = fextl::make_unique<FEXCore::Core::DebugData>();
 
   // If the trap flag is set we generate single instruction blocks that each check to generate a single step exception.
@@ -790,7 +898,10 @@ uintptr_t ContextImpl::CompileBlock(FEXCore::Core::CpuStateFrame* Frame, uint64_
   // Accumulate a JIT count now, as even if another thread raced us, it should count as a compile.
   FEXCORE_PROFILE_INSTANT_INCREMENT(Thread, AccumulatedJITCount, 1);
 
-  auto [CompiledCode, DebugData, StartAddr, Length, NeedsAddGuestCodeRanges] = CompileCode(Thread, GuestRIP, MaxInst);
+  Thread->Compiling.store(true, std::memory_order_relaxed);
+  auto [CompiledCode, DebugData, StartAddr, Length, NeedsAddGuestCodeRanges, CachedIR] = CompileCode(Thread, GuestRIP, MaxInst);
+  Thread->Compiling.store(false, std::memory_order_relaxed);
+
   auto CodePtr = CompiledCode.EntryPoints[GuestRIP];
   if (CodePtr == nullptr) {
     return 0;
@@ -848,11 +959,14 @@ uintptr_t ContextImpl::CompileBlock(FEXCore::Core::CpuStateFrame* Frame, uint64_
   if (NeedsAddGuestCodeRanges) {
     // Track in the guest to host map all entrypoints for all pages the compiled block touches, if any page didn't previously
     // contain code, inform the frontend so it can setup SMC detection.
+    // The decoder didn't run if the IR came from the IR cache.
     auto BlockInfo = Thread->FrontendDecoder->GetDecodedBlockInfo();
-    CodePages.reserve(BlockInfo->CodePages.size());
-    CodePages.insert(CodePages.end(), BlockInfo->CodePages.begin(), BlockInfo->CodePages.end());
-    for (auto CodePage : BlockInfo->CodePages) {
-      if (Thread->LookupCache->AddBlockExecutableRange(Thread, BlockInfo->EntryPoints, CodePage, FEXCore::Utils::FEX_PAGE_SIZE)) {
+    const auto& BlockCodePages = CachedIR ? CachedIR->CodePages : BlockInfo->CodePages;
+    const auto& BlockEntryPoints = CachedIR ? CachedIR->EntryPoints : BlockInfo->EntryPoints;
+    CodePages.reserve(BlockCodePages.size());
+    CodePages.insert(CodePages.end(), BlockCodePages.begin(), BlockCodePages.end());
+    for (auto CodePage : BlockCodePages) {
+      if (Thread->LookupCache->AddBlockExecutableRange(Thread, BlockEntryPoints, CodePage, FEXCore::Utils::FEX_PAGE_SIZE)) {
         SyscallHandler->MarkGuestExecutableRange(Thread, CodePage, FEXCore::Utils::FEX_PAGE_SIZE);
       }
     }
@@ -883,7 +997,7 @@ uintptr_t ContextImpl::CompileSingleStep(FEXCore::Core::CpuStateFrame* Frame, ui
   // Invalidate might take a unique lock on this, to guarantee that during invalidation no code gets compiled
   auto lk = GuardSignalDeferringSection<std::shared_lock>(CodeInvalidationMutex, Thread);
 
-  auto [CompiledCode, DebugData, StartAddr, Length, _] = CompileCode(Thread, GuestRIP, 1);
+  auto [CompiledCode, DebugData, StartAddr, Length, _, CachedIR] = CompileCode(Thread, GuestRIP, 1);
   auto CodePtr = CompiledCode.EntryPoints[GuestRIP];
   if (CodePtr == nullptr) {
     return 0;
@@ -899,6 +1013,10 @@ void ContextImpl::InvalidateCodeBuffersCodeRange(uint64_t Start, uint64_t Length
   FEXCORE_PROFILE_SCOPED("InvalidateCodeBuffersCodeRange");
 
   LOGMAN_THROW_A_FMT(CodeInvalidationMutex.try_lock() == false, "CodeInvalidationMutex needs to be unique_locked here");
+  if (IRCache) {
+    IRCache->InvalidateRange(Start, Length);
+  }
+
   std::scoped_lock lk {CodeBufferListLock};
   auto it = CodeBufferList.begin();
   while (it != CodeBufferList.end()) {
@@ -926,8 +1044,19 @@ void ContextImpl::InvalidateThreadCachedCodeRange(FEXCore::Core::InternalThreadS
   }
 }
 
+void ContextImpl::TrimThreadLocalCaches(FEXCore::Core::InternalThreadState* Thread) {
+  FEXCORE_PROFILE_SCOPED("TrimThreadLocalCaches");
+  Thread->LookupCache->TrimThreadLocalCaches(Thread);
+}
+
 void ContextImpl::ThreadRemoveCodeEntryFromJit(FEXCore::Core::CpuStateFrame* Frame, uint64_t GuestRIP) {
-  static_cast<ContextImpl*>(Frame->Thread->CTX)->SyscallHandler->InvalidateGuestCodeRange(Frame->Thread, GuestRIP, 1);
+  auto CTX = static_cast<ContextImpl*>(Frame->Thread->CTX);
+  if (CTX->Config.SMCChecks == FEXCore::Config::CONFIG_SMC_FULL_BLOCK) {
+    // The code changed under a compiled block, it is likely to change again so validate it per instruction from now on.
+    std::unique_lock lk(CTX->SelfModifyingBlocksMutex);
+    CTX->SelfModifyingBlocks.emplace(GuestRIP);
+  }
+  CTX->SyscallHandler->InvalidateGuestCodeRange(Frame->Thread, GuestRIP, 1);
 }
 
 std::optional<CustomIRResult>
@@ -936,6 +1065,11 @@ ContextImpl::AddCustomIREntrypoint(uintptr_t Entrypoint, CustomIREntrypointHandl
 
   std::unique_lock lk(CustomIRMutex);
 
+  if (IRCache) {
+    // Custom IR takes priority over the guest code at the entrypoint.
+    IRCache->InvalidateRange(Entrypoint, 1);
+  }
+
   auto InsertedIterator = CustomIRHandlers.emplace(Entrypoint, CustomIRHandlerEntry {Handler, Creator, Data});
   HasCustomIRHandlers = true;
 
@@ -990,10 +1124,93 @@ void ContextImpl::AddThunkTrampolineIRHandler(uintptr_t Entrypoint, uintptr_t Gu
   }
 }
 
+void ContextImpl::AddHostFunctionIRHandler(uintptr_t Entrypoint, const IR::SHA256Sum& HostFunction, HostFunctionABI ABI) {
+  LOGMAN_THROW_A_FMT(Config.Is64BitMode, "Host function redirection is only supported for 64-bit guests");
+
+  LogMan::Msg::DFmt("Adding host function handler at guest address {:#x}", Entrypoint);
+
+  const auto VectorSize = (HostFeatures.SupportsSVE256 && HostFeatures.SupportsAVX) ? IR::OpSize::i256Bit : IR::OpSize::i128Bit;
+
+  auto Result = AddCustomIREntrypoint(
+    Entrypoint,
+    [HostFunction, ABI, VectorSize](uintptr_t Entrypoint, FEXCore::IR::IREmitter* emit) {
+      auto IRHeader = emit->_IRHeader(emit->Invalid(), Entrypoint, 0, 0, 0, 0);
+      auto Block = emit->CreateCodeNode(true, 0);
+      IRHeader.first->Blocks = emit->WrapNode(Block);
+      emit->SetCurrentCodeBlock(Block);
+
+      // The argument block lives in the red zone of the replaced function.
+      // Layout: RDI, RSI, RDX, RCX, R8, R9, return value. The return value is initialized with the entrypoint.
+      // The vector ABI appends padding and XMM0, XMM1, XMM2, which still fits in the 128 byte red zone.
+      constexpr std::array<uint32_t, 6> ArgumentRegisters {X86State::REG_RDI, X86State::REG_RSI, X86State::REG_RDX,
+                                                           X86State::REG_RCX, X86State::REG_R8,  X86State::REG_R9};
+      constexpr size_t VectorArguments = 3;
+      constexpr int64_t ReturnValueOffset = ArgumentRegisters.size() * 8;
+      constexpr int64_t VectorOffset = ReturnValueOffset + 16;
+      const int64_t ArgumentBlockOffset =
+        ABI == HostFunctionABI::Vector ? -int64_t(VectorOffset + VectorArguments * 16) : -int64_t(ReturnValueOffset + 8);
+
+      auto ArgPtr = emit->_Add(IR::OpSize::i64Bit, emit->_LoadRegister(X86State::REG_RSP, IR::RegClass::GPR, IR::OpSize::i64Bit),
+                               emit->Constant(ArgumentBlockOffset));
+      for (size_t i = 0; i < ArgumentRegisters.size(); ++i) {
+        auto Arg = emit->_LoadRegister(ArgumentRegisters[i], IR::RegClass::GPR, IR::OpSize::i64Bit);
+        emit->_StoreMemGPR(IR::OpSize::i64Bit, emit->_Add(IR::OpSize::i64Bit, ArgPtr, emit->Constant(i * 8)), Arg);
+      }
+      emit->_StoreMemGPR(IR::OpSize::i64Bit, emit->_Add(IR::OpSize::i64Bit, ArgPtr, emit->Constant(ReturnValueOffset)),
+                         emit->Constant(Entrypoint));
+
+      if (ABI == HostFunctionABI::Vector) {
+        for (uint32_t i = 0; i < VectorArguments; ++i) {
+          auto Arg = emit->_LoadRegister(i, IR::RegClass::FPR, VectorSize);
+          emit->_StoreMemFPR(IR::OpSize::i128Bit, emit->_Add(IR::OpSize::i64Bit, ArgPtr, emit->Constant(VectorOffset + i * 16)), Arg);
+        }
+      }
+
+      // The replaced function is entered through a guest call and host functions never call back in to the guest,
+      // so the cheaper leaf transition is sufficient.
+      emit->_Thunk(ArgPtr, HostFunction, true);
+
+      // Return to the caller with the result in RAX or XMM0.
+      auto RSP = emit->_LoadRegister(X86State::REG_RSP, IR::RegClass::GPR, IR::OpSize::i64Bit);
+      auto ReturnAddress = emit->_LoadMemGPR(IR::OpSize::i64Bit, RSP);
+
+      const int64_t ReturnSlotOffset = ArgumentBlockOffset + (ABI == HostFunctionABI::Vector ? VectorOffset : ReturnValueOffset);
+      auto ReturnSlot = emit->_Add(IR::OpSize::i64Bit, RSP, emit->Constant(ReturnSlotOffset));
+
+      IR::Ref R;
+      if (ABI == HostFunctionABI::Vector) {
+        R = emit->_StoreRegister(emit->_LoadMemFPR(IR::OpSize::i128Bit, ReturnSlot), VectorSize);
+        R->Reg = IR::PhysicalRegister(IR::RegClass::FPRFixed, 0).Raw;
+      } else {
+        R = emit->_StoreRegister(emit->_LoadMemGPR(IR::OpSize::i64Bit, ReturnSlot), IR::OpSize::i64Bit);
+        R->Reg = IR::PhysicalRegister(IR::RegClass::GPRFixed, X86State::REG_RAX).Raw;
+      }
+      R = emit->_StoreRegister(emit->_Add(IR::OpSize::i64Bit, RSP, emit->Constant(8)), IR::OpSize::i64Bit);
+      R->Reg = IR::PhysicalRegister(IR::RegClass::GPRFixed, X86State::REG_RSP).Raw;
+
+      emit->_ExitFunction(IR::OpSize::i64Bit, ReturnAddress, IR::BranchHint::Return, emit->Invalid(), emit->Invalid());
+    },
+    ThunkHandler, nullptr);
+
+  if (Result.has_value()) {
+    LogMan::Msg::EFmt("Guest address {:#x} already has a custom IR handler, not redirecting it to a host function", Entrypoint);
+  }
+}
+
+void ContextImpl::RemoveHostFunctionIRHandler(FEXCore::Core::InternalThreadState* Thread, uintptr_t Entrypoint) {
+  RemoveCustomIREntrypoint(Thread, Entrypoint);
+}
+
 void ContextImpl::AddForceTSOInformation(const IntervalList<uint64_t>& ValidRanges, fextl::set<uint64_t>&& Instructions) {
   LogMan::Throw::AFmt(CodeInvalidationMutex.try_lock() == false, "CodeInvalidationMutex needs to be unique_locked here");
   ForceTSOValidRanges.Insert(ValidRanges);
   ForceTSOInstructions.merge(std::move(Instructions));
+
+  if (IRCache) {
+    for (const auto& Range : ValidRanges) {
+      IRCache->InvalidateRange(Range.Offset, Range.End - Range.Offset);
+    }
+  }
 }
 
 void ContextImpl::RemoveForceTSOInformation(uint64_t Address, uint64_t Size) {
@@ -1001,6 +1218,84 @@ void ContextImpl::RemoveForceTSOInformation(uint64_t Address, uint64_t Size) {
 
   ForceTSOValidRanges.Remove({Address, Address + Size});
   ForceTSOInstructions.erase(ForceTSOInstructions.lower_bound(Address), ForceTSOInstructions.upper_bound(Address + Size));
+  TSOFreeInstructions.erase(TSOFreeInstructions.lower_bound(Address), TSOFreeInstructions.upper_bound(Address + Size));
+  if (IRCache) {
+    IRCache->InvalidateRange(Address, Size);
+  }
+
+  std::unique_lock lk(UnalignedAtomicMutex);
+  UnalignedAtomicInstructions.erase(UnalignedAtomicInstructions.lower_bound(Address),
+                                    UnalignedAtomicInstructions.upper_bound(Address + Size));
+}
+
+void ContextImpl::AddTSOFreeInstructions(fextl::set<uint64_t>&& Instructions) {
+  LogMan::Throw::AFmt(CodeInvalidationMutex.try_lock() == false, "CodeInvalidationMutex needs to be unique_locked here");
+  if (IRCache) {
+    for (auto Address : Instructions) {
+      IRCache->InvalidateRange(Address, 1);
+    }
+  }
+
+  TSOFreeInstructions.merge(std::move(Instructions));
+}
+
+void ContextImpl::RemoveTSOFreeInstructions(const fextl::set<uint64_t>& Instructions) {
+  LogMan::Throw::AFmt(CodeInvalidationMutex.try_lock() == false, "CodeInvalidationMutex needs to be unique_locked here");
+  for (auto Address : Instructions) {
+    TSOFreeInstructions.erase(Address);
+    if (IRCache) {
+      IRCache->InvalidateRange(Address, 1);
+    }
+  }
+}
+
+void ContextImpl::AddUnalignedAtomicInformation(fextl::set<uint64_t>&& Instructions) {
+  std::unique_lock lk(UnalignedAtomicMutex);
+  UnalignedAtomicInstructions.merge(std::move(Instructions));
+}
+
+void ContextImpl::MarkUnalignedAtomic(FEXCore::Core::InternalThreadState* Thread, uint64_t HostPC) {
+  FEXCORE_PROFILE_INSTANT_INCREMENT(Thread, AccumulatedSIGBUSBackpatchCount, 1);
+
+  // Runs inside the SIGBUS handler, so only lock-free operations are allowed here.
+  const auto GuestRIP = RestoreRIPFromHostPC(Thread, HostPC);
+  for (auto& Slot : PendingUnalignedAtomics) {
+    uint64_t Expected = 0;
+    if (Slot.compare_exchange_strong(Expected, GuestRIP, std::memory_order_release, std::memory_order_relaxed)) {
+      HasPendingUnalignedAtomics.store(true, std::memory_order_release);
+      return;
+    }
+
+    if (Expected == GuestRIP) {
+      // Another thread backpatched the same instruction.
+      return;
+    }
+  }
+
+  // The queue is full. The access was backpatched regardless, the instruction just isn't remembered.
+}
+
+void ContextImpl::AddPendingUnalignedAtomics(FEXCore::Core::InternalThreadState* Thread) {
+  HasPendingUnalignedAtomics.store(false, std::memory_order_relaxed);
+
+  fextl::vector<uint64_t> NewInstructions;
+  {
+    std::unique_lock lk(UnalignedAtomicMutex);
+    for (auto& Slot : PendingUnalignedAtomics) {
+      if (Slot.load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+
+      const auto GuestRIP = Slot.exchange(0, std::memory_order_acquire);
+      if (GuestRIP && UnalignedAtomicInstructions.insert(GuestRIP).second) {
+        NewInstructions.push_back(GuestRIP);
+      }
+    }
+  }
+
+  for (auto GuestRIP : NewInstructions) {
+    SyscallHandler->MarkUnalignedAtomic(Thread, GuestRIP);
+  }
 }
 
 void ContextImpl::MarkMonoBackpatcherBlock(uint64_t BlockEntry) {
@@ -181,6 +181,11 @@ void Dispatcher::EmitDispatcher() {
   } else {
     // This is the block cache lookup routine
     // It matches what is going on it LookupCache.h::FindBlock
+    // Snapshot the L1 generation before reading any entries, see LookupCache::BeginL1Invalidation.
+    ldr(TMP1, STATE, offsetof(FEXCore::Core::CpuStateFrame, State.L1GenerationPointer));
+    ldar(TMP1, TMP1);
+    fmov(ARMEmitter::Size::i64Bit, VTMP2.D(), TMP1);
+
     ldr(TMP1, STATE_PTR(CpuStateFrame, Pointers.Common.L2Pointer));
 
     // Mask the address by the virtual address size so we can check for aliases
@@ -223,15 +228,40 @@ void Dispatcher::EmitDispatcher() {
       // If we've made it here then we have a real compiled block
       {
         // update L1 cache
-        ldp<ARMEmitter::IndexType::OFFSET>(TMP1, TMP2, STATE, offsetof(FEXCore::Core::CpuStateFrame, State.L1Pointer));
-
-        // Calculate (tmp1 + ((ripreg & L1_ENTRIES_MASK) << 4)) for the address
+        // Calculate (L1Pointer + ((L1Hash(ripreg) & L1_SETS_MASK) << 5)) for the address of the set
         // L1Mask is pre-shifted.
-        and_(ARMEmitter::Size::i64Bit, TMP2, TMP2, RipReg.R(), ARMEmitter::ShiftType::LSL, FEXCore::ilog2(sizeof(LookupCache::LookupCacheEntry)));
+        ldr(TMP2, STATE, offsetof(FEXCore::Core::CpuStateFrame, State.L1Mask));
+        eor(ARMEmitter::Size::i64Bit, TMP1.R(), RipReg.R(), RipReg.R(), ARMEmitter::ShiftType::LSR, LookupCache::L1_HASH_SHIFT);
+        and_(ARMEmitter::Size::i64Bit, TMP2, TMP2, TMP1.R(), ARMEmitter::ShiftType::LSL,
+             FEXCore::ilog2(sizeof(LookupCache::LookupCacheEntry) * LookupCache::L1_WAYS));
+        ldr(TMP1, STATE, offsetof(FEXCore::Core::CpuStateFrame, State.L1Pointer));
         add(TMP1, TMP1, TMP2);
 
+        // Insert the block as the most recently used entry, same as LookupCache::InsertL1Entry.
+        // Way 0 only gets demoted to way 1 if it holds a different block.
+        ARMEmitter::ForwardLabel SkipDemotion;
+        ldr(TMP2, TMP1, offsetof(LookupCache::LookupCacheEntry, GuestCode));
+        sub(TMP2, TMP2, RipReg);
+        (void)cbz(ARMEmitter::Size::i64Bit, TMP2, &SkipDemotion);
+        ldr(VTMP1.Q(), TMP1, 0);
+        str(VTMP1.Q(), TMP1, sizeof(LookupCache::LookupCacheEntry));
+        (void)Bind(&SkipDemotion);
         stp<ARMEmitter::IndexType::OFFSET>(TMP4, RipReg, TMP1);
 
+        // If an invalidation ran concurrently the entries written may be stale, drop the set in that case.
+        // An invalidation in progress leaves the snapshot odd, so it never matches.
+        ARMEmitter::ForwardLabel GenerationUnchanged;
+        dmb(ARMEmitter::BarrierScope::ISH);
+        ldr(TMP2, STATE, offsetof(FEXCore::Core::CpuStateFrame, State.L1GenerationPointer));
+        ldr(TMP2, TMP2, 0);
+        fmov(ARMEmitter::Size::i64Bit, TMP3, VTMP2.D());
+        and_(ARMEmitter::Size::i64Bit, TMP3, TMP3, ~1ULL);
+        sub(TMP2, TMP2, TMP3);
+        (void)cbz(ARMEmitter::Size::i64Bit, TMP2, &GenerationUnchanged);
+        str(ARMEmitter::XReg::zr, TMP1, offsetof(LookupCache::LookupCacheEntry, GuestCode));
+        str(ARMEmitter::XReg::zr, TMP1, sizeof(LookupCache::LookupCacheEntry) + offsetof(LookupCache::LookupCacheEntry, GuestCode));
+        (void)Bind(&GenerationUnchanged);
+
         // Jump to the block
         br(TMP4);
       }
@@ -151,6 +151,8 @@ uint64_t Decoder::ReadData(uint8_t Size) {
     ReadByte();
   }
 #else
+  // Keep the bytes of the instruction, they are what the block gets validated against.
+  std::memcpy(&Instruction[InstructionSize], &Res, std::min<size_t>(Size, MAX_INST_SIZE - InstructionSize));
   SkipBytes(Size);
 #endif
 
@@ -1204,6 +1206,140 @@ bool Decoder::IsBranchMonoTailcall(uint64_t NumInstructions) const {
   return false;
 }
 
+bool Decoder::IsSpinLoop(const DecodedBlocks& Block) const {
+  // Matches small single block loops that only wait for a memory word to change, such as:
+  // 1: PAUSE
+  //    CMP dword [rdi], 0  /  MOV eax, [rdi]; TEST eax, eax
+  //    JNE 1b
+  //
+  // The block may contain PAUSE, NOP, one load through MOV, MOVZX, CMP or TEST, and register-only CMP or TEST after the
+  // load. Since nothing else in the loop has side effects, and the branch only depends on the loaded value and on
+  // registers that the loop doesn't write, delaying the back edge until the memory changes can't be observed by the guest.
+  constexpr uint64_t MaxSpinLoopInstructions = 8;
+  if (Block.NumInstructions < 3 || Block.NumInstructions > MaxSpinLoopInstructions || Block.BlockStatus != DecodedBlockStatus::SUCCESS) {
+    return false;
+  }
+
+  auto TableIndex = [](const auto& Table, const X86InstInfo* Info) -> int64_t {
+    if (Info < Table.data() || Info >= Table.data() + Table.size()) {
+      return -1;
+    }
+    return Info - Table.data();
+  };
+
+  // Matches the OPD macro used for the primary group tables.
+  auto PrimaryGroupIndex = [](InstType Group, uint8_t Prefix, uint8_t Reg) -> int64_t {
+    return ((Group - TYPE_GROUP_1) << 6) | (Prefix << 3) | Reg;
+  };
+
+  auto IsMemOperand = [](const DecodedOperand& Operand) {
+    return Operand.IsGPRDirect() || Operand.IsGPRIndirect() || Operand.IsRIPRelative() || Operand.IsSIB();
+  };
+
+  auto UsesAddressRegister = [](const DecodedOperand& Operand, uint8_t GPR) {
+    if (Operand.IsGPRDirect()) {
+      return Operand.Data.GPR.GPR == GPR;
+    } else if (Operand.IsGPRIndirect()) {
+      return Operand.Data.GPRIndirect.GPR == GPR;
+    } else if (Operand.IsSIB()) {
+      return Operand.Data.SIB.Base == GPR || Operand.Data.SIB.Index == GPR;
+    }
+    return false;
+  };
+
+  // The back edge must be a conditional branch to the start of the block. Parity conditions aren't handled.
+  const auto& Branch = Block.DecodedInstructions[Block.NumInstructions - 1];
+  const auto BaseBranch = TableIndex(BaseOps, Branch.TableInfo);
+  const auto SecondBranch = TableIndex(SecondBaseOps, Branch.TableInfo);
+  int64_t BranchCond {};
+  if (BaseBranch >= 0x70 && BaseBranch <= 0x7F) {
+    BranchCond = BaseBranch & 0xF;
+  } else if (SecondBranch >= 0x80 && SecondBranch <= 0x8F) {
+    BranchCond = SecondBranch & 0xF;
+  } else {
+    return false;
+  }
+
+  if (BranchCond == 0xA || BranchCond == 0xB) {
+    return false;
+  }
+
+  uint64_t Target = Branch.PC + Branch.InstSize + Branch.Src[0].Literal();
+  if (GetGPROpSize() == IR::OpSize::i32Bit) {
+    Target &= 0xFFFFFFFFU;
+  }
+
+  if (Target != Block.Entry) {
+    return false;
+  }
+
+  bool HasPause {};
+  bool HasFlagsAfterLoad {};
+  const DecodedInst* Load {};
+
+  for (size_t i = 0; i < Block.NumInstructions - 1; ++i) {
+    const auto& Inst = Block.DecodedInstructions[i];
+    const auto* Info = Inst.TableInfo;
+
+    if (Inst.Flags & DecodeFlags::FLAG_LOCK) {
+      return false;
+    }
+
+    const auto Base = TableIndex(BaseOps, Info);
+    const auto Second = TableIndex(SecondBaseOps, Info);
+    const auto Group = TableIndex(PrimaryInstGroupOps, Info);
+
+    if (Base == 0x90 && Inst.Dest.IsGPR() && Inst.Dest.Data.GPR.GPR == FEXCore::X86State::REG_RAX && Inst.Src[0].IsGPR() &&
+        Inst.Src[0].Data.GPR.GPR == FEXCore::X86State::REG_RAX) {
+      // NOP, or PAUSE with a REP prefix. Same special case as OpDispatchBuilder::XCHGOp.
+      HasPause |= (Inst.Flags & DecodeFlags::FLAG_REP_PREFIX) != 0;
+      continue;
+    }
+
+    const bool IsMov = Base == 0x8A || Base == 0x8B || Second == 0xB6 || Second == 0xB7;
+    const bool IsCompare = (Base >= 0x38 && Base <= 0x3D) || Base == 0x84 || Base == 0x85 || Base == 0xA8 || Base == 0xA9 ||
+                           Group == PrimaryGroupIndex(TYPE_GROUP_1, 0, 7) || Group == PrimaryGroupIndex(TYPE_GROUP_1, 1, 7) ||
+                           Group == PrimaryGroupIndex(TYPE_GROUP_1, 3, 7) || Group == PrimaryGroupIndex(TYPE_GROUP_3, 0, 0) ||
+                           Group == PrimaryGroupIndex(TYPE_GROUP_3, 0, 1) || Group == PrimaryGroupIndex(TYPE_GROUP_3, 1, 0) ||
+                           Group == PrimaryGroupIndex(TYPE_GROUP_3, 1, 1);
+
+    if (!IsMov && !IsCompare) {
+      return false;
+    }
+
+    const bool AccessesMemory = IsMemOperand(Inst.Dest) || IsMemOperand(Inst.Src[0]) || IsMemOperand(Inst.Src[1]);
+
+    if (IsMov) {
+      // A MOV is only allowed as the load itself, register moves would carry state between iterations.
+      if (!AccessesMemory || Load) {
+        return false;
+      }
+
+      // The address must stay the same for every iteration.
+      if (UsesAddressRegister(Inst.Src[0], Inst.Dest.Data.GPR.GPR)) {
+        return false;
+      }
+
+      Load = &Inst;
+      continue;
+    }
+
+    if (AccessesMemory) {
+      if (Load) {
+        return false;
+      }
+      Load = &Inst;
+    } else if (!Load) {
+      // Flags need to be calculated from the value loaded in this iteration.
+      return false;
+    }
+
+    HasFlagsAfterLoad = true;
+  }
+
+  return HasPause && Load && HasFlagsAfterLoad;
+}
+
 bool Decoder::InstCanContinue() const {
   if (DecodeInst->PC + DecodeInst->InstSize == NextBlockStartAddress) {
     return false;
@@ -1266,6 +1402,7 @@ void Decoder::AddBranchTarget(uint64_t Target) {
           .Size = BlockIt->Size - SplitOffset,
           .NumInstructions = BlockIt->NumInstructions - SplitIdx,
           .DecodedInstructions = BlockIt->DecodedInstructions + SplitIdx,
+          .CodeOffset = BlockIt->CodeOffset + SplitOffset,
           .BlockStatus = BlockIt->BlockStatus,
         };
 
@@ -1310,6 +1447,7 @@ void Decoder::DecodeInstructionsAtEntry(FEXCore::Core::InternalThreadState* Thre
   FEXCORE_PROFILE_SCOPED("DecodeInstructions");
   BlockInfo.TotalInstructionCount = 0;
   BlockInfo.Blocks.clear();
+  BlockInfo.CodeBytes.clear();
   VisitedBlocks.clear();
   // Reset internal state management
   DecodedSize = 0;
@@ -1388,6 +1526,7 @@ void Decoder::DecodeInstructionsAtEntry(FEXCore::Core::InternalThreadState* Thre
 
     BlockIt->DecodedInstructions = &DecodedBuffer[BlockStartOffset];
     BlockIt->NumInstructions = 0;
+    BlockIt->CodeOffset = BlockInfo.CodeBytes.size();
 
     // Do a bit of pointer math to figure out where we are in code
     InstStream = AdjustAddrForSpecialRegion(_InstStream, EntryPoint, RIPToDecode);
@@ -1434,6 +1573,7 @@ void Decoder::DecodeInstructionsAtEntry(FEXCore::Core::InternalThreadState* Thre
       ++DecodedSize;
       ++BlockIt->NumInstructions;
       BlockIt->Size += DecodeInst->InstSize;
+      BlockInfo.CodeBytes.insert(BlockInfo.CodeBytes.end(), Instruction.begin(), Instruction.begin() + DecodeInst->InstSize);
 
       // Can not continue this block at all on invalid instruction
       if (BlockIt->BlockStatus != DecodedBlockStatus::SUCCESS) [[unlikely]] {
@@ -1443,6 +1583,7 @@ void Decoder::DecodeInstructionsAtEntry(FEXCore::Core::InternalThreadState* Thre
           // Just need to undo additions that this block decoding has caused.
           TotalInstructions -= BlockIt->NumInstructions;
           DecodedSize = BlockStartOffset;
+          BlockInfo.CodeBytes.resize(BlockIt->CodeOffset);
           InstStream -= PCOffset;
           EraseBlock = true;
         } else {
@@ -1491,8 +1632,13 @@ void Decoder::DecodeInstructionsAtEntry(FEXCore::Core::InternalThreadState* Thre
 
   BlockInfo.TotalInstructionCount = TotalInstructions;
 
+  // Spin-loop waits need the whole loop to be a single IR block, which isn't the case with full SMC checks.
+  const bool DetectSpinLoops = CTX->Config.SpinLoopWait && CTX->Config.SMCChecks != FEXCore::Config::CONFIG_SMC_FULL &&
+                               CTX->Config.SMCChecks != FEXCore::Config::CONFIG_SMC_FULL_BLOCK;
+
   for (auto& Block : BlockInfo.Blocks) {
     Block.IsEntryPoint = BlockInfo.EntryPoints.contains(Block.Entry);
+    Block.IsSpinLoop = DetectSpinLoops && !Block.ForceFullSMCDetection && IsSpinLoop(Block);
   }
 }
 
@@ -36,9 +36,13 @@ public:
     uint64_t Size {};
     uint64_t NumInstructions {};
     FEXCore::X86Tables::DecodedInst* DecodedInstructions;
+    // Offset of the guest code of the block in DecodedBlockInformation::CodeBytes
+    uint64_t CodeOffset {};
     DecodedBlockStatus BlockStatus;
     bool IsEntryPoint {};
     bool ForceFullSMCDetection {};
+    // The block is a loop that only spins on a memory word, see Decoder::IsSpinLoop.
+    bool IsSpinLoop {};
   };
 
   struct DecodedBlockInformation final {
@@ -47,6 +51,8 @@ public:
     fextl::vector<DecodedBlocks> Blocks;
     fextl::set<uint64_t> EntryPoints;
     fextl::set<uint64_t> CodePages; // Start addresses of all pages touching the block
+    // Guest code of all blocks as the decoder read it, guest memory may have changed since
+    fextl::vector<uint8_t> CodeBytes;
   };
 
   Decoder(FEXCore::Core::InternalThreadState* Thread);
@@ -92,6 +98,7 @@ private:
 
   void BranchTargetInMultiblockRange();
   bool IsBranchMonoTailcall(uint64_t NumInstructions) const;
+  bool IsSpinLoop(const DecodedBlocks& Block) const;
   bool InstCanContinue() const;
 
   void AddBranchTarget(uint64_t Target);
@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: glue|block-database
+desc: Caches the final IR of blocks so code buffer flushes don't need to run the frontend again
+$end_info$
+*/
+
+#include "Interface/Core/IRCache.h"
+
+#include <FEXCore/HLE/SyscallHandler.h>
+#include <FEXCore/Utils/TypeDefines.h>
+
+#include <algorithm>
+#include <cstring>
+#include <xxhash.h>
+
+namespace FEXCore {
+namespace {
+  // Rough size of a node in the sets and lists that hold an entry.
+  constexpr size_t NODE_SIZE = 48;
+
+  size_t EntrySize(const IRCache::Entry& CachedEntry) {
+    return sizeof(CachedEntry) + CachedEntry.IR.size() + CachedEntry.GuestCode.size() * sizeof(IRCache::CodeRange) +
+           (CachedEntry.EntryPoints.size() + CachedEntry.CodePages.size() * 2 + 1) * NODE_SIZE;
+  }
+} // namespace
+
+uint64_t IRCache::HashGuestCode(const fextl::vector<CodeRange>& GuestCode) {
+  uint64_t Hash {};
+  for (const auto& Range : GuestCode) {
+    Hash = XXH3_64bits_withSeed(reinterpret_cast<const void*>(Range.Start), Range.Size, Hash);
+  }
+  return Hash;
+}
+
+uint64_t IRCache::HashDecodedCode(const Frontend::Decoder::DecodedBlockInformation& BlockInfo) {
+  // Chained the same way as HashGuestCode so the two match for unchanged code.
+  uint64_t Hash {};
+  for (const auto& Block : BlockInfo.Blocks) {
+    Hash = XXH3_64bits_withSeed(&BlockInfo.CodeBytes[Block.CodeOffset], Block.Size, Hash);
+  }
+  return Hash;
+}
+
+bool IRCache::IsGuestCodeMapped(FEXCore::Core::InternalThreadState* Thread, FEXCore::HLE::SyscallHandler* SyscallHandler,
+                                const fextl::vector<CodeRange>& GuestCode) {
+  for (const auto& Range : GuestCode) {
+    uint64_t Address = Range.Start;
+    const uint64_t End = Range.Start + Range.Size;
+    while (Address < End) {
+      const auto RangeInfo = SyscallHandler->QueryGuestExecutableRange(Thread, Address);
+      const uint64_t RangeEnd = RangeInfo.Base + RangeInfo.Size;
+      if (RangeInfo.Size == 0 || RangeEnd <= Address) {
+        return false;
+      }
+      Address = RangeEnd;
+    }
+  }
+  return true;
+}
+
+fextl::shared_ptr<IRCache::Entry> IRCache::CreateEntry(const IR::IRListView& IR,
+                                                       const Frontend::Decoder::DecodedBlockInformation& BlockInfo,
+                                                       uint64_t TotalInstructions, uint64_t StartAddr, uint64_t Length) {
+  // Whether an instruction decodes to a fault can depend on the page permissions rather than the code bytes.
+  const bool AllDecoded = std::all_of(BlockInfo.Blocks.begin(), BlockInfo.Blocks.end(), [](const auto& Block) {
+    return Block.BlockStatus == Frontend::Decoder::DecodedBlockStatus::SUCCESS;
+  });
+  if (!AllDecoded || BlockInfo.Blocks.empty()) {
+    return nullptr;
+  }
+
+  auto CachedEntry = fextl::make_shared<Entry>();
+  CachedEntry->DataSize = IR.GetDataSize();
+  CachedEntry->ListSize = IR.GetListSize();
+  CachedEntry->IR.resize(CachedEntry->DataSize + CachedEntry->ListSize);
+  memcpy(CachedEntry->IR.data(), IR.GetData(), CachedEntry->DataSize);
+  memcpy(CachedEntry->IR.data() + CachedEntry->DataSize, IR.GetListData(), CachedEntry->ListSize);
+
+  CachedEntry->TotalInstructions = TotalInstructions;
+  CachedEntry->StartAddr = StartAddr;
+  CachedEntry->Length = Length;
+
+  CachedEntry->GuestCode.reserve(BlockInfo.Blocks.size());
+  for (const auto& Block : BlockInfo.Blocks) {
+    CachedEntry->GuestCode.push_back({Block.Entry, Block.Size});
+  }
+  // Guest memory may already differ from what got decoded, the hash needs to match the IR.
+  CachedEntry->CodeHash = HashDecodedCode(BlockInfo);
+
+  CachedEntry->EntryPoints = BlockInfo.EntryPoints;
+  CachedEntry->CodePages = BlockInfo.CodePages;
+  return CachedEntry;
+}
+
+fextl::shared_ptr<IRCache::Entry>
+IRCache::Find(FEXCore::Core::InternalThreadState* Thread, FEXCore::HLE::SyscallHandler* SyscallHandler, uint64_t GuestRIP) {
+  fextl::shared_ptr<Entry> CachedEntry;
+  {
+    std::scoped_lock lk {Mutex};
+    auto It = Entries.find(GuestRIP);
+    if (It == Entries.end()) {
+      return nullptr;
+    }
+
+    LRU.splice(LRU.begin(), LRU, It->second.LRU);
+    CachedEntry = It->second.CachedEntry;
+  }
+
+  // Code that got modified or unmapped without an invalidation, only possible without SMC checks.
+  // Unmapping drops the range from the cache in every SMC mode, this catches lookups racing with an unmap.
+  if (!IsGuestCodeMapped(Thread, SyscallHandler, CachedEntry->GuestCode) ||
+      HashGuestCode(CachedEntry->GuestCode) != CachedEntry->CodeHash) {
+    std::scoped_lock lk {Mutex};
+    if (auto It = Entries.find(GuestRIP); It != Entries.end() && It->second.CachedEntry == CachedEntry) {
+      EraseLocked(It);
+    }
+    return nullptr;
+  }
+
+  return CachedEntry;
+}
+
+void IRCache::Insert(uint64_t GuestRIP, fextl::shared_ptr<Entry> CachedEntry) {
+  const size_t NewSize = EntrySize(*CachedEntry);
+  if (NewSize > MaxSize) {
+    return;
+  }
+
+  std::scoped_lock lk {Mutex};
+  if (auto It = Entries.find(GuestRIP); It != Entries.end()) {
+    EraseLocked(It);
+  }
+
+  while (Size + NewSize > MaxSize) {
+    EraseLocked(Entries.find(LRU.back()));
+  }
+
+  for (auto Page : CachedEntry->CodePages) {
+    PageEntries[Page].push_back(GuestRIP);
+  }
+  LRU.push_front(GuestRIP);
+  Entries.emplace(GuestRIP, Slot {std::move(CachedEntry), NewSize, LRU.begin()});
+  Size += NewSize;
+}
+
+void IRCache::InvalidateRange(uint64_t Start, uint64_t Length) {
+  std::scoped_lock lk {Mutex};
+  const uint64_t StartPage = Start & FEXCore::Utils::FEX_PAGE_MASK;
+  const uint64_t End = Start + Length;
+
+  fextl::vector<uint64_t> Invalidated;
+  for (auto It = PageEntries.lower_bound(StartPage); It != PageEntries.end() && It->first < End; ++It) {
+    Invalidated.insert(Invalidated.end(), It->second.begin(), It->second.end());
+  }
+
+  // Entries spanning multiple pages show up more than once.
+  for (auto GuestRIP : Invalidated) {
+    if (auto It = Entries.find(GuestRIP); It != Entries.end()) {
+      EraseLocked(It);
+    }
+  }
+}
+
+void IRCache::Clear() {
+  std::scoped_lock lk {Mutex};
+  Entries.clear();
+  LRU.clear();
+  PageEntries.clear();
+  Size = 0;
+}
+
+void IRCache::EraseLocked(EntryMap::iterator It) {
+  const uint64_t GuestRIP = It->first;
+  for (auto Page : It->second.CachedEntry->CodePages) {
+    auto PageIt = PageEntries.find(Page);
+    std::erase(PageIt->second, GuestRIP);
+    if (PageIt->second.empty()) {
+      PageEntries.erase(PageIt);
+    }
+  }
+
+  LRU.erase(It->second.LRU);
+  Size -= It->second.Size;
+  Entries.erase(It);
+}
+} // namespace FEXCore
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "Interface/Core/Frontend.h"
+#include <Interface/IR/IntrusiveIRList.h>
+
+#include <FEXCore/fextl/list.h>
+#include <FEXCore/fextl/map.h>
+#include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/set.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace FEXCore::Core {
+struct InternalThreadState;
+}
+namespace FEXCore::HLE {
+class SyscallHandler;
+}
+
+namespace FEXCore {
+/**
+ * @brief Keeps the final IR of compiled blocks around so they can be compiled again without running the frontend.
+ *
+ * Clearing the code buffer throws away every compiled block while the guest code is unchanged, recompiling from a
+ * cached entry only needs the backend.
+ * Entries are validated against a hash of the guest code bytes the decoder read, and get dropped when their code range
+ * is invalidated or unmapped. Memory use is bounded, the least recently used entries get evicted first.
+ */
+class IRCache final {
+public:
+  struct CodeRange {
+    uint64_t Start;
+    uint64_t Size;
+  };
+
+  struct Entry {
+    // IR data followed by the IR list.
+    fextl::vector<uint8_t> IR;
+    size_t DataSize;
+    size_t ListSize;
+
+    uint64_t TotalInstructions;
+    uint64_t StartAddr;
+    uint64_t Length;
+
+    // Decoded guest code, the hash covers all of it as the decoder read it.
+    fextl::vector<CodeRange> GuestCode;
+    uint64_t CodeHash;
+
+    // Frontend information needed to track the compiled block.
+    fextl::set<uint64_t> EntryPoints;
+    fextl::set<uint64_t> CodePages;
+
+    // Number of known unaligned atomics in the guest code at the time the IR was generated.
+    size_t UnalignedAtomics;
+
+    IR::IRListView GetView() {
+      return IR::IRListView(IR.data(), IR.data() + DataSize, DataSize, ListSize);
+    }
+  };
+
+  explicit IRCache(size_t MaxSize)
+    : MaxSize {MaxSize} {}
+
+  static uint64_t HashGuestCode(const fextl::vector<CodeRange>& GuestCode);
+  static uint64_t HashDecodedCode(const Frontend::Decoder::DecodedBlockInformation& BlockInfo);
+
+  /**
+   * @brief Creates an entry from the IR and decoder state of a block that was just generated
+   *
+   * @return nullptr if the block can't be cached
+   */
+  static fextl::shared_ptr<Entry> CreateEntry(const IR::IRListView& IR, const Frontend::Decoder::DecodedBlockInformation& BlockInfo,
+                                              uint64_t TotalInstructions, uint64_t StartAddr, uint64_t Length);
+
+  /**
+   * @brief Looks up the IR for a block entry
+   *
+   * Entries whose guest code changed or is no longer mapped executable since they were generated are dropped.
+   */
+  fextl::shared_ptr<Entry>
+  Find(FEXCore::Core::InternalThreadState* Thread, FEXCore::HLE::SyscallHandler* SyscallHandler, uint64_t GuestRIP);
+
+  void Insert(uint64_t GuestRIP, fextl::shared_ptr<Entry> CachedEntry);
+
+  // Drops all entries that decoded guest code in any page touching [Start, Start + Length).
+  void InvalidateRange(uint64_t Start, uint64_t Length);
+
+  void Clear();
+
+private:
+  struct Slot {
+    fextl::shared_ptr<Entry> CachedEntry;
+    size_t Size;
+    fextl::list<uint64_t>::iterator LRU;
+  };
+
+  using EntryMap = fextl::unordered_map<uint64_t, Slot>;
+  void EraseLocked(EntryMap::iterator It);
+  static bool IsGuestCodeMapped(FEXCore::Core::InternalThreadState* Thread, FEXCore::HLE::SyscallHandler* SyscallHandler,
+                                const fextl::vector<CodeRange>& GuestCode);
+
+  std::mutex Mutex;
+  const size_t MaxSize;
+  size_t Size {};
+  EntryMap Entries;
+  // Block entries, most recently used first.
+  fextl::list<uint64_t> LRU;
+  // Block entries of all entries that decoded code in a page.
+  fextl::map<uint64_t, fextl::vector<uint64_t>> PageEntries;
+};
+} // namespace FEXCore
@@ -17,6 +17,9 @@ $end_info$
 #include <FEXCore/HLE/SyscallHandler.h>
 #include <FEXCore/Utils/MathUtils.h>
 
+#include <array>
+#include <span>
+
 namespace FEXCore::CPU {
 
 DEF_OP(CallbackReturn) {
@@ -176,16 +179,45 @@ DEF_OP(ExitFunction) {
     // L1 Cache
     ldp<ARMEmitter::IndexType::OFFSET>(TMP1, TMP2, STATE, offsetof(FEXCore::Core::CpuStateFrame, State.L1Pointer));
 
-    // Calculate (tmp1 + ((ripreg & L1_ENTRIES_MASK) << 4)) for the address
+    // Calculate (tmp1 + ((L1Hash(ripreg) & L1_SETS_MASK) << 5)) for the address of the set
     // L1Mask is pre-shifted.
-    and_(ARMEmitter::Size::i64Bit, TMP2, TMP2, RipReg, ARMEmitter::ShiftType::LSL, FEXCore::ilog2(sizeof(LookupCache::LookupCacheEntry)));
+    eor(ARMEmitter::Size::i64Bit, TMP3, RipReg, RipReg, ARMEmitter::ShiftType::LSR, LookupCache::L1_HASH_SHIFT);
+    and_(ARMEmitter::Size::i64Bit, TMP2, TMP2, TMP3, ARMEmitter::ShiftType::LSL,
+         FEXCore::ilog2(sizeof(LookupCache::LookupCacheEntry) * LookupCache::L1_WAYS));
     add(TMP1, TMP1, TMP2);
 
-    ldp<ARMEmitter::IndexType::OFFSET>(TMP2, TMP1, TMP1, 0);
-
-    // Note: sub+cbnz used over cmp+br to preserve flags.
-    sub(TMP1, TMP1, RipReg.X());
-    (void)cbz(ARMEmitter::Size::i64Bit, TMP1, &SkipFullLookup);
+    // Check both ways of the set, way 0 holds the most recently used block.
+    // Note: sub+cbz used over cmp+br to preserve flags.
+    ARMEmitter::ForwardLabel L1Miss;
+    ldp<ARMEmitter::IndexType::OFFSET>(TMP2, TMP3, TMP1, 0);
+    sub(TMP3, TMP3, RipReg.X());
+    (void)cbz(ARMEmitter::Size::i64Bit, TMP3, &SkipFullLookup);
+
+    // Snapshot the L1 generation before reading way 1, see LookupCache::BeginL1Invalidation.
+    ldr(TMP4, STATE, offsetof(FEXCore::Core::CpuStateFrame, State.L1GenerationPointer));
+    ldar(TMP4, TMP4);
+    ldp<ARMEmitter::IndexType::OFFSET>(TMP2, TMP3, TMP1, sizeof(LookupCache::LookupCacheEntry));
+    sub(TMP3, TMP3, RipReg.X());
+    (void)cbnz(ARMEmitter::Size::i64Bit, TMP3, &L1Miss);
+
+    // Promote the way 1 hit by swapping the ways, same as LookupCache::FindBlock.
+    ldr(VTMP1.Q(), TMP1, 0);
+    str(VTMP1.Q(), TMP1, sizeof(LookupCache::LookupCacheEntry));
+    stp<ARMEmitter::IndexType::OFFSET>(TMP2, RipReg.X(), TMP1);
+
+    // If an invalidation ran concurrently the swapped entries may be stale, drop the set in that case.
+    // An invalidation in progress leaves the snapshot odd, so it never matches.
+    dmb(ARMEmitter::BarrierScope::ISH);
+    ldr(TMP3, STATE, offsetof(FEXCore::Core::CpuStateFrame, State.L1GenerationPointer));
+    ldr(TMP3, TMP3, 0);
+    and_(ARMEmitter::Size::i64Bit, TMP4, TMP4, ~1ULL);
+    sub(TMP3, TMP3, TMP4);
+    (void)cbz(ARMEmitter::Size::i64Bit, TMP3, &SkipFullLookup);
+    str(ARMEmitter::XReg::zr, TMP1, offsetof(LookupCache::LookupCacheEntry, GuestCode));
+    str(ARMEmitter::XReg::zr, TMP1, sizeof(LookupCache::LookupCacheEntry) + offsetof(LookupCache::LookupCacheEntry, GuestCode));
+    (void)b(&SkipFullLookup);
+
+    (void)Bind(&L1Miss);
     ldr(TMP2, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.DispatcherLoopTop));
     str(RipReg.X(), STATE, offsetof(FEXCore::Core::CpuStateFrame, State.rip));
 
@@ -322,7 +354,30 @@ DEF_OP(Thunk) {
   // X0: CTX
   // X1: Args (from guest stack)
 
-  SpillStaticRegs(TMP1); // spill to ctx before ra64 spill
+  // Leaf thunks are entered through a guest call and never call back in to the guest.
+  // Guest caller-saved GPRs and all vector registers are dead across the call,
+  // so only guest callee-saved GPRs that live in host caller-saved registers need to be preserved.
+  uint32_t GPRSpillMask = ~0U;
+  uint32_t FPRSpillMask = ~0U;
+  if (Op->Leaf) {
+    constexpr std::array<X86State::X86Reg, 7> CalleeSaved64 = {
+      X86State::REG_RBX, X86State::REG_RSP, X86State::REG_RBP, X86State::REG_R12, X86State::REG_R13, X86State::REG_R14, X86State::REG_R15,
+    };
+    constexpr std::array<X86State::X86Reg, 5> CalleeSaved32 = {
+      X86State::REG_RBX, X86State::REG_RSP, X86State::REG_RBP, X86State::REG_RSI, X86State::REG_RDI,
+    };
+    using RegSpan = std::span<const X86State::X86Reg>;
+    const auto CalleeSaved = CTX->Config.Is64BitMode() ? RegSpan {CalleeSaved64} : RegSpan {CalleeSaved32};
+
+    GPRSpillMask = 0;
+    for (auto Reg : CalleeSaved) {
+      GPRSpillMask |= 1U << StaticRegisters[Reg].Idx();
+    }
+    GPRSpillMask &= CALLER_GPR_MASK;
+    FPRSpillMask = 0;
+  }
+
+  SpillStaticRegs(TMP1, true, GPRSpillMask, FPRSpillMask); // spill to ctx before ra64 spill
 
   PushDynamicRegs(TMP1);
 
@@ -337,7 +392,7 @@ DEF_OP(Thunk) {
 
   PopDynamicRegs();
 
-  FillStaticRegs(); // load from ctx after ra64 refill
+  FillStaticRegs(true, GPRSpillMask, FPRSpillMask); // load from ctx after ra64 refill
 }
 
 DEF_OP(ValidateCode) {
@@ -388,6 +443,81 @@ DEF_OP(ValidateCode) {
   BindOrRestart(&End);
 }
 
+DEF_OP(ValidateCodeBlock) {
+  auto Op = IROp->C<IR::IROp_ValidateCodeBlock>();
+  auto Base = GetReg(Op->Address).X();
+  const auto Dst = GetReg(Node);
+  uint32_t len = Op->CodeLength;
+  ARMEmitter::ForwardLabel Fail;
+
+  // Compare against the copy of the code placed after the block instead of materializing every byte as a constant.
+  const auto DecodedCode = reinterpret_cast<const uint8_t*>(IR->GetData() + Op->CodeDataOffset);
+  auto& Validation = PendingCodeValidations.emplace_back(PendingCodeValidation {DecodedCode, len, {}});
+  (void)adr(TMP1, &Validation.Label);
+
+  if (len >= 16) {
+    mov(ARMEmitter::Size::i64Bit, TMP2, Base);
+
+    // 16 bytes at a time, the tail overlaps with the last full chunk.
+    const auto Tail = len % 16;
+    for (; len >= 16; len -= 16) {
+      ldr<ARMEmitter::IndexType::POST>(VTMP1.Q(), TMP2, 16);
+      ldr<ARMEmitter::IndexType::POST>(VTMP2.Q(), TMP1, 16);
+      eor(VTMP1.Q(), VTMP1.Q(), VTMP2.Q());
+      umaxp(ARMEmitter::SubRegSize::i32Bit, VTMP1.Q(), VTMP1.Q(), VTMP1.Q());
+      fmov(ARMEmitter::Size::i64Bit, TMP3, VTMP1.D());
+      cbnz_OrRestart(ARMEmitter::Size::i64Bit, TMP3, &Fail);
+    }
+
+    if (Tail) {
+      ldur(VTMP1.Q(), TMP2, static_cast<int32_t>(Tail) - 16);
+      ldur(VTMP2.Q(), TMP1, static_cast<int32_t>(Tail) - 16);
+      eor(VTMP1.Q(), VTMP1.Q(), VTMP2.Q());
+      umaxp(ARMEmitter::SubRegSize::i32Bit, VTMP1.Q(), VTMP1.Q(), VTMP1.Q());
+      fmov(ARMEmitter::Size::i64Bit, TMP3, VTMP1.D());
+      cbnz_OrRestart(ARMEmitter::Size::i64Bit, TMP3, &Fail);
+    }
+  } else {
+    int Offset = 0;
+    auto EmitCheck = [&](size_t Size, auto&& LoadData) {
+      while (len >= Size) {
+        LoadData();
+        sub(ARMEmitter::Size::i64Bit, TMP3, TMP3, TMP4);
+        cbnz_OrRestart(ARMEmitter::Size::i64Bit, TMP3, &Fail);
+        len -= Size;
+        Offset += Size;
+      }
+    };
+
+    EmitCheck(8, [&]() {
+      ldr(TMP3, Base, Offset);
+      ldr(TMP4, TMP1, Offset);
+    });
+
+    EmitCheck(4, [&]() {
+      ldr(TMP3.W(), Base, Offset);
+      ldr(TMP4.W(), TMP1, Offset);
+    });
+
+    EmitCheck(2, [&]() {
+      ldrh(TMP3.W(), Base, Offset);
+      ldrh(TMP4.W(), TMP1, Offset);
+    });
+
+    EmitCheck(1, [&]() {
+      ldrb(TMP3.W(), Base, Offset);
+      ldrb(TMP4.W(), TMP1, Offset);
+    });
+  }
+
+  ARMEmitter::ForwardLabel End;
+  LoadConstant(ARMEmitter::Size::i32Bit, Dst, 0);
+  b_OrRestart(&End);
+  BindOrRestart(&Fail);
+  LoadConstant(ARMEmitter::Size::i32Bit, Dst, 1);
+  BindOrRestart(&End);
+}
+
 DEF_OP(ThreadRemoveCodeEntry) {
   PushDynamicRegs(TMP4);
   SpillStaticRegs(TMP4);
@@ -844,6 +844,7 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry, uint64_t Size
   JumpTargets.clear();
   CallReturnTargets.clear();
   PendingJumpThunks.clear();
+  PendingCodeValidations.clear();
   JumpTargets.resize(IR->GetHeader()->BlockCount, {});
 
   CodeData.EntryPoints.clear();
@@ -999,6 +1000,14 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry, uint64_t Size
   BindOrRestart(&l_ExitLink);
   PlaceNamedSymbolLiteral(InsertNamedSymbolLiteral(RelocNamedSymbolLiteral::NamedSymbol::SYMBOL_LITERAL_EXITFUNCTION_LINKER));
 
+  for (auto& PendingValidation : PendingCodeValidations) {
+    // Guest code as the decoder read it.
+    Align(16);
+    BindOrRestart(&PendingValidation.Label);
+    memcpy(GetCursorAddress<uint8_t*>(), PendingValidation.DecodedCode, PendingValidation.Length);
+    CursorIncrement(PendingValidation.Length);
+  }
+
   // CodeSize not including the header or tail data.
   const uint64_t CodeOnlySize = GetCursorAddress<uint8_t*>() - CodeBegin;
 
@@ -1129,6 +1138,7 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry, uint64_t Size
     LogMan::Msg::IFmt("Guest Code instructions: {}", HeaderOp->NumHostInstructions);
     LogMan::Msg::IFmt("Host Code instructions: {}", CodeOnlySize >> 2);
     LogMan::Msg::IFmt("Blow-up Amt: {}x", double(CodeOnlySize >> 2) / double(HeaderOp->NumHostInstructions));
+    LogMan::Msg::IFmt("Elided TSO accesses: {}", HeaderOp->ElidedTSOAccesses);
   }
 
   if (Disassemble() & FEXCore::Config::Disassemble::BLOCKS) {
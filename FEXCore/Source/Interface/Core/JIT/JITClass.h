@@ -105,6 +105,14 @@ private:
   };
   fextl::vector<PendingJumpThunk> PendingJumpThunks;
 
+  // Guest code ranges checked by ValidateCodeBlock, a copy of their decoded bytes gets placed at the end of the block.
+  struct PendingCodeValidation {
+    const uint8_t* DecodedCode;
+    uint32_t Length;
+    ARMEmitter::ForwardLabel Label;
+  };
+  fextl::vector<PendingCodeValidation> PendingCodeValidations;
+
   Utils::PoolBufferWithTimedRetirement<uint8_t*, 5000, 500> TempAllocator;
 
   static uint64_t ExitFunctionLink(FEXCore::Core::CpuStateFrame* Frame, FEXCore::Context::ExitFunctionLinkData* Record);
@@ -323,6 +331,11 @@ private:
   ARMEmitter::Register ApplyMemOperand(IR::OpSize AccessSize, ARMEmitter::Register Base, ARMEmitter::Register Tmp,
                                        IR::OrderedNodeWrapper Offset, IR::MemOffsetType OffsetType, uint8_t OffsetScale);
 
+  // Helpers for the REP SCAS/CMPS implementations, which return the last compared elements zero extended.
+  void ExtractLane(size_t Size, ARMEmitter::Register Lo, ARMEmitter::Register Hi, ARMEmitter::Register Shift,
+                   ARMEmitter::Condition UpperHalf);
+  void ZeroExtendElement(size_t Size, ARMEmitter::Register Reg);
+
   // NOTE: Will use TMP1 as a way to encode immediates that happen to fall outside
   //       the limits of the scalar plus immediate variant of SVE load/stores.
   //
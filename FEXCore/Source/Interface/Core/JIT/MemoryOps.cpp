@@ -14,6 +14,7 @@ $end_info$
 #include "Interface/IR/RegisterAllocationData.h"
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/Utils/TypeDefines.h>
 
 namespace FEXCore::CPU {
 
@@ -1924,11 +1925,16 @@ DEF_OP(MemSet) {
     // Early exit if zero count.
     (void)cbz(ARMEmitter::Size::i64Bit, TMP1, &DoneInternal);
 
-    if (!IsAtomic) {
+    // x86 fast-string operations don't guarantee ordering between their own stores, so the wide path is used even with TSO enabled.
+    // In that case the wide stores are bracketed with barriers, keeping them ordered against the surrounding guest memory accesses.
+    ARMEmitter::ForwardLabel WideDone {};
+    {
       ARMEmitter::ForwardLabel AgainInternal256Exit {};
       ARMEmitter::BackwardLabel AgainInternal256 {};
       ARMEmitter::ForwardLabel AgainInternal128Exit {};
       ARMEmitter::BackwardLabel AgainInternal128 {};
+      ARMEmitter::ForwardLabel SkipWide {};
+      auto WideDoneLabel = IsAtomic ? &WideDone : &DoneInternal;
 
       if (Direction == -1) {
         sub(ARMEmitter::Size::i64Bit, TMP2, TMP2, 32 - Size);
@@ -1939,7 +1945,11 @@ DEF_OP(MemSet) {
       // Do this in two parts, to fallback to the byte by byte loop if size < 32, and to the
       // single copy loop if size < 64.
       sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 32 / Size);
-      (void)tbnz(TMP1, 63, &AgainInternal128Exit);
+      (void)tbnz(TMP1, 63, &SkipWide);
+
+      if (IsAtomic) {
+        dmb(ARMEmitter::BarrierScope::ISH);
+      }
 
       // Fill VTMP2 with the set pattern
       dup(SubRegSize, VTMP2.Q(), Value);
@@ -1955,7 +1965,7 @@ DEF_OP(MemSet) {
 
       (void)Bind(&AgainInternal256Exit);
       add(ARMEmitter::Size::i64Bit, TMP1, TMP1, 64 / Size);
-      (void)cbz(ARMEmitter::Size::i64Bit, TMP1, &DoneInternal);
+      (void)cbz(ARMEmitter::Size::i64Bit, TMP1, WideDoneLabel);
 
       sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 32 / Size);
       (void)tbnz(TMP1, 63, &AgainInternal128Exit);
@@ -1965,6 +1975,11 @@ DEF_OP(MemSet) {
       (void)tbz(TMP1, 63, &AgainInternal128);
 
       (void)Bind(&AgainInternal128Exit);
+      if (IsAtomic) {
+        dmb(ARMEmitter::BarrierScope::ISH);
+      }
+
+      (void)Bind(&SkipWide);
       add(ARMEmitter::Size::i64Bit, TMP1, TMP1, 32 / Size);
       (void)cbz(ARMEmitter::Size::i64Bit, TMP1, &DoneInternal);
 
@@ -1982,6 +1997,12 @@ DEF_OP(MemSet) {
     sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
     (void)cbnz(ARMEmitter::Size::i64Bit, TMP1, &AgainInternal);
 
+    if (IsAtomic) {
+      (void)b(&DoneInternal);
+      (void)Bind(&WideDone);
+      dmb(ARMEmitter::BarrierScope::ISH);
+    }
+
     (void)Bind(&DoneInternal);
 
     if (SizeDirection >= 0) {
@@ -2166,12 +2187,17 @@ DEF_OP(MemCpy) {
     // Early exit if zero count.
     (void)cbz(ARMEmitter::Size::i64Bit, TMP1, &DoneInternal);
 
-    if (!IsAtomic) {
+    // x86 fast-string operations don't guarantee ordering between their own loads and stores, so the wide path is used even with TSO
+    // enabled. In that case the wide copy is bracketed with barriers, keeping it ordered against the surrounding guest memory accesses.
+    ARMEmitter::ForwardLabel WideDone {};
+    {
       ARMEmitter::ForwardLabel AbsPos {};
       ARMEmitter::ForwardLabel AgainInternal256Exit {};
       ARMEmitter::ForwardLabel AgainInternal128Exit {};
       ARMEmitter::BackwardLabel AgainInternal128 {};
       ARMEmitter::BackwardLabel AgainInternal256 {};
+      ARMEmitter::ForwardLabel SkipWide {};
+      auto WideDoneLabel = IsAtomic ? &WideDone : &DoneInternal;
 
       sub(ARMEmitter::Size::i64Bit, TMP4, TMP2, TMP3);
       (void)tbz(TMP4, 63, &AbsPos);
@@ -2190,7 +2216,12 @@ DEF_OP(MemCpy) {
       // Do this in two parts, to fallback to the byte by byte loop if size < 32, and to the
       // single copy loop if size < 64.
       sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 32 / Size);
-      (void)tbnz(TMP1, 63, &AgainInternal128Exit);
+      (void)tbnz(TMP1, 63, &SkipWide);
+
+      if (IsAtomic) {
+        dmb(ARMEmitter::BarrierScope::ISH);
+      }
+
       sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 32 / Size);
       (void)tbnz(TMP1, 63, &AgainInternal256Exit);
 
@@ -2202,7 +2233,7 @@ DEF_OP(MemCpy) {
 
       (void)Bind(&AgainInternal256Exit);
       add(ARMEmitter::Size::i64Bit, TMP1, TMP1, 64 / Size);
-      (void)cbz(ARMEmitter::Size::i64Bit, TMP1, &DoneInternal);
+      (void)cbz(ARMEmitter::Size::i64Bit, TMP1, WideDoneLabel);
 
       sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 32 / Size);
       (void)tbnz(TMP1, 63, &AgainInternal128Exit);
@@ -2212,6 +2243,11 @@ DEF_OP(MemCpy) {
       (void)tbz(TMP1, 63, &AgainInternal128);
 
       (void)Bind(&AgainInternal128Exit);
+      if (IsAtomic) {
+        dmb(ARMEmitter::BarrierScope::ISH);
+      }
+
+      (void)Bind(&SkipWide);
       add(ARMEmitter::Size::i64Bit, TMP1, TMP1, 32 / Size);
       (void)cbz(ARMEmitter::Size::i64Bit, TMP1, &DoneInternal);
 
@@ -2230,6 +2266,12 @@ DEF_OP(MemCpy) {
     sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
     (void)cbnz(ARMEmitter::Size::i64Bit, TMP1, &AgainInternal);
 
+    if (IsAtomic) {
+      (void)b(&DoneInternal);
+      (void)Bind(&WideDone);
+      dmb(ARMEmitter::BarrierScope::ISH);
+    }
+
     (void)Bind(&DoneInternal);
 
     // Needs to use temporaries just in case of overwrite
@@ -2297,6 +2339,416 @@ DEF_OP(MemCpy) {
   }
 }
 
+// Moves the Size sized lane at bit offset Shift of the 16 bytes in Lo:Hi to Lo, zero extended.
+// UpperHalf needs to be set if the lane is in Hi, Shift is only used modulo 64.
+void Arm64JITCore::ExtractLane(size_t Size, ARMEmitter::Register Lo, ARMEmitter::Register Hi, ARMEmitter::Register Shift,
+                               ARMEmitter::Condition UpperHalf) {
+  csel(ARMEmitter::Size::i64Bit, Lo, Hi, Lo, UpperHalf);
+  lsrv(ARMEmitter::Size::i64Bit, Lo, Lo, Shift);
+  ZeroExtendElement(Size, Lo);
+}
+
+void Arm64JITCore::ZeroExtendElement(size_t Size, ARMEmitter::Register Reg) {
+  switch (Size) {
+  case 1: uxtb(ARMEmitter::Size::i32Bit, Reg, Reg); break;
+  case 2: uxth(ARMEmitter::Size::i32Bit, Reg, Reg); break;
+  case 4: mov(ARMEmitter::Size::i32Bit, Reg, Reg); break;
+  case 8: break;
+  default: LOGMAN_MSG_A_FMT("Unhandled {} size: {}", __func__, Size); break;
+  }
+}
+
+DEF_OP(MemScan) {
+  const auto Op = IROp->C<IR::IROp_MemScan>();
+
+  const auto Size = IR::OpSizeToSize(Op->Size);
+  const auto MemReg = GetReg(Op->Addr);
+  const auto Value = GetReg(Op->Value);
+  const auto Length = GetReg(Op->Length);
+  const auto Remaining = GetReg(Op->OutRemaining);
+  const auto EndAddress = GetReg(Op->OutEndAddress);
+  const auto Last = GetReg(Op->OutLast);
+
+  uint64_t DirectionConstant;
+  bool DirectionIsInline = IsInlineConstant(Op->Direction, &DirectionConstant);
+  ARMEmitter::Register DirectionReg = ARMEmitter::Reg::r0;
+  if (!DirectionIsInline) {
+    DirectionReg = GetReg(Op->Direction);
+  }
+
+  // TMP1 = Remaining count
+  // TMP2 = Address with the prefix appended
+  // TMP3 = Lane mask or low half of the chunk
+  // TMP4 = High half of the chunk
+  // Last = Last element that was compared, also used as a temporary by the vector loop
+  //
+  // Forward scans compare 16 bytes at a time while the whole chunk is inside of the page of its first element, and while more
+  // than one chunk is remaining. The guest would have faulted on that first element anyway, so reading past the element that
+  // ends the scan can't introduce a new fault. Everything else, including the very last element, is handled by the element
+  // sized loop.
+  //
+  // The compared element is returned instead of being loaded again, another thread could have changed it in the meantime.
+
+  ARMEmitter::ForwardLabel BackwardImpl {};
+  ARMEmitter::ForwardLabel Done {};
+
+  const auto SubRegSize = Size == 1 ? ARMEmitter::SubRegSize::i8Bit :
+                          Size == 2 ? ARMEmitter::SubRegSize::i16Bit :
+                          Size == 4 ? ARMEmitter::SubRegSize::i32Bit :
+                          Size == 8 ? ARMEmitter::SubRegSize::i64Bit :
+                                      ARMEmitter::SubRegSize::i8Bit;
+
+  mov(TMP1, Length.X());
+  if (Op->Prefix.IsInvalid()) {
+    mov(TMP2, MemReg.X());
+  } else {
+    const auto Prefix = GetReg(Op->Prefix);
+    add(TMP2, Prefix.X(), MemReg.X());
+  }
+
+  if (!DirectionIsInline) {
+    // Backward or forwards implementation depends on flag
+    (void)tbnz(DirectionReg, 1, &BackwardImpl);
+  }
+
+  auto LoadElement = [this, Size, Last](int32_t Offset) {
+    switch (Size) {
+    case 1: ldrb<ARMEmitter::IndexType::POST>(Last.W(), TMP2, Offset); break;
+    case 2: ldrh<ARMEmitter::IndexType::POST>(Last.W(), TMP2, Offset); break;
+    case 4: ldr<ARMEmitter::IndexType::POST>(Last.W(), TMP2, Offset); break;
+    case 8: ldr<ARMEmitter::IndexType::POST>(Last.X(), TMP2, Offset); break;
+    default: LOGMAN_MSG_A_FMT("Unhandled {} size: {}", __func__, Size); break;
+    }
+  };
+
+  auto CompareElement = [this, Size, Value, Last]() {
+    // The value may contain garbage in the upper bits.
+    switch (Size) {
+    case 1: cmp(ARMEmitter::Size::i32Bit, Last, Value, ARMEmitter::ExtendedType::UXTB); break;
+    case 2: cmp(ARMEmitter::Size::i32Bit, Last, Value, ARMEmitter::ExtendedType::UXTH); break;
+    case 4: cmp(ARMEmitter::Size::i32Bit, Last, Value); break;
+    case 8: cmp(ARMEmitter::Size::i64Bit, Last, Value); break;
+    default: LOGMAN_MSG_A_FMT("Unhandled {} size: {}", __func__, Size); break;
+    }
+  };
+
+  // REPE stops on the first mismatch, REPNE stops on the first match.
+  const auto StopCondition = Op->REPE ? ARMEmitter::Condition::CC_NE : ARMEmitter::Condition::CC_EQ;
+
+  auto EmitScan = [&](int32_t Direction) {
+    ARMEmitter::BackwardLabel VectorLoop {};
+    ARMEmitter::BiDirectionalLabel ScalarLoop {};
+    ARMEmitter::ForwardLabel Found {};
+    ARMEmitter::ForwardLabel DoneInternal {};
+
+    if (Direction == 1) {
+      // Fill VTMP2 with the element being scanned for
+      dup(SubRegSize, VTMP2.Q(), Value);
+
+      (void)Bind(&VectorLoop);
+      cmp(ARMEmitter::Size::i64Bit, TMP1, 16 / Size);
+      (void)b(ARMEmitter::Condition::CC_LS, &ScalarLoop);
+      and_(ARMEmitter::Size::i64Bit, TMP3, TMP2, FEXCore::Utils::FEX_PAGE_SIZE - 1);
+      cmp(ARMEmitter::Size::i64Bit, TMP3, FEXCore::Utils::FEX_PAGE_SIZE - 16);
+      (void)b(ARMEmitter::Condition::CC_HI, &ScalarLoop);
+
+      ldr(VTMP1.Q(), TMP2, 0);
+      if (Op->REPE) {
+        // Lanes that don't match are non-zero, keep the difference around to get the element back from it.
+        eor(VTMP1.Q(), VTMP1.Q(), VTMP2.Q());
+        fmov(ARMEmitter::Size::i64Bit, TMP3, VTMP1.D());
+        fmov(ARMEmitter::Size::i64Bit, TMP4, VTMP1, true);
+        orr(ARMEmitter::Size::i64Bit, Last, TMP3, TMP4);
+        (void)cbnz(ARMEmitter::Size::i64Bit, Last, &Found);
+      } else {
+        cmeq(SubRegSize, VTMP1.Q(), VTMP1.Q(), VTMP2.Q());
+        // Narrow the lane mask to four bits per byte so it fits in a GPR.
+        shrn(ARMEmitter::SubRegSize::i8Bit, VTMP1.D(), VTMP1.D(), 4);
+        fmov(ARMEmitter::Size::i64Bit, TMP3, VTMP1.D());
+        (void)cbnz(ARMEmitter::Size::i64Bit, TMP3, &Found);
+      }
+
+      add(ARMEmitter::Size::i64Bit, TMP2, TMP2, 16);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 16 / Size);
+      (void)b(&VectorLoop);
+
+      (void)Bind(&Found);
+      if (Op->REPE) {
+        // Bit offset of the first differing lane within its half, the element is the difference flipped back.
+        cmp(ARMEmitter::Size::i64Bit, TMP3, 0);
+        csel(ARMEmitter::Size::i64Bit, Last, TMP4, TMP3, ARMEmitter::Condition::CC_EQ);
+        rbit(ARMEmitter::Size::i64Bit, Last, Last);
+        clz(ARMEmitter::Size::i64Bit, Last, Last);
+        and_(ARMEmitter::Size::i64Bit, Last, Last, ~static_cast<uint64_t>(Size * 8 - 1));
+        ExtractLane(Size, TMP3, TMP4, Last, ARMEmitter::Condition::CC_EQ);
+        // Byte offset of the element within the chunk.
+        lsr(ARMEmitter::Size::i64Bit, Last, Last, 3);
+        cset(ARMEmitter::Size::i64Bit, TMP4, ARMEmitter::Condition::CC_EQ);
+        add(ARMEmitter::Size::i64Bit, TMP4, Last, TMP4, ARMEmitter::ShiftType::LSL, 3);
+        eor(ARMEmitter::Size::i64Bit, Last, TMP3, Value);
+        ZeroExtendElement(Size, Last);
+      } else {
+        // Byte offset of the element within the chunk. It matched, so it is the value.
+        rbit(ARMEmitter::Size::i64Bit, TMP4, TMP3);
+        clz(ARMEmitter::Size::i64Bit, TMP4, TMP4);
+        lsr(ARMEmitter::Size::i64Bit, TMP4, TMP4, 2);
+        mov(ARMEmitter::Size::i64Bit, Last, Value);
+        ZeroExtendElement(Size, Last);
+      }
+      // The element that ended the scan is consumed as well.
+      add(ARMEmitter::Size::i64Bit, TMP2, TMP2, TMP4);
+      add(ARMEmitter::Size::i64Bit, TMP2, TMP2, Size);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, TMP4, ARMEmitter::ShiftType::LSR, FEXCore::ilog2(Size));
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
+      (void)b(&DoneInternal);
+    }
+
+    (void)Bind(&ScalarLoop);
+    LoadElement(Size * Direction);
+    sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
+    CompareElement();
+    (void)b(StopCondition, &DoneInternal);
+
+    if (Direction == 1) {
+      // Go back to the vector loop in case this element crossed a page.
+      (void)cbnz(ARMEmitter::Size::i64Bit, TMP1, &VectorLoop);
+    } else {
+      (void)cbnz(ARMEmitter::Size::i64Bit, TMP1, &ScalarLoop);
+    }
+
+    (void)Bind(&DoneInternal);
+  };
+
+  if (DirectionIsInline) {
+    LOGMAN_THROW_A_FMT(DirectionConstant == 1 || DirectionConstant == -1, "unexpected direction");
+    EmitScan(DirectionConstant);
+  } else {
+    // Emit forward direction scan then backward direction scan.
+    for (int32_t Direction : {1, -1}) {
+      EmitScan(Direction);
+
+      if (Direction == 1) {
+        (void)b(&Done);
+        (void)Bind(&BackwardImpl);
+      }
+    }
+
+    (void)Bind(&Done);
+  }
+
+  if (CTX->IsAtomicTSOEnabled()) {
+    // The scan uses plain loads, order them against any later guest loads.
+    dmb(ARMEmitter::BarrierScope::ISHLD);
+  }
+
+  // Needs to use temporaries just in case of overwrite
+  if (Op->Prefix.IsInvalid()) {
+    mov(TMP3, TMP2);
+  } else {
+    sub(ARMEmitter::Size::i64Bit, TMP3, TMP2, GetReg(Op->Prefix));
+  }
+  mov(Remaining.X(), TMP1);
+  mov(EndAddress.X(), TMP3);
+}
+
+DEF_OP(MemCmp) {
+  const auto Op = IROp->C<IR::IROp_MemCmp>();
+
+  const auto Size = IR::OpSizeToSize(Op->Size);
+  const auto MemRegDest = GetReg(Op->Dest);
+  const auto MemRegSrc = GetReg(Op->Src);
+  const auto Length = GetReg(Op->Length);
+  const auto Remaining = GetReg(Op->OutRemaining);
+  const auto Dst0 = GetReg(Op->OutDstAddress);
+  const auto Dst1 = GetReg(Op->OutSrcAddress);
+  const auto DstLast = GetReg(Op->OutDstLast);
+  const auto SrcLast = GetReg(Op->OutSrcLast);
+
+  uint64_t DirectionConstant;
+  bool DirectionIsInline = IsInlineConstant(Op->Direction, &DirectionConstant);
+  ARMEmitter::Register DirectionReg = ARMEmitter::Reg::r0;
+  if (!DirectionIsInline) {
+    DirectionReg = GetReg(Op->Direction);
+  }
+
+  // TMP1 = Remaining count
+  // TMP2 = Dest
+  // TMP3 = Src
+  // TMP4 = Lane mask or low half of the chunk
+  // DstLast, SrcLast = Last element pair that was compared
+  //
+  // The inputs are only read up front, so the remaining count and address destinations are free to be used as temporaries.
+  //
+  // Forward compares work on 16 bytes at a time while the whole chunk is inside of the pages of both first elements, and
+  // while more than one chunk is remaining, see MemScan for why that can't introduce new faults.
+  // The compared elements are returned instead of being loaded again, another thread could have changed them in the meantime.
+
+  ARMEmitter::ForwardLabel BackwardImpl {};
+  ARMEmitter::ForwardLabel Done {};
+
+  const auto SubRegSize = Size == 1 ? ARMEmitter::SubRegSize::i8Bit :
+                          Size == 2 ? ARMEmitter::SubRegSize::i16Bit :
+                          Size == 4 ? ARMEmitter::SubRegSize::i32Bit :
+                          Size == 8 ? ARMEmitter::SubRegSize::i64Bit :
+                                      ARMEmitter::SubRegSize::i8Bit;
+
+  mov(TMP1, Length.X());
+  mov(TMP2, MemRegDest.X());
+  mov(TMP3, MemRegSrc.X());
+
+  if (!DirectionIsInline) {
+    // Backward or forwards implementation depends on flag
+    (void)tbnz(DirectionReg, 1, &BackwardImpl);
+  }
+
+  auto LoadElements = [this, Size, DstLast, SrcLast](int32_t Offset) {
+    switch (Size) {
+    case 1:
+      ldrb<ARMEmitter::IndexType::POST>(DstLast.W(), TMP2, Offset);
+      ldrb<ARMEmitter::IndexType::POST>(SrcLast.W(), TMP3, Offset);
+      break;
+    case 2:
+      ldrh<ARMEmitter::IndexType::POST>(DstLast.W(), TMP2, Offset);
+      ldrh<ARMEmitter::IndexType::POST>(SrcLast.W(), TMP3, Offset);
+      break;
+    case 4:
+      ldr<ARMEmitter::IndexType::POST>(DstLast.W(), TMP2, Offset);
+      ldr<ARMEmitter::IndexType::POST>(SrcLast.W(), TMP3, Offset);
+      break;
+    case 8:
+      ldr<ARMEmitter::IndexType::POST>(DstLast.X(), TMP2, Offset);
+      ldr<ARMEmitter::IndexType::POST>(SrcLast.X(), TMP3, Offset);
+      break;
+    default: LOGMAN_MSG_A_FMT("Unhandled {} size: {}", __func__, Size); break;
+    }
+  };
+
+  // REPE stops on the first mismatch, REPNE stops on the first match.
+  const auto StopCondition = Op->REPE ? ARMEmitter::Condition::CC_NE : ARMEmitter::Condition::CC_EQ;
+
+  auto EmitCompare = [&](int32_t Direction) {
+    ARMEmitter::BackwardLabel VectorLoop {};
+    ARMEmitter::BiDirectionalLabel ScalarLoop {};
+    ARMEmitter::ForwardLabel Found {};
+    ARMEmitter::ForwardLabel DoneInternal {};
+
+    if (Direction == 1) {
+      (void)Bind(&VectorLoop);
+      cmp(ARMEmitter::Size::i64Bit, TMP1, 16 / Size);
+      (void)b(ARMEmitter::Condition::CC_LS, &ScalarLoop);
+      and_(ARMEmitter::Size::i64Bit, TMP4, TMP2, FEXCore::Utils::FEX_PAGE_SIZE - 1);
+      cmp(ARMEmitter::Size::i64Bit, TMP4, FEXCore::Utils::FEX_PAGE_SIZE - 16);
+      (void)b(ARMEmitter::Condition::CC_HI, &ScalarLoop);
+      and_(ARMEmitter::Size::i64Bit, TMP4, TMP3, FEXCore::Utils::FEX_PAGE_SIZE - 1);
+      cmp(ARMEmitter::Size::i64Bit, TMP4, FEXCore::Utils::FEX_PAGE_SIZE - 16);
+      (void)b(ARMEmitter::Condition::CC_HI, &ScalarLoop);
+
+      // Src stays in VTMP2 to get the elements back from.
+      ldr(VTMP1.Q(), TMP2, 0);
+      ldr(VTMP2.Q(), TMP3, 0);
+      if (Op->REPE) {
+        // Lanes that don't match are non-zero, the Dest element is the difference flipped back.
+        eor(VTMP1.Q(), VTMP1.Q(), VTMP2.Q());
+        fmov(ARMEmitter::Size::i64Bit, TMP4, VTMP1.D());
+        fmov(ARMEmitter::Size::i64Bit, SrcLast, VTMP1, true);
+        orr(ARMEmitter::Size::i64Bit, DstLast, TMP4, SrcLast);
+        (void)cbnz(ARMEmitter::Size::i64Bit, DstLast, &Found);
+      } else {
+        cmeq(SubRegSize, VTMP1.Q(), VTMP1.Q(), VTMP2.Q());
+        // Narrow the lane mask to four bits per byte so it fits in a GPR.
+        shrn(ARMEmitter::SubRegSize::i8Bit, VTMP1.D(), VTMP1.D(), 4);
+        fmov(ARMEmitter::Size::i64Bit, TMP4, VTMP1.D());
+        (void)cbnz(ARMEmitter::Size::i64Bit, TMP4, &Found);
+      }
+
+      add(ARMEmitter::Size::i64Bit, TMP2, TMP2, 16);
+      add(ARMEmitter::Size::i64Bit, TMP3, TMP3, 16);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 16 / Size);
+      (void)b(&VectorLoop);
+
+      (void)Bind(&Found);
+      if (Op->REPE) {
+        // Bit offset of the first differing lane within its half.
+        cmp(ARMEmitter::Size::i64Bit, TMP4, 0);
+        csel(ARMEmitter::Size::i64Bit, DstLast, SrcLast, TMP4, ARMEmitter::Condition::CC_EQ);
+        rbit(ARMEmitter::Size::i64Bit, DstLast, DstLast);
+        clz(ARMEmitter::Size::i64Bit, DstLast, DstLast);
+        and_(ARMEmitter::Size::i64Bit, DstLast, DstLast, ~static_cast<uint64_t>(Size * 8 - 1));
+        ExtractLane(Size, TMP4, SrcLast, DstLast, ARMEmitter::Condition::CC_EQ);
+        fmov(ARMEmitter::Size::i64Bit, SrcLast, VTMP2.D());
+        fmov(ARMEmitter::Size::i64Bit, Remaining, VTMP2, true);
+        ExtractLane(Size, SrcLast, Remaining, DstLast, ARMEmitter::Condition::CC_EQ);
+        // Byte offset of the element pair within the chunk.
+        lsr(ARMEmitter::Size::i64Bit, DstLast, DstLast, 3);
+        cset(ARMEmitter::Size::i64Bit, Remaining, ARMEmitter::Condition::CC_EQ);
+        add(ARMEmitter::Size::i64Bit, Remaining, DstLast, Remaining, ARMEmitter::ShiftType::LSL, 3);
+        eor(ARMEmitter::Size::i64Bit, DstLast, TMP4, SrcLast);
+        mov(ARMEmitter::Size::i64Bit, TMP4, Remaining);
+      } else {
+        // Byte offset of the element pair within the chunk. It matched, so both elements are the same.
+        rbit(ARMEmitter::Size::i64Bit, TMP4, TMP4);
+        clz(ARMEmitter::Size::i64Bit, TMP4, TMP4);
+        lsr(ARMEmitter::Size::i64Bit, TMP4, TMP4, 2);
+        fmov(ARMEmitter::Size::i64Bit, SrcLast, VTMP2.D());
+        fmov(ARMEmitter::Size::i64Bit, DstLast, VTMP2, true);
+        cmp(ARMEmitter::Size::i64Bit, TMP4, 8);
+        lsl(ARMEmitter::Size::i64Bit, Remaining, TMP4, 3);
+        ExtractLane(Size, SrcLast, DstLast, Remaining, ARMEmitter::Condition::CC_HS);
+        mov(ARMEmitter::Size::i64Bit, DstLast, SrcLast);
+      }
+      // The element pair that ended the compare is consumed as well.
+      add(ARMEmitter::Size::i64Bit, TMP2, TMP2, TMP4);
+      add(ARMEmitter::Size::i64Bit, TMP2, TMP2, Size);
+      add(ARMEmitter::Size::i64Bit, TMP3, TMP3, TMP4);
+      add(ARMEmitter::Size::i64Bit, TMP3, TMP3, Size);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, TMP4, ARMEmitter::ShiftType::LSR, FEXCore::ilog2(Size));
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
+      (void)b(&DoneInternal);
+    }
+
+    (void)Bind(&ScalarLoop);
+    LoadElements(Size * Direction);
+    sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
+    cmp(Size == 8 ? ARMEmitter::Size::i64Bit : ARMEmitter::Size::i32Bit, SrcLast, DstLast);
+    (void)b(StopCondition, &DoneInternal);
+
+    if (Direction == 1) {
+      // Go back to the vector loop in case this element pair crossed a page.
+      (void)cbnz(ARMEmitter::Size::i64Bit, TMP1, &VectorLoop);
+    } else {
+      (void)cbnz(ARMEmitter::Size::i64Bit, TMP1, &ScalarLoop);
+    }
+
+    (void)Bind(&DoneInternal);
+  };
+
+  if (DirectionIsInline) {
+    LOGMAN_THROW_A_FMT(DirectionConstant == 1 || DirectionConstant == -1, "unexpected direction");
+    EmitCompare(DirectionConstant);
+  } else {
+    // Emit forward direction compare then backward direction compare.
+    for (int32_t Direction : {1, -1}) {
+      EmitCompare(Direction);
+
+      if (Direction == 1) {
+        (void)b(&Done);
+        (void)Bind(&BackwardImpl);
+      }
+    }
+
+    (void)Bind(&Done);
+  }
+
+  if (CTX->IsAtomicTSOEnabled()) {
+    // The compare uses plain loads, order them against any later guest loads.
+    dmb(ARMEmitter::BarrierScope::ISHLD);
+  }
+
+  mov(Remaining.X(), TMP1);
+  mov(Dst0.X(), TMP2);
+  mov(Dst1.X(), TMP3);
+}
+
 DEF_OP(CacheLineClear) {
   if (!CTX->HostFeatures.SupportsCacheMaintenanceOps) {
     dmb(ARMEmitter::BarrierScope::SY);
@@ -278,6 +278,41 @@ DEF_OP(ProcessorID) {
 #endif
 }
 
+DEF_OP(SpinWait) {
+  auto Op = IROp->C<IR::IROp_SpinWait>();
+  const auto Addr = GetReg(Op->Addr);
+  const auto Expected = GetReg(Op->Expected);
+  const auto EmitSize = Op->Size == IR::OpSize::i64Bit ? ARMEmitter::Size::i64Bit : ARMEmitter::Size::i32Bit;
+
+  // Nothing in here is allowed to modify NZCV, the CondJump following this reads it.
+  ARMEmitter::ForwardLabel Skip;
+  (void)b(InvertCondition(MapCC(Op->Cond)), &Skip);
+
+  if (Op->Size != IR::OpSize::i8Bit) {
+    // Exclusive loads fault on unaligned addresses, spin instead.
+    and_(ARMEmitter::Size::i64Bit, TMP1, Addr, IR::OpSizeToSize(Op->Size) - 1);
+    (void)cbnz(ARMEmitter::Size::i64Bit, TMP1, &Skip);
+  }
+
+  // Prime the exclusive monitor, a write to the memory will wake up WFE.
+  // If the memory already changed since the guest loaded it then don't wait at all.
+  ldaxr(ConvertSubRegSize8(Op->Size), TMP1, Addr);
+  eor(EmitSize, TMP1, TMP1, Expected);
+  (void)cbnz(EmitSize, TMP1, &Skip);
+
+  if (CTX->HostFeatures.SupportsWFXT) {
+    // Bound the wait so the guest still gets to run its loop regularly.
+    constexpr uint32_t SpinWaitTimeoutCycles = 256;
+    mrs(TMP1, ARMEmitter::SystemRegister::CNTVCT_EL0);
+    add(ARMEmitter::Size::i64Bit, TMP1, TMP1, SpinWaitTimeoutCycles);
+    wfet(TMP1);
+  } else {
+    wfe();
+  }
+
+  (void)Bind(&Skip);
+}
+
 DEF_OP(RDRAND) {
   auto Op = IROp->C<IR::IROp_RDRAND>();
 
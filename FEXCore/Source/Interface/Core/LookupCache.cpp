@@ -60,10 +60,10 @@ LookupCache::LookupCache(FEXCore::Context::ContextImpl* CTX)
 
   if (DynamicL1Cache()) {
     // Start at minimum size when dynamic.
-    L1PointerMask = MIN_L1_ENTRIES - 1;
+    L1PointerMask = MIN_L1_ENTRIES / L1_WAYS - 1;
   } else {
     // Start at maximum instead.
-    L1PointerMask = MAX_L1_ENTRIES - 1;
+    L1PointerMask = MAX_L1_ENTRIES / L1_WAYS - 1;
   }
 }
 
@@ -83,10 +83,13 @@ void LookupCache::ClearL2Cache(const FEXCore::LookupCacheBaseLockToken& lk) {
   AllocateOffset = 0;
 }
 
-void LookupCache::ClearThreadLocalCaches(const LookupCacheWriteLockToken&) {
+void LookupCache::ClearThreadLocalCaches(const LookupCacheBaseLockToken&) {
   // Clear L1 and L2 by clearing the full cache.
+  BeginL1Invalidation();
   FEXCore::Allocator::VirtualDontNeed(reinterpret_cast<void*>(PagePointer), TotalCacheSize, false);
+  EndL1Invalidation();
   CachedCodePages.clear();
+  AllocateOffset = 0;
 }
 
 void LookupCache::ClearCache(const LookupCacheWriteLockToken& lk) {
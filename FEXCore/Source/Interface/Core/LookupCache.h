@@ -12,6 +12,7 @@
 #include <FEXCore/fextl/vector.h>
 #include <FEXCore/fextl/memory_resource.h>
 
+#include <atomic>
 #include <cstdint>
 #include <stddef.h>
 #include <utility>
@@ -163,6 +164,16 @@ public:
     uintptr_t GuestCode;
   };
 
+  // The L1 cache is 2-way set-associative, way 0 holds the most recently used entry of a set.
+  // Hits in way 1 get promoted by swapping the ways, entries filled from L2/L3 demote way 0 to way 1.
+  // The set is picked by folding the page number in to the low address bits, so blocks at the same page offset don't alias.
+  constexpr static size_t L1_WAYS = 2;
+  constexpr static size_t L1_HASH_SHIFT = 12;
+
+  static uint64_t L1Hash(uint64_t Address) {
+    return Address ^ (Address >> L1_HASH_SHIFT);
+  }
+
   LookupCache(FEXCore::Context::ContextImpl* CTX);
   ~LookupCache();
 
@@ -175,9 +186,9 @@ public:
 
   uintptr_t FindBlock(FEXCore::Core::InternalThreadState* Thread, uint64_t Address) {
     // Try L1, no lock needed
-    auto& L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1PointerMask];
-    if (L1Entry.GuestCode == Address) {
-      return L1Entry.HostCode;
+    auto L1Set = GetL1Set(Address);
+    if (L1Set[0].GuestCode == Address) {
+      return L1Set[0].HostCode;
     }
 
     // L2 and L3 need to be locked
@@ -188,6 +199,12 @@ public:
       auto lk = Shared->AcquireReadLock();
       LockTime.reset();
 
+      // Promoting a way 1 hit moves entries around, which can't race with cross-thread invalidation.
+      if (L1Set[1].GuestCode == Address) {
+        std::swap(L1Set[0], L1Set[1]);
+        return L1Set[0].HostCode;
+      }
+
       if (!DisableL2Cache()) {
         // Try L2
         const auto PageIndex = (Address & (VirtualMemSize - 1)) >> 12;
@@ -202,9 +219,8 @@ public:
           auto BlockPointers = reinterpret_cast<LookupCacheEntry*>(LocalPagePointer);
 
           if (BlockPointers[PageOffset].GuestCode == Address) {
-            L1Entry.GuestCode = Address;
-            L1Entry.HostCode = BlockPointers[PageOffset].HostCode;
-            HostPtr = L1Entry.HostCode;
+            HostPtr = BlockPointers[PageOffset].HostCode;
+            InsertL1Entry(L1Set, Address, HostPtr);
           }
         }
       }
@@ -224,6 +240,7 @@ public:
     }
 
     FEXCORE_PROFILE_INSTANT_INCREMENT(Thread, AccumulatedCacheMissCount, 1);
+    UpdateMemoryStats(Thread);
 
     return HostPtr;
   }
@@ -243,7 +260,7 @@ public:
       if (AveragePerSecond >= DynamicL1CacheIncreaseCountHeuristic()) {
         if (CurrentL1Entries < MAX_L1_ENTRIES) {
           CurrentL1Entries <<= 1;
-          L1PointerMask = CurrentL1Entries - 1;
+          L1PointerMask = CurrentL1Entries / L1_WAYS - 1;
 
           // Update the thread's L1 pointer mask to increase how much cache it uses.
           // Since we're in C-code, this is safe to update here.
@@ -252,7 +269,7 @@ public:
       } else if (AveragePerSecond < DynamicL1CacheDecreaseCountHeuristic()) {
         if (CurrentL1Entries > MIN_L1_ENTRIES) {
           CurrentL1Entries >>= 1;
-          L1PointerMask = CurrentL1Entries - 1;
+          L1PointerMask = CurrentL1Entries / L1_WAYS - 1;
 
           // Madvise the entries that we are dropping. Gives the memory back to the OS.
           LookupCacheEntry* FirstZeroL1Entry = &reinterpret_cast<LookupCacheEntry*>(L1Pointer)[CurrentL1Entries];
@@ -296,17 +313,20 @@ public:
     // There is no need to update L1 or L2, they will get updated on first lookup
     // However, adding to L1 here increases performance
     CacheBlockMapping(Address, Entry, true, lk);
+    UpdateMemoryStats(Thread);
   }
 
   // Invalidates L1/L2 for a given guest block
   void InvalidateCache(uint64_t Address, const LookupCacheWriteLockToken& lk) {
     // Do L1
-    auto& L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1PointerMask];
-    if (L1Entry.GuestCode == Address) {
-      L1Entry.GuestCode = 0;
-      // Leave L1Entry.HostCode as is, so that concurrent lookups won't read a null pointer
-      // This is a soft guarantee for cross thread invalidation, as atomics are not used
-      // and it hasn't been thoroughly tested
+    auto L1Set = GetL1Set(Address);
+    for (size_t Way = 0; Way < L1_WAYS; ++Way) {
+      if (L1Set[Way].GuestCode == Address) {
+        L1Set[Way].GuestCode = 0;
+        // Leave HostCode as is, so that concurrent lookups won't read a null pointer
+        // This is a soft guarantee for cross thread invalidation, as atomics are not used
+        // and it hasn't been thoroughly tested
+      }
     }
 
     if (!DisableL2Cache()) {
@@ -336,11 +356,13 @@ public:
     auto lower = CachedCodePages.lower_bound(Start >> 12);
     auto upper = CachedCodePages.upper_bound((Start + Length - 1) >> 12);
 
+    BeginL1Invalidation();
     for (auto it = lower; it != upper; it++) {
       for (const auto& Entry : it->second) {
         InvalidateCache(Entry, lk);
       }
     }
+    EndL1Invalidation();
     bool ret = upper != lower;
     CachedCodePages.erase(lower, upper);
     return ret;
@@ -353,17 +375,32 @@ public:
 
   void ClearCache(const LookupCacheWriteLockToken&);
   void ClearL2Cache(const LookupCacheBaseLockToken&);
-  void ClearThreadLocalCaches(const LookupCacheWriteLockToken&);
+  void ClearThreadLocalCaches(const LookupCacheBaseLockToken&);
+
+  // Drops L1 and L2 so their memory goes back to the OS.
+  // Only other threads' invalidations touch this thread's L1 and L2, those hold the write lock. So the read lock is enough
+  // and lookups of other threads aren't blocked.
+  void TrimThreadLocalCaches(FEXCore::Core::InternalThreadState* Thread) {
+    std::optional<FEXCore::SHMStats::AccumulationBlock<uint64_t>> LockTime(
+      Thread->ThreadStats ? &Thread->ThreadStats->AccumulatedCacheReadLockTime : nullptr);
+    auto lk = Shared->AcquireReadLock();
+    LockTime.reset();
+
+    ClearThreadLocalCaches(lk);
+  }
 
   uintptr_t GetL1Pointer() const {
     return L1Pointer;
   }
   uintptr_t GetScaledL1PointerMask() const {
-    return L1PointerMask << FEXCore::ilog2(sizeof(LookupCache::LookupCacheEntry));
+    return L1PointerMask << FEXCore::ilog2(sizeof(LookupCache::LookupCacheEntry) * L1_WAYS);
   }
   uintptr_t GetPagePointer() const {
     return PagePointer;
   }
+  uintptr_t GetL1GenerationPointer() const {
+    return reinterpret_cast<uintptr_t>(&L1Generation);
+  }
   uintptr_t GetVirtualMemorySize() const {
     return VirtualMemSize;
   }
@@ -380,15 +417,44 @@ public:
   }
 
 private:
+  LookupCacheEntry* GetL1Set(uint64_t Address) const {
+    return &reinterpret_cast<LookupCacheEntry*>(L1Pointer)[(L1Hash(Address) & L1PointerMask) * L1_WAYS];
+  }
+
+  // Brackets writes to L1 and L2 that can happen while the owning thread is running.
+  // The JIT and dispatcher move L1 entries between ways without taking the lock, they compare L1Generation from before
+  // reading the set with the value after writing it and drop the set on a mismatch. The fence pairs with the barrier
+  // emitted after those writes, so either the invalidation sees the moved entry or the owning thread sees the change.
+  void BeginL1Invalidation() {
+    L1Generation.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+  void EndL1Invalidation() {
+    L1Generation.fetch_add(1, std::memory_order_release);
+  }
+
+  // Inserts as the most recently used entry of the set, evicting the least recently used one.
+  // Matches the L1 update in the dispatcher.
+  static void InsertL1Entry(LookupCacheEntry* L1Set, uint64_t Address, uintptr_t HostCode) {
+    if (L1Set[0].GuestCode != Address) {
+      L1Set[1] = L1Set[0];
+    }
+    L1Set[0].GuestCode = Address;
+    L1Set[0].HostCode = HostCode;
+  }
+
   void CacheBlockMapping(uint64_t Address, const GuestToHostMap::BlockEntry& Entry, bool L1Only, const LookupCacheBaseLockToken& lk) {
     for (const auto& CodePage : Entry.CodePages) {
       CachedCodePages[CodePage >> 12].insert(Address);
     }
 
     // Do L1
-    auto& L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1PointerMask];
-    L1Entry.GuestCode = Address;
-    L1Entry.HostCode = Entry.HostCode;
+    auto L1Set = GetL1Set(Address);
+    if (L1Set[1].GuestCode == Address) {
+      // Don't leave a stale copy of the mapping behind in the other way
+      L1Set[1].GuestCode = 0;
+    }
+    InsertL1Entry(L1Set, Address, Entry.HostCode);
 
     if (!DisableL2Cache() && !L1Only) {
       // Do ful map
@@ -423,6 +489,17 @@ private:
     }
   }
 
+  // Only L1 and L2 belong to this thread, L3 is shared with every thread using the same code buffer.
+  // Both are reserved up front and lazily backed, readers of the stats query how much of them is resident.
+  void UpdateMemoryStats(FEXCore::Core::InternalThreadState* Thread) const {
+    if (Thread->ThreadStats) {
+      Thread->ThreadStats->L1CacheBase = L1Pointer;
+      Thread->ThreadStats->L1CacheSize = MAX_L1_SIZE;
+      Thread->ThreadStats->L2CacheBase = PagePointer;
+      Thread->ThreadStats->L2CacheSize = TotalCacheSize - MAX_L1_SIZE;
+    }
+  }
+
   uintptr_t AllocateBackingForPage() {
     uintptr_t NewBase = AllocateOffset;
     uintptr_t NewEnd = AllocateOffset + SIZE_PER_PAGE;
@@ -444,6 +521,8 @@ private:
   uintptr_t PageMemory;
   uintptr_t L1Pointer;
   uintptr_t L1PointerMask;
+  // Odd while an invalidation is in progress, see BeginL1Invalidation.
+  std::atomic<uint64_t> L1Generation {};
 
   size_t TotalCacheSize;
 
@@ -451,6 +530,7 @@ private:
   // Max out at 1 million entries to give each thread 16MB of L1 cache maximum.
   constexpr static size_t MIN_L1_ENTRIES = 8 * 1024;        // Must be a power of 2
   constexpr static size_t MAX_L1_ENTRIES = 1 * 1024 * 1024; // Must be a power of 2
+  static_assert(L1_WAYS == 2, "Dispatcher and JIT lookups assume two ways");
 
   constexpr static size_t CODE_SIZE = 128 * 1024 * 1024;
   constexpr static size_t SIZE_PER_PAGE = FEXCore::Utils::FEX_PAGE_SIZE * sizeof(LookupCacheEntry);
@@ -17,6 +17,7 @@ $end_info$
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Core/Context.h>
 #include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Core/Thunks.h>
 #include <FEXCore/Core/X86Enums.h>
 #include <FEXCore/HLE/SyscallHandler.h>
 #include <FEXCore/IR/IR.h>
@@ -110,14 +111,18 @@ void OpDispatchBuilder::SyscallOp(OpcodeArgs, bool IsSyscallInst) {
 
 void OpDispatchBuilder::ThunkOp(OpcodeArgs) {
   const auto GPRSize = GetGPROpSize();
-  uint8_t* sha256 = (uint8_t*)(Op->PC + 2);
+  const auto& Sum = *reinterpret_cast<SHA256Sum*>(Op->PC + 2);
+
+  // Leaf thunks are called from a guest function and never call back in to the guest.
+  // Guest caller-saved registers are dead at that point, so the JIT only needs to preserve the callee-saved ones.
+  const bool Leaf = CTX->ThunkHandler && CTX->ThunkHandler->IsLeafThunk(Sum);
 
   if (Is64BitMode) {
     // x86-64 ABI puts the function argument in RDI
-    Thunk(LoadGPRRegister(X86State::REG_RDI), *reinterpret_cast<SHA256Sum*>(sha256));
+    Thunk(LoadGPRRegister(X86State::REG_RDI), Sum, Leaf);
   } else {
     // x86 fastcall ABI puts the function argument in ECX
-    Thunk(LoadGPRRegister(X86State::REG_RCX), *reinterpret_cast<SHA256Sum*>(sha256));
+    Thunk(LoadGPRRegister(X86State::REG_RCX), Sum, Leaf);
   }
 
   auto NewRIP = Pop(GPRSize);
@@ -709,6 +714,10 @@ void OpDispatchBuilder::CondJUMPOp(OpcodeArgs) {
     auto OP = Op->OP & 0xF;
     auto Cond = DecodeNZCVCondition(OP);
     if (Cond) {
+      if (SpinLoop.Value && SpinLoop.CodeBlock == GetCurrentBlock() && Target == SpinLoop.Entry && TrueBlock != JumpTargets.end()) {
+        // Back edge of a spin-loop, wait for the loaded memory to change before running the next iteration.
+        _SpinWait(SpinLoop.Size, SpinLoop.Addr, SpinLoop.Value, *Cond);
+      }
       CondJump_ = CondJumpNZCV(*Cond);
     } else {
       LOGMAN_THROW_A_FMT(OP == 0xA || OP == 0xB, "only PF left");
@@ -3348,6 +3357,66 @@ void OpDispatchBuilder::CMPSOp(OpcodeArgs) {
     } else {
       StoreGPRRegister(X86State::REG_RSI, Dest_RSI, AddrSize);
     }
+  } else if (AddrSize == OpSize::i64Bit) {
+    // Calculate flags early.
+    CalculateDeferredFlags();
+
+    bool REPE = Op->Flags & FEXCore::X86Tables::DecodeFlags::FLAG_REP_PREFIX;
+
+    // If rcx = 0, skip the whole compare, flags are left untouched.
+    Ref Counter = LoadGPRRegister(X86State::REG_RCX);
+    auto OuterJump = CondJump(Counter, CondClass::EQ);
+
+    auto CompareBlock = CreateNewCodeBlockAfter(GetCurrentBlock());
+    SetFalseJumpTarget(OuterJump, CompareBlock);
+    SetCurrentCodeBlock(CompareBlock);
+    StartNewBlock();
+
+    {
+      auto SrcAddr = LoadGPRRegister(X86State::REG_RSI);
+      auto DstAddr = LoadGPRRegister(X86State::REG_RDI);
+      auto TailCounter = LoadGPRRegister(X86State::REG_RCX);
+
+      auto DstSegment = GetSegment(0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
+      auto SrcSegment = GetSegment(Op->Flags, FEXCore::X86Tables::DecodeFlags::FLAG_DS_PREFIX);
+
+      if (DstSegment) {
+        DstAddr = Add(OpSize::i64Bit, DstAddr, DstSegment);
+      }
+
+      if (SrcSegment) {
+        SrcAddr = Add(OpSize::i64Bit, SrcAddr, SrcSegment);
+      }
+
+      Ref Result_Counter = _AllocateGPR(false);
+      Ref Result_Dst = _AllocateGPR(false);
+      Ref Result_Src = _AllocateGPR(false);
+      Ref Src1 = _AllocateGPR(false);
+      Ref Src2 = _AllocateGPR(false);
+      _MemCmp(Size, REPE, DstAddr, SrcAddr, TailCounter, LoadDir(1), Result_Counter, Result_Dst, Result_Src, Src1, Src2);
+
+      // The compare doesn't generate flags, calculate them from the last element pair that it consumed.
+      CalculateFlags_SUB(Size, Src2, Src1);
+
+      if (DstSegment) {
+        Result_Dst = Sub(OpSize::i64Bit, Result_Dst, DstSegment);
+      }
+
+      if (SrcSegment) {
+        Result_Src = Sub(OpSize::i64Bit, Result_Src, SrcSegment);
+      }
+
+      StoreGPRRegister(X86State::REG_RCX, Result_Counter);
+      StoreGPRRegister(X86State::REG_RDI, Result_Dst);
+      StoreGPRRegister(X86State::REG_RSI, Result_Src);
+    }
+    auto Jump_ = Jump();
+
+    auto Exit = CreateNewCodeBlockAfter(GetCurrentBlock());
+    SetJumpTarget(Jump_, Exit);
+    SetTrueJumpTarget(OuterJump, Exit);
+    SetCurrentCodeBlock(Exit);
+    StartNewBlock();
   } else {
     // Calculate flags early.
     CalculateDeferredFlags();
@@ -3557,6 +3626,48 @@ void OpDispatchBuilder::SCASOp(OpcodeArgs) {
     } else {
       StoreGPRRegister(X86State::REG_RDI, TailDest_RDI, AddrSize);
     }
+  } else if (AddrSize == OpSize::i64Bit) {
+    // Calculate flags early. because end of block
+    CalculateDeferredFlags();
+
+    bool REPE = Op->Flags & FEXCore::X86Tables::DecodeFlags::FLAG_REP_PREFIX;
+
+    // If rcx = 0, skip the whole scan, flags are left untouched.
+    Ref Counter = LoadGPRRegister(X86State::REG_RCX);
+    auto OuterJump = CondJump(Counter, CondClass::EQ);
+
+    auto ScanBlock = CreateNewCodeBlockAfter(GetCurrentBlock());
+    SetFalseJumpTarget(OuterJump, ScanBlock);
+    SetCurrentCodeBlock(ScanBlock);
+    StartNewBlock();
+
+    {
+      Ref Dest = LoadGPRRegister(X86State::REG_RDI);
+      Ref TailCounter = LoadGPRRegister(X86State::REG_RCX);
+
+      // Only ES prefix
+      auto Segment = GetSegment(0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
+
+      auto Src1 = LoadSourceGPR(Op, Op->Src[0], Op->Flags, {.AllowUpperGarbage = true});
+
+      Ref Result_Counter = _AllocateGPR(false);
+      Ref Result_Dst = _AllocateGPR(false);
+      Ref Src2 = _AllocateGPR(false);
+      _MemScan(Size, REPE, Segment ?: InvalidNode, Dest, Src1, TailCounter, LoadDir(1), Result_Counter, Result_Dst, Src2);
+
+      // The scan doesn't generate flags, calculate them from the last element that it consumed.
+      CalculateFlags_SUB(Size, Src1, Src2);
+
+      StoreGPRRegister(X86State::REG_RCX, Result_Counter);
+      StoreGPRRegister(X86State::REG_RDI, Result_Dst);
+    }
+    auto Jump_ = Jump();
+
+    auto Exit = CreateNewCodeBlockAfter(GetCurrentBlock());
+    SetJumpTarget(Jump_, Exit);
+    SetTrueJumpTarget(OuterJump, Exit);
+    SetCurrentCodeBlock(Exit);
+    StartNewBlock();
   } else {
     // Calculate flags early. because end of block
     CalculateDeferredFlags();
@@ -4322,6 +4433,15 @@ Ref OpDispatchBuilder::LoadSource_WithOpSize(RegClass Class, const X86Tables::De
       }
     }
 
+    if (SpinLoop.Active && Class == RegClass::GPR && OpSize <= OpSize::i64Bit) {
+      // Record the watched memory word of a spin-loop. The wait needs a flat address.
+      SpinLoop.CodeBlock = GetCurrentBlock();
+      SpinLoop.Addr = LoadEffectiveAddress(this, A, GetGPROpSize(), true);
+      SpinLoop.Value = _LoadMemAutoTSO(Class, OpSize, SpinLoop.Addr, Align == OpSize::iInvalid ? OpSize : Align);
+      SpinLoop.Size = OpSize;
+      return SpinLoop.Value;
+    }
+
     return _LoadMemAutoTSO(Class, OpSize, A, Align == OpSize::iInvalid ? OpSize : Align);
   } else {
     return LoadEffectiveAddress(this, A, GetGPROpSize(), false, AllowUpperGarbage);
@@ -4465,8 +4585,6 @@ void OpDispatchBuilder::StoreResult(RegClass Class, X86Tables::DecodedOp Op, Ref
 OpDispatchBuilder::OpDispatchBuilder(FEXCore::Context::ContextImpl* ctx)
   : IREmitter {ctx->OpDispatcherAllocator, ctx->HostFeatures.SupportsTSOImm9}
   , CTX {ctx} {
-  ResetWorkingList();
-
   if (CTX->HostFeatures.SupportsAVX && CTX->HostFeatures.SupportsSVE256) {
     SaveAVXStateFunc = &OpDispatchBuilder::SaveAVXState;
     RestoreAVXStateFunc = &OpDispatchBuilder::RestoreAVXState;
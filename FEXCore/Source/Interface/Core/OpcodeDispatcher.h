@@ -129,6 +129,14 @@ public:
 
     // Need to clear any named constants that were cached.
     ClearCachedNamedConstants();
+
+    SpinLoop = {};
+  }
+
+  // The guest block that is about to be translated was recognized as a spin-loop by the frontend.
+  void StartSpinLoop(uint64_t BlockEntry) {
+    SpinLoop.Active = true;
+    SpinLoop.Entry = BlockEntry;
   }
 
   IRPair<IROp_Jump> Jump() {
@@ -174,9 +182,9 @@ public:
     FlushRegisterCache();
     return _Break(Reason);
   }
-  IRPair<IROp_Thunk> Thunk(Ref ArgPtr, SHA256Sum ThunkNameHash) {
+  IRPair<IROp_Thunk> Thunk(Ref ArgPtr, SHA256Sum ThunkNameHash, bool Leaf) {
     FlushRegisterCache();
-    return _Thunk(ArgPtr, ThunkNameHash);
+    return _Thunk(ArgPtr, ThunkNameHash, Leaf);
   }
 
   bool FinishOp(uint64_t NextRIP, bool LastOp) {
@@ -294,6 +302,11 @@ public:
     return ForceTSO;
   }
 
+  // Set if the current instruction is known to perform unaligned atomic accesses.
+  void SetUnalignedAtomic(bool Unaligned) {
+    UnalignedAtomic = Unaligned;
+  }
+
   void SetDumpIR(bool DumpIR) {
     ShouldDump = DumpIR;
   }
@@ -1370,6 +1383,7 @@ private:
   bool DecodeFailure {false};
   bool NeedsBlockEnd {false};
   ForceTSOMode ForceTSO {ForceTSOMode::NoOverride};
+  bool UnalignedAtomic {false};
   // Used during new op bringup
   bool ShouldDump {false};
 
@@ -2437,6 +2451,17 @@ private:
   bool Is64BitMode {};
   uint64_t Entry {};
 
+  // State of the spin-loop currently being translated. The load of the watched memory word is recorded so the back edge
+  // can wait for it to change, see Decoder::IsSpinLoop.
+  struct {
+    bool Active;
+    uint64_t Entry;
+    Ref CodeBlock;
+    Ref Addr;
+    Ref Value;
+    IR::OpSize Size;
+  } SpinLoop {};
+
   // Set if mono hacks are enabled and the current block is the mono callsite backpatcher, in which case the
   // XCHG ops that would patch code are replaced with a hook that performs the write and manually invalidates
   // the target address.
@@ -2456,9 +2481,40 @@ private:
     }
   }
 
+  // Forced TSO accesses are marked so the TSO elision pass never lowers them.
+  [[nodiscard]]
+  bool IsTSOForced() const {
+    return ForceTSO == ForceTSOMode::ForceEnabled;
+  }
+
+  // Unaligned atomic GPR accesses use regular loads and stores with half-barriers, same as what the SIGBUS handler would
+  // backpatch them to. Vector TSO accesses already use barriers.
+  [[nodiscard]]
+  bool IsUnalignedTSO(RegClass Class) const {
+    return UnalignedAtomic && Class == RegClass::GPR && IsTSOEnabled(Class);
+  }
+
+  Ref _LoadMemUnalignedTSO(RegClass Class, OpSize Size, Ref Base, Ref Index, OpSize Align, MemOffsetType IndexType, uint8_t IndexScale) {
+    auto Value = _LoadMem(Class, Size, Base, Index, Align, IndexType, IndexScale);
+    if (CTX->Config.HalfBarrierTSOEnabled) {
+      _Fence(FenceType::Load);
+    }
+    return Value;
+  }
+
+  Ref _StoreMemUnalignedTSO(RegClass Class, OpSize Size, Ref Value, Ref Base, Ref Index, OpSize Align, MemOffsetType IndexType,
+                            uint8_t IndexScale) {
+    if (CTX->Config.HalfBarrierTSOEnabled) {
+      _Fence(FenceType::LoadStore);
+    }
+    return _StoreMem(Class, Size, Value, Base, Index, Align, IndexType, IndexScale);
+  }
+
   Ref _StoreMemAutoTSO(RegClass Class, OpSize Size, Ref Addr, Ref Value, OpSize Align = OpSize::i8Bit) {
-    if (IsTSOEnabled(Class)) {
-      return _StoreMemTSO(Class, Size, Value, Addr, Invalid(), Align, MemOffsetType::SXTX, 1);
+    if (IsUnalignedTSO(Class)) {
+      return _StoreMemUnalignedTSO(Class, Size, Value, Addr, Invalid(), Align, MemOffsetType::SXTX, 1);
+    } else if (IsTSOEnabled(Class)) {
+      return _StoreMemTSO(Class, Size, Value, Addr, Invalid(), Align, MemOffsetType::SXTX, 1, IsTSOForced());
     } else {
       return _StoreMem(Class, Size, Value, Addr, Invalid(), Align, MemOffsetType::SXTX, 1);
     }
@@ -2471,8 +2527,10 @@ private:
   }
 
   Ref _LoadMemAutoTSO(RegClass Class, OpSize Size, Ref ssa0, OpSize Align = OpSize::i8Bit) {
-    if (IsTSOEnabled(Class)) {
-      return _LoadMemTSO(Class, Size, ssa0, Invalid(), Align, MemOffsetType::SXTX, 1);
+    if (IsUnalignedTSO(Class)) {
+      return _LoadMemUnalignedTSO(Class, Size, ssa0, Invalid(), Align, MemOffsetType::SXTX, 1);
+    } else if (IsTSOEnabled(Class)) {
+      return _LoadMemTSO(Class, Size, ssa0, Invalid(), Align, MemOffsetType::SXTX, 1, IsTSOForced());
     } else {
       return _LoadMem(Class, Size, ssa0, Invalid(), Align, MemOffsetType::SXTX, 1);
     }
@@ -2485,11 +2543,14 @@ private:
   }
 
   Ref _LoadMemAutoTSO(RegClass Class, OpSize Size, const AddressMode& A, OpSize Align = OpSize::i8Bit) {
-    const bool AtomicTSO = IsTSOEnabled(Class) && !A.NonTSO;
+    const bool UnalignedTSO = IsUnalignedTSO(Class) && !A.NonTSO;
+    const bool AtomicTSO = IsTSOEnabled(Class) && !A.NonTSO && !UnalignedTSO;
     const auto B = SelectAddressMode(this, A, GetGPROpSize(), CTX->HostFeatures.SupportsTSOImm9, AtomicTSO, Class != RegClass::GPR, Size);
 
-    if (AtomicTSO) {
-      return _LoadMemTSO(Class, Size, B.Base, B.Index, Align, B.IndexType, B.IndexScale);
+    if (UnalignedTSO) {
+      return _LoadMemUnalignedTSO(Class, Size, B.Base, B.Index, Align, B.IndexType, B.IndexScale);
+    } else if (AtomicTSO) {
+      return _LoadMemTSO(Class, Size, B.Base, B.Index, Align, B.IndexType, B.IndexScale, IsTSOForced());
     } else {
       return _LoadMem(Class, Size, B.Base, B.Index, Align, B.IndexType, B.IndexScale);
     }
@@ -2548,11 +2609,14 @@ private:
   }
 
   Ref _StoreMemAutoTSO(RegClass Class, OpSize Size, const AddressMode& A, Ref Value, OpSize Align = OpSize::i8Bit) {
-    const bool AtomicTSO = IsTSOEnabled(Class) && !A.NonTSO;
+    const bool UnalignedTSO = IsUnalignedTSO(Class) && !A.NonTSO;
+    const bool AtomicTSO = IsTSOEnabled(Class) && !A.NonTSO && !UnalignedTSO;
     const auto B = SelectAddressMode(this, A, GetGPROpSize(), CTX->HostFeatures.SupportsTSOImm9, AtomicTSO, Class != RegClass::GPR, Size);
 
-    if (AtomicTSO) {
-      return _StoreMemTSO(Class, Size, Value, B.Base, B.Index, Align, B.IndexType, B.IndexScale);
+    if (UnalignedTSO) {
+      return _StoreMemUnalignedTSO(Class, Size, Value, B.Base, B.Index, Align, B.IndexType, B.IndexScale);
+    } else if (AtomicTSO) {
+      return _StoreMemTSO(Class, Size, Value, B.Base, B.Index, Align, B.IndexType, B.IndexScale, IsTSOForced());
     } else {
       return _StoreMem(Class, Size, Value, B.Base, B.Index, Align, B.IndexType, B.IndexScale);
     }
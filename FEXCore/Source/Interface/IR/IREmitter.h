@@ -9,6 +9,7 @@
 #include <FEXCore/IR/IR.h>
 
 #include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/fextl/vector.h>
 
 #include <algorithm>
@@ -22,8 +23,7 @@ public:
   IREmitter(FEXCore::Utils::IntrusivePooledAllocator& ThreadAllocator, bool SupportsTSOImm9)
     : DualListData {ThreadAllocator, 8 * 1024 * 1024}
     , SupportsTSOImm9(SupportsTSOImm9) {
-    ReownOrClaimBuffer();
-    ResetWorkingList();
+    // No buffer is claimed until ReownOrClaimBuffer, which must be followed by ResetWorkingList before emitting IR.
   }
 
   virtual ~IREmitter() = default;
@@ -363,6 +363,14 @@ public:
   void Remove(Ref Node);
   void RemovePostRA(Ref Node);
 
+  // Copies raw data into the IR data buffer and returns its offset from the start of the buffer.
+  // The data isn't part of any node, so passes never see it, but it is kept with the IR.
+  uint32_t AllocateInlineData(const void* Src, size_t Size) {
+    auto Ptr = DualListData.DataAllocate(FEXCore::AlignUp(Size, 8));
+    memcpy(Ptr, Src, Size);
+    return reinterpret_cast<uintptr_t>(Ptr) - DualListData.DataBegin();
+  }
+
   void CopyData(const IREmitter& rhs) {
     LOGMAN_THROW_A_FMT(rhs.DualListData.DataBackingSize() <= DualListData.DataBackingSize(), "Trying to take ownership of data that is too "
                                                                                              "large");
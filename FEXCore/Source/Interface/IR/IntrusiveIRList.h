@@ -120,8 +120,7 @@ public:
   DualIntrusiveAllocatorThreadPool(FEXCore::Utils::IntrusivePooledAllocator& ThreadAllocator, size_t Size)
     : DualIntrusiveAllocator {Size}
     , PoolObject {ThreadAllocator, Size * 2} {
-    // Claim a buffer on allocation
-    PoolObject.ReownOrClaimBuffer();
+    // The buffer is only claimed on first use, threads that never compile code don't hold on to one.
   }
 
   void ReownOrClaimBuffer() {
@@ -71,6 +71,10 @@ void PassManager::AddDefaultPasses(FEXCore::Context::ContextImpl* ctx) {
 
   if (!DisablePasses()) {
     InsertPass(CreateX87StackOptimizationPass(ctx->HostFeatures, ctx->Config.Is64BitMode ? IR::OpSize::i64Bit : IR::OpSize::i32Bit));
+    if (ctx->IsAtomicTSOEnabled()) {
+      // Nothing but forced TSO accesses is emitted as TSO otherwise, and those must stay TSO.
+      InsertPass(CreateTSOElisionPass(ctx->Config.Is64BitMode ? IR::OpSize::i64Bit : IR::OpSize::i32Bit));
+    }
     InsertPass(CreateDeadFlagCalculationEliminination());
   }
 }
@@ -324,6 +324,7 @@ constexpr FlagInfo ClassifyConst(IROps Op) {
   case OP_NZCVSELECTINCREMENT:
   case OP_NEG:
   case OP_CONDJUMP:
+  case OP_SPINWAIT:
   case OP_CONDSUBNZCV:
   case OP_CONDADDNZCV:
   case OP_RMIFNZCV:
@@ -374,6 +375,11 @@ FlagInfo DeadFlagCalculationEliminination::Classify(IROp_Header* IROp) {
     return FlagInfo::Pack({.Read = FlagsForCondClassType(Op->Cond)});
   }
 
+  case OP_SPINWAIT: {
+    auto Op = IROp->CW<IR::IROp_SpinWait>();
+    return FlagInfo::Pack({.Read = FlagsForCondClassType(Op->Cond)});
+  }
+
   case OP_CONDSUBNZCV:
   case OP_CONDADDNZCV: {
     auto Op = IROp->CW<IR::IROp_CondAddNZCV>();
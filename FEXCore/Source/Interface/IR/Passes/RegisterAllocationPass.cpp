@@ -70,6 +70,10 @@ private:
   // Map of nodes to their preferred register, to coalesce load/store reg.
   fextl::vector<PhysicalRegister> PreferredReg;
 
+  // Map of nodes to the SRA node their preferred register was inherited from,
+  // when they are the killed tied source of a node with a preferred register.
+  fextl::vector<Ref> TiedSRANode;
+
   // Map of assigned registers. Does not grow beyond the initial set.
   fextl::vector<PhysicalRegister> SSAToReg;
 
@@ -571,6 +575,7 @@ void ConstrainedRAPass::Run(IREmitter* IREmit_) {
   IR = &IR_;
 
   PreferredReg.resize(IR->GetSSACount(), PhysicalRegister::Invalid());
+  TiedSRANode.resize(IR->GetSSACount(), nullptr);
   SSAToReg.resize(IR->GetSSACount(), PhysicalRegister::Invalid());
   Seen.resize(IR->GetSSACount(), false);
 
@@ -619,7 +624,8 @@ void ConstrainedRAPass::Run(IREmitter* IREmit_) {
           auto Node = GetClass(Reg)->RegToSSA[Reg.Reg];
           IROp_Header* Header = IR->GetOp<IROp_Header>(Node);
 
-          if (CodeNode != DecodeSRANode(Header, Node)) {
+          auto SRANode = DecodeSRANode(Header, Node);
+          if (CodeNode != SRANode && TiedSRANode[IR->GetID(CodeNode).Value] != SRANode) {
             PreferredReg[IR->GetID(CodeNode).Value] = PhysicalRegister::Invalid();
           }
         }
@@ -636,6 +642,26 @@ void ConstrainedRAPass::Run(IREmitter* IREmit_) {
           }
         }
 
+        // Guest registers stay cached across instructions, so a tied operation
+        // like a partial register write often consumes a value that is not
+        // stored to the static register itself. Let the tied source inherit the
+        // preferred register when this is its last use, so the operation can
+        // happen in place instead of the JIT inserting a move. The check above
+        // still requires no intervening SRA load/store for the source.
+        if (auto Reg = PreferredReg[IR->GetID(CodeNode).Value]; !Reg.IsInvalid()) {
+          if (int TiedIdx = IR::TiedSource(IROp->Op); TiedIdx >= 0 && IROp->Args[TiedIdx].HasKill()) {
+            auto V = IROp->Args[TiedIdx];
+            V.ClearKill();
+            const uint32_t Index = V.ID().Value;
+
+            if (IsValidArg(V) && PreferredReg[Index].IsInvalid()) {
+              Ref SRANode = TiedSRANode[IR->GetID(CodeNode).Value];
+              PreferredReg[Index] = Reg;
+              TiedSRANode[Index] = SRANode ? SRANode : CodeNode;
+            }
+          }
+        }
+
         // Rest is iteration gunk
         if (CodeLast == CodeBegin) {
           break;
@@ -772,6 +798,7 @@ void ConstrainedRAPass::Run(IREmitter* IREmit_) {
   }
 
   PreferredReg.clear();
+  TiedSRANode.clear();
   SSAToReg.clear();
   SpillSlots.clear();
   NextUses.clear();
@@ -0,0 +1,290 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: ir|opts
+desc: Lowers TSO memory accesses that provably target stack slots private to the thread to regular loadstores
+$end_info$
+*/
+
+#include "Interface/IR/IR.h"
+#include "Interface/IR/IREmitter.h"
+#include "Interface/IR/PassManager.h"
+#include "Interface/IR/RegisterAllocationData.h"
+
+#include <FEXCore/Core/X86Enums.h>
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+// The OpcodeDispatcher already emits regular loadstores for memory operands that are directly addressed through RSP.
+// This pass extends that to addresses that only get their stack provenance through other instructions in the block, for
+// example `sub rsp, 32; lea rax, [rsp + 16]; mov [rax], ebx; ...`.
+//
+// Provenance is tracked per block through the SRA register loads and stores, with offsets relative to RSP at block
+// entry, so a pointer that gets moved between guest registers keeps its provenance.
+//
+// Only accesses to stack slots that the block allocated itself by lowering RSP are lowered. Anything at or above RSP
+// at block entry might have been published to other threads before the block ran, which the pass can't see.
+// A slot allocated by the block can still become shared through the block itself, so stack elision is disabled for
+// the whole multiblock if a stack derived value escapes anywhere in it: stored to memory, passed to anything that
+// isn't address arithmetic or a memory access, or left in a GPR other than RSP at the end of a block.
+// Blocks of a multiblock can execute in any order, which is why this can't be decided per block.
+//
+// Accesses from instructions with forced TSO are never lowered.
+
+namespace FEXCore::IR {
+
+class TSOElision final : public FEXCore::IR::Pass {
+public:
+  TSOElision(OpSize GPROpSize)
+    : GPROpSize {GPROpSize} {}
+  void Run(IREmitter* IREmit) override;
+
+private:
+  struct Provenance {
+    bool Stack {};
+    // Byte offset from RSP at block entry, only valid for stack provenance.
+    int64_t Offset {};
+  };
+
+  Provenance Get(OrderedNodeWrapper Arg) const {
+    return SSAProvenance[Arg.ID().Value];
+  }
+
+  void Set(IRListView& IR, Ref Node, Provenance P) {
+    SSAProvenance[IR.GetID(Node).Value] = P;
+  }
+
+  bool IsStack(OrderedNodeWrapper Arg) const {
+    return !Arg.IsInvalid() && Get(Arg).Stack;
+  }
+
+  bool GetConstant(IREmitter* IREmit, OrderedNodeWrapper Arg, int64_t* Value) const;
+  std::optional<Provenance> Combine(IREmitter* IREmit, IROp_Header* IROp, bool Subtract) const;
+  bool IsAllocatedSlot(IRListView& IR, IROp_Header* IROp, OrderedNodeWrapper Addr, OrderedNodeWrapper Offset, int64_t AllocatedBase) const;
+  bool HasStackArg(IROp_Header* IROp) const;
+
+  const OpSize GPROpSize;
+  fextl::vector<Provenance> SSAProvenance;
+  fextl::vector<IROp_Header*> Candidates;
+};
+
+// The TSO variants carry a trailing Forced flag, everything LoadMem/StoreMem reads must be at the same offset.
+static_assert(sizeof(IROp_LoadMemTSO) >= sizeof(IROp_LoadMem), "LoadMemTSO is lowered in place");
+static_assert(offsetof(IROp_LoadMemTSO, OffsetScale) == offsetof(IROp_LoadMem, OffsetScale), "LoadMemTSO is lowered in place");
+static_assert(sizeof(IROp_StoreMemTSO) >= sizeof(IROp_StoreMem), "StoreMemTSO is lowered in place");
+static_assert(offsetof(IROp_StoreMemTSO, OffsetScale) == offsetof(IROp_StoreMem, OffsetScale), "StoreMemTSO is lowered in place");
+
+bool TSOElision::GetConstant(IREmitter* IREmit, OrderedNodeWrapper Arg, int64_t* Value) const {
+  auto Header = IREmit->GetOpHeader(Arg);
+  if (Header->Op == OP_CONSTANT) {
+    *Value = Header->C<IROp_Constant>()->Constant;
+    return true;
+  } else if (Header->Op == OP_INLINECONSTANT) {
+    *Value = Header->C<IROp_InlineConstant>()->Constant;
+    return true;
+  }
+
+  return false;
+}
+
+// Returns the provenance of an add or sub, or nothing if a stack pointer gets combined in a way that can't be tracked.
+std::optional<TSOElision::Provenance> TSOElision::Combine(IREmitter* IREmit, IROp_Header* IROp, bool Subtract) const {
+  const auto Src1 = Get(IROp->Args[0]);
+  const auto Src2 = Get(IROp->Args[1]);
+  int64_t Constant {};
+
+  if (!Src1.Stack && !Src2.Stack) {
+    return Provenance {};
+  } else if (IR::OpSizeToSize(IROp->Size) < IR::OpSizeToSize(GPROpSize)) {
+    // Truncated, so no longer a stack address.
+    return std::nullopt;
+  } else if (Src1.Stack && !Src2.Stack && GetConstant(IREmit, IROp->Args[1], &Constant)) {
+    return Provenance {true, Subtract ? Src1.Offset - Constant : Src1.Offset + Constant};
+  } else if (!Subtract && Src2.Stack && !Src1.Stack && GetConstant(IREmit, IROp->Args[0], &Constant)) {
+    return Provenance {true, Src2.Offset + Constant};
+  }
+
+  return std::nullopt;
+}
+
+bool TSOElision::IsAllocatedSlot(IRListView& IR, IROp_Header* IROp, OrderedNodeWrapper Addr, OrderedNodeWrapper Offset,
+                                 int64_t AllocatedBase) const {
+  const auto P = Get(Addr);
+  if (!P.Stack) {
+    return false;
+  }
+
+  // TSO accesses only ever carry an inline immediate offset, anything else can't be tracked.
+  int64_t ImmOffset {};
+  if (!Offset.IsInvalid()) {
+    auto OffsetHeader = IR.GetOp<IROp_Header>(Offset);
+    if (OffsetHeader->Op != OP_INLINECONSTANT) {
+      return false;
+    }
+    ImmOffset = OffsetHeader->C<IROp_InlineConstant>()->Constant;
+  }
+
+  const auto SlotOffset = P.Offset + ImmOffset;
+  return SlotOffset >= AllocatedBase && SlotOffset + IR::OpSizeToSize(IROp->Size) <= 0;
+}
+
+bool TSOElision::HasStackArg(IROp_Header* IROp) const {
+  const auto NumArgs = IR::GetArgs(IROp->Op);
+  for (uint8_t i = 0; i < NumArgs; ++i) {
+    if (IsStack(IROp->Args[i])) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void TSOElision::Run(IREmitter* IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::TSOElision");
+
+  auto CurrentIR = IREmit->ViewIR();
+  auto HeaderOp = CurrentIR.GetHeader();
+
+  SSAProvenance.clear();
+  SSAProvenance.resize(CurrentIR.GetSSACount());
+  Candidates.clear();
+
+  bool StackEscaped {};
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    // Provenance of the guest GPRs, RSP is by definition the stack and everything else is unknown at block entry.
+    std::array<Provenance, 16> GPRProvenance {};
+    GPRProvenance[X86State::REG_RSP] = {true, 0};
+
+    // Lowest RSP that the block has set, everything from there up to RSP at block entry was allocated by the block.
+    int64_t AllocatedBase {};
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      switch (IROp->Op) {
+      case OP_LOADREGISTER: {
+        auto Op = IROp->C<IROp_LoadRegister>();
+        if (Op->Class == RegClass::GPR && Op->Reg < GPRProvenance.size()) {
+          Set(CurrentIR, CodeNode, GPRProvenance[Op->Reg]);
+        }
+        break;
+      }
+      case OP_STOREREGISTER: {
+        const PhysicalRegister Reg(CodeNode);
+        if (Reg.AsRegClass() == RegClass::GPRFixed && Reg.Reg < GPRProvenance.size()) {
+          const auto P = Get(IROp->Args[0]);
+          GPRProvenance[Reg.Reg] = P;
+          if (Reg.Reg == X86State::REG_RSP && P.Stack) {
+            AllocatedBase = std::min(AllocatedBase, P.Offset);
+          }
+        } else {
+          StackEscaped |= HasStackArg(IROp);
+        }
+        break;
+      }
+      case OP_COPY:
+      case OP_RMWHANDLE: Set(CurrentIR, CodeNode, Get(IROp->Args[0])); break;
+      case OP_ADD:
+      case OP_ADDWITHFLAGS:
+      case OP_SUB:
+      case OP_SUBWITHFLAGS: {
+        if (const auto P = Combine(IREmit, IROp, IROp->Op == OP_SUB || IROp->Op == OP_SUBWITHFLAGS)) {
+          Set(CurrentIR, CodeNode, *P);
+        } else {
+          StackEscaped = true;
+        }
+        break;
+      }
+      case OP_ADDNZCV:
+      case OP_SUBNZCV:
+      case OP_TESTNZ:
+        // Only produce flags.
+        break;
+      case OP_PUSH: {
+        auto Op = IROp->C<IROp_Push>();
+        StackEscaped |= IsStack(Op->Value);
+        if (const auto P = Get(Op->Addr); P.Stack) {
+          Set(CurrentIR, CodeNode, {true, P.Offset - IR::OpSizeToSize(Op->ValueSize)});
+        }
+        break;
+      }
+      case OP_POP: {
+        // The address is updated in place.
+        auto Op = IROp->C<IROp_Pop>();
+        if (const auto P = Get(Op->InoutAddr); P.Stack) {
+          SSAProvenance[Op->InoutAddr.ID().Value].Offset += IR::OpSizeToSize(Op->Size);
+        }
+        break;
+      }
+      case OP_LOADMEMPAIR: break;
+      case OP_STOREMEMPAIR: {
+        auto Op = IROp->C<IROp_StoreMemPair>();
+        StackEscaped |= IsStack(Op->Value1) || IsStack(Op->Value2);
+        break;
+      }
+      case OP_BFE: {
+        // 32-bit address size zero extension, which doesn't change the address of a 32-bit guest.
+        auto Op = IROp->C<IROp_Bfe>();
+        if (GPROpSize == OpSize::i32Bit && Op->lsb == 0 && Op->Width == 32) {
+          Set(CurrentIR, CodeNode, Get(Op->Src));
+        } else {
+          StackEscaped |= HasStackArg(IROp);
+        }
+        break;
+      }
+      case OP_LOADMEM: StackEscaped |= IsStack(IROp->C<IROp_LoadMem>()->Offset); break;
+      case OP_LOADMEMTSO: {
+        auto Op = IROp->C<IROp_LoadMemTSO>();
+        StackEscaped |= IsStack(Op->Offset);
+        if (!Op->Forced && IsAllocatedSlot(CurrentIR, IROp, Op->Addr, Op->Offset, AllocatedBase)) {
+          Candidates.push_back(IROp);
+        }
+        break;
+      }
+      case OP_STOREMEM: {
+        auto Op = IROp->C<IROp_StoreMem>();
+        StackEscaped |= IsStack(Op->Value) || IsStack(Op->Offset);
+        break;
+      }
+      case OP_STOREMEMTSO: {
+        auto Op = IROp->C<IROp_StoreMemTSO>();
+        StackEscaped |= IsStack(Op->Value) || IsStack(Op->Offset);
+        if (!Op->Forced && IsAllocatedSlot(CurrentIR, IROp, Op->Addr, Op->Offset, AllocatedBase)) {
+          Candidates.push_back(IROp);
+        }
+        break;
+      }
+      default: StackEscaped |= HasStackArg(IROp); break;
+      }
+    }
+
+    // Whatever runs after the block can see the GPRs, only RSP itself is expected to hold a stack pointer.
+    for (size_t i = 0; i < GPRProvenance.size(); ++i) {
+      StackEscaped |= i != X86State::REG_RSP && GPRProvenance[i].Stack;
+    }
+  }
+
+  // Lowering is deferred until every block has been walked, since a stack pointer escaping anywhere in the multiblock
+  // invalidates stack elision in all of its blocks.
+  if (StackEscaped) {
+    return;
+  }
+
+  for (auto IROp : Candidates) {
+    IROp->Op = IROp->Op == OP_LOADMEMTSO ? OP_LOADMEM : OP_STOREMEM;
+  }
+
+  HeaderOp->ElidedTSOAccesses += Candidates.size();
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateTSOElisionPass(OpSize GPROpSize) {
+  return fextl::make_unique<TSOElision>(GPROpSize);
+}
+
+} // namespace FEXCore::IR
@@ -2064,6 +2064,15 @@ std::optional<int32_t> HandleUnalignedAccess(FEXCore::Core::InternalThreadState*
     }
   }
 
+  if ((Instr & LDAXR_MASK) == LDAR_INST ||    // LDAR*
+      (Instr & LDAXR_MASK) == LDAPR_INST ||   // LDAPR*
+      (Instr & LDAXR_MASK) == STLR_INST ||    // STLR*
+      (Instr & RCPC2_MASK) == LDAPUR_INST ||  // LDAPUR*
+      (Instr & RCPC2_MASK) == STLUR_INST) {   // STLUR*
+    // This access is about to be backpatched, remember the guest instruction so it gets compiled unaligned-safe from now on.
+    CTX->MarkUnalignedAtomic(Thread, ProgramCounter);
+  }
+
   // Lock code mutex during any SIGBUS handling that potentially changes code.
   // Due to code buffer sharing between threads, code must be carefully backpatched from last to first.
   // Multiple threads can be attempting to handle the SIGBUS or even be executing the code being backpatched.
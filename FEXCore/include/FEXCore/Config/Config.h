@@ -28,6 +28,8 @@ namespace Handler {
       return "1";
     } else if (Value == "full") {
       return "2";
+    } else if (Value == "fullblock") {
+      return "3";
     }
     return "0";
   }
@@ -55,6 +57,7 @@ enum ConfigSMCChecks {
   CONFIG_SMC_NONE,
   CONFIG_SMC_MTRACK,
   CONFIG_SMC_FULL,
+  CONFIG_SMC_FULL_BLOCK,
 };
 
 enum class LayerType {
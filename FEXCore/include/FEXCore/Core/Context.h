@@ -40,6 +40,14 @@ enum OperatingMode {
   MODE_64BIT,
 };
 
+// Which x86-64 SysV argument registers are passed to a host function installed with AddHostFunctionIRHandler.
+enum class HostFunctionABI {
+  // RDI, RSI, RDX, RCX, R8, R9, the return value is passed back in RAX.
+  Integer,
+  // The integer registers followed by the low 128 bits of XMM0, XMM1 and XMM2, the return value is passed back in XMM0.
+  Vector,
+};
+
 using CodeRangeInvalidationFn = std::function<void(uint64_t start, uint64_t Length)>;
 
 using CustomIREntrypointHandler = std::function<void(uintptr_t Entrypoint, IR::IREmitter*)>;
@@ -145,6 +153,22 @@ public:
   InvalidateThreadCachedCodeRange(FEXCore::Core::InternalThreadState* Thread, uint64_t Start, uint64_t Length) = 0;
   FEX_DEFAULT_VISIBILITY virtual FEXCore::ForkableSharedMutex& GetCodeInvalidationMutex() = 0;
 
+  /**
+   * @brief Drops the cached IR of blocks with guest code in the range.
+   *
+   * Needed whenever guest code gets unmapped, remapped or its protection changes, even if the compiled code is kept.
+   * Cached IR is checked against the guest code on lookup, which can't be done for code that is no longer mapped.
+   */
+  FEX_DEFAULT_VISIBILITY virtual void InvalidateCachedIR(uint64_t Start, uint64_t Length) = 0;
+
+  /**
+   * @brief Gives the memory of the thread's L1 and L2 lookup caches back to the OS.
+   *
+   * They get refilled from the shared L3 on demand. For threads that are about to sit idle.
+   * Must be called from the thread itself, outside of JIT code.
+   */
+  FEX_DEFAULT_VISIBILITY virtual void TrimThreadLocalCaches(FEXCore::Core::InternalThreadState* Thread) = 0;
+
   FEX_DEFAULT_VISIBILITY virtual void
   ConfigureAOTGen(FEXCore::Core::InternalThreadState* Thread, fextl::set<uint64_t>* ExternalBranches, uint64_t SectionMaxAddress) = 0;
 
@@ -182,6 +206,24 @@ public:
    */
   FEX_DEFAULT_VISIBILITY virtual void AddThunkTrampolineIRHandler(uintptr_t Entrypoint, uintptr_t GuestThunkEntrypoint) = 0;
 
+  /**
+   * @brief Replaces the 64-bit guest function at the given address with a host function
+   *
+   * The host function is looked up through the ThunkHandler. It receives a pointer to the six integer argument registers
+   * of the x86-64 SysV calling convention followed by a return value slot, which is initialized with Entrypoint.
+   * With HostFunctionABI::Vector, 8 bytes of padding and three 16-byte vector register slots follow.
+   * Once the host function returns, the guest returns to its caller with the return value in RAX, or with the first
+   * vector slot in XMM0.
+   * The host function must not call back in to guest code, guest caller-saved registers aren't preserved across it.
+   *
+   * @param Entrypoint The guest PC that the IR handler will be installed at.
+   * @param HostFunction The thunk name hash of the host function.
+   * @param ABI The argument registers that the host function takes.
+   */
+  FEX_DEFAULT_VISIBILITY virtual void
+  AddHostFunctionIRHandler(uintptr_t Entrypoint, const IR::SHA256Sum& HostFunction, HostFunctionABI ABI) = 0;
+  FEX_DEFAULT_VISIBILITY virtual void RemoveHostFunctionIRHandler(FEXCore::Core::InternalThreadState* Thread, uintptr_t Entrypoint) = 0;
+
   /**
    * @brief Adds additional per-instruction granularity TSO enable/disable information for the given range.
    *
@@ -192,6 +234,30 @@ public:
 
   FEX_DEFAULT_VISIBILITY virtual void RemoveForceTSOInformation(uint64_t Address, uint64_t Size) = 0;
 
+  /**
+   * @brief Adds instructions that are known to not need TSO emulation.
+   *
+   * Unlike AddForceTSOInformation, instructions that aren't listed keep the default TSO behaviour.
+   * Ranges with ForceTSO information and instructions with forced TSO take precedence.
+   * The information is removed along with the ForceTSO information of the range.
+   *
+   * @param Instructions The set of instruction addresses for which TSO should be disabled
+   */
+  FEX_DEFAULT_VISIBILITY virtual void AddTSOFreeInstructions(fextl::set<uint64_t>&& Instructions) = 0;
+
+  // Enables TSO emulation again for instructions that were added with AddTSOFreeInstructions.
+  FEX_DEFAULT_VISIBILITY virtual void RemoveTSOFreeInstructions(const fextl::set<uint64_t>& Instructions) = 0;
+
+  /**
+   * @brief Adds instructions that are known to perform unaligned atomic accesses.
+   *
+   * These get compiled to the unaligned-safe sequence directly, instead of being backpatched after a SIGBUS.
+   * The information is removed along with the ForceTSO information of the range.
+   *
+   * @param Instructions The set of instruction addresses
+   */
+  FEX_DEFAULT_VISIBILITY virtual void AddUnalignedAtomicInformation(fextl::set<uint64_t>&& Instructions) = 0;
+
   FEX_DEFAULT_VISIBILITY virtual void MarkMonoDetected() = 0;
 
   FEX_DEFAULT_VISIBILITY virtual void MarkMonoBackpatcherBlock(uint64_t BlockEntry) = 0;
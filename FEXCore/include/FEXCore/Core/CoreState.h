@@ -107,7 +107,7 @@ struct CPUState {
   uint64_t L1Pointer {};
   uint64_t L1Mask {};
   uint64_t callret_sp {};
-  uint64_t _pad1 {};
+  uint64_t L1GenerationPointer {}; ///< Points to the LookupCache's L1Generation
   XMMRegs xmm {};
 
   // Raw segment register indexes
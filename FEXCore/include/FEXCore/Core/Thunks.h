@@ -18,5 +18,7 @@ class ThunkHandler {
 public:
   virtual ~ThunkHandler() = default;
   virtual ThunkedFunction* LookupThunk(const IR::SHA256Sum& sha256) = 0;
+  // Returns true if the thunk never calls back in to guest code, which lets the JIT skip preserving guest caller-saved registers
+  virtual bool IsLeafThunk(const IR::SHA256Sum& sha256) = 0;
 };
 } // namespace FEXCore
@@ -8,6 +8,7 @@
 #include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <shared_mutex>
@@ -38,6 +39,7 @@ class PassManager;
 
 namespace FEXCore::SHMStats {
 struct ThreadStats;
+struct ThreadSyscallStats;
 };
 
 namespace FEXCore::Core {
@@ -106,11 +108,15 @@ struct alignas(FEXCore::Utils::FEX_PAGE_SIZE) InternalThreadState : public FEXCo
 
   std::shared_mutex ObjectCacheRefCounter {};
 
-  // This pointer is owned by the frontend.
+  // These pointers are owned by the frontend.
   FEXCore::SHMStats::ThreadStats* ThreadStats {};
+  FEXCore::SHMStats::ThreadSyscallStats* SyscallStats {};
 
   UnalignedExclusiveStore ExclusiveStore;
 
+  // Set while guest code is being compiled, read by sampling profilers from a signal handler on this thread.
+  std::atomic<bool> Compiling {};
+
   ///< Data pointer for exclusive use by the frontend
   void* FrontendPtr;
 
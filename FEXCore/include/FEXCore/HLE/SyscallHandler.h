@@ -62,6 +62,9 @@ public:
   virtual void InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState* Thread, uint64_t Start, uint64_t Length) {}
   virtual void MarkOvercommitRange(uint64_t Start, uint64_t Length) {}
   virtual void UnmarkOvercommitRange(uint64_t Start, uint64_t Length) {}
+  // Called when an atomic access of the guest instruction at `GuestRIP` had to be backpatched due to misalignment.
+  // Called outside of signal handlers, the next time code gets compiled after the backpatch was queued.
+  virtual void MarkUnalignedAtomic(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP) {}
   virtual ExecutableRangeInfo QueryGuestExecutableRange(FEXCore::Core::InternalThreadState* Thread, uint64_t Address) = 0;
   virtual std::optional<ExecutableFileSectionInfo> LookupExecutableFileSection(Core::InternalThreadState& Thread, uint64_t GuestAddr) = 0;
 
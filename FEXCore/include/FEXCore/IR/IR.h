@@ -85,6 +85,8 @@ typedef void ThunkedFunction(void* ArgsRv);
 struct ThunkDefinition final {
   SHA256Sum Sum;
   ThunkedFunction* ThunkFunction;
+  // The function never calls back in to guest code, see ThunkHandler::IsLeafThunk
+  bool Leaf {};
 };
 
 } // namespace FEXCore::IR
@@ -32,7 +32,7 @@ static inline uint64_t GetCycleCounter() {
 }
 #endif
 // FEXCore live-stats
-constexpr uint8_t STATS_VERSION = 2;
+constexpr uint8_t STATS_VERSION = 8;
 enum class AppType : uint8_t {
   LINUX_32,
   LINUX_64,
@@ -52,6 +52,28 @@ struct ThreadStatsHeader {
   uint32_t Pad;
 };
 
+// Per-syscall sample entry.
+struct SyscallStat {
+  // Guest syscall number + 1, zero means the entry is unused.
+  std::atomic<uint32_t> Number;
+  uint32_t Pad;
+  uint64_t Count;
+  // Accumulated time (In unscaled CPU cycles!)
+  uint64_t AccumulatedTime;
+};
+
+// Number of distinct syscalls tracked per thread.
+// A thread only ever touches a handful of hot syscalls, so this is an open-addressed table instead of a full per-syscall array.
+// Syscalls that don't fit are still accounted in the thread totals.
+constexpr size_t SYSCALL_STATS_ENTRIES = 32;
+
+// Per-syscall samples of a thread, STATS_VERSION >= 7
+// These live in their own `fex-<pid>-syscall-stats` region instead of ThreadStats, so they don't reduce the number of thread slots.
+// The table of a thread is at the same index in that region as the thread's slot in the stats region.
+struct ThreadSyscallStats {
+  SyscallStat Entries[SYSCALL_STATS_ENTRIES];
+};
+
 struct ThreadStats {
   std::atomic<uint32_t> Next;
   std::atomic<uint32_t> TID;
@@ -70,9 +92,35 @@ struct ThreadStats {
   uint64_t AccumulatedCacheWriteLockTime;
 
   uint64_t AccumulatedJITCount;
+
+  // Accumulated syscall information, STATS_VERSION >= 3
+  uint64_t AccumulatedSyscallCount;
+  uint64_t AccumulatedSyscallTime;
+
+  // Accumulated unaligned atomic information, STATS_VERSION >= 4
+  // SIGBUS events that had to backpatch JIT code. Sites that were learned in an earlier run don't show up here.
+  uint64_t AccumulatedSIGBUSBackpatchCount;
+  // Instructions that were compiled straight to the unaligned-safe sequence.
+  uint64_t AccumulatedUnalignedAtomicCount;
+
+  // Accumulated seccomp information, STATS_VERSION >= 5
+  // Syscalls where every installed filter had a cached verdict, so no filter was executed.
+  uint64_t AccumulatedSeccompCachedCount;
+  // Syscalls where at least one filter had to be executed.
+  uint64_t AccumulatedSeccompFilterCount;
+
+  // Per-thread memory, STATS_VERSION >= 8
+  // Address ranges of the thread's L1 and L2 lookup caches, set on the first lookup cache miss.
+  // Both are lazily backed, readers get their resident size from /proc/<pid>/pagemap.
+  uint64_t L1CacheBase;
+  uint64_t L1CacheSize;
+  // Includes the L2 page table.
+  uint64_t L2CacheBase;
+  uint64_t L2CacheSize;
 };
 
 // Ensure 16-byte alignment to take advantage of ARM single-copy atomicity.
+static_assert(SYSCALL_STATS_ENTRIES && (SYSCALL_STATS_ENTRIES & (SYSCALL_STATS_ENTRIES - 1)) == 0, "Needs to be a power of two!");
 static_assert(sizeof(ThreadStats) % 16 == 0, "Needs to be 16-byte aligned!");
 
 template<typename T, size_t FlatOffset = 0>
@@ -94,12 +142,75 @@ private:
   uint64_t Begin;
   T* Stat;
 };
+/**
+ * @brief Finds or claims the sample entry for a syscall number.
+ *
+ * Only the owning thread writes to its stats slot, so claiming an entry doesn't need anything stronger than a relaxed store.
+ *
+ * @return The entry or nullptr if the table is full.
+ */
+static inline SyscallStat* GetSyscallStat(ThreadSyscallStats* Stats, uint64_t Syscall) {
+  const uint32_t Key = Syscall + 1;
+  for (size_t i = 0; i < SYSCALL_STATS_ENTRIES; ++i) {
+    auto Entry = &Stats->Entries[(Syscall + i) & (SYSCALL_STATS_ENTRIES - 1)];
+    const auto Number = Entry->Number.load(std::memory_order_relaxed);
+    if (Number == Key) {
+      return Entry;
+    }
+
+    if (Number == 0) {
+      Entry->Number.store(Key, std::memory_order_relaxed);
+      return Entry;
+    }
+  }
+
+  return nullptr;
+}
+
+// Accumulates both the thread-wide and per-syscall stats with a single pair of cycle counter reads.
+class SyscallAccumulationBlock final {
+public:
+  SyscallAccumulationBlock(ThreadStats* Stats, ThreadSyscallStats* SyscallStats, uint64_t Syscall)
+    : Stats {Stats} {
+    if (!Stats) {
+      return;
+    }
+
+    Begin = GetCycleCounter();
+    Entry = SyscallStats ? GetSyscallStat(SyscallStats, Syscall) : nullptr;
+    std::atomic_ref<uint64_t>(Stats->AccumulatedSyscallCount).fetch_add(1, std::memory_order_relaxed);
+    if (Entry) {
+      std::atomic_ref<uint64_t>(Entry->Count).fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  ~SyscallAccumulationBlock() {
+    if (!Stats) {
+      return;
+    }
+
+    const auto Duration = GetCycleCounter() - Begin;
+    std::atomic_ref<uint64_t>(Stats->AccumulatedSyscallTime).fetch_add(Duration, std::memory_order_relaxed);
+    if (Entry) {
+      std::atomic_ref<uint64_t>(Entry->AccumulatedTime).fetch_add(Duration, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  uint64_t Begin {};
+  ThreadStats* Stats;
+  SyscallStat* Entry {};
+};
+
 #define UniqueScopeName2(name, line) name##line
 #define UniqueScopeName(name, line) UniqueScopeName2(name, line)
 
 #define FEXCORE_PROFILE_ACCUMULATION(ThreadState, Stat)                                                                          \
   FEXCore::SHMStats::AccumulationBlock<decltype(ThreadState->ThreadStats->Stat)> UniqueScopeName(ScopedAccumulation_, __LINE__)( \
     ThreadState->ThreadStats ? &ThreadState->ThreadStats->Stat : nullptr);
+#define FEXCORE_PROFILE_SYSCALL(ThreadState, Syscall)                                                             \
+  FEXCore::SHMStats::SyscallAccumulationBlock UniqueScopeName(ScopedSyscallAccumulation_, __LINE__)(ThreadState->ThreadStats, \
+                                                                                                    ThreadState->SyscallStats, Syscall);
 #define FEXCORE_PROFILE_INSTANT_INCREMENT(ThreadState, Stat, value) \
   do {                                                              \
     if (ThreadState->ThreadStats) {                                 \
@@ -50,6 +50,9 @@ namespace FHU::Syscalls {
 #ifndef SYS_pidfd_open
 #define SYS_pidfd_open 434
 #endif
+#ifndef SYS_pidfd_send_signal
+#define SYS_pidfd_send_signal 424
+#endif
 
 #ifndef _WIN32
 inline int32_t getcpu(uint32_t* cpu, uint32_t* node) {
@@ -96,6 +99,10 @@ inline int32_t renameat2(int olddirfd, const char* oldpath, int newdirfd, const
 inline int32_t pidfd_open(pid_t pid, unsigned int flags) {
   return ::syscall(SYS_pidfd_open, pid, flags);
 }
+
+inline int32_t pidfd_send_signal(int pidfd, int sig, siginfo_t* info, unsigned int flags) {
+  return ::syscall(SYS_pidfd_send_signal, pidfd, sig, info, flags);
+}
 #else
 
 inline int32_t getcpu(uint32_t* cpu, uint32_t* node) {
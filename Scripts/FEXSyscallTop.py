@@ -0,0 +1,200 @@
+#!/usr/bin/python3
+# Top-like viewer for the per-thread syscall statistics that FEX exports through its SHM stats region.
+# Requires the guest to be run with FEX_PROFILESTATS=1.
+import argparse
+import os
+import re
+import struct
+import sys
+import time
+
+HEADER_FORMAT = "<BBH48sIII"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+
+# Next, TID, 9 accumulated stats, syscall count and time.
+THREAD_STATS_FORMAT = "<II9QQQ"
+# L1 and L2 lookup cache base and size, after 15 accumulated stats. STATS_VERSION >= 8
+MEMORY_STATS_FORMAT = "<QQQQ"
+MEMORY_STATS_OFFSET = 8 + 15 * 8
+MEMORY_STATS_VERSION = 8
+SYSCALL_STAT_FORMAT = "<IIQQ"
+SYSCALL_STAT_SIZE = struct.calcsize(SYSCALL_STAT_FORMAT)
+SYSCALL_STATS_ENTRIES = 32
+# The per-syscall tables live in their own region, at the same index as the thread's slot.
+THREAD_SYSCALL_STATS_SIZE = SYSCALL_STAT_SIZE * SYSCALL_STATS_ENTRIES
+
+MIN_STATS_VERSION = 7
+
+APP_TYPES = ["Linux32", "Linux64", "WinArm64ec", "WinWow64"]
+
+def LoadSyscallNames(Is64Bit):
+    ScriptDir = os.path.dirname(os.path.realpath(__file__))
+    Arch = "x64" if Is64Bit else "x32"
+    Prefix = "SYSCALL_x64_" if Is64Bit else "SYSCALL_x86_"
+    Path = os.path.join(ScriptDir, "..", "Source", "Tools", "LinuxEmulation", "LinuxSyscalls", Arch, "SyscallsEnum.h")
+
+    Names = {}
+    try:
+        with open(Path, "r") as File:
+            for Line in File:
+                Match = re.match(r"\s*" + Prefix + r"(\w+)\s*=\s*(\d+),", Line)
+                if Match:
+                    Names[int(Match.group(2))] = Match.group(1)
+    except OSError:
+        pass
+    return Names
+
+def ResidentSize(PagemapFile, Base, Size):
+    # Bit 63 of a pagemap entry is set when the page is present.
+    if PagemapFile is None or Size == 0:
+        return None
+
+    PageSize = os.sysconf("SC_PAGE_SIZE")
+    try:
+        PagemapFile.seek(Base // PageSize * 8)
+        Entries = PagemapFile.read(Size // PageSize * 8)
+    except OSError:
+        return None
+
+    Present = 0
+    for (Entry,) in struct.iter_unpack("<Q", Entries):
+        Present += Entry >> 63
+    return Present * PageSize
+
+def ReadStats(Path, SyscallPath, PagemapFile):
+    with open(Path, "rb") as File:
+        Data = File.read()
+
+    # Tables get mapped as threads are created, the region might not exist yet.
+    try:
+        with open(SyscallPath, "rb") as File:
+            SyscallData = File.read()
+    except FileNotFoundError:
+        SyscallData = b""
+
+    if len(Data) < HEADER_SIZE:
+        return None
+
+    Version, AppType, ThreadStatsSize, FEXVersion, Head, Size, _ = struct.unpack_from(HEADER_FORMAT, Data, 0)
+    if Version < MIN_STATS_VERSION:
+        sys.exit("Stats version {} isn't supported, version {} or newer is required".format(Version, MIN_STATS_VERSION))
+
+    Threads = []
+    Offset = Head
+    Visited = set()
+    while Offset != 0 and Offset not in Visited and Offset + ThreadStatsSize <= len(Data):
+        Visited.add(Offset)
+        Fields = struct.unpack_from(THREAD_STATS_FORMAT, Data, Offset)
+        Next, TID = Fields[0], Fields[1]
+        SyscallCount, SyscallTime = Fields[-2], Fields[-1]
+
+        Syscalls = {}
+        SyscallOffset = (Offset - HEADER_SIZE) // ThreadStatsSize * THREAD_SYSCALL_STATS_SIZE
+        if SyscallOffset + THREAD_SYSCALL_STATS_SIZE <= len(SyscallData):
+            for i in range(SYSCALL_STATS_ENTRIES):
+                Number, _, Count, Time = struct.unpack_from(SYSCALL_STAT_FORMAT, SyscallData, SyscallOffset + i * SYSCALL_STAT_SIZE)
+                if Number != 0:
+                    Syscalls[Number - 1] = (Count, Time)
+
+        # FEX only publishes where its lookup caches are, querying residency is left to readers.
+        Resident = None
+        if Version >= MEMORY_STATS_VERSION and ThreadStatsSize >= MEMORY_STATS_OFFSET + struct.calcsize(MEMORY_STATS_FORMAT):
+            L1Base, L1Size, L2Base, L2Size = struct.unpack_from(MEMORY_STATS_FORMAT, Data, Offset + MEMORY_STATS_OFFSET)
+            L1Resident = ResidentSize(PagemapFile, L1Base, L1Size)
+            L2Resident = ResidentSize(PagemapFile, L2Base, L2Size)
+            if L1Resident is not None and L2Resident is not None:
+                Resident = (L1Resident, L2Resident)
+
+        if TID != 0:
+            Threads.append((TID, SyscallCount, SyscallTime, Syscalls, Resident))
+        Offset = Next
+
+    return {
+        "AppType": AppType,
+        "Version": FEXVersion.split(b"\0", 1)[0].decode(errors = "replace"),
+        "Threads": Threads,
+    }
+
+def Delta(Current, Previous):
+    if Previous is None:
+        return Current
+    return max(0, Current - Previous)
+
+def Main():
+    Parser = argparse.ArgumentParser(description = "Shows the hottest guest syscalls per thread of a running FEX process")
+    Parser.add_argument("pid", type = int, help = "PID of the FEX process")
+    Parser.add_argument("-n", "--top", type = int, default = 10, help = "Number of syscalls to show per thread")
+    Parser.add_argument("-i", "--interval", type = float, default = 1.0, help = "Refresh interval in seconds")
+    Parser.add_argument("-f", "--frequency", type = float, default = 0, help = "Cycle counter frequency in Hz, shows time in microseconds when set")
+    Parser.add_argument("--once", action = "store_true", help = "Print accumulated totals once and exit")
+    Args = Parser.parse_args()
+
+    Path = "/dev/shm/fex-{}-stats".format(Args.pid)
+    SyscallPath = "/dev/shm/fex-{}-syscall-stats".format(Args.pid)
+    Names = None
+    Previous = {}
+
+    try:
+        PagemapFile = open("/proc/{}/pagemap".format(Args.pid), "rb")
+    except OSError:
+        PagemapFile = None
+
+    while True:
+        try:
+            Stats = ReadStats(Path, SyscallPath, PagemapFile)
+        except OSError as e:
+            sys.exit("Couldn't read {}: {}".format(Path, e))
+
+        if Stats is None:
+            sys.exit("{} doesn't contain a stats header".format(Path))
+
+        if Names is None:
+            Names = LoadSyscallNames(Stats["AppType"] != 0)
+
+        Lines = []
+        Lines.append("FEX {} ({}) pid {}: {} threads".format(Stats["Version"], APP_TYPES[Stats["AppType"]] if Stats["AppType"] < len(APP_TYPES) else "Unknown",
+                                                        Args.pid, len(Stats["Threads"])))
+        TimeUnit = "us" if Args.frequency else "cycles"
+        Current = {}
+        for TID, SyscallCount, SyscallTime, Syscalls, Resident in sorted(Stats["Threads"], key = lambda Thread: Thread[2], reverse = True):
+            PrevThread = Previous.get(TID, (None, None, {}))
+            Current[TID] = (SyscallCount, SyscallTime, Syscalls)
+
+            ThreadCount = Delta(SyscallCount, PrevThread[0])
+            ThreadTime = Delta(SyscallTime, PrevThread[1])
+            if ThreadCount == 0 and not Args.once:
+                continue
+
+            Lines.append("")
+            Lines.append("TID {}: {} syscalls, {} {}".format(TID, ThreadCount,
+                                                           round(ThreadTime / Args.frequency * 1e6, 1) if Args.frequency else ThreadTime, TimeUnit))
+            if Resident is not None:
+                Lines.append("  Lookup cache resident: L1 {} KiB, L2 {} KiB".format(Resident[0] // 1024, Resident[1] // 1024))
+            Lines.append("  {:>5} {:<24} {:>12} {:>16} {:>12}".format("NR", "Name", "Count", "Time (" + TimeUnit + ")", "Avg"))
+
+            Rows = []
+            for Number, (Count, Time) in Syscalls.items():
+                PrevCount, PrevTime = PrevThread[2].get(Number, (None, None))
+                Count = Delta(Count, PrevCount)
+                Time = Delta(Time, PrevTime)
+                if Count:
+                    Rows.append((Number, Count, Time))
+
+            for Number, Count, Time in sorted(Rows, key = lambda Row: Row[2], reverse = True)[:Args.top]:
+                if Args.frequency:
+                    Time = Time / Args.frequency * 1e6
+                Lines.append("  {:>5} {:<24} {:>12} {:>16.1f} {:>12.1f}".format(Number, Names.get(Number, "?"), Count, Time, Time / Count))
+
+        if Args.once:
+            print("\n".join(Lines))
+            break
+
+        print("\033[2J\033[H" + "\n".join(Lines), flush = True)
+        Previous = Current
+        time.sleep(Args.interval)
+
+if __name__ == "__main__":
+    try:
+        Main()
+    except KeyboardInterrupt:
+        pass
@@ -15,11 +15,13 @@ logger.setLevel(logging.ERROR)
 class TestData:
     name: str
     expectedinstructioncount: int
+    expectedelidedtsoaccesses: int
     code: bytes
     instructions: list
-    def __init__(self, Name, ExpectedInstructionCount, Code, Instructions):
+    def __init__(self, Name, ExpectedInstructionCount, ExpectedElidedTSOAccesses, Code, Instructions):
         self.name = Name
         self.expectedinstructioncount = ExpectedInstructionCount
+        self.expectedelidedtsoaccesses = ExpectedElidedTSOAccesses
         self.code = Code
         self.instructions = Instructions
 
@@ -31,6 +33,10 @@ class TestData:
     def ExpectedInstructionCount(self):
         return self.expectedinstructioncount
 
+    @property
+    def ExpectedElidedTSOAccesses(self):
+        return self.expectedelidedtsoaccesses
+
     @property
     def Code(self):
         return self.code
@@ -120,10 +126,14 @@ def parse_json_data(json_filepath, json_filename, json_data, output_binary_path)
 
     for key, items in json_data["Instructions"].items():
         ExpectedInstructionCount = 0
+        ExpectedElidedTSOAccesses = -1
         Instructions = []
         if ("ExpectedInstructionCount" in items):
             ExpectedInstructionCount = int(items["ExpectedInstructionCount"])
 
+        if ("ExpectedElidedTSOAccesses" in items):
+            ExpectedElidedTSOAccesses = int(items["ExpectedElidedTSOAccesses"])
+
         if ("Skip" in items):
                 if items["Skip"].upper() == "YES":
                     continue
@@ -166,7 +176,7 @@ def parse_json_data(json_filepath, json_filename, json_data, output_binary_path)
         with open(tmp_asm_out, "rb") as tmp_asm_out_file:
             binary_hex = tmp_asm_out_file.read()
 
-        TestDataMap[TestName] = TestData(key, ExpectedInstructionCount, binary_hex, Instructions)
+        TestDataMap[TestName] = TestData(key, ExpectedInstructionCount, ExpectedElidedTSOAccesses, binary_hex, Instructions)
 
         os.remove(tmp_asm)
         os.remove(tmp_asm_out)
@@ -185,6 +195,7 @@ def parse_json_data(json_filepath, json_filename, json_data, output_binary_path)
         # struct TestInfo {
         #   char InstName[128];
         #   int64_t ExpectedInstructionCount;
+        #   int64_t ExpectedElidedTSOAccesses;
         #   uint64_t CodeSize;
         #   uint64_t x86InstCount;
         #   uint32_t Cookie;
@@ -211,6 +222,7 @@ def parse_json_data(json_filepath, json_filename, json_data, output_binary_path)
     for key, item in TestDataMap.items():
         MemData += struct.pack('128s', item.Name.encode("ascii"))
         MemData += struct.pack('q', item.ExpectedInstructionCount)
+        MemData += struct.pack('q', item.ExpectedElidedTSOAccesses)
         MemData += struct.pack('Q', len(item.Code))
         MemData += struct.pack('Q', len(item.Instructions))
         MemData += struct.pack('I', 0x41424344)
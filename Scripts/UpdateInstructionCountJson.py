@@ -21,6 +21,8 @@ def update_performance_numbers(performance_json_path, performance_json, new_json
 
         if "ExpectedInstructionCount" in items:
             performance_json["Instructions"][key]["ExpectedInstructionCount"] = items["ExpectedInstructionCount"]
+        if "ExpectedElidedTSOAccesses" in items:
+            performance_json["Instructions"][key]["ExpectedElidedTSOAccesses"] = items["ExpectedElidedTSOAccesses"]
         if "ExpectedArm64ASM" in items:
             performance_json["Instructions"][key]["ExpectedArm64ASM"] = items["ExpectedArm64ASM"]
         if "x86Insts" in performance_json["Instructions"][key]:
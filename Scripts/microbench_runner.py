@@ -0,0 +1,199 @@
+#!/usr/bin/python3
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import time
+
+# Runs the guest microbenchmarks in unittests/Microbenchmarks and reports guest instructions per second and host cycles
+# per guest instruction as JSON.
+#
+# Usage: microbench_runner.py --sources <dir> --binaries <dir> [--output <json>] [--baseline <json>] [--previous <json>]
+#                              [--update-baseline <json>] -- <TestHarnessRunner>...
+#
+# Guest instruction counts come from the "Benchmark" section of each kernel's CONFIG block, FEX doesn't count them at
+# runtime. Host cycles are gathered with `perf stat` when it is available, otherwise only timings get reported.
+# The reported numbers include FEX startup and JIT compilation, kernels are sized so that this is negligible.
+# Kernels with a "Unit" in their Benchmark section also get their iterations per second reported in that unit, eg: signals/s.
+#
+# Results are compared against --baseline when given. Otherwise they are compared against --previous if that exists, which
+# is the last run on the same machine.
+
+def ParseConfig(AsmFile):
+    with open(AsmFile) as File:
+        Text = File.read()
+
+    Sections = Text.split("%ifdef CONFIG")
+    if len(Sections) < 2:
+        return None
+
+    return json.loads(Sections[1].split("%endif")[0].strip())
+
+def FindKernels(SourceDir, Filter):
+    Kernels = []
+    for Root, _, Files in os.walk(SourceDir):
+        for Name in sorted(Files):
+            if not Name.endswith(".asm"):
+                continue
+
+            if Filter and Filter not in Name:
+                continue
+
+            AsmFile = os.path.join(Root, Name)
+            Config = ParseConfig(AsmFile)
+            if Config is None or "Benchmark" not in Config:
+                sys.exit("{} is missing a Benchmark section".format(AsmFile))
+
+            Bench = Config["Benchmark"]
+            Kernels.append({
+                "Name": os.path.relpath(AsmFile, SourceDir),
+                "Iterations": int(Bench["Iterations"], 0),
+                "GuestInstructions": int(Bench["Iterations"], 0) * int(Bench["InstructionsPerIteration"], 0),
+                "Unit": Bench.get("Unit"),
+            })
+    return Kernels
+
+def RunOnce(Command, UsePerf):
+    PerfOutput = None
+    if UsePerf:
+        PerfOutput = "/tmp/microbench_perf_{}.csv".format(os.getpid())
+        Command = ["perf", "stat", "-x", ",", "-e", "cycles", "-o", PerfOutput, "--"] + Command
+
+    # The harness only reports whether the kernel ran when logging is enabled.
+    Env = dict(os.environ, FEX_SILENTLOG="0")
+
+    Start = time.perf_counter()
+    Process = subprocess.run(Command, env=Env, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    Seconds = time.perf_counter() - Start
+
+    Cycles = None
+    if PerfOutput:
+        with open(PerfOutput) as File:
+            for Line in File:
+                Fields = Line.strip().split(",")
+                if len(Fields) > 2 and Fields[2].startswith("cycles") and Fields[0].isdigit():
+                    Cycles = int(Fields[0])
+        os.remove(PerfOutput)
+
+    # Kernels that need unsupported host features exit early without running
+    Ran = "Passed? Yes" in Process.stdout
+    return Process.returncode, Ran, Seconds, Cycles
+
+def RunKernel(Kernel, Args):
+    Binary = os.path.join(Args.binaries, Kernel["Name"] + ".bin")
+    Config = os.path.join(Args.binaries, Kernel["Name"] + ".config.bin")
+    Command = Args.harness + [Binary, Config]
+
+    Best = None
+    for _ in range(Args.repeat):
+        ReturnCode, Ran, Seconds, Cycles = RunOnce(Command, Args.perf)
+        if ReturnCode != 0:
+            return {"Error": "TestHarnessRunner returned {}".format(ReturnCode)}
+        if not Ran:
+            return {"Skipped": "Unsupported by the host"}
+
+        # The fastest run is the least disturbed one
+        if Best is None or Seconds < Best[0]:
+            Best = (Seconds, Cycles)
+
+    Seconds, Cycles = Best
+    Result = {
+        "GuestInstructions": Kernel["GuestInstructions"],
+        "Seconds": Seconds,
+        "GuestInstructionsPerSecond": Kernel["GuestInstructions"] / Seconds,
+        "HostCycles": Cycles,
+        "HostCyclesPerGuestInstruction": Cycles / Kernel["GuestInstructions"] if Cycles else None,
+    }
+
+    if Kernel["Unit"]:
+        Result["Unit"] = Kernel["Unit"]
+        Result["IterationsPerSecond"] = Kernel["Iterations"] / Seconds
+    return Result
+
+def LoadBaseline(Args):
+    if Args.baseline:
+        BaselineFile = Args.baseline
+    elif Args.previous and os.path.exists(Args.previous):
+        BaselineFile = Args.previous
+    else:
+        return None, None
+
+    with open(BaselineFile) as File:
+        return BaselineFile, json.load(File)
+
+def CompareToBaseline(Results, Baseline, Tolerance):
+
+    Regressions = []
+    for Name, Result in Results.items():
+        if Name not in Baseline or "GuestInstructionsPerSecond" not in Result:
+            continue
+
+        Expected = Baseline[Name]["GuestInstructionsPerSecond"]
+        Actual = Result["GuestInstructionsPerSecond"]
+        Result["BaselineRatio"] = Actual / Expected
+        if Actual < Expected * (1.0 - Tolerance):
+            Regressions.append("{}: {:.0f} guest instructions/s, baseline {:.0f} ({:+.1f}%)".format(
+                Name, Actual, Expected, (Actual / Expected - 1.0) * 100.0))
+    return Regressions
+
+def main():
+    Parser = argparse.ArgumentParser(description="Runs the FEX guest microbenchmarks")
+    Parser.add_argument("--sources", required=True, help="Directory containing the benchmark .asm files")
+    Parser.add_argument("--binaries", required=True, help="Directory containing the assembled benchmarks")
+    Parser.add_argument("--output", help="JSON file to write the results to")
+    Parser.add_argument("--baseline", help="JSON results to compare against")
+    Parser.add_argument("--previous", help="JSON results of the previous run, compared against if no baseline is given")
+    Parser.add_argument("--update-baseline", help="JSON file to write the results of the kernels that ran to, as a new baseline")
+    Parser.add_argument("--tolerance", type=float, default=0.1, help="Allowed slowdown against the baseline (default 0.1)")
+    Parser.add_argument("--repeat", type=int, default=3, help="Runs per benchmark, the fastest one gets reported")
+    Parser.add_argument("--filter", help="Only run benchmarks whose file name contains this string")
+    Parser.add_argument("harness", nargs="+", help="TestHarnessRunner command line")
+    Args = Parser.parse_args()
+
+    Args.perf = shutil.which("perf") is not None
+
+    # Read before running, --previous and --output are usually the same file.
+    BaselineFile, Baseline = LoadBaseline(Args)
+
+    Results = {}
+    for Kernel in FindKernels(Args.sources, Args.filter):
+        Result = RunKernel(Kernel, Args)
+        Results[Kernel["Name"]] = Result
+
+        if "GuestInstructionsPerSecond" not in Result:
+            print("{:<24} {}".format(Kernel["Name"], Result.get("Error") or Result.get("Skipped")))
+            continue
+
+        CPI = Result["HostCyclesPerGuestInstruction"]
+        print("{:<24} {:>14.0f} guest instructions/s {:>10} host cycles/guest instruction".format(
+            Kernel["Name"], Result["GuestInstructionsPerSecond"], "{:.2f}".format(CPI) if CPI else "n/a"))
+        if "Unit" in Result:
+            print("{:<24} {:>14.0f} {}/s".format("", Result["IterationsPerSecond"], Result["Unit"]))
+
+    Regressions = []
+    if Baseline is not None:
+        print("Comparing against " + BaselineFile)
+        Regressions = CompareToBaseline(Results, Baseline, Args.tolerance)
+
+    if Args.output:
+        with open(Args.output, "w") as File:
+            json.dump(Results, File, indent=2, sort_keys=True)
+
+    if Args.update_baseline:
+        NewBaseline = {Name: Result for Name, Result in Results.items() if "GuestInstructionsPerSecond" in Result}
+        for Result in NewBaseline.values():
+            Result.pop("BaselineRatio", None)
+        with open(Args.update_baseline, "w") as File:
+            json.dump(NewBaseline, File, indent=2, sort_keys=True)
+            File.write("\n")
+
+    for Regression in Regressions:
+        print("Regression: " + Regression)
+
+    if Regressions or any("Error" in Result for Result in Results.values()):
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
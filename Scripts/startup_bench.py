@@ -0,0 +1,91 @@
+#!/usr/bin/python3
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+# Measures FEX cold-start latency by running a short-lived guest many times.
+#
+# Usage: startup_bench.py [--runs <N>] [--output <json>] -- FEXInterpreter /bin/true
+#
+# Every run gets the StartupTrace config pointed at a temporary file, the timeline that FEX writes in to it uses the
+# same CLOCK_MONOTONIC timebase as the spawn timestamp taken here. So every phase is reported relative to the moment
+# the process was spawned, which includes the host exec and dynamic linking of FEX itself.
+# Time-to-first-instruction is the GuestEntry phase, time-to-exit is when the process was reaped.
+
+def Percentile(Values, Percent):
+    Values = sorted(Values)
+    Index = min(len(Values) - 1, int(round(Percent / 100.0 * (len(Values) - 1))))
+    return Values[Index]
+
+def ReadTrace(TraceFile, PID):
+    Phases = None
+    with open(TraceFile) as File:
+        for Line in File:
+            Entry = json.loads(Line)
+            # The last line wins if the process wrote one on a failed execve as well.
+            if Entry["PID"] == PID:
+                Phases = Entry["Phases"]
+    return Phases
+
+def RunOnce(Command, TraceFile):
+    Env = dict(os.environ, FEX_STARTUPTRACE=TraceFile)
+
+    Start = time.monotonic_ns()
+    Process = subprocess.Popen(Command, env=Env, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    Process.wait()
+    End = time.monotonic_ns()
+
+    if Process.returncode != 0:
+        sys.exit("{} returned {}".format(" ".join(Command), Process.returncode))
+
+    Phases = ReadTrace(TraceFile, Process.pid)
+    if Phases is None:
+        sys.exit("No startup trace was written, is the StartupTrace config supported by this FEX build?")
+
+    Result = {Name: Timestamp - Start for Name, Timestamp in Phases.items()}
+    Result["Reaped"] = End - Start
+    return Result
+
+def main():
+    Parser = argparse.ArgumentParser(description="Measures FEX startup latency")
+    Parser.add_argument("--runs", type=int, default=50, help="Number of guest processes to start (default 50)")
+    Parser.add_argument("--warmup", type=int, default=3, help="Runs to discard to warm up the page cache and FEXServer (default 3)")
+    Parser.add_argument("--output", help="JSON file to write the percentiles to")
+    Parser.add_argument("command", nargs="+", help="FEX command line to run, eg. FEXInterpreter /bin/true")
+    Args = Parser.parse_args()
+
+    Samples = {}
+    with tempfile.TemporaryDirectory() as Dir:
+        TraceFile = os.path.join(Dir, "startup.jsonl")
+        for Run in range(Args.warmup + Args.runs):
+            Result = RunOnce(Args.command, TraceFile)
+            if Run < Args.warmup:
+                continue
+
+            for Name, Nanoseconds in Result.items():
+                Samples.setdefault(Name, []).append(Nanoseconds)
+
+    # Order phases by when they usually happen
+    Order = sorted(Samples, key=lambda Name: Percentile(Samples[Name], 50))
+    Results = {}
+    print("{:<20} {:>10} {:>10} {:>8}".format("Phase", "p50 (ms)", "p99 (ms)", "Runs"))
+    for Name in Order:
+        P50 = Percentile(Samples[Name], 50) / 1e6
+        P99 = Percentile(Samples[Name], 99) / 1e6
+        Results[Name] = {"p50_ms": P50, "p99_ms": P99, "Runs": len(Samples[Name])}
+        print("{:<20} {:>10.2f} {:>10.2f} {:>8}".format(Name, P50, P99, len(Samples[Name])))
+
+    for Label, Name in (("Time to first instruction", "GuestEntry"), ("Time to exit", "Reaped")):
+        if Name in Results:
+            print("{}: p50 {:.2f}ms p99 {:.2f}ms".format(Label, Results[Name]["p50_ms"], Results[Name]["p99_ms"]))
+
+    if Args.output:
+        with open(Args.output, "w") as File:
+            json.dump(Results, File, indent=2, sort_keys=True)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,92 @@
+#!/usr/bin/python3
+# Compares `openssl speed` throughput of the emulated guest libcrypto against the FEX OpenSSL provider, which runs
+# digests and ciphers in the host libcrypto.
+#
+# Usage: thunk_openssl_speed.py <FEX> <GuestThunks directory> [algorithm...]
+import os
+import subprocess
+import sys
+import tempfile
+
+DefaultAlgorithms = ["aes-128-gcm", "aes-256-gcm", "aes-128-ctr", "sha1", "sha256", "sha512"]
+BlockSizes = ["16", "1024", "16384"]
+Seconds = "3"
+
+ProviderConfig = """openssl_conf = openssl_init
+
+[openssl_init]
+providers = provider_sect
+alg_section = evp_properties
+
+[provider_sect]
+default = default_sect
+fex = fex_sect
+
+[default_sect]
+activate = 1
+
+[fex_sect]
+module = {Module}
+activate = 1
+
+[evp_properties]
+default_properties = ?provider=fex
+"""
+
+def Speed(FEX, Algorithm, Config):
+    Env = dict(os.environ)
+    if Config:
+        Env["OPENSSL_CONF"] = Config
+    else:
+        Env.pop("OPENSSL_CONF", None)
+
+    Args = [FEX, "/usr/bin/openssl", "speed", "-mr", "-elapsed", "-seconds", Seconds, "-evp", Algorithm]
+    Results = {}
+    for Size in BlockSizes:
+        Process = subprocess.run(Args + ["-bytes", Size], capture_output=True, text=True, env=Env)
+        if Process.returncode != 0:
+            sys.stderr.write(Process.stderr)
+            return None
+
+        # Machine readable results: +F:<index>:<algorithm>:<bytes per second>
+        for Line in Process.stdout.splitlines():
+            if Line.startswith("+F:"):
+                Results[Size] = float(Line.split(":")[3])
+    return Results
+
+def main():
+    if len(sys.argv) < 3:
+        print(f"Usage: {sys.argv[0]} <FEX> <GuestThunks directory> [algorithm...]")
+        return 1
+
+    FEX = sys.argv[1]
+    Module = os.path.join(sys.argv[2], "libcrypto-guest.so")
+    Algorithms = sys.argv[3:] or DefaultAlgorithms
+
+    if not os.path.exists(Module):
+        print(f"{Module} doesn't exist")
+        return 1
+
+    with tempfile.NamedTemporaryFile("w", suffix=".cnf") as Config:
+        Config.write(ProviderConfig.format(Module=Module))
+        Config.flush()
+
+        print(f"{'Algorithm':<14}{'Bytes':>8}{'Emulated MB/s':>16}{'Thunked MB/s':>16}{'Speedup':>10}")
+        for Algorithm in Algorithms:
+            Emulated = Speed(FEX, Algorithm, None)
+            Thunked = Speed(FEX, Algorithm, Config.name)
+            if Emulated is None or Thunked is None:
+                print(f"{Algorithm:<14} failed")
+                continue
+
+            for Size in BlockSizes:
+                if Size not in Emulated or Size not in Thunked:
+                    continue
+                E = Emulated[Size] / 1e6
+                T = Thunked[Size] / 1e6
+                print(f"{Algorithm:<14}{Size:>8}{E:>16.1f}{T:>16.1f}{T / E if E else 0:>9.2f}x")
+
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,52 @@
+#!/usr/bin/python3
+# Runs a guest command once fully emulated and once with thunked libraries, then checks that both produce the exact
+# same output for the same input.
+#
+# Usage: thunk_output_compare.py <FEX> <ThunksConfig> <InputFile> <Guest command> [args...]
+import os
+import subprocess
+import sys
+
+def Run(Args, InputPath, ThunksConfig):
+    Env = dict(os.environ)
+    Env.pop("FEX_THUNKCONFIG", None)
+    if ThunksConfig:
+        Env["FEX_THUNKCONFIG"] = ThunksConfig
+
+    with open(InputPath, "rb") as Input:
+        Process = subprocess.run(Args, stdin=Input, capture_output=True, env=Env)
+
+    if Process.returncode != 0:
+        sys.stderr.buffer.write(Process.stderr)
+        print(f"'{' '.join(Args)}' {'with' if ThunksConfig else 'without'} thunks exited with {Process.returncode}")
+        sys.exit(1)
+
+    return Process.stdout
+
+def main():
+    if len(sys.argv) < 5:
+        print(f"Usage: {sys.argv[0]} <FEX> <ThunksConfig> <InputFile> <Guest command> [args...]")
+        return 1
+
+    FEX = sys.argv[1]
+    ThunksConfig = sys.argv[2]
+    InputPath = sys.argv[3]
+    Args = [FEX] + sys.argv[4:]
+
+    Emulated = Run(Args, InputPath, None)
+    Thunked = Run(Args, InputPath, ThunksConfig)
+
+    if len(Emulated) == 0:
+        print("Guest command didn't produce any output")
+        return 1
+
+    if Emulated != Thunked:
+        Mismatch = next((i for i, (a, b) in enumerate(zip(Emulated, Thunked)) if a != b), min(len(Emulated), len(Thunked)))
+        print(f"Output mismatch at byte {Mismatch}: {len(Emulated)} bytes emulated, {len(Thunked)} bytes thunked")
+        return 1
+
+    print(f"{len(Emulated)} bytes match")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -408,6 +408,50 @@ int RequestCodeMapFD(int ServerSocket, int ProgramFD, bool HasMultiblock) {
   return NewFD;
 }
 
+int RequestZygote(int ServerSocket, int32_t* PID) {
+  fasio::tcp_socket Socket {ServerSocket};
+  FEXServerRequestPacket Req {
+    .Header {
+      .Type = PacketType::TYPE_CLAIM_ZYGOTE,
+    },
+  };
+
+  // Send request
+  fasio::error ec;
+  write(Socket, fasio::mutable_buffer {std::as_writable_bytes(std::span {&Req, 1})}, ec);
+  if (ec != fasio::error::success) {
+    return -1;
+  }
+
+  // Wait for the zygote's PID and socket, an error packet without an FD means none were idle
+  FEXServerResultPacket Res {};
+  fasio::mutable_buffer ResBuffer {std::as_writable_bytes(std::span {&Res, 1})};
+  int NewFD = -1;
+  ResBuffer.FD = &NewFD;
+  auto BytesRead = Socket.read_some(ResBuffer, ec);
+  if (ec != fasio::error::success || BytesRead != sizeof(Res) || Res.Header.Type != PacketType::TYPE_SUCCESS) {
+    if (NewFD != -1) {
+      close(NewFD);
+    }
+    return -1;
+  }
+
+  *PID = Res.PID.PID;
+  return NewFD;
+}
+
+std::optional<int> WaitForZygoteExit(int ServerSocket) {
+  fasio::tcp_socket Socket {ServerSocket};
+  FEXServerResultPacket Res {};
+  fasio::error ec;
+  read(Socket, fasio::mutable_buffer {std::as_writable_bytes(std::span {&Res, 1})}, ec);
+  if (ec != fasio::error::success || Res.Header.Type != PacketType::TYPE_ZYGOTE_EXIT) {
+    return std::nullopt;
+  }
+
+  return Res.ZygoteExit.Status;
+}
+
 /**  @} */
 
 /**
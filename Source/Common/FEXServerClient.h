@@ -1,11 +1,14 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include "Common/ProcessIdentity.h"
+
 #include <FEXCore/fextl/string.h>
 
 #include <cstddef>
 #include <cstdint>
 #include <ctime>
+#include <optional>
 #include <string_view>
 
 namespace LogMan {
@@ -21,10 +24,12 @@ enum class PacketType {
   TYPE_GET_PID_FD,
   TYPE_QUERY_CODE_MAP,
   TYPE_QUERY_CODE_MAP_NO_MULTIBLOCK,
+  TYPE_CLAIM_ZYGOTE,
 
   // Result only
   TYPE_SUCCESS,
   TYPE_ERROR,
+  TYPE_ZYGOTE_EXIT,
 };
 
 union FEXServerRequestPacket {
@@ -52,6 +57,21 @@ union FEXServerResultPacket {
     size_t Length;
     char Mount[0];
   } MountPath;
+
+  struct {
+    struct Header Header;
+    // Status as returned by waitpid
+    int32_t Status;
+  } ZygoteExit;
+};
+
+// Sent by FEXServer to a zygote before the process that claimed it gets the zygote's socket.
+// FEXServer fills it from the peer credentials of the process' connection and /proc, so none of it comes from the process itself.
+struct ZygoteClient {
+  FEX::ProcessIdentity Identity;
+  int32_t PID;
+  int32_t Session;
+  int32_t ProcessGroup;
 };
 
 constexpr size_t MAXIMUM_REQUEST_PACKET_SIZE = sizeof(FEXServerRequestPacket);
@@ -125,6 +145,27 @@ int RequestPIDFD(int ServerSocket);
  */
 int RequestCodeMapFD(int ServerSocket, int ProgramFD, bool HasMultiblock);
 
+/**
+ * @brief Request FEXServer to hand over one of its pre-initialized FEXInterpreter zygotes
+ *
+ * FEXServer reports the exit status of the zygote on the same socket once it exits.
+ *
+ * @param ServerSocket - Socket to the server
+ * @param PID - Receives the PID of the zygote
+ *
+ * @return Socket FD connected to the zygote, -1 if no zygote was idle
+ */
+int RequestZygote(int ServerSocket, int32_t* PID);
+
+/**
+ * @brief Wait for FEXServer to report the exit of a zygote claimed with RequestZygote
+ *
+ * @param ServerSocket - Socket to the server
+ *
+ * @return The waitpid status of the zygote, std::nullopt if the connection to FEXServer was lost
+ */
+std::optional<int> WaitForZygoteExit(int ServerSocket);
+
 /**  @} */
 
 /**
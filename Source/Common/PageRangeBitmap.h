@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace FEX {
+
+/**
+ * @brief Tracks which pages of a fixed range are used, with range updates and free range searches in both directions.
+ *
+ * Pages are stored as a bit per page in 64-page words.
+ * A summary level keeps a bit per word for whether that word is completely used and whether it is completely free,
+ * so searches only look at the individual words where used and free pages meet.
+ *
+ * Pages outside of [0, NumPages) are never free.
+ */
+template<size_t NumPages>
+class PageRangeBitmap final {
+public:
+  PageRangeBitmap() {
+    Empty.fill(~0ULL);
+  }
+
+  bool Test(uint64_t Page) const {
+    return Page >= NumPages || (Pages[Page / WORD_BITS] >> (Page % WORD_BITS)) & 1;
+  }
+
+  void Set(uint64_t Page, uint64_t Count) {
+    Update<true>(Page, Count);
+  }
+
+  void Clear(uint64_t Page, uint64_t Count) {
+    Update<false>(Page, Count);
+  }
+
+  bool IsFree(uint64_t Page, uint64_t Count) const {
+    if (Page > NumPages || Count > NumPages - Page) {
+      return false;
+    }
+    return !FindNext<true>(Page, Page + Count);
+  }
+
+  /**
+   * @brief Finds the lowest range of Count free pages in [Begin, End)
+   *
+   * @return The first page of the range
+   */
+  std::optional<uint64_t> FindFirstFree(uint64_t Begin, uint64_t End, uint64_t Count) const {
+    End = std::min<uint64_t>(End, NumPages);
+    if (!Count) {
+      return std::nullopt;
+    }
+
+    uint64_t Candidate = Begin;
+    while (Candidate < End && Count <= End - Candidate) {
+      auto Free = Count >= LARGE_RANGE ? FindFirstLargeCandidate(Candidate, End) : FindNext<false>(Candidate, End - Count + 1);
+      if (!Free || Count > End - *Free) {
+        return std::nullopt;
+      }
+
+      // The range only fits if the next used page is at least Count pages away.
+      auto Used = FindNext<true>(*Free, *Free + Count);
+      if (!Used) {
+        return Free;
+      }
+      Candidate = *Used + 1;
+    }
+
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Finds the highest range of Count free pages in [Begin, End)
+   *
+   * @return The first page of the range
+   */
+  std::optional<uint64_t> FindLastFree(uint64_t Begin, uint64_t End, uint64_t Count) const {
+    End = std::min<uint64_t>(End, NumPages);
+    if (!Count) {
+      return std::nullopt;
+    }
+
+    uint64_t CandidateEnd = End;
+    while (CandidateEnd > Begin && Count <= CandidateEnd - Begin) {
+      auto Free = Count >= LARGE_RANGE ? FindLastLargeCandidate(Begin, CandidateEnd) : FindPrev<false>(Begin + Count - 1, CandidateEnd);
+      if (!Free || *Free + 1 - Begin < Count) {
+        return std::nullopt;
+      }
+
+      // The range only fits if the previous used page is at least Count pages away.
+      CandidateEnd = *Free + 1;
+      auto Used = FindPrev<true>(CandidateEnd - Count, CandidateEnd);
+      if (!Used) {
+        return CandidateEnd - Count;
+      }
+      CandidateEnd = *Used;
+    }
+
+    return std::nullopt;
+  }
+
+private:
+  constexpr static size_t WORD_BITS = 64;
+  constexpr static size_t NUM_WORDS = NumPages / WORD_BITS;
+  constexpr static size_t NUM_SUMMARY_WORDS = NUM_WORDS / WORD_BITS;
+  static_assert(NumPages && NumPages % (WORD_BITS * WORD_BITS) == 0, "Needs to be a multiple of the summary granularity");
+  // Any free range at least this long covers a completely free word.
+  constexpr static size_t LARGE_RANGE = WORD_BITS * 2 - 1;
+
+  // Bit set for every used page.
+  std::array<uint64_t, NUM_WORDS> Pages {};
+  // Bit set for every word in Pages that has all pages used.
+  std::array<uint64_t, NUM_SUMMARY_WORDS> Full {};
+  // Bit set for every word in Pages that has all pages free.
+  std::array<uint64_t, NUM_SUMMARY_WORDS> Empty {};
+
+  template<bool Used>
+  void Update(uint64_t Page, uint64_t Count) {
+    const uint64_t End = Page < NumPages ? Page + std::min<uint64_t>(Count, NumPages - Page) : Page;
+    while (Page < End) {
+      const uint64_t Word = Page / WORD_BITS;
+      const uint64_t Bit = Page % WORD_BITS;
+      const uint64_t Bits = std::min<uint64_t>(WORD_BITS - Bit, End - Page);
+      const uint64_t Mask = (Bits == WORD_BITS ? ~0ULL : ((1ULL << Bits) - 1)) << Bit;
+
+      if constexpr (Used) {
+        Pages[Word] |= Mask;
+      } else {
+        Pages[Word] &= ~Mask;
+      }
+
+      const uint64_t SummaryBit = 1ULL << (Word % WORD_BITS);
+      Full[Word / WORD_BITS] = Pages[Word] == ~0ULL ? Full[Word / WORD_BITS] | SummaryBit : Full[Word / WORD_BITS] & ~SummaryBit;
+      Empty[Word / WORD_BITS] = Pages[Word] == 0 ? Empty[Word / WORD_BITS] | SummaryBit : Empty[Word / WORD_BITS] & ~SummaryBit;
+
+      Page += Bits;
+    }
+  }
+
+  // Bits of the pages in a word that are used or free.
+  template<bool Used>
+  uint64_t Matching(uint64_t Word) const {
+    return Used ? Pages[Word] : ~Pages[Word];
+  }
+
+  // Bits of the words in a summary word that have at least one used or free page.
+  template<bool Used>
+  uint64_t MatchingWords(uint64_t SummaryWord) const {
+    return Used ? ~Empty[SummaryWord] : ~Full[SummaryWord];
+  }
+
+  // Lowest completely free word in [BeginWord, EndWord).
+  std::optional<uint64_t> FindNextEmptyWord(uint64_t BeginWord, uint64_t EndWord) const {
+    if (BeginWord >= EndWord) {
+      return std::nullopt;
+    }
+
+    uint64_t SummaryWord = BeginWord / WORD_BITS;
+    uint64_t WordBits = Empty[SummaryWord] & (~0ULL << (BeginWord % WORD_BITS));
+    while (!WordBits) {
+      if (++SummaryWord >= NUM_SUMMARY_WORDS || SummaryWord * WORD_BITS >= EndWord) {
+        return std::nullopt;
+      }
+      WordBits = Empty[SummaryWord];
+    }
+
+    const uint64_t Word = SummaryWord * WORD_BITS + std::countr_zero(WordBits);
+    if (Word >= EndWord) {
+      return std::nullopt;
+    }
+    return Word;
+  }
+
+  // Highest completely free word in [BeginWord, EndWord).
+  std::optional<uint64_t> FindPrevEmptyWord(uint64_t BeginWord, uint64_t EndWord) const {
+    if (BeginWord >= EndWord) {
+      return std::nullopt;
+    }
+
+    const uint64_t LastWord = EndWord - 1;
+    uint64_t SummaryWord = LastWord / WORD_BITS;
+    uint64_t WordBits = Empty[SummaryWord] & (~0ULL >> (WORD_BITS - 1 - LastWord % WORD_BITS));
+    while (!WordBits) {
+      if (SummaryWord == 0 || SummaryWord * WORD_BITS <= BeginWord) {
+        return std::nullopt;
+      }
+      WordBits = Empty[--SummaryWord];
+    }
+
+    const uint64_t Word = SummaryWord * WORD_BITS + (WORD_BITS - 1 - std::countl_zero(WordBits));
+    if (Word < BeginWord) {
+      return std::nullopt;
+    }
+    return Word;
+  }
+
+  // First page of the lowest free run in [Begin, End) that covers a completely free word.
+  // Shorter runs can't fit a large range, this skips over them through the summary.
+  std::optional<uint64_t> FindFirstLargeCandidate(uint64_t Begin, uint64_t End) const {
+    auto Word = FindNextEmptyWord((Begin + WORD_BITS - 1) / WORD_BITS, End / WORD_BITS);
+    if (!Word) {
+      return std::nullopt;
+    }
+
+    auto Used = FindPrev<true>(Begin, *Word * WORD_BITS);
+    return Used ? *Used + 1 : Begin;
+  }
+
+  // Last page of the highest free run in [Begin, End) that covers a completely free word.
+  std::optional<uint64_t> FindLastLargeCandidate(uint64_t Begin, uint64_t End) const {
+    auto Word = FindPrevEmptyWord((Begin + WORD_BITS - 1) / WORD_BITS, End / WORD_BITS);
+    if (!Word) {
+      return std::nullopt;
+    }
+
+    auto Used = FindNext<true>((*Word + 1) * WORD_BITS, End);
+    return (Used ? *Used : End) - 1;
+  }
+
+  // Lowest used or free page in [Begin, End).
+  template<bool Used>
+  std::optional<uint64_t> FindNext(uint64_t Begin, uint64_t End) const {
+    if (Begin >= End) {
+      return std::nullopt;
+    }
+
+    uint64_t Word = Begin / WORD_BITS;
+    uint64_t Bits = Matching<Used>(Word) & (~0ULL << (Begin % WORD_BITS));
+    if (!Bits) {
+      // Skip over the words that have no matching pages.
+      ++Word;
+      uint64_t SummaryWord = Word / WORD_BITS;
+      if (SummaryWord >= NUM_SUMMARY_WORDS) {
+        return std::nullopt;
+      }
+
+      uint64_t WordBits = MatchingWords<Used>(SummaryWord) & (~0ULL << (Word % WORD_BITS));
+      while (!WordBits) {
+        if (++SummaryWord >= NUM_SUMMARY_WORDS || SummaryWord * WORD_BITS * WORD_BITS >= End) {
+          return std::nullopt;
+        }
+        WordBits = MatchingWords<Used>(SummaryWord);
+      }
+
+      Word = SummaryWord * WORD_BITS + std::countr_zero(WordBits);
+      Bits = Matching<Used>(Word);
+    }
+
+    const uint64_t Page = Word * WORD_BITS + std::countr_zero(Bits);
+    if (Page >= End) {
+      return std::nullopt;
+    }
+    return Page;
+  }
+
+  // Highest used or free page in [Begin, End).
+  template<bool Used>
+  std::optional<uint64_t> FindPrev(uint64_t Begin, uint64_t End) const {
+    if (Begin >= End) {
+      return std::nullopt;
+    }
+
+    const uint64_t Last = End - 1;
+    uint64_t Word = Last / WORD_BITS;
+    uint64_t Bits = Matching<Used>(Word) & (~0ULL >> (WORD_BITS - 1 - Last % WORD_BITS));
+    if (!Bits) {
+      // Skip over the words that have no matching pages.
+      if (Word == 0) {
+        return std::nullopt;
+      }
+      --Word;
+      uint64_t SummaryWord = Word / WORD_BITS;
+      uint64_t WordBits = MatchingWords<Used>(SummaryWord) & (~0ULL >> (WORD_BITS - 1 - Word % WORD_BITS));
+      while (!WordBits) {
+        if (SummaryWord == 0 || SummaryWord * WORD_BITS * WORD_BITS <= Begin) {
+          return std::nullopt;
+        }
+        WordBits = MatchingWords<Used>(--SummaryWord);
+      }
+
+      Word = SummaryWord * WORD_BITS + (WORD_BITS - 1 - std::countl_zero(WordBits));
+      Bits = Matching<Used>(Word);
+    }
+
+    const uint64_t Page = Word * WORD_BITS + (WORD_BITS - 1 - std::countl_zero(Bits));
+    if (Page < Begin) {
+      return std::nullopt;
+    }
+    return Page;
+  }
+};
+} // namespace FEX
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: MIT
+#include "Common/ProcessIdentity.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <fcntl.h>
+#include <span>
+#include <string_view>
+#include <sys/stat.h>
+#include <tuple>
+#include <unistd.h>
+
+namespace FEX {
+namespace {
+  // Reads a whole file from procfs.
+  // Returns the size, or -1 if it couldn't be read or doesn't fit.
+  ssize_t ReadProcFile(int ProcFD, const char* Path, std::span<char> Buffer) {
+    int FD = openat(ProcFD, Path, O_RDONLY | O_CLOEXEC);
+    if (FD == -1) {
+      return -1;
+    }
+
+    size_t Size {};
+    while (Size < Buffer.size()) {
+      auto Read = ::read(FD, Buffer.data() + Size, Buffer.size() - Size);
+      if (Read == -1 && errno == EINTR) {
+        continue;
+      }
+      if (Read <= 0) {
+        close(FD);
+        return Read == 0 ? Size : -1;
+      }
+      Size += Read;
+    }
+
+    close(FD);
+    return -1;
+  }
+
+  // Parses the whitespace separated values of a line in /proc/<pid>/status.
+  // Returns the number of values, or -1 if the line is missing or has more values than fit.
+  template<typename T>
+  int ParseStatusLine(std::string_view Status, std::string_view Name, std::span<T> Values, int Base = 10) {
+    auto Offset = Status.find(Name);
+    if (Offset == Status.npos) {
+      return -1;
+    }
+
+    auto Line = Status.substr(Offset + Name.size());
+    Line = Line.substr(0, Line.find('\n'));
+
+    int Count {};
+    while (true) {
+      const auto Start = Line.find_first_not_of(" \t");
+      if (Start == Line.npos) {
+        return Count;
+      }
+      Line.remove_prefix(Start);
+
+      if (static_cast<size_t>(Count) == Values.size()) {
+        return -1;
+      }
+      auto [End, ec] = std::from_chars(Line.data(), Line.data() + Line.size(), Values[Count], Base);
+      if (ec != std::errc {}) {
+        return -1;
+      }
+      Line.remove_prefix(End - Line.data());
+      ++Count;
+    }
+  }
+
+  bool ReadStatus(int ProcFD, ProcessIdentity* Identity) {
+    char Buffer[8192];
+    auto Size = ReadProcFile(ProcFD, "status", Buffer);
+    if (Size == -1) {
+      return false;
+    }
+    std::string_view Status {Buffer, static_cast<size_t>(Size)};
+
+    std::array<uint32_t, 4> IDs;
+    if (ParseStatusLine<uint32_t>(Status, "\nUid:", IDs) != 4) {
+      return false;
+    }
+    Identity->UID = IDs[0];
+    Identity->EUID = IDs[1];
+    Identity->SUID = IDs[2];
+    Identity->FSUID = IDs[3];
+    if (ParseStatusLine<uint32_t>(Status, "\nGid:", IDs) != 4) {
+      return false;
+    }
+    Identity->GID = IDs[0];
+    Identity->EGID = IDs[1];
+    Identity->SGID = IDs[2];
+    Identity->FSGID = IDs[3];
+
+    const int GroupCount = ParseStatusLine<uint32_t>(Status, "\nGroups:", Identity->Groups);
+    if (GroupCount == -1) {
+      return false;
+    }
+    Identity->GroupCount = GroupCount;
+    std::sort(Identity->Groups.begin(), Identity->Groups.begin() + GroupCount);
+
+    constexpr std::array<std::string_view, 5> Names {"\nCapInh:", "\nCapPrm:", "\nCapEff:", "\nCapBnd:", "\nCapAmb:"};
+    for (size_t i = 0; i < Names.size(); ++i) {
+      if (ParseStatusLine(Status, Names[i], std::span {&Identity->Capabilities[i], 1}, 16) != 1) {
+        return false;
+      }
+    }
+
+    // Both are missing on kernels that don't support them, which reads the same as not being set.
+    ParseStatusLine(Status, "\nNoNewPrivs:", std::span {&Identity->NoNewPrivs, 1});
+    ParseStatusLine(Status, "\nSeccomp:", std::span {&Identity->Seccomp, 1});
+    return true;
+  }
+} // namespace
+
+bool ReadProcessIdentity(int ProcFD, ProcessIdentity* Identity) {
+  *Identity = {};
+  if (!ReadStatus(ProcFD, Identity)) {
+    return false;
+  }
+
+  // Namespaces that the kernel doesn't support stay at 0 on both sides.
+  constexpr std::array<const char*, 8> Namespaces {"ns/cgroup", "ns/ipc", "ns/mnt", "ns/net", "ns/pid", "ns/time", "ns/user", "ns/uts"};
+  static_assert(Namespaces.size() == std::tuple_size_v<decltype(Identity->Namespaces)>);
+  struct stat Stat {};
+  for (size_t i = 0; i < Namespaces.size(); ++i) {
+    if (fstatat(ProcFD, Namespaces[i], &Stat, 0) == 0) {
+      Identity->Namespaces[i] = Stat.st_ino;
+    }
+  }
+  if (fstatat(ProcFD, "root", &Stat, 0) != 0) {
+    return false;
+  }
+  Identity->RootDev = Stat.st_dev;
+  Identity->RootIno = Stat.st_ino;
+
+  // Leave room for the null terminator so truncated contents can't compare equal.
+  if (ReadProcFile(ProcFD, "cgroup", std::span {Identity->CGroups}.first(Identity->CGroups.size() - 1)) == -1) {
+    return false;
+  }
+  // Without an LSM the label can't be read, which is the same for both sides.
+  ReadProcFile(ProcFD, "attr/current", std::span {Identity->SecurityLabel}.first(Identity->SecurityLabel.size() - 1));
+  return true;
+}
+} // namespace FEX
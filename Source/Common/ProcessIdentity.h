@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: Common|Zygote
+desc: Reads what decides the privileges and view of a process from procfs
+$end_info$
+*/
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace FEX {
+// Maximum number of supplementary groups of a process that can use a zygote.
+constexpr size_t MAX_IDENTITY_GROUPS = 64;
+
+/**
+ * @brief Everything that decides what a process is allowed to do and what it can see.
+ *
+ * The program runs with the zygote's credentials, namespaces and sandboxing, so the zygote only takes over processes
+ * where all of it matches.
+ * Only contains what can be read from /proc/<pid>, so FEXServer can fill it for its peer without trusting anything the peer sends.
+ * Securebits can't be read from outside of a process and aren't part of it.
+ */
+struct ProcessIdentity {
+  uint32_t UID, EUID, SUID, FSUID;
+  uint32_t GID, EGID, SGID, FSGID;
+  uint32_t GroupCount;
+  // Sorted supplementary groups.
+  std::array<uint32_t, MAX_IDENTITY_GROUPS> Groups;
+  // Inheritable, permitted, effective, bounding and ambient sets.
+  std::array<uint64_t, 5> Capabilities;
+  uint32_t NoNewPrivs;
+  uint32_t Seccomp;
+  // Inode of every entry in /proc/<pid>/ns.
+  std::array<uint64_t, 8> Namespaces;
+  uint64_t RootDev;
+  uint64_t RootIno;
+  // Contents of /proc/<pid>/cgroup and the LSM label from /proc/<pid>/attr/current.
+  std::array<char, 1024> CGroups;
+  std::array<char, 256> SecurityLabel;
+
+  bool operator==(const ProcessIdentity&) const = default;
+};
+
+/**
+ * @brief Fills the identity of the process that a /proc/<pid> directory belongs to.
+ *
+ * Doesn't go through the allocator.
+ *
+ * @param ProcFD Directory FD of /proc/<pid> or /proc/self
+ *
+ * @return false if it couldn't be read or the process has state that doesn't fit in to ProcessIdentity
+ */
+bool ReadProcessIdentity(int ProcFD, ProcessIdentity* Identity);
+} // namespace FEX
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: MIT
+#include "Common/StartupTrace.h"
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/string.h>
+
+#include <fcntl.h>
+#include <iterator>
+#include <string_view>
+#include <time.h>
+#include <unistd.h>
+
+namespace FEX::StartupTrace {
+std::atomic<uint64_t> Timestamps[static_cast<size_t>(Phase::Count)];
+
+namespace {
+  pid_t TracedPID {};
+  // Differs from TracedPID in zygotes.
+  pid_t ReportedPID {};
+  // Only one line is written per process, an execve that fails after writing its line doesn't get a second one on exit.
+  std::atomic<bool> Written {};
+
+  constexpr const char* PhaseNames[] = {
+    "Main",       "ConfigLoaded",    "ServerConnected", "RootFSMounted", "ELFLoaded",    "ContextCreated", "ThunkDatabaseLoaded",
+    "VDSOLoaded", "ELFMapped",       "CoreInitialized", "GuestEntry",    "FirstSyscall", "Execve",         "Exit",
+  };
+  static_assert(std::size(PhaseNames) == static_cast<size_t>(Phase::Count));
+
+  uint64_t GetTimestamp() {
+    struct timespec Time {};
+    clock_gettime(CLOCK_MONOTONIC, &Time);
+    return Time.tv_sec * 1'000'000'000ULL + Time.tv_nsec;
+  }
+
+  void AppendJSONString(fextl::string& Data, std::string_view String) {
+    Data += '"';
+    for (const char c : String) {
+      if (c == '"' || c == '\\') {
+        Data += '\\';
+        Data += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        Data += fextl::fmt::format("\\u{:04x}", static_cast<unsigned char>(c));
+      } else {
+        Data += c;
+      }
+    }
+    Data += '"';
+  }
+} // namespace
+
+void Record(Phase Phase) {
+  // Only the first thread to reach a phase records it.
+  uint64_t Expected {};
+  Timestamps[static_cast<size_t>(Phase)].compare_exchange_strong(Expected, GetTimestamp(), std::memory_order_relaxed);
+}
+
+void Initialize() {
+  TracedPID = ::getpid();
+  ReportedPID = TracedPID;
+  Written.store(false, std::memory_order_relaxed);
+  Record(Phase::Main);
+}
+
+void ContinueFrom(int32_t PID, uint64_t MainTimestamp) {
+  TracedPID = ::getpid();
+  ReportedPID = PID;
+  Written.store(false, std::memory_order_relaxed);
+  for (auto& Timestamp : Timestamps) {
+    Timestamp.store(0, std::memory_order_relaxed);
+  }
+  Timestamps[static_cast<size_t>(Phase::Main)].store(MainTimestamp, std::memory_order_relaxed);
+}
+
+void Write(Phase FinalPhase) {
+  if (TracedPID != ::getpid()) {
+    return;
+  }
+
+  FEX_CONFIG_OPT(StartupTrace, STARTUPTRACE);
+  if (StartupTrace().empty()) {
+    return;
+  }
+
+  if (Written.exchange(true, std::memory_order_relaxed)) {
+    return;
+  }
+
+  Record(FinalPhase);
+
+  FEX_CONFIG_OPT(AppConfigName, APP_CONFIG_NAME);
+  fextl::string Data = fextl::fmt::format("{{\"PID\": {}, \"Application\": ", ReportedPID);
+  AppendJSONString(Data, AppConfigName());
+  Data += ", \"Phases\": {";
+  bool First = true;
+  for (size_t i = 0; i < static_cast<size_t>(Phase::Count); ++i) {
+    const auto Timestamp = Timestamps[i].load(std::memory_order_relaxed);
+    if (Timestamp == 0) {
+      continue;
+    }
+
+    Data += fextl::fmt::format("{}\"{}\": {}", First ? "" : ", ", PhaseNames[i], Timestamp);
+    First = false;
+  }
+  Data += "}}\n";
+
+  // Appended so that every process of a process tree can share the same file.
+  // Lines are small enough that a single write doesn't interleave with other writers.
+  int FD = open(StartupTrace().c_str(), O_CREAT | O_WRONLY | O_APPEND | O_CLOEXEC, 0644);
+  if (FD == -1) {
+    LogMan::Msg::EFmt("Startup trace: Couldn't open {}", StartupTrace());
+    return;
+  }
+
+  if (write(FD, Data.data(), Data.size()) != static_cast<ssize_t>(Data.size())) {
+    LogMan::Msg::EFmt("Startup trace: Couldn't write {}", StartupTrace());
+  }
+  close(FD);
+}
+} // namespace FEX::StartupTrace
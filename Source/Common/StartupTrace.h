@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: Common|StartupTrace
+desc: Records a timeline of process startup phases
+$end_info$
+*/
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace FEX::StartupTrace {
+// Startup phases in the order that they usually occur in.
+enum class Phase : uint8_t {
+  Main,
+  ConfigLoaded,
+  ServerConnected,
+  RootFSMounted,
+  ELFLoaded,
+  ContextCreated,
+  ThunkDatabaseLoaded,
+  VDSOLoaded,
+  ELFMapped,
+  CoreInitialized,
+  GuestEntry,
+  // First guest syscall, the first blocks have been compiled and executed by this point.
+  FirstSyscall,
+  Execve,
+  Exit,
+  Count,
+};
+
+// CLOCK_MONOTONIC nanoseconds of each phase, zero when the phase hasn't been reached.
+extern std::atomic<uint64_t> Timestamps[static_cast<size_t>(Phase::Count)];
+
+void Record(Phase Phase);
+
+/**
+ * @brief Starts the timeline of this process.
+ *
+ * Marks the `Main` phase, only the process that called this will write a trace.
+ */
+void Initialize();
+
+/**
+ * @brief Restarts the timeline in a zygote that took over the startup of another process.
+ *
+ * Phases that the zygote went through before the handoff are dropped, the trace is written as if it came from `PID`.
+ */
+void ContinueFrom(int32_t PID, uint64_t MainTimestamp);
+
+/**
+ * @brief Records the first occurrence of a phase.
+ *
+ * Cheap enough to be called from hot paths once the phase has been recorded.
+ */
+inline void Mark(Phase Phase) {
+  if (Timestamps[static_cast<size_t>(Phase)].load(std::memory_order_relaxed) == 0) [[unlikely]] {
+    Record(Phase);
+  }
+}
+
+/**
+ * @brief Appends the timeline as a JSON line to the file set by the `StartupTrace` config.
+ *
+ * Does nothing if the option isn't set, if the process is a fork of the one that was initialized, or if the process
+ * already wrote its line.
+ */
+void Write(Phase FinalPhase);
+} // namespace FEX::StartupTrace
@@ -34,6 +34,8 @@ public:
 
     uint64_t HeaderSize {};
     uint64_t TailSize {};
+
+    uint64_t ElidedTSOAccesses {};
   };
 
   using CodeLines = fextl::vector<fextl::string>;
@@ -95,6 +97,7 @@ constexpr std::string_view GuestCodeMessage = "Guest Code instructions: ";
 constexpr std::string_view DisassembleBeginMessage = "Disassemble Begin";
 constexpr std::string_view DisassembleEndMessage = "Disassemble End";
 constexpr std::string_view BlowUpMsg = "Blow-up Amt: ";
+constexpr std::string_view ElidedTSOMessage = "Elided TSO accesses: ";
 
 static std::string_view SanitizeDisassembly(std::string_view Message) {
   auto it = Message.find(" (addr");
@@ -146,6 +149,12 @@ bool CodeSizeValidation::ParseMessage(const char* Message) {
     return false;
   }
 
+  if (MessageView.find(ElidedTSOMessage) != MessageView.npos) {
+    std::string_view ElidedView = std::string_view {Message + ElidedTSOMessage.size()};
+    std::from_chars(ElidedView.data(), ElidedView.end(), CurrentStats.first.ElidedTSOAccesses);
+    return false;
+  }
+
   if (ConsumingDisassembly) {
     // Currently consuming disassembly. Each line will be a single line of disassembly.
     CurrentStats.second.push_back(fextl::string(SanitizeDisassembly(Message)));
@@ -216,6 +225,8 @@ void AssertHandler(const char* Message) {
 struct TestInfo {
   char TestInst[128];
   int64_t ExpectedInstructionCount;
+  // -1 if the test doesn't check the number of elided TSO accesses.
+  int64_t ExpectedElidedTSOAccesses;
   uint64_t CodeSize;
   uint64_t x86InstCount;
   uint32_t Cookie;
@@ -283,6 +294,13 @@ static bool TestInstructions(FEXCore::Context::Context* CTX, FEXCore::Core::Inte
       TestsPassed = false;
     }
 
+    if (CurrentTest->ExpectedElidedTSOAccesses != -1 &&
+        INSTStats->first.ElidedTSOAccesses != static_cast<uint64_t>(CurrentTest->ExpectedElidedTSOAccesses)) {
+      LogMan::Msg::EFmt("Fail: '{}': {} elided TSO accesses but we expected {}!", CurrentTest->TestInst,
+                        INSTStats->first.ElidedTSOAccesses, CurrentTest->ExpectedElidedTSOAccesses);
+      TestsPassed = false;
+    }
+
     // Go to the next test.
     CurrentTest = reinterpret_cast<const TestInfo*>(&CurrentTest->Code[CurrentTest->CodeSize]);
   }
@@ -313,6 +331,10 @@ static bool TestInstructions(FEXCore::Context::Context* CTX, FEXCore::Core::Inte
         FD.Write(fextl::fmt::format("\t\t\"ExpectedInstructionCount\": {},\n", INSTStats->first.HostCodeInstructions));
       }
 
+      if (CurrentTest->ExpectedElidedTSOAccesses != -1 || INSTStats->first.ElidedTSOAccesses != 0) {
+        FD.Write(fextl::fmt::format("\t\t\"ExpectedElidedTSOAccesses\": {},\n", INSTStats->first.ElidedTSOAccesses));
+      }
+
       FD.Write(fextl::fmt::format("\t\t\"ExpectedArm64ASM\": [\n", INSTStats->first.HostCodeInstructions));
       for (auto it = INSTStats->second.begin(); it != INSTStats->second.end(); ++it) {
         const auto& Line = *it;
@@ -493,6 +493,7 @@ ApplicationWindow {
                         ListElement { text: qsTr("None") }
                         ListElement { text: qsTr("MTrack") }
                         ListElement { text: qsTr("Full") }
+                        ListElement { text: qsTr("Full (block entry)") }
                     }
                 }
             }
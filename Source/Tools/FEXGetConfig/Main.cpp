@@ -223,6 +223,8 @@ int main(int argc, char** argv, char** envp) {
     FEX_CONFIG_OPT(MemcpySetTSOEnabled, MEMCPYSETTSOENABLED);
     FEX_CONFIG_OPT(VectorTSOEnabled, VECTORTSOENABLED);
     FEX_CONFIG_OPT(HalfBarrierTSOEnabled, HALFBARRIERTSOENABLED);
+    FEX_CONFIG_OPT(TSOTraining, TSOTRAINING);
+    FEX_CONFIG_OPT(TSOProfiles, TSOPROFILES);
     FEX_CONFIG_OPT(StrictInProcessSplitLocks, STRICTINPROCESSSPLITLOCKS);
     fprintf(stderr, "Strict: %d\n", StrictInProcessSplitLocks());
 
@@ -231,6 +233,8 @@ int main(int argc, char** argv, char** envp) {
     fprintf(stdout, "\tMemcpy TSO Emulation:                 %s\n", TSOEnabled() && MemcpySetTSOEnabled() ? "Enabled" : "Disabled");
     fprintf(stdout, "\tVector TSO Emulation:                 %s\n", TSOEnabled() && VectorTSOEnabled() ? "Enabled" : "Disabled");
     fprintf(stdout, "\tHalf-barrier unaligned TSO emulation: %s\n", TSOEnabled() && HalfBarrierTSOEnabled() ? "Enabled" : "Disabled");
+    fprintf(stdout, "\tTSO training:                         %s\n", TSOEnabled() && TSOTraining() ? "Enabled" : "Disabled");
+    fprintf(stdout, "\tTSO profiles:                         %s\n", TSOEnabled() && TSOProfiles() ? "Enabled" : "Disabled");
     fprintf(stdout, "\t16-Byte strict split-lock emulation:  %s\n", StrictInProcessSplitLocks() ? "In-process mutex" : "Tearing");
     fprintf(stdout, "\t64-Byte strict split-lock emulation:  %s\n", StrictInProcessSplitLocks() ? "In-process mutex" : "Tearing");
   }
@@ -3,7 +3,9 @@
 
 #include "ELFCodeLoader.h"
 #include "Linux/Utils/ELFContainer.h"
+#include "LinuxSyscalls/OffsetProfile.h"
 
+#include <FEXCore/Core/CodeCache.h>
 #include <FEXCore/Core/Context.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/fextl/queue.h>
@@ -17,6 +19,29 @@
 #include <thread>
 
 namespace FEX::AOT {
+// Instructions that earlier runs had to backpatch for unaligned atomic accesses get compiled to the unaligned-safe
+// sequence right away, same as when the section gets mapped at runtime.
+static void ApplyUnalignedAtomics(FEXCore::Context::Context* CTX, const ELFCodeLoader::LoadedSection& Section) {
+  FEXCore::ExecutableFileInfo FileInfo {
+    .FileId = CTX->GetCodeCache().ComputeCodeMapId(Section.Filename, -1),
+    .Filename = Section.Filename,
+  };
+
+  fextl::set<uint64_t> Offsets;
+  const auto Path = FEX::HLE::OffsetProfile::GetPath(FileInfo, ".unaligned");
+  if (Path.empty() || !FEX::HLE::OffsetProfile::Load(Path, Offsets)) {
+    return;
+  }
+
+  fextl::set<uint64_t> Instructions;
+  for (auto It = Offsets.lower_bound(Section.Offs); It != Offsets.end() && *It < Section.Offs + Section.Size; ++It) {
+    Instructions.insert(Section.Base + *It - Section.Offs);
+  }
+
+  LogMan::Msg::IFmt("Unaligned atomic seed: {}", Instructions.size());
+  CTX->AddUnalignedAtomicInformation(std::move(Instructions));
+}
+
 void AOTGenSection(FEXCore::Context::Context* CTX, ELFCodeLoader::LoadedSection& Section) {
   // Make sure this section is executable and big enough
   if (!Section.Executable || Section.Size < 16) {
@@ -54,6 +79,8 @@ void AOTGenSection(FEXCore::Context::Context* CTX, ELFCodeLoader::LoadedSection&
 
   LogMan::Msg::IFmt("Symbol + Unwind seed: {}", InitialBranchTargets.size());
 
+  ApplyUnalignedAtomics(CTX, Section);
+
   // Scan the executable section and try to find function entries
   for (size_t Offset = 0; Offset < (Section.Size - 16); Offset++) {
     uint8_t* pCode = (uint8_t*)(Section.Base + Offset);
@@ -10,9 +10,11 @@ $end_info$
 #include "Common/FEXServerClient.h"
 #include "Common/Config.h"
 #include "Common/HostFeatures.h"
+#include "Common/StartupTrace.h"
 #include "PortabilityInfo.h"
 #include "ELFCodeLoader.h"
 #include "VDSO_Emulation.h"
+#include "Zygote.h"
 #include "LinuxSyscalls/GdbServer.h"
 #include "LinuxSyscalls/LinuxAllocator.h"
 #include "LinuxSyscalls/Syscalls.h"
@@ -50,6 +52,7 @@ $end_info$
 #include <elf.h>
 #include <fcntl.h>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <set>
 #include <sys/auxv.h>
@@ -242,6 +245,74 @@ void SetupKernelUnalignedAtomics() {
 }
 } // namespace FEX::UnalignedAtomic
 
+struct HostState {
+  fextl::unique_ptr<FEX::LinuxEmulation::Threads::StackTracker> StackTracker;
+  fextl::unique_ptr<FEX::HLE::MemAllocator> Allocator;
+  fextl::vector<FEXCore::Allocator::MemoryRegion> Base48Bit;
+  fextl::vector<FEXCore::Allocator::MemoryRegion> Low4GB;
+  fextl::unique_ptr<FEXCore::Context::Context> CTX;
+  bool SupportsAVX;
+};
+
+/**
+ * @brief Sets up the state of FEX that only depends on the configuration and the bitness of the guest.
+ *
+ * Zygotes set this up before they know which program they are going to run.
+ */
+static HostState SetupHostState(bool Is64Bit) {
+  HostState State {};
+
+  // Setup Thread handlers, so FEXCore can create threads.
+  State.StackTracker = FEX::LinuxEmulation::Threads::SetupThreadHandlers();
+
+  if (Is64Bit) {
+    // Destroy the 48th bit if it exists
+    State.Base48Bit = FEXCore::Allocator::Setup48BitAllocatorIfExists();
+  } else {
+    // Reserve [0x1_0000_0000, 0x2_0000_0000).
+    // Safety net if 32-bit address calculation overflows in to 64-bit range.
+    constexpr uint64_t First64BitAddr = 0x1'0000'0000ULL;
+    State.Low4GB = FEXCore::Allocator::StealMemoryRegion(First64BitAddr, First64BitAddr + First64BitAddr);
+
+    // Setup our userspace allocator
+    FEXCore::Allocator::SetupHooks();
+    State.Allocator = FEX::HLE::CreatePassthroughAllocator();
+
+    // Now that the upper 32-bit address space is blocked for future allocations,
+    // exhaust all of jemalloc's remaining internal allocations that it reserved before.
+    // TODO: It's unclear how reliably this exhausts those reserves
+    FEXCore::Allocator::YesIKnowImNotSupposedToUseTheGlibcAllocator glibc;
+    void* data;
+    do {
+      data = malloc(0x1);
+    } while (reinterpret_cast<uintptr_t>(data) >> 32 != 0);
+    free(data);
+  }
+
+  {
+    auto HostFeatures = FEX::FetchHostFeatures();
+    State.CTX = FEXCore::Context::Context::CreateNewContext(HostFeatures);
+    State.SupportsAVX = HostFeatures.SupportsAVX;
+  }
+  FEX::StartupTrace::Mark(FEX::StartupTrace::Phase::ContextCreated);
+
+  // Setup TSO hardware emulation immediately after initializing the context.
+  FEX::TSO::SetupTSOEmulation(State.CTX.get());
+  FEX::UnalignedAtomic::SetupKernelUnalignedAtomics();
+
+  if (!Is64Bit) {
+    // Tell the kernel we want to use the compat input syscalls even though we're
+    // a 64 bit process.
+    FEX::CompatInput::SetupCompatInput(true);
+  } else {
+    // Our parent could be an instance running a 32 bit application, so we need
+    // to disable compat input if we're running a 64 bit one ourselves.
+    FEX::CompatInput::SetupCompatInput(false);
+  }
+
+  return State;
+}
+
 /**
  * @brief Get an FD from an environment variable and then unset the environment variable.
  *
@@ -260,20 +331,47 @@ static int StealFEXFDFromEnv(const char* Env) {
   return FEXFD;
 }
 
-int main(int argc, char** argv, char** const envp) {
+int main(int argc, char** argv, char** envp) {
   auto SBRKPointer = FEXCore::Allocator::DisableSBRKAllocations();
   FEXCore::Allocator::GLIBCScopedFault GLIBFaultScope;
+  FEX::StartupTrace::Initialize();
 
-  const bool ExecutedWithFD = getauxval(AT_EXECFD) != 0;
   const auto PortableInfo = FEX::ReadPortabilityInformation();
+  int ZygoteFD {StealFEXFDFromEnv("FEX_ZYGOTEFD")};
+
+  LogMan::Throw::InstallHandler(AssertHandler);
+  LogMan::Msg::InstallHandler(MsgHandler);
+
+  std::optional<HostState> Host;
+  std::optional<FEX::Zygote::Handoff> Handoff;
+  if (ZygoteFD != -1) {
+    // Started by FEXServer as a zygote. Initialize everything that doesn't depend on the program and wait for one.
+    ZygoteFD = FEX::Zygote::PrepareFDs(ZygoteFD);
+    FEX::GCS::CheckForGCS();
+    FEX::Config::LoadConfig({}, envp, PortableInfo);
+    FEXCore::Config::ReloadMetaLayer();
+    FEXCore::Config::Set(FEXCore::Config::CONFIG_IS64BIT_MODE, "1");
+    Host = SetupHostState(true);
+
+    Handoff = FEX::Zygote::WaitForHandoff(ZygoteFD);
+    if (!Handoff) {
+      return 0;
+    }
+
+    // Continue as the process that was handed over, the configuration gets loaded again for its program.
+    FEXCore::Config::Shutdown();
+    argc = Handoff->Argv.size() - 1;
+    argv = Handoff->Argv.data();
+    envp = Handoff->Envp.data();
+    FEX::StartupTrace::ContinueFrom(Handoff->Client.PID, Handoff->Header.MainTimestamp);
+  }
+
+  const bool ExecutedWithFD = Handoff ? Handoff->Header.ExecFD != -1 : getauxval(AT_EXECFD) != 0;
   const bool InterpreterInstalled = QueryInterpreterInstalled(ExecutedWithFD, PortableInfo);
 
   int FEXFD {StealFEXFDFromEnv("FEX_EXECVEFD")};
   int FEXSeccompFD {StealFEXFDFromEnv("FEX_SECCOMPFD")};
 
-  LogMan::Throw::InstallHandler(AssertHandler);
-  LogMan::Msg::InstallHandler(MsgHandler);
-
   auto ArgsLoader = fextl::make_unique<FEX::ArgLoader::ArgLoader>(argc, argv);
   auto Args = ArgsLoader->Get();
   auto ParsedArgs = ArgsLoader->GetParsedArgs();
@@ -290,6 +388,11 @@ int main(int argc, char** argv, char** const envp) {
   // Reload the meta layer
   FEXCore::Config::ReloadMetaLayer();
   FEXCore::Config::Set(FEXCore::Config::CONFIG_INTERPRETER_INSTALLED, InterpreterInstalled ? "1" : "0");
+  FEX::StartupTrace::Mark(FEX::StartupTrace::Phase::ConfigLoaded);
+
+  if (Handoff && !FEX::Zygote::IsCompatible(*Handoff, Program.ProgramName)) {
+    FEX::Zygote::Reject(*Handoff);
+  }
 #ifdef VIXL_SIMULATOR
   // If running under the vixl simulator, ensure that indirect runtime calls are enabled.
   FEXCore::Config::Set(FEXCore::Config::CONFIG_DISABLE_VIXL_INDIRECT_RUNTIME_CALLS, "0");
@@ -307,12 +410,18 @@ int main(int argc, char** argv, char** const envp) {
     }
   }
 
+  if (!Handoff && FEXFD == -1 && FEXSeccompFD == -1) {
+    // Only returns if no zygote took over this process.
+    FEX::Zygote::TryHandoff(argc, argv, envp);
+  }
+
   // Ensure FEXServer is setup before config options try to pull CONFIG_ROOTFS
   auto SelfPath = FEX::GetSelfPath();
   if (!FEXServerClient::SetupClient(SelfPath.value_or(argv[0]))) {
     LogMan::Msg::EFmt("FEXServerClient: Failure to setup client");
     return -1;
   }
+  FEX::StartupTrace::Mark(FEX::StartupTrace::Phase::ServerConnected);
 
   FEX_CONFIG_OPT(SilentLog, SILENTLOG);
   FEX_CONFIG_OPT(OutputLog, OUTPUTLOG);
@@ -320,6 +429,8 @@ int main(int argc, char** argv, char** const envp) {
   FEX_CONFIG_OPT(Environment, ENV);
   FEX_CONFIG_OPT(HostEnvironment, HOSTENV);
   ::SilentLog = SilentLog();
+  // Fetching the RootFS waits for FEXServer to mount it if it is a squashfs image.
+  FEX::StartupTrace::Mark(FEX::StartupTrace::Phase::RootFSMounted);
 
   if (::SilentLog) {
     LogMan::Throw::UnInstallHandler();
@@ -380,6 +491,11 @@ int main(int argc, char** argv, char** const envp) {
   bool ProgramExists = InterpreterHandler(&Program.ProgramPath, LDPath(), &Args);
 
   if (!ExecutedWithFD && FEXFD == -1 && !ProgramExists) {
+    if (Handoff) {
+      // Let the original process report the error.
+      FEX::Zygote::Reject(*Handoff);
+    }
+
     // Early exit if the program passed in doesn't exist
     // Will prevent a crash later
     fextl::fmt::print(stderr, "{}: command not found\n", Program.ProgramPath);
@@ -398,7 +514,15 @@ int main(int argc, char** argv, char** const envp) {
     putenv(HostEnv.data());
   }
 
-  ELFCodeLoader Loader {Program.ProgramPath, FEXFD, LDPath(), Args, ParsedArgs, envp, &Environment};
+  ELFCodeLoader Loader {Program.ProgramPath, Handoff ? Handoff->Header.ExecFD : FEXFD, LDPath(), Args, ParsedArgs, envp, &Environment};
+
+  if (Handoff) {
+    // Zygotes are only initialized for 64-bit programs.
+    if (!Loader.ELFWasLoaded() || !Loader.Is64BitMode()) {
+      FEX::Zygote::Reject(*Handoff);
+    }
+    FEX::Zygote::Accept(*Handoff);
+  }
 
   if (!Loader.ELFWasLoaded()) {
     // Loader couldn't load this program for some reason
@@ -413,6 +537,7 @@ int main(int argc, char** argv, char** const envp) {
 #endif
     return -ENOEXEC;
   }
+  FEX::StartupTrace::Mark(FEX::StartupTrace::Phase::ELFLoaded);
 
   if (ExecutedWithFD) {
     // Don't need to canonicalize Program.ProgramPath, Config loader will have resolved this already.
@@ -437,63 +562,15 @@ int main(int argc, char** argv, char** const envp) {
     FEXCore::Config::Set(FEXCore::Config::CONFIG_APP_CONFIG_NAME, Program.ProgramName);
   }
 
-  // Setup Thread handlers, so FEXCore can create threads.
-  auto StackTracker = FEX::LinuxEmulation::Threads::SetupThreadHandlers();
-
   FEXCore::Config::Set(FEXCore::Config::CONFIG_IS64BIT_MODE, Loader.Is64BitMode() ? "1" : "0");
 
-  fextl::unique_ptr<FEX::HLE::MemAllocator> Allocator;
-  fextl::vector<FEXCore::Allocator::MemoryRegion> Base48Bit;
-  fextl::vector<FEXCore::Allocator::MemoryRegion> Low4GB;
-
-  if (Loader.Is64BitMode()) {
-    // Destroy the 48th bit if it exists
-    Base48Bit = FEXCore::Allocator::Setup48BitAllocatorIfExists();
-  } else {
-    // Reserve [0x1_0000_0000, 0x2_0000_0000).
-    // Safety net if 32-bit address calculation overflows in to 64-bit range.
-    constexpr uint64_t First64BitAddr = 0x1'0000'0000ULL;
-    Low4GB = FEXCore::Allocator::StealMemoryRegion(First64BitAddr, First64BitAddr + First64BitAddr);
-
-    // Setup our userspace allocator
-    FEXCore::Allocator::SetupHooks();
-    Allocator = FEX::HLE::CreatePassthroughAllocator();
-
-    // Now that the upper 32-bit address space is blocked for future allocations,
-    // exhaust all of jemalloc's remaining internal allocations that it reserved before.
-    // TODO: It's unclear how reliably this exhausts those reserves
-    FEXCore::Allocator::YesIKnowImNotSupposedToUseTheGlibcAllocator glibc;
-    void* data;
-    do {
-      data = malloc(0x1);
-    } while (reinterpret_cast<uintptr_t>(data) >> 32 != 0);
-    free(data);
+  if (!Host) {
+    Host = SetupHostState(Loader.Is64BitMode());
   }
+  auto& [StackTracker, Allocator, Base48Bit, Low4GB, CTX, SupportsAVX] = *Host;
 
   FEXCore::Profiler::Init(Program.ProgramName, Program.ProgramPath);
 
-  bool SupportsAVX {};
-  fextl::unique_ptr<FEXCore::Context::Context> CTX;
-  {
-    auto HostFeatures = FEX::FetchHostFeatures();
-    CTX = FEXCore::Context::Context::CreateNewContext(HostFeatures);
-    SupportsAVX = HostFeatures.SupportsAVX;
-  }
-
-  // Setup TSO hardware emulation immediately after initializing the context.
-  FEX::TSO::SetupTSOEmulation(CTX.get());
-  FEX::UnalignedAtomic::SetupKernelUnalignedAtomics();
-
-  if (!Loader.Is64BitMode()) {
-    // Tell the kernel we want to use the compat input syscalls even though we're
-    // a 64 bit process.
-    FEX::CompatInput::SetupCompatInput(true);
-  } else {
-    // Our parent could be an instance running a 32 bit application, so we need
-    // to disable compat input if we're running a 64 bit one ourselves.
-    FEX::CompatInput::SetupCompatInput(false);
-  }
-
   auto SignalDelegation = FEX::HLE::CreateSignalDelegator(CTX.get(), Program.ProgramName, SupportsAVX);
   auto ThunkHandler = FEX::HLE::CreateThunkHandler();
 
@@ -509,7 +586,9 @@ int main(int argc, char** argv, char** const envp) {
 
   // Pass in our VDSO thunks
   ThunkHandler->AppendThunkDefinitions(FEX::VDSO::GetVDSOThunkDefinitions(Loader.Is64BitMode()));
+  FEX::VDSO::InstallHostFunctionHandlers(CTX.get(), ThunkHandler.get());
   SignalDelegation->SetVDSOSymbols();
+  FEX::StartupTrace::Mark(FEX::StartupTrace::Phase::VDSOLoaded);
 
   // Now that we have the syscall handler. Track some FDs that are FEX owned.
   if (OutputFD > 2) {
@@ -530,6 +609,7 @@ int main(int argc, char** argv, char** const envp) {
       return -ENOEXEC;
     }
   }
+  FEX::StartupTrace::Mark(FEX::StartupTrace::Phase::ELFMapped);
 
   SyscallHandler->SetCodeLoader(&Loader);
 
@@ -550,14 +630,15 @@ int main(int argc, char** argv, char** const envp) {
   if (!CTX->InitCore()) {
     return 1;
   }
+  FEX::StartupTrace::Mark(FEX::StartupTrace::Phase::CoreInitialized);
 
   auto ParentThread = SyscallHandler->TM.CreateThread(Loader.DefaultRIP(), Loader.GetStackPointer());
   SyscallHandler->TM.TrackThread(ParentThread);
-  SignalDelegation->RegisterTLSState(ParentThread);
-  ThunkHandler->RegisterTLSState(ParentThread);
+  SyscallHandler->RegisterTLSState(ParentThread);
 
   SyscallHandler->DeserializeSeccompFD(ParentThread, FEXSeccompFD);
 
+  FEX::StartupTrace::Mark(FEX::StartupTrace::Phase::GuestEntry);
   CTX->ExecuteThread(ParentThread->Thread);
 
   DebugServer.reset();
@@ -565,7 +646,7 @@ int main(int argc, char** argv, char** const envp) {
 
   auto ProgramStatus = ParentThread->StatusCode;
 
-  SignalDelegation->UninstallTLSState(ParentThread);
+  SyscallHandler->UninstallTLSState(ParentThread);
   SyscallHandler->TM.DestroyThread(ParentThread);
 
   FEX::VDSO::UnloadVDSOMapping(VDSOMapping);
@@ -578,6 +659,7 @@ int main(int argc, char** argv, char** const envp) {
 
   Loader.FreeSections();
 
+  FEX::StartupTrace::Write(FEX::StartupTrace::Phase::Exit);
   FEXCore::Config::Shutdown();
 
   LogMan::Throw::UnInstallHandler();
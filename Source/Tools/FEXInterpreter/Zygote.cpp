@@ -0,0 +1,484 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: Bin|FEX
+desc: Hands new processes over to pre-initialized FEXInterpreter processes kept by FEXServer
+$end_info$
+*/
+
+#include "Zygote.h"
+#include "Common/Async.h"
+#include "Common/AsyncNet.h"
+#include "Common/FEXServerClient.h"
+#include "Common/StartupTrace.h"
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXHeaderUtils/Filesystem.h>
+#include <FEXHeaderUtils/Syscalls.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <span>
+#include <sys/auxv.h>
+#include <sys/personality.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace FEX::Zygote {
+namespace {
+  // Environment variables that change how the zygote would have been initialized.
+  bool AffectsInitialization(std::string_view Variable) {
+    return Variable.starts_with("FEX_") || Variable.starts_with("HOME=") || Variable.starts_with("XDG_CONFIG_HOME=") ||
+           Variable.starts_with("XDG_DATA_HOME=");
+  }
+
+  fextl::vector<fextl::string> GetInitializationEnvironment(char* const* Envp) {
+    fextl::vector<fextl::string> Result;
+    for (; *Envp; ++Envp) {
+      if (AffectsInitialization(*Envp)) {
+        Result.emplace_back(*Envp);
+      }
+    }
+    std::sort(Result.begin(), Result.end());
+    return Result;
+  }
+
+  // Environment that the zygote was initialized with.
+  fextl::vector<fextl::string> ZygoteEnvironment;
+
+  bool SendAll(fasio::tcp_socket& Socket, std::span<std::byte> Data, int* FD = nullptr) {
+    fasio::mutable_buffer Buffer {.Data = Data};
+    if (FD) {
+      Buffer.FD = FD;
+    }
+    fasio::error ec;
+    write(Socket, Buffer, ec);
+    return ec == fasio::error::success;
+  }
+
+  bool ReceiveAll(fasio::tcp_socket& Socket, std::span<std::byte> Data, int* FD = nullptr) {
+    fasio::mutable_buffer Buffer {.Data = Data};
+    if (FD) {
+      Buffer.FD = FD;
+    }
+    fasio::error ec;
+    read(Socket, Buffer, ec);
+    return ec == fasio::error::success;
+  }
+
+  void SendVerdict(Handoff& Handoff, int32_t Accepted) {
+    fasio::tcp_socket Socket {Handoff.ControlFD};
+    SendAll(Socket, std::as_writable_bytes(std::span {&Accepted, 1}));
+    close(Handoff.ControlFD);
+    Handoff.ControlFD = -1;
+  }
+} // namespace
+
+int PrepareFDs(int ZygoteFD) {
+  int NewFD = fcntl(ZygoteFD, F_DUPFD_CLOEXEC, FD_FLOOR);
+  if (NewFD == -1) {
+    return -1;
+  }
+
+  // Nothing else that FEXServer passed down is of use.
+  ::syscall(SYS_close_range, 0, FD_FLOOR - 1, 0);
+  if (NewFD > FD_FLOOR) {
+    ::syscall(SYS_close_range, FD_FLOOR, NewFD - 1, 0);
+  }
+  ::syscall(SYS_close_range, NewFD + 1, ~0U, 0);
+
+  // Occupy every FD below the floor, so anything FEX opens before the handoff can't take the place of an inherited FD.
+  int NullFD = open("/dev/null", O_RDWR | O_CLOEXEC);
+  for (int FD = 0; FD < FD_FLOOR; ++FD) {
+    if (FD != NullFD) {
+      dup3(NullFD, FD, O_CLOEXEC);
+    }
+  }
+
+  return NewFD;
+}
+
+std::optional<Handoff> WaitForHandoff(int ZygoteFD) {
+  fasio::tcp_socket Socket {ZygoteFD};
+  Handoff Result {
+    .ControlFD = ZygoteFD,
+  };
+
+  // FEXServer closes the socket instead if it is shutting down.
+  // Otherwise it sends what it knows about the new process before the process itself sends anything.
+  if (!ReceiveAll(Socket, std::as_writable_bytes(std::span {&Result.Client, 1})) ||
+      !ReceiveAll(Socket, std::as_writable_bytes(std::span {&Result.Header, 1}))) {
+    return std::nullopt;
+  }
+  auto& Header = Result.Header;
+
+  if (Header.ArgCount == 0 || Header.StringsSize == 0) {
+    return std::nullopt;
+  }
+
+  Result.Strings.resize(Header.StringsSize);
+  if (!ReceiveAll(Socket, std::as_writable_bytes(std::span {Result.Strings})) || Result.Strings.back() != '\0') {
+    return std::nullopt;
+  }
+
+  char* String = Result.Strings.data();
+  char* End = String + Result.Strings.size();
+  for (uint32_t i = 0; i < Header.ArgCount + Header.EnvCount; ++i) {
+    if (String >= End) {
+      return std::nullopt;
+    }
+    (i < Header.ArgCount ? Result.Argv : Result.Envp).emplace_back(String);
+    String += strlen(String) + 1;
+  }
+  Result.Argv.emplace_back(nullptr);
+  Result.Envp.emplace_back(nullptr);
+
+  // Received FDs land above the placeholders, move them to the number they had in the client.
+  std::array<bool, FD_FLOOR> Inherited {};
+  for (uint32_t i = 0; i < Header.FDCount; ++i) {
+    int32_t Target {};
+    int FD {-1};
+    if (!ReceiveAll(Socket, std::as_writable_bytes(std::span {&Target, 1}), &FD) || FD == -1) {
+      return std::nullopt;
+    }
+
+    if (Target == AT_FDCWD) {
+      const bool Changed = fchdir(FD) == 0;
+      close(FD);
+      if (!Changed) {
+        return std::nullopt;
+      }
+      continue;
+    }
+
+    if (Target < 0 || Target >= FD_FLOOR) {
+      close(FD);
+      return std::nullopt;
+    }
+
+    dup3(FD, Target, 0);
+    close(FD);
+    Inherited[Target] = true;
+  }
+
+  for (int FD = 0; FD < FD_FLOOR; ++FD) {
+    if (!Inherited[FD]) {
+      close(FD);
+    }
+  }
+
+  umask(Header.Umask);
+  personality(Header.Personality);
+  setpriority(PRIO_PROCESS, 0, Header.Nice);
+  for (int Resource = 0; Resource < RLIM_NLIMITS; ++Resource) {
+    if (setrlimit(Resource, &Header.Limits[Resource]) != 0) {
+      // Limits the client could raise but the zygote can't.
+      return std::nullopt;
+    }
+  }
+  sched_setaffinity(0, sizeof(Header.Affinity), &Header.Affinity);
+
+  // FEX hasn't installed any signal handlers yet, so the client's dispositions can be taken over directly.
+  sigset_t Blocked;
+  sigemptyset(&Blocked);
+  for (int Signal = 1; Signal <= 64; ++Signal) {
+    const uint64_t Bit = 1ULL << (Signal - 1);
+    if (Header.BlockedSignals & Bit) {
+      sigaddset(&Blocked, Signal);
+    }
+
+    if (Signal == SIGKILL || Signal == SIGSTOP) {
+      continue;
+    }
+    struct sigaction Action {};
+    Action.sa_handler = (Header.IgnoredSignals & Bit) ? SIG_IGN : SIG_DFL;
+    // Fails for the signals reserved by libc, which is fine.
+    sigaction(Signal, &Action, nullptr);
+  }
+  sigprocmask(SIG_SETMASK, &Blocked, nullptr);
+
+  // Stay in the process group of the client so job control and signals sent to the group reach the program.
+  // Moving between sessions isn't possible, zygotes only take over processes from their own session.
+  if (getsid(0) != Result.Client.Session || setpgid(0, Result.Client.ProcessGroup) != 0) {
+    return std::nullopt;
+  }
+
+  ZygoteEnvironment = GetInitializationEnvironment(environ);
+  environ = Result.Envp.data();
+
+  return Result;
+}
+
+bool IsCompatible(const Handoff& Handoff, std::string_view ProgramName) {
+  // Only compare against what FEXServer read from /proc for the new process, the process could claim anything.
+  int ProcFD = open("/proc/self", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (ProcFD == -1) {
+    return false;
+  }
+  ProcessIdentity Zygote {};
+  const bool Matches = ReadProcessIdentity(ProcFD, &Zygote) && Zygote == Handoff.Client.Identity;
+  close(ProcFD);
+  if (!Matches) {
+    return false;
+  }
+
+  if (GetInitializationEnvironment(Handoff.Envp.data()) != ZygoteEnvironment) {
+    return false;
+  }
+
+  // The zygote was initialized without any application configuration.
+  if (getenv("SteamAppId") || FHU::Filesystem::Exists(FEXCore::Config::GetApplicationConfig(ProgramName, true)) ||
+      FHU::Filesystem::Exists(FEXCore::Config::GetApplicationConfig(ProgramName, false))) {
+    return false;
+  }
+
+  return true;
+}
+
+void Accept(Handoff& Handoff) {
+  SendVerdict(Handoff, 1);
+}
+
+void Reject(Handoff& Handoff) {
+  SendVerdict(Handoff, 0);
+  _exit(0);
+}
+
+namespace {
+  pid_t ZygotePID {};
+
+  void ForwardSignal(int Signal) {
+    ::kill(ZygotePID, Signal);
+  }
+
+  struct DirEntry {
+    uint64_t Inode;
+    int64_t Offset;
+    uint16_t RecordLength;
+    uint8_t Type;
+    char Name[];
+  };
+
+  // Collects every FD that would survive an execve, without going through the glibc allocator.
+  bool GetInheritedFDs(int ExecFD, fextl::vector<int>* FDs) {
+    int DirFD = open("/proc/self/fd", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (DirFD == -1) {
+      return false;
+    }
+
+    bool Result = true;
+    alignas(DirEntry) char Buffer[4096];
+    while (true) {
+      auto Read = ::syscall(SYS_getdents64, DirFD, Buffer, sizeof(Buffer));
+      if (Read <= 0) {
+        Result &= Read == 0;
+        break;
+      }
+
+      for (long Offset = 0; Offset < Read;) {
+        auto Entry = reinterpret_cast<DirEntry*>(&Buffer[Offset]);
+        Offset += Entry->RecordLength;
+
+        std::string_view Name {Entry->Name};
+        int FD {-1};
+        if (std::from_chars(Name.data(), Name.data() + Name.size(), FD).ec != std::errc {} || FD == DirFD) {
+          continue;
+        }
+
+        const int Flags = fcntl(FD, F_GETFD);
+        if (Flags == -1 || ((Flags & FD_CLOEXEC) && FD != ExecFD)) {
+          continue;
+        }
+
+        Result &= FD < FD_FLOOR;
+        FDs->emplace_back(FD);
+      }
+    }
+
+    close(DirFD);
+    return Result;
+  }
+
+  void FillProcessState(HandoffHeader* Header) {
+    Header->Umask = umask(0);
+    umask(Header->Umask);
+    errno = 0;
+    Header->Nice = getpriority(PRIO_PROCESS, 0);
+    Header->Personality = personality(0xffffffff);
+
+    for (int Resource = 0; Resource < RLIM_NLIMITS; ++Resource) {
+      getrlimit(Resource, &Header->Limits[Resource]);
+    }
+    sched_getaffinity(0, sizeof(Header->Affinity), &Header->Affinity);
+
+    sigset_t Blocked;
+    sigprocmask(SIG_SETMASK, nullptr, &Blocked);
+    for (int Signal = 1; Signal <= 64; ++Signal) {
+      const uint64_t Bit = 1ULL << (Signal - 1);
+      if (sigismember(&Blocked, Signal) == 1) {
+        Header->BlockedSignals |= Bit;
+      }
+
+      struct sigaction Action {};
+      if (sigaction(Signal, nullptr, &Action) == 0 && Action.sa_handler == SIG_IGN) {
+        Header->IgnoredSignals |= Bit;
+      }
+    }
+  }
+
+  bool SendHandoff(int ControlFD, int argc, char** argv, char** envp, int ExecFD, const fextl::vector<int>& FDs) {
+    HandoffHeader Header {
+      .ArgCount = static_cast<uint32_t>(argc),
+      .ExecFD = ExecFD,
+      .MainTimestamp = FEX::StartupTrace::Timestamps[static_cast<size_t>(FEX::StartupTrace::Phase::Main)].load(std::memory_order_relaxed),
+    };
+    FillProcessState(&Header);
+
+    fextl::string Strings;
+    for (int i = 0; i < argc; ++i) {
+      Strings.append(argv[i], strlen(argv[i]) + 1);
+    }
+    for (char** Env = envp; *Env; ++Env) {
+      Strings.append(*Env, strlen(*Env) + 1);
+      ++Header.EnvCount;
+    }
+    Header.StringsSize = Strings.size();
+
+    int CWD = open(".", O_PATH | O_DIRECTORY | O_CLOEXEC);
+    if (CWD == -1) {
+      return false;
+    }
+    Header.FDCount = FDs.size() + 1;
+
+    fasio::tcp_socket Socket {ControlFD};
+    bool Result = SendAll(Socket, std::as_writable_bytes(std::span {&Header, 1})) &&
+                  SendAll(Socket, std::as_writable_bytes(std::span {Strings.data(), Strings.size()}));
+
+    int32_t Target = AT_FDCWD;
+    Result = Result && SendAll(Socket, std::as_writable_bytes(std::span {&Target, 1}), &CWD);
+    close(CWD);
+
+    for (int FD : FDs) {
+      Target = FD;
+      Result = Result && SendAll(Socket, std::as_writable_bytes(std::span {&Target, 1}), &FD);
+    }
+
+    return Result;
+  }
+
+  [[noreturn]]
+  void ProxyZygote(int ServerFD, pid_t PID, const fextl::vector<int>& FDs) {
+    // The zygote owns the inherited FDs now, don't keep pipes open behind its back.
+    for (int FD : FDs) {
+      close(FD);
+    }
+
+    ZygotePID = PID;
+    struct sigaction Action {};
+    Action.sa_handler = ForwardSignal;
+    Action.sa_flags = SA_RESTART;
+    sigfillset(&Action.sa_mask);
+    for (int Signal = 1; Signal <= 64; ++Signal) {
+      struct sigaction Current {};
+      if (Signal == SIGKILL || Signal == SIGSTOP || Signal == SIGCHLD || sigaction(Signal, nullptr, &Current) != 0 ||
+          Current.sa_handler == SIG_IGN) {
+        // Ignored signals were ignored in the zygote as well.
+        continue;
+      }
+      sigaction(Signal, &Action, nullptr);
+    }
+
+    sigset_t Unblocked;
+    sigemptyset(&Unblocked);
+    sigprocmask(SIG_SETMASK, &Unblocked, nullptr);
+
+    auto Status = FEXServerClient::WaitForZygoteExit(ServerFD);
+    if (!Status) {
+      // Lost FEXServer, which also means losing the exit status. Still wait for the program to finish.
+      int PIDFD = FHU::Syscalls::pidfd_open(PID, 0);
+      if (PIDFD != -1) {
+        pollfd PollFD {.fd = PIDFD, .events = POLLIN, .revents = 0};
+        while (poll(&PollFD, 1, -1) == -1 && errno == EINTR)
+          ;
+      }
+      _exit(1);
+    }
+
+    if (WIFSIGNALED(*Status)) {
+      // Die the same way the program did, without a second core dump.
+      const int Signal = WTERMSIG(*Status);
+      rlimit NoCore {};
+      setrlimit(RLIMIT_CORE, &NoCore);
+
+      struct sigaction Default {};
+      Default.sa_handler = SIG_DFL;
+      sigaction(Signal, &Default, nullptr);
+      raise(Signal);
+      _exit(128 + Signal);
+    }
+
+    _exit(WEXITSTATUS(*Status));
+  }
+} // namespace
+
+void TryHandoff(int argc, char** argv, char** envp) {
+  FEX_CONFIG_OPT(ZygotePool, ZYGOTEPOOL);
+  if (!ZygotePool()) {
+    return;
+  }
+
+  // Zygotes don't share the session of the process, so they can't take over a terminal.
+  if (isatty(STDIN_FILENO) || isatty(STDOUT_FILENO) || isatty(STDERR_FILENO)) {
+    return;
+  }
+
+  // Restrictions that can't be moved to another process.
+  if (getauxval(AT_SECURE) || prctl(PR_GET_SECCOMP, 0, 0, 0, 0) != 0 || prctl(PR_GET_NO_NEW_PRIVS, 0, 0, 0, 0) != 0) {
+    return;
+  }
+
+  const int ExecFD = getauxval(AT_EXECFD) ? static_cast<int>(getauxval(AT_EXECFD)) : -1;
+  fextl::vector<int> FDs;
+  if (!GetInheritedFDs(ExecFD, &FDs)) {
+    return;
+  }
+
+  int ServerFD = FEXServerClient::ConnectToServer(FEXServerClient::ConnectionOption::NoPrintConnectionError);
+  if (ServerFD == -1) {
+    return;
+  }
+
+  int32_t PID {};
+  int ControlFD = FEXServerClient::RequestZygote(ServerFD, &PID);
+  if (ControlFD == -1) {
+    close(ServerFD);
+    return;
+  }
+
+  int32_t Accepted {};
+  if (SendHandoff(ControlFD, argc, argv, envp, ExecFD, FDs)) {
+    fasio::tcp_socket Socket {ControlFD};
+    if (!ReceiveAll(Socket, std::as_writable_bytes(std::span {&Accepted, 1}))) {
+      Accepted = 0;
+    }
+  }
+  close(ControlFD);
+
+  if (!Accepted) {
+    // FEXServer kills the zygote once this connection is gone, if it didn't exit already.
+    close(ServerFD);
+    return;
+  }
+
+  ProxyZygote(ServerFD, PID, FDs);
+}
+} // namespace FEX::Zygote
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "Common/FEXServerClient.h"
+
+#include <FEXCore/fextl/vector.h>
+
+#include <cstdint>
+#include <optional>
+#include <sched.h>
+#include <string_view>
+#include <sys/resource.h>
+
+namespace FEX::Zygote {
+// Inherited FDs keep their number in the zygote, so FEX's own FDs in the zygote are kept at or above this.
+// Processes with inherited FDs at or above this don't use a zygote.
+constexpr int FD_FLOOR = 64;
+
+// Process state that a new process sends to the zygote that takes it over, followed by the argument and environment strings.
+// Every inherited FD then gets sent with its own int32_t FD number, the working directory uses AT_FDCWD.
+struct HandoffHeader {
+  uint32_t ArgCount;
+  uint32_t EnvCount;
+  uint32_t StringsSize;
+  uint32_t FDCount;
+  // AT_EXECFD that binfmt_misc passed, -1 if there wasn't one.
+  int32_t ExecFD;
+  // StartupTrace Main timestamp of the client.
+  uint64_t MainTimestamp;
+
+  uint32_t Umask;
+  int32_t Nice;
+  uint32_t Personality;
+  // Bit (Signal - 1) for every signal.
+  uint64_t BlockedSignals;
+  uint64_t IgnoredSignals;
+  rlimit Limits[RLIM_NLIMITS];
+  cpu_set_t Affinity;
+};
+
+struct Handoff {
+  int ControlFD;
+  // Identity, session and process group of the new process as FEXServer saw them.
+  FEXServerClient::ZygoteClient Client;
+  HandoffHeader Header;
+  fextl::vector<char> Strings;
+  // Null terminated, pointing in to Strings.
+  fextl::vector<char*> Argv;
+  fextl::vector<char*> Envp;
+};
+
+/**
+ * @name Zygote side
+ * @{ */
+
+/**
+ * @brief Moves the FEXServer socket above FD_FLOOR and fills the FDs below it with placeholders.
+ *
+ * @return The new FD of the FEXServer socket
+ */
+int PrepareFDs(int ZygoteFD);
+
+/**
+ * @brief Waits for FEXServer to hand this zygote to a new process and takes over that process' state.
+ *
+ * Replaces `environ` with the environment of the new process.
+ *
+ * @return std::nullopt if FEXServer shut down the zygote or the handoff failed
+ */
+std::optional<Handoff> WaitForHandoff(int ZygoteFD);
+
+/**
+ * @brief Checks that the state the zygote was initialized with matches what the new process would have initialized.
+ *
+ * Requires the configuration of the new process to be loaded.
+ */
+bool IsCompatible(const Handoff& Handoff, std::string_view ProgramName);
+
+/**
+ * @brief Lets the new process know that the zygote runs its program from here on.
+ */
+void Accept(Handoff& Handoff);
+
+/**
+ * @brief Lets the new process know that it needs to start up by itself and exits.
+ */
+[[noreturn]]
+void Reject(Handoff& Handoff);
+/**  @} */
+
+/**
+ * @brief Hands this process over to a zygote if the ZygotePool config is enabled.
+ *
+ * Once a zygote accepted, this process only forwards signals to the zygote and exits with its status.
+ * Only returns if no zygote took over, in which case the process needs to start up normally.
+ */
+void TryHandoff(int argc, char** argv, char** envp);
+} // namespace FEX::Zygote
@@ -193,9 +193,16 @@ int main(int argc, char** argv, char** const envp) {
     return -1;
   }
 
-  // Switch this process over to a new session id
-  // Probably not required but allows this to become the process group leader of its session
-  ::setsid();
+  FEX_CONFIG_OPT(ZygotePool, ZYGOTEPOOL);
+  if (ZygotePool()) {
+    // Zygotes can only take over processes of their own session, so stay in the session FEXServer was started from.
+    // A process group of its own still keeps signals to the group of the starting process away.
+    ::setpgid(0, 0);
+  } else {
+    // Switch this process over to a new session id
+    // Probably not required but allows this to become the process group leader of its session
+    ::setsid();
+  }
 
   // Set process as a subreaper so subprocesses can't escape
   if (::prctl(PR_SET_CHILD_SUBREAPER, 1) == -1) [[unlikely]] {
@@ -2,6 +2,7 @@
 #include "FEXHeaderUtils/Syscalls.h"
 #include "Logger.h"
 #include "SquashFS.h"
+#include "ZygotePool.h"
 
 #include <Common/AsyncNet.h>
 #include <Common/Config.h>
@@ -234,6 +235,7 @@ bool InitializeServerSocket(bool abstract) {
       },
       [Socket = std::move(Socket).value()](fasio::error ec) mutable {
         if (ec != fasio::error::success) {
+          ZygotePool::ClientClosed(Socket.FD);
           close(Socket.FD);
           --NumClients;
           return fasio::post_callback::drop;
@@ -425,6 +427,33 @@ void HandleSocketData(fasio::tcp_socket& Socket) {
       break;
     }
 
+    case FEXServerClient::PacketType::TYPE_CLAIM_ZYGOTE: {
+      int32_t PID {};
+      int ControlFD = ZygotePool::Claim(Socket.FD, &PID);
+      if (ControlFD == -1) {
+        SendEmptyErrorPacket(Socket);
+      } else {
+        FEXServerClient::FEXServerResultPacket Res {
+          .PID {
+            .Header {
+              .Type = FEXServerClient::PacketType::TYPE_SUCCESS,
+            },
+            .PID = PID,
+          },
+        };
+
+        fasio::mutable_buffer Data = {.Data = std::as_writable_bytes(std::span(&Res, 1)), .FD = &ControlFD};
+        fasio::error ec;
+        write(Socket, Data, ec);
+
+        // The client owns the zygote now
+        close(ControlFD);
+      }
+
+      buffer += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
+      break;
+    }
+
     // Invalid
     case FEXServerClient::PacketType::TYPE_ERROR:
     default:
@@ -473,6 +502,7 @@ void WaitForRequests() {
   }
 
   Reactor.enable_async_stop();
+  ZygotePool::Initialize(Reactor);
 
   while (true) {
     std::optional Timeout = std::chrono::seconds {RequestTimeout};
@@ -488,6 +518,7 @@ void WaitForRequests() {
 
   LogMan::Msg::DFmt("[FEXServer] Shutting Down");
 
+  ZygotePool::Shutdown();
   CloseConnections();
 }
 
@@ -0,0 +1,284 @@
+// SPDX-License-Identifier: MIT
+#include "ZygotePool.h"
+#include "PortabilityInfo.h"
+
+#include <Common/Async.h>
+#include <Common/AsyncNet.h>
+#include <Common/FEXServerClient.h>
+#include <Common/ProcessIdentity.h>
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXHeaderUtils/Filesystem.h>
+#include <FEXHeaderUtils/Syscalls.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <span>
+#include <string>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#ifndef SO_PEERPIDFD
+#define SO_PEERPIDFD 77
+#endif
+
+namespace ZygotePool {
+struct Zygote {
+  pid_t PID;
+  // FEXServer's end of the socket the zygote waits for a handoff on, -1 once it was passed to a client.
+  int ControlFD;
+  // Client the zygote was handed to, -1 while idle or once the client went away.
+  int ClientFD;
+  bool Claimed;
+};
+
+static fasio::poll_reactor* Reactor {};
+static uint32_t PoolSize {};
+static fextl::string InterpreterPath {};
+static std::vector<Zygote> Zygotes {};
+
+static void Reaped(pid_t PID, int Status) {
+  auto It = std::find_if(Zygotes.begin(), Zygotes.end(), [PID](const Zygote& Zygote) { return Zygote.PID == PID; });
+  if (It == Zygotes.end()) {
+    return;
+  }
+
+  if (It->ClientFD != -1) {
+    FEXServerClient::FEXServerResultPacket Res {
+      .ZygoteExit {
+        .Header {
+          .Type = FEXServerClient::PacketType::TYPE_ZYGOTE_EXIT,
+        },
+        .Status = Status,
+      },
+    };
+    // The client might have gone away already.
+    send(It->ClientFD, &Res, sizeof(Res), MSG_NOSIGNAL);
+  }
+
+  if (!It->Claimed) {
+    // Zygotes only exit on their own once they were handed out, so this one failed to start.
+    // Don't keep on trying to start them.
+    LogMan::Msg::EFmt("[FEXServer] Zygote {} exited before it was used with status {:#x}, disabling the zygote pool", PID, Status);
+    close(It->ControlFD);
+    PoolSize = 0;
+  }
+
+  Zygotes.erase(It);
+}
+
+static void Spawn() {
+  int Sockets[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, Sockets) != 0) {
+    LogMan::Msg::EFmt("[FEXServer] Couldn't create zygote socket: {}", strerror(errno));
+    return;
+  }
+
+  // Prepare everything the child needs before forking, the log thread could be holding the allocator lock.
+  std::vector<std::string> Environment;
+  for (char** Var = environ; *Var; ++Var) {
+    Environment.emplace_back(*Var);
+  }
+  Environment.emplace_back(fmt::format("FEX_ZYGOTEFD={}", Sockets[1]));
+
+  std::vector<char*> EnvP;
+  for (auto& Var : Environment) {
+    EnvP.emplace_back(Var.data());
+  }
+  EnvP.emplace_back(nullptr);
+
+  const char* Argv[] = {InterpreterPath.c_str(), nullptr};
+
+  pid_t PID = fork();
+  if (PID == 0) {
+    // Idle zygotes get their own process group so signals to FEXServer's group don't reach them.
+    // They join the process group of the client once handed over.
+    setpgid(0, 0);
+
+    // Only the zygote's end of the socket survives the exec.
+    fcntl(Sockets[1], F_SETFD, 0);
+    execvpe(Argv[0], const_cast<char* const*>(Argv), EnvP.data());
+    _exit(1);
+  }
+
+  close(Sockets[1]);
+  if (PID == -1) {
+    close(Sockets[0]);
+    return;
+  }
+
+  int PIDFD = FHU::Syscalls::pidfd_open(PID, 0);
+  if (PIDFD == -1) {
+    // Without a pidfd there is no way to wait for the zygote in the reactor.
+    LogMan::Msg::EFmt("[FEXServer] pidfd_open isn't supported, disabling the zygote pool");
+    kill(PID, SIGKILL);
+    while (waitpid(PID, nullptr, 0) == -1 && errno == EINTR)
+      ;
+    close(Sockets[0]);
+    PoolSize = 0;
+    return;
+  }
+
+  Zygotes.emplace_back(Zygote {
+    .PID = PID,
+    .ControlFD = Sockets[0],
+    .ClientFD = -1,
+    .Claimed = false,
+  });
+
+  Reactor->bind_handler(
+    pollfd {
+      .fd = PIDFD,
+      .events = POLLIN,
+      .revents = 0,
+    },
+    [PID, PIDFD](fasio::error) {
+      // pidfds become readable once the process exited.
+      int Status {};
+      while (waitpid(PID, &Status, 0) == -1 && errno == EINTR)
+        ;
+      close(PIDFD);
+      Reaped(PID, Status);
+      return fasio::post_callback::drop;
+    });
+}
+
+static void Replenish() {
+  auto Idle = std::count_if(Zygotes.begin(), Zygotes.end(), [](const Zygote& Zygote) { return !Zygote.Claimed; });
+  for (; Idle < PoolSize; ++Idle) {
+    Spawn();
+  }
+}
+
+void Initialize(fasio::poll_reactor& Reactor) {
+  FEX_CONFIG_OPT(ZygotePoolSize, ZYGOTEPOOL);
+  ZygotePool::Reactor = &Reactor;
+  PoolSize = ZygotePoolSize();
+  if (!PoolSize) {
+    return;
+  }
+
+  // Prefer a FEXInterpreter next to this FEXServer, same as FEX does to find FEXServer.
+  InterpreterPath = "FEXInterpreter";
+  auto SelfPath = FEX::GetSelfPath();
+  if (SelfPath && FHU::Filesystem::Exists(*SelfPath + "FEXInterpreter")) {
+    InterpreterPath = *SelfPath + "FEXInterpreter";
+  }
+
+  Replenish();
+}
+
+// Fills what the zygote needs to know about a client from its peer credentials and /proc.
+// Nothing the client sent is trusted, the abstract FEXServer socket is reachable by every process of the user.
+static bool ReadClient(int ClientFD, FEXServerClient::ZygoteClient* Client) {
+  ucred Credentials {};
+  socklen_t Size = sizeof(Credentials);
+  if (getsockopt(ClientFD, SOL_SOCKET, SO_PEERCRED, &Credentials, &Size) != 0 || Credentials.uid != getuid()) {
+    return false;
+  }
+
+  // Pin the peer so its PID can't be reused while /proc/<pid> is read.
+  // SO_PEERPIDFD refers to the process that connected, pidfd_open is the fallback for kernels before 6.5.
+  int PIDFD {-1};
+  Size = sizeof(PIDFD);
+  if (getsockopt(ClientFD, SOL_SOCKET, SO_PEERPIDFD, &PIDFD, &Size) != 0) {
+    PIDFD = FHU::Syscalls::pidfd_open(Credentials.pid, 0);
+  }
+  if (PIDFD == -1) {
+    return false;
+  }
+
+  bool Result = false;
+  int ProcFD = open(fmt::format("/proc/{}", Credentials.pid).c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (ProcFD != -1) {
+    Client->PID = Credentials.pid;
+    Client->Session = getsid(Credentials.pid);
+    Client->ProcessGroup = getpgid(Credentials.pid);
+    Result = FEX::ReadProcessIdentity(ProcFD, &Client->Identity) && Client->Session != -1 && Client->ProcessGroup != -1;
+    close(ProcFD);
+  }
+
+  // If the pinned process is still alive then everything above was read from it and not from a process that took over its PID.
+  Result = Result && FHU::Syscalls::pidfd_send_signal(PIDFD, 0, nullptr, 0) == 0;
+  close(PIDFD);
+  if (!Result) {
+    return false;
+  }
+
+  // Sandboxing can't be carried over to the zygote, so sandboxed processes must not escape it by handing off.
+  // Their identity wouldn't match the zygote's anyway, but don't even give them a zygote to talk to.
+  if (Client->Identity.UID != Credentials.uid || Client->Identity.Seccomp != 0 || Client->Identity.NoNewPrivs != 0) {
+    return false;
+  }
+
+  // Zygotes can only join the process group of a client in their own session, don't hand them to anyone else.
+  return Client->Session == getsid(0);
+}
+
+int Claim(int ClientFD, int32_t* PID) {
+  FEXServerClient::ZygoteClient Client {};
+  if (!ReadClient(ClientFD, &Client)) {
+    return -1;
+  }
+
+  auto It = std::find_if(Zygotes.begin(), Zygotes.end(), [](const Zygote& Zygote) { return !Zygote.Claimed; });
+  if (It == Zygotes.end()) {
+    return -1;
+  }
+
+  It->Claimed = true;
+  It->ClientFD = ClientFD;
+  *PID = It->PID;
+  int ControlFD = std::exchange(It->ControlFD, -1);
+
+  // The zygote reads this before anything that the client sends over the same socket.
+  // It fits in the socket buffer of a socket that nothing was sent on yet.
+  fasio::tcp_socket Socket {ControlFD};
+  fasio::mutable_buffer Buffer {.Data = std::as_writable_bytes(std::span {&Client, 1})};
+  fasio::error ec;
+  write(Socket, Buffer, ec);
+  if (ec != fasio::error::success) {
+    It->ClientFD = -1;
+    kill(It->PID, SIGKILL);
+    close(ControlFD);
+    ControlFD = -1;
+  }
+
+  Replenish();
+  return ControlFD;
+}
+
+void ClientClosed(int ClientFD) {
+  for (auto& Zygote : Zygotes) {
+    if (Zygote.ClientFD != ClientFD) {
+      continue;
+    }
+
+    // The client only goes away early if it was SIGKILLed, the program it handed over goes down with it.
+    Zygote.ClientFD = -1;
+    kill(Zygote.PID, SIGKILL);
+  }
+}
+
+void Shutdown() {
+  PoolSize = 0;
+  for (auto& Zygote : Zygotes) {
+    if (!Zygote.Claimed) {
+      // Idle zygotes exit once they see their socket close.
+      close(std::exchange(Zygote.ControlFD, -1));
+      Zygote.Claimed = true;
+    }
+  }
+}
+} // namespace ZygotePool
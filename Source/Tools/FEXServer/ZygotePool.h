@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#include <cstdint>
+
+namespace fasio {
+struct poll_reactor;
+}
+
+namespace ZygotePool {
+/**
+ * @brief Starts the number of zygotes that the ZygotePool config asks for.
+ *
+ * Zygotes are FEXInterpreter processes that initialized everything that doesn't depend on the program they are going to run.
+ * New FEX processes hand themselves over to one of them instead of initializing themselves.
+ */
+void Initialize(fasio::poll_reactor& Reactor);
+
+/**
+ * @brief Hands an idle zygote over to a client and starts a replacement.
+ *
+ * The zygote's exit status gets sent to the client once it exits.
+ *
+ * @return Socket connected to the zygote that the caller needs to pass on and close, -1 if no zygote was idle.
+ */
+int Claim(int ClientFD, int32_t* PID);
+
+/**
+ * @brief Kills the zygote a client was running in if the client went away without waiting for it.
+ */
+void ClientClosed(int ClientFD);
+
+/**
+ * @brief Lets idle zygotes know that they aren't going to be used.
+ */
+void Shutdown();
+} // namespace ZygotePool
@@ -9,6 +9,7 @@ $end_info$
 #include "Common/Config.h"
 #include "Common/FDUtils.h"
 #include "Common/JSONPool.h"
+#include "Common/StartupTrace.h"
 
 #include "FEXCore/Config/Config.h"
 #include "LinuxSyscalls/FileManagement.h"
@@ -318,6 +319,7 @@ FileManager::FileManager(FEXCore::Context::Context* ctx)
     DBObjectHandler.SetupOverlay(DBObject.second);
     DBObjectHandler.InsertDependencies(DBObject.second.Depends);
   }
+  FEX::StartupTrace::Mark(FEX::StartupTrace::Phase::ThunkDatabaseLoaded);
 
   if (false) {
     // Useful for debugging
@@ -0,0 +1,334 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Sampling profiler that attributes host time to guest code
+$end_info$
+*/
+
+#include "ArchHelpers/MContext.h"
+#include "LinuxSyscalls/GuestSampler.h"
+#include "LinuxSyscalls/SignalDelegator.h"
+#include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/ThreadManager.h"
+
+#include <FEXCore/Core/CodeCache.h>
+#include <FEXCore/Core/Context.h>
+#include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/Utils/AllocatorHooks.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXHeaderUtils/Filesystem.h>
+#include <FEXHeaderUtils/Syscalls.h>
+
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <shared_mutex>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace FEX::HLE {
+static void* ThreadHandler(void* Arg) {
+  FEXCore::Threads::SetThreadName("FEX:GuestSampler");
+  reinterpret_cast<GuestSampler*>(Arg)->DrainLoop();
+  return nullptr;
+}
+
+static std::string_view GetBucketName(uint64_t Bucket) {
+  switch (Bucket) {
+  case 1: return "jit";
+  case 2: return "dispatcher";
+  case 3: return "compile";
+  case 4: return "syscall";
+  case 5: return "fallback";
+  default: return "unknown";
+  }
+}
+
+GuestSampler::GuestSampler(FEXCore::Context::Context* CTX, SyscallHandler* Handler)
+  : CTX {CTX}
+  , Handler {Handler} {
+  Enabled = !GuestProfile().empty();
+
+  if (Enabled) {
+    StartThread();
+  }
+}
+
+GuestSampler::~GuestSampler() {
+  ShouldStop = true;
+  if (DrainThread && DrainThread->joinable()) {
+    DrainThread->join(nullptr);
+  }
+}
+
+void GuestSampler::StartThread() {
+  // The drain thread must never receive a guest signal.
+  uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
+  DrainThread = FEXCore::Threads::Thread::Create(ThreadHandler, this);
+  FEXCore::Threads::SetSignalMask(OldMask);
+}
+
+void GuestSampler::ArmTimer(GuestSampleRing* Ring) {
+  sigevent Event {};
+  Event.sigev_notify = SIGEV_THREAD_ID;
+  Event.sigev_signo = SignalDelegator::SIGNAL_FOR_PAUSE;
+  Event.sigev_notify_thread_id = FHU::Syscalls::gettid();
+
+  // Only counts while the thread is running, blocked threads don't generate samples.
+  if (timer_create(CLOCK_THREAD_CPUTIME_ID, &Event, &Ring->Timer) != 0) {
+    LogMan::Msg::EFmt("Guest profiler: Couldn't create sampling timer: {}", strerror(errno));
+    return;
+  }
+
+  const itimerspec Spec {
+    .it_interval = {.tv_sec = 0, .tv_nsec = SamplePeriodNS},
+    .it_value = {.tv_sec = 0, .tv_nsec = SamplePeriodNS},
+  };
+  timer_settime(Ring->Timer, 0, &Spec, nullptr);
+  Ring->HasTimer = true;
+}
+
+void GuestSampler::DisarmTimer(GuestSampleRing* Ring) {
+  if (Ring->HasTimer) {
+    timer_delete(Ring->Timer);
+    Ring->HasTimer = false;
+  }
+}
+
+void GuestSampler::RegisterThread(ThreadStateObject* Thread) {
+  // A fork child reuses the parent's thread object, which already had its ring re-armed in UnlockAfterFork.
+  if (!Enabled || Thread->SamplerRing) {
+    return;
+  }
+
+  auto Ring = reinterpret_cast<GuestSampleRing*>(FEXCore::Allocator::VirtualAlloc(sizeof(GuestSampleRing)));
+  if (Ring == MAP_FAILED) {
+    return;
+  }
+  FEXCore::Allocator::VirtualName("FEXMem_Misc", Ring, sizeof(GuestSampleRing));
+
+  {
+    auto lk = FEXCore::GuardSignalDeferringSectionWithFallback(SampleMutex, Thread->Thread);
+    Rings.emplace_back(Ring);
+  }
+
+  Thread->SamplerRing = Ring;
+  ArmTimer(Ring);
+}
+
+void GuestSampler::UnregisterThread(ThreadStateObject* Thread) {
+  auto Ring = Thread->SamplerRing;
+  if (!Ring) {
+    return;
+  }
+
+  DisarmTimer(Ring);
+  Thread->SamplerRing = nullptr;
+
+  RawSamples Raw;
+  {
+    auto lk = FEXCore::GuardSignalDeferringSectionWithFallback(SampleMutex, Thread->Thread);
+    Drain(Ring, Raw);
+    std::erase(Rings, Ring);
+  }
+
+  Fold(Thread->Thread, Raw);
+  FEXCore::Allocator::VirtualFree(Ring, sizeof(GuestSampleRing));
+}
+
+bool GuestSampler::HandleSample(FEXCore::Core::InternalThreadState* Thread, void* ucontext) {
+  auto ThreadObject = FEX::HLE::ThreadManager::GetStateObjectFromFEXCoreThread(Thread);
+  auto Ring = ThreadObject->SamplerRing;
+  if (!Ring) {
+    // Timer signal that was already pending when sampling stopped
+    return true;
+  }
+
+  const auto PC = ArchHelpers::Context::GetPc(ucontext);
+  const auto Frame = Thread->CurrentFrame;
+  const auto& Config = ThreadObject->SignalInfo.Delegator->GetConfig();
+
+  uint64_t Bucket {};
+  uint64_t RIP {};
+  if (Frame->InSyscallInfo != 0) {
+    Bucket = BUCKET_SYSCALL;
+    RIP = Frame->State.rip;
+  } else if (Thread->Compiling.load(std::memory_order_relaxed)) {
+    Bucket = BUCKET_COMPILE;
+    RIP = Frame->State.rip;
+  } else if (PC >= Config.DispatcherBegin && PC < Config.DispatcherEnd) {
+    Bucket = BUCKET_DISPATCHER;
+    RIP = Frame->State.rip;
+  } else if (CTX->IsAddressInCodeBuffer(Thread, PC)) {
+    Bucket = BUCKET_JIT;
+    RIP = CTX->RestoreRIPFromHostPC(Thread, PC);
+  } else {
+    Bucket = BUCKET_FALLBACK;
+#ifdef _M_ARM_64
+    // Attribute to the guest instruction that called out of the JIT, when the link register still points in to the block.
+    RIP = CTX->RestoreRIPFromHostPC(Thread, ArchHelpers::Context::GetArmReg(ucontext, 30));
+#else
+    RIP = Frame->State.rip;
+#endif
+  }
+
+  const auto Head = Ring->Head.load(std::memory_order_relaxed);
+  if (Head - Ring->Tail.load(std::memory_order_acquire) >= GuestSampleRing::NumSamples) {
+    Ring->Dropped.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  Ring->Samples[Head % GuestSampleRing::NumSamples] = (RIP << 3) | Bucket;
+  Ring->Head.store(Head + 1, std::memory_order_release);
+  return true;
+}
+
+void GuestSampler::Drain(GuestSampleRing* Ring, RawSamples& Raw) {
+  const auto Head = Ring->Head.load(std::memory_order_acquire);
+  auto Tail = Ring->Tail.load(std::memory_order_relaxed);
+  for (; Tail != Head; ++Tail) {
+    ++Raw[Ring->Samples[Tail % GuestSampleRing::NumSamples]];
+  }
+  Ring->Tail.store(Tail, std::memory_order_release);
+  Dropped += Ring->Dropped.exchange(0, std::memory_order_relaxed);
+}
+
+void GuestSampler::DrainAll(RawSamples& Raw) {
+  for (auto Ring : Rings) {
+    Drain(Ring, Raw);
+  }
+}
+
+void GuestSampler::Fold(FEXCore::Core::InternalThreadState* Thread, const RawSamples& Raw) {
+  if (Raw.empty()) {
+    return;
+  }
+
+  fextl::map<fextl::string, uint64_t> Resolved;
+  {
+    // Resolved before the mapping can go away, the profile only keeps the file names and offsets.
+    auto lk = FEXCore::GuardSignalDeferringSectionWithFallback<std::shared_lock>(Handler->VMATracking.Mutex, Thread);
+
+    for (auto [Key, Count] : Raw) {
+      const uint64_t RIP = Key >> 3;
+      const auto BucketName = GetBucketName(Key & 7);
+
+      auto Entry = Handler->VMATracking.FindVMAEntry(RIP);
+      if (Entry != Handler->VMATracking.VMAs.end() && Entry->second.Resource && Entry->second.Resource->MappedFile) {
+        const auto& Filename = Entry->second.Resource->MappedFile->Filename;
+        const auto Offset = RIP - Entry->second.Resource->FirstVMA->Base;
+        Resolved[fextl::fmt::format("{};{};{}+{:#x}", BucketName, Filename, FHU::Filesystem::GetFilename(Filename), Offset)] += Count;
+      } else {
+        Resolved[fextl::fmt::format("{};[unknown];{:#x}", BucketName, RIP)] += Count;
+      }
+    }
+  }
+
+  auto lk = FEXCore::GuardSignalDeferringSectionWithFallback(SampleMutex, Thread);
+  for (auto& [Stack, Count] : Resolved) {
+    Folded[Stack] += Count;
+  }
+}
+
+void GuestSampler::DrainLoop() {
+  RawSamples Raw;
+
+  while (!ShouldStop.load(std::memory_order_relaxed)) {
+    const timespec Period {.tv_sec = 0, .tv_nsec = DrainPeriodNS};
+    nanosleep(&Period, nullptr);
+
+    Raw.clear();
+    {
+      std::lock_guard lk(SampleMutex);
+      DrainAll(Raw);
+    }
+
+    Fold(nullptr, Raw);
+  }
+}
+
+void GuestSampler::Persist(FEXCore::Core::InternalThreadState* Thread) {
+  if (!Enabled) {
+    return;
+  }
+
+  RawSamples Raw;
+  {
+    auto lk = FEXCore::GuardSignalDeferringSectionWithFallback(SampleMutex, Thread);
+    DrainAll(Raw);
+  }
+  Fold(Thread, Raw);
+
+  auto lk = FEXCore::GuardSignalDeferringSectionWithFallback(SampleMutex, Thread);
+  if (Folded.empty()) {
+    return;
+  }
+
+  fextl::string Data;
+  for (auto& [Stack, Count] : Folded) {
+    Data += fextl::fmt::format("{} {}\n", Stack, Count);
+  }
+  if (Dropped) {
+    Data += fextl::fmt::format("[dropped] {}\n", Dropped);
+  }
+
+  FEX_CONFIG_OPT(AppFilename, APP_FILENAME);
+  const auto Path = fextl::fmt::format("{}/{}-{}.folded", GuestProfile(), FHU::Filesystem::GetFilename(AppFilename()), ::getpid());
+  FHU::Filesystem::CreateDirectories(GuestProfile());
+
+  int FD = open(Path.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, 0644);
+  if (FD == -1) {
+    LogMan::Msg::EFmt("Guest profiler: Couldn't write {}", Path);
+    return;
+  }
+
+  if (write(FD, Data.data(), Data.size()) != static_cast<ssize_t>(Data.size())) {
+    LogMan::Msg::EFmt("Guest profiler: Couldn't write {}", Path);
+  }
+  close(FD);
+}
+
+void GuestSampler::LockBeforeFork() {
+  SampleMutex.lock();
+}
+
+void GuestSampler::UnlockAfterFork(ThreadStateObject* LiveThread, bool Child) {
+  if (!Child) {
+    SampleMutex.unlock();
+    return;
+  }
+
+  SampleMutex.StealAndDropActiveLocks();
+
+  if (!Enabled) {
+    return;
+  }
+
+  // Samples taken before the fork belong to the parent's profile.
+  // Rings of threads that don't exist in the child are leaked along with the rest of their state.
+  Folded.clear();
+  Dropped = 0;
+  Rings.clear();
+
+  // Timers and the drain thread aren't inherited, the stale thread object can't be joined so it is leaked.
+  (void)DrainThread.release();
+  ShouldStop = false;
+  StartThread();
+
+  if (auto Ring = LiveThread->SamplerRing) {
+    Ring->Tail.store(Ring->Head.load());
+    Ring->Dropped = 0;
+    Ring->HasTimer = false;
+    Rings.emplace_back(Ring);
+    ArmTimer(Ring);
+  }
+}
+
+} // namespace FEX::HLE
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Sampling profiler that attributes host time to guest code
+$end_info$
+*/
+#pragma once
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/SignalScopeGuards.h>
+#include <FEXCore/Utils/Threads.h>
+#include <FEXCore/fextl/map.h>
+#include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <atomic>
+#include <cstdint>
+#include <time.h>
+
+namespace FEXCore {
+namespace Context {
+  class Context;
+}
+namespace Core {
+  struct InternalThreadState;
+}
+} // namespace FEXCore
+
+namespace FEX::HLE {
+class SyscallHandler;
+struct ThreadStateObject;
+
+/**
+ * Per-thread ring of raw samples.
+ *
+ * Only the sampling signal handler of the owning thread produces samples, consumers are serialized by
+ * GuestSampler::SampleMutex.
+ */
+struct GuestSampleRing {
+  constexpr static uint32_t NumSamples = 4096;
+
+  timer_t Timer;
+  bool HasTimer;
+  std::atomic<uint32_t> Head;
+  std::atomic<uint32_t> Tail;
+  // Samples lost because the ring was full
+  std::atomic<uint64_t> Dropped;
+  // (Guest RIP << 3) | Bucket
+  uint64_t Samples[NumSamples];
+};
+
+/**
+ * Sampling profiler that tells which guest code the host time goes to.
+ *
+ * Every guest thread gets a thread CPU time timer that delivers SIGNAL_FOR_PAUSE with SI_TIMER. The handler maps the
+ * interrupted host PC back to a guest RIP and records it in one of these buckets:
+ * - jit: Executing generated code
+ * - dispatcher: Looking up or linking blocks
+ * - compile: Compiling guest code
+ * - syscall: Emulating a guest syscall
+ * - fallback: Host code called from generated code, like interpreter fallbacks and thunks
+ *
+ * A background thread periodically drains the per-thread rings and resolves the samples to `<executable file>+<offset>`
+ * while the mappings are still alive. The profile is written in the folded stack format to
+ * `<GuestProfile>/<application>-<pid>.folded` when the process exits or execs, ready for flamegraph.pl or speedscope.
+ */
+class GuestSampler final {
+public:
+  GuestSampler(FEXCore::Context::Context* CTX, SyscallHandler* Handler);
+  ~GuestSampler();
+
+  bool IsEnabled() const {
+    return Enabled;
+  }
+
+  // Starts sampling the calling thread.
+  void RegisterThread(ThreadStateObject* Thread);
+  // Stops sampling the calling thread and folds its samples in to the process profile.
+  void UnregisterThread(ThreadStateObject* Thread);
+
+  // Records a sample of the interrupted thread, called from the SIGNAL_FOR_PAUSE handler for SI_TIMER signals.
+  bool HandleSample(FEXCore::Core::InternalThreadState* Thread, void* ucontext);
+
+  // Folds the samples of all threads and writes the profile.
+  void Persist(FEXCore::Core::InternalThreadState* Thread);
+
+  void LockBeforeFork();
+  void UnlockAfterFork(ThreadStateObject* LiveThread, bool Child);
+
+  // Public for threading
+  void DrainLoop();
+
+private:
+  enum Bucket : uint8_t {
+    BUCKET_JIT = 1,
+    BUCKET_DISPATCHER,
+    BUCKET_COMPILE,
+    BUCKET_SYSCALL,
+    BUCKET_FALLBACK,
+  };
+
+  using RawSamples = fextl::unordered_map<uint64_t, uint64_t>;
+
+  constexpr static uint64_t SamplePeriodNS = 1'000'000;
+  constexpr static uint64_t DrainPeriodNS = 100'000'000;
+
+  void StartThread();
+  void ArmTimer(GuestSampleRing* Ring);
+  void DisarmTimer(GuestSampleRing* Ring);
+  // SampleMutex must be locked before calling
+  void Drain(GuestSampleRing* Ring, RawSamples& Raw);
+  void DrainAll(RawSamples& Raw);
+  // Resolves the samples and adds them to the profile, takes VMATracking.Mutex and SampleMutex.
+  void Fold(FEXCore::Core::InternalThreadState* Thread, const RawSamples& Raw);
+
+  FEXCore::Context::Context* CTX;
+  SyscallHandler* Handler;
+
+  FEX_CONFIG_OPT(GuestProfile, GUESTPROFILE);
+  bool Enabled {};
+
+  // Protects Rings, Folded and Dropped
+  FEXCore::ForkableUniqueMutex SampleMutex;
+  fextl::vector<GuestSampleRing*> Rings;
+  // Folded stack to sample count
+  fextl::map<fextl::string, uint64_t> Folded;
+  uint64_t Dropped {};
+
+  std::atomic<bool> ShouldStop {};
+  fextl::unique_ptr<FEXCore::Threads::Thread> DrainThread;
+};
+} // namespace FEX::HLE
@@ -0,0 +1,647 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Redirects hot guest glibc string and math routines to their host implementations
+$end_info$
+*/
+
+#include "LinuxSyscalls/HostLibcRoutines.h"
+#include "LinuxSyscalls/Syscalls.h"
+#include "Thunks.h"
+
+#include <FEXCore/Core/Context.h>
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/TypeDefines.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <elf.h>
+#include <mutex>
+#include <optional>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace FEX::HLE {
+namespace {
+  using FEXCore::Context::HostFunctionABI;
+
+  // Layout of the argument block passed by AddHostFunctionIRHandler
+  struct ArgsRV_t {
+    uint64_t Args[6];
+    uint64_t rv;
+  };
+
+  // Layout of the argument block passed by AddHostFunctionIRHandler with HostFunctionABI::Vector
+  struct VectorArgsRV_t {
+    uint64_t Args[6];
+    uint64_t rv;
+    uint64_t Pad;
+    union {
+      double F64[2];
+      float F32[4];
+      uint64_t U64[2];
+    } XMM[3];
+  };
+  static_assert(offsetof(VectorArgsRV_t, XMM) == 64);
+
+  void HostMemmove(void* ArgsRV) {
+    auto Args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+    Args->rv = reinterpret_cast<uint64_t>(
+      ::memmove(reinterpret_cast<void*>(Args->Args[0]), reinterpret_cast<const void*>(Args->Args[1]), Args->Args[2]));
+  }
+
+  void HostMemset(void* ArgsRV) {
+    auto Args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+    Args->rv =
+      reinterpret_cast<uint64_t>(::memset(reinterpret_cast<void*>(Args->Args[0]), static_cast<int>(Args->Args[1]), Args->Args[2]));
+  }
+
+  void HostStrlen(void* ArgsRV) {
+    auto Args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+    Args->rv = ::strlen(reinterpret_cast<const char*>(Args->Args[0]));
+  }
+
+  void HostMemcmp(void* ArgsRV) {
+    auto Args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+    Args->rv = static_cast<int64_t>(
+      ::memcmp(reinterpret_cast<const void*>(Args->Args[0]), reinterpret_cast<const void*>(Args->Args[1]), Args->Args[2]));
+  }
+
+  void HostStrchr(void* ArgsRV) {
+    auto Args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+    Args->rv = reinterpret_cast<uint64_t>(::strchr(reinterpret_cast<const char*>(Args->Args[0]), static_cast<int>(Args->Args[1])));
+  }
+
+  // Scalar libm functions take and return their values in the low lanes of XMM0 and XMM1.
+  template<double (*Fn)(double)>
+  void HostF64(void* ArgsRV) {
+    auto Args = reinterpret_cast<VectorArgsRV_t*>(ArgsRV);
+    Args->XMM[0].F64[0] = Fn(Args->XMM[0].F64[0]);
+  }
+
+  template<double (*Fn)(double, double)>
+  void HostF64F64(void* ArgsRV) {
+    auto Args = reinterpret_cast<VectorArgsRV_t*>(ArgsRV);
+    Args->XMM[0].F64[0] = Fn(Args->XMM[0].F64[0], Args->XMM[1].F64[0]);
+  }
+
+  template<float (*Fn)(float)>
+  void HostF32(void* ArgsRV) {
+    auto Args = reinterpret_cast<VectorArgsRV_t*>(ArgsRV);
+    Args->XMM[0].F32[0] = Fn(Args->XMM[0].F32[0]);
+  }
+
+  template<float (*Fn)(float, float)>
+  void HostF32F32(void* ArgsRV) {
+    auto Args = reinterpret_cast<VectorArgsRV_t*>(ArgsRV);
+    Args->XMM[0].F32[0] = Fn(Args->XMM[0].F32[0], Args->XMM[1].F32[0]);
+  }
+
+  void HostSincos(void* ArgsRV) {
+    auto Args = reinterpret_cast<VectorArgsRV_t*>(ArgsRV);
+    ::sincos(Args->XMM[0].F64[0], reinterpret_cast<double*>(Args->Args[0]), reinterpret_cast<double*>(Args->Args[1]));
+  }
+
+  void HostSincosf(void* ArgsRV) {
+    auto Args = reinterpret_cast<VectorArgsRV_t*>(ArgsRV);
+    ::sincosf(Args->XMM[0].F32[0], reinterpret_cast<float*>(Args->Args[0]), reinterpret_cast<float*>(Args->Args[1]));
+  }
+
+  // libmvec's SSE variants are evaluated lane by lane, so they match the scalar functions exactly.
+  template<double (*Fn)(double)>
+  void HostV2F64(void* ArgsRV) {
+    auto Args = reinterpret_cast<VectorArgsRV_t*>(ArgsRV);
+    for (size_t i = 0; i < 2; ++i) {
+      Args->XMM[0].F64[i] = Fn(Args->XMM[0].F64[i]);
+    }
+  }
+
+  template<double (*Fn)(double, double)>
+  void HostV2F64F64(void* ArgsRV) {
+    auto Args = reinterpret_cast<VectorArgsRV_t*>(ArgsRV);
+    for (size_t i = 0; i < 2; ++i) {
+      Args->XMM[0].F64[i] = Fn(Args->XMM[0].F64[i], Args->XMM[1].F64[i]);
+    }
+  }
+
+  template<float (*Fn)(float)>
+  void HostV4F32(void* ArgsRV) {
+    auto Args = reinterpret_cast<VectorArgsRV_t*>(ArgsRV);
+    for (size_t i = 0; i < 4; ++i) {
+      Args->XMM[0].F32[i] = Fn(Args->XMM[0].F32[i]);
+    }
+  }
+
+  template<float (*Fn)(float, float)>
+  void HostV4F32F32(void* ArgsRV) {
+    auto Args = reinterpret_cast<VectorArgsRV_t*>(ArgsRV);
+    for (size_t i = 0; i < 4; ++i) {
+      Args->XMM[0].F32[i] = Fn(Args->XMM[0].F32[i], Args->XMM[1].F32[i]);
+    }
+  }
+
+  // The result pointers of both lanes are passed in XMM1 and XMM2.
+  void HostV2Sincos(void* ArgsRV) {
+    auto Args = reinterpret_cast<VectorArgsRV_t*>(ArgsRV);
+    for (size_t i = 0; i < 2; ++i) {
+      ::sincos(Args->XMM[0].F64[i], reinterpret_cast<double*>(Args->XMM[1].U64[i]), reinterpret_cast<double*>(Args->XMM[2].U64[i]));
+    }
+  }
+
+  enum class Library {
+    Libc,
+    Libm,
+    Libmvec,
+  };
+
+  struct Routine {
+    Library Lib;
+    std::string_view Name;
+    FEXCore::IR::ThunkDefinition Definition;
+    HostFunctionABI ABI;
+  };
+
+  // glibc's x86-64 memcpy shares its implementation with memmove and old binaries depend on it tolerating overlap.
+  // libm's exp, log and pow are wrappers that set errno and call the __*_finite IFUNCs, which get replaced instead.
+  const std::array<Routine, 44> Routines = {{
+    {Library::Libc,
+     "memcpy",
+     {// sha256(fex:libc_memcpy)
+      {0x53, 0xf2, 0x1b, 0x7c, 0xb2, 0x62, 0x59, 0xfe, 0x15, 0xc5, 0xda, 0xc5, 0x79, 0xbd, 0x42, 0xa0,
+       0x97, 0xa1, 0x13, 0x31, 0xc4, 0x4d, 0x9f, 0x3a, 0xb3, 0xfe, 0x25, 0xfb, 0x73, 0x45, 0x8e, 0x7f},
+      &HostMemmove},
+     HostFunctionABI::Integer},
+    {Library::Libc,
+     "memmove",
+     {// sha256(fex:libc_memmove)
+      {0x63, 0x8d, 0x07, 0xb5, 0x98, 0xe7, 0xf2, 0xe2, 0x59, 0xf6, 0x26, 0x18, 0xed, 0x87, 0x08, 0xa9,
+       0xf1, 0x36, 0x0a, 0x06, 0x44, 0x3a, 0xb0, 0x0c, 0xc8, 0x3b, 0xbd, 0x8a, 0xb1, 0xdc, 0x6f, 0x56},
+      &HostMemmove},
+     HostFunctionABI::Integer},
+    {Library::Libc,
+     "memset",
+     {// sha256(fex:libc_memset)
+      {0xcc, 0x79, 0xcd, 0x5e, 0x37, 0xf0, 0x9e, 0xb8, 0x0a, 0x69, 0xe6, 0x6b, 0x85, 0x8e, 0x24, 0x40,
+       0x3b, 0x55, 0x40, 0x5e, 0x9f, 0x9b, 0x98, 0x01, 0x44, 0x6f, 0xfa, 0x1c, 0x98, 0x78, 0xa8, 0x47},
+      &HostMemset},
+     HostFunctionABI::Integer},
+    {Library::Libc,
+     "strlen",
+     {// sha256(fex:libc_strlen)
+      {0x75, 0x9a, 0x48, 0x32, 0x06, 0x53, 0x5c, 0x37, 0xad, 0x26, 0x72, 0x0c, 0x5b, 0x9c, 0xad, 0x36,
+       0x98, 0x2c, 0xa5, 0xda, 0xfe, 0x02, 0x88, 0x45, 0xa1, 0x0c, 0x8e, 0xcf, 0xc0, 0xed, 0x39, 0x8b},
+      &HostStrlen},
+     HostFunctionABI::Integer},
+    {Library::Libc,
+     "memcmp",
+     {// sha256(fex:libc_memcmp)
+      {0x71, 0xea, 0x4f, 0x96, 0xb5, 0xe2, 0x07, 0x62, 0xd5, 0xf6, 0x33, 0x91, 0xef, 0x76, 0x6e, 0xff,
+       0xc5, 0x65, 0x7a, 0xe8, 0x2f, 0x10, 0xf7, 0xce, 0xdb, 0xd0, 0x7c, 0x7e, 0x3b, 0x5e, 0x6e, 0xfd},
+      &HostMemcmp},
+     HostFunctionABI::Integer},
+    {Library::Libc,
+     "strchr",
+     {// sha256(fex:libc_strchr)
+      {0xea, 0x2f, 0x84, 0xa4, 0x71, 0x6f, 0x91, 0xf6, 0xc3, 0xe1, 0x4a, 0x3c, 0x3a, 0x83, 0x63, 0xa2,
+       0x25, 0x2a, 0xf9, 0x19, 0x71, 0xa0, 0x56, 0x02, 0xdb, 0x57, 0x22, 0x05, 0xf6, 0xa2, 0x3d, 0x52},
+      &HostStrchr},
+     HostFunctionABI::Integer},
+    {Library::Libm,
+     "sin",
+     {// sha256(fex:libm_sin)
+      {0xa8, 0xf2, 0x7d, 0x53, 0x47, 0xb7, 0x84, 0xfa, 0xe5, 0x6c, 0x5e, 0x9e, 0x7c, 0xb9, 0x6a, 0x7c,
+       0x21, 0xb6, 0x48, 0x21, 0xc0, 0x3f, 0x29, 0x52, 0xd8, 0xbd, 0xd1, 0x07, 0xa4, 0x5d, 0x62, 0x44},
+      &HostF64<::sin>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "cos",
+     {// sha256(fex:libm_cos)
+      {0xf0, 0x1f, 0xf0, 0x64, 0xbd, 0x85, 0xa6, 0x2a, 0xe0, 0xa1, 0x6e, 0x4e, 0x44, 0xbd, 0x6c, 0x2c,
+       0xd0, 0x7f, 0xa3, 0x64, 0x60, 0xda, 0x66, 0x76, 0x9b, 0x23, 0x02, 0xed, 0x67, 0x9b, 0xa4, 0xcc},
+      &HostF64<::cos>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "tan",
+     {// sha256(fex:libm_tan)
+      {0xeb, 0x92, 0x2f, 0xfe, 0x4c, 0x44, 0x9a, 0x62, 0xbb, 0xc4, 0xba, 0xba, 0xc2, 0x9d, 0xab, 0x09,
+       0x7c, 0xc8, 0x55, 0x4d, 0x30, 0x7c, 0x66, 0x31, 0xa9, 0xf3, 0x0d, 0xd7, 0x37, 0x93, 0x67, 0xac},
+      &HostF64<::tan>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "atan",
+     {// sha256(fex:libm_atan)
+      {0x0b, 0xa3, 0x09, 0x1a, 0xa5, 0x7a, 0x48, 0xcd, 0x93, 0x33, 0xe0, 0x11, 0x6d, 0xc9, 0x3a, 0x74,
+       0x24, 0xfd, 0x42, 0x21, 0x0b, 0x9c, 0x76, 0xbe, 0x16, 0xa8, 0x86, 0x01, 0xbf, 0xc1, 0x37, 0x50},
+      &HostF64<::atan>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "__asin_finite",
+     {// sha256(fex:libm___asin_finite)
+      {0x1c, 0x46, 0x32, 0x39, 0xc2, 0xca, 0xf1, 0xdb, 0x32, 0x9c, 0x29, 0x2c, 0xb0, 0x07, 0x19, 0xe1,
+       0xed, 0x8f, 0xab, 0xdd, 0x07, 0x68, 0xbc, 0xce, 0x0a, 0xb7, 0xe2, 0x00, 0x92, 0x23, 0x07, 0x92},
+      &HostF64<::asin>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "__acos_finite",
+     {// sha256(fex:libm___acos_finite)
+      {0xd3, 0x48, 0x0e, 0xa3, 0x43, 0x27, 0x1e, 0xd8, 0xf3, 0x3a, 0x90, 0x37, 0xaa, 0x84, 0xd7, 0x27,
+       0xd8, 0x4a, 0x43, 0x96, 0xee, 0x15, 0xbf, 0xdc, 0x10, 0xf7, 0xde, 0x8b, 0x9f, 0x42, 0x6b, 0xbb},
+      &HostF64<::acos>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "__atan2_finite",
+     {// sha256(fex:libm___atan2_finite)
+      {0x76, 0xef, 0xb5, 0x2b, 0x86, 0xe1, 0x8e, 0x50, 0x3b, 0x42, 0xe9, 0xce, 0x30, 0xb9, 0xb4, 0x30,
+       0xb6, 0x89, 0x7a, 0xfb, 0x5b, 0xa4, 0x63, 0x32, 0x3b, 0xc0, 0xd4, 0x94, 0x80, 0x82, 0x79, 0xae},
+      &HostF64F64<::atan2>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "__exp_finite",
+     {// sha256(fex:libm___exp_finite)
+      {0xd4, 0x76, 0x83, 0x2d, 0x64, 0x2c, 0x51, 0xa1, 0x03, 0x2e, 0x90, 0x5a, 0xbf, 0x64, 0xcf, 0xdf,
+       0x5b, 0x26, 0xc3, 0xb7, 0x49, 0x35, 0x3d, 0x7c, 0xe5, 0xe1, 0x9a, 0xe8, 0x17, 0x3e, 0x95, 0x28},
+      &HostF64<::exp>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "expm1",
+     {// sha256(fex:libm_expm1)
+      {0xaf, 0x2c, 0x37, 0x7c, 0x24, 0xe3, 0xa2, 0xcd, 0x92, 0x09, 0x7b, 0xb1, 0x6b, 0x60, 0xd6, 0x26,
+       0x74, 0x73, 0xe9, 0xbd, 0x5e, 0xe0, 0x91, 0xfe, 0xe3, 0x16, 0x9a, 0x5b, 0x03, 0x71, 0x37, 0xc8},
+      &HostF64<::expm1>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "__log_finite",
+     {// sha256(fex:libm___log_finite)
+      {0x4e, 0x5b, 0x1b, 0x3a, 0x5f, 0x7d, 0x3e, 0xd7, 0xba, 0x30, 0x84, 0xce, 0x51, 0xb1, 0xc1, 0x9c,
+       0xb4, 0x8f, 0x5f, 0xa4, 0xd5, 0x62, 0x1c, 0xee, 0x99, 0x83, 0x5d, 0x47, 0x2e, 0xef, 0x3f, 0x97},
+      &HostF64<::log>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "log2",
+     {// sha256(fex:libm_log2)
+      {0x49, 0x83, 0xc4, 0xbe, 0x00, 0xc5, 0x7f, 0x63, 0xaa, 0xbc, 0x9a, 0xd2, 0x95, 0x83, 0x13, 0x7a,
+       0xf0, 0xf0, 0xf6, 0x32, 0x32, 0xb9, 0xd2, 0x05, 0x04, 0x62, 0xec, 0xaa, 0xe9, 0x9a, 0x2d, 0xca},
+      &HostF64<::log2>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "__log2_finite",
+     {// sha256(fex:libm___log2_finite)
+      {0x70, 0xdd, 0x71, 0xcc, 0x49, 0x87, 0xd5, 0x78, 0x1e, 0xf5, 0xac, 0xef, 0xcb, 0xee, 0x64, 0xaa,
+       0x9e, 0xf2, 0x87, 0x03, 0xa8, 0xde, 0xa9, 0xfd, 0xea, 0xbc, 0xa2, 0x2f, 0x19, 0xb0, 0x45, 0x54},
+      &HostF64<::log2>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "__pow_finite",
+     {// sha256(fex:libm___pow_finite)
+      {0x60, 0x0d, 0x8d, 0xcf, 0x46, 0x83, 0xa0, 0xf7, 0xf4, 0xfc, 0x99, 0xed, 0xc2, 0x47, 0x7c, 0x26,
+       0x1c, 0x63, 0xcc, 0x1c, 0x95, 0xbb, 0xcc, 0x89, 0xcf, 0x14, 0x0f, 0x6e, 0xfc, 0x33, 0xc3, 0x41},
+      &HostF64F64<::pow>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "sincos",
+     {// sha256(fex:libm_sincos)
+      {0x95, 0xc4, 0x19, 0x12, 0xf5, 0x96, 0x0e, 0x2e, 0xf5, 0x51, 0x2f, 0xad, 0x38, 0x7c, 0x5e, 0xb6,
+       0x27, 0x52, 0xc9, 0x2d, 0x16, 0x0c, 0x2a, 0x37, 0x03, 0x26, 0xd6, 0x78, 0x1e, 0x2b, 0x1c, 0xb4},
+      &HostSincos},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "sinf",
+     {// sha256(fex:libm_sinf)
+      {0x6b, 0x97, 0x56, 0x2c, 0xfa, 0x5a, 0x10, 0xf9, 0x1b, 0xe3, 0x40, 0xa2, 0xaf, 0x45, 0x4c, 0x0d,
+       0xe8, 0x75, 0xdc, 0xa3, 0x2e, 0x30, 0x96, 0x1f, 0x4a, 0x35, 0x67, 0xa0, 0x6d, 0x8d, 0xfe, 0x72},
+      &HostF32<::sinf>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "cosf",
+     {// sha256(fex:libm_cosf)
+      {0x5e, 0xdb, 0x13, 0x8b, 0x9f, 0x6d, 0x8f, 0xbe, 0x71, 0xef, 0xbe, 0x6b, 0xc7, 0xfb, 0x7e, 0x6b,
+       0x97, 0xf4, 0x31, 0x6c, 0xff, 0x2f, 0x4a, 0xfe, 0xed, 0x39, 0x77, 0xaa, 0x3c, 0x8f, 0x32, 0xca},
+      &HostF32<::cosf>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "sincosf",
+     {// sha256(fex:libm_sincosf)
+      {0x66, 0xb3, 0x74, 0x16, 0x65, 0x70, 0xca, 0x11, 0x1d, 0xbf, 0x62, 0x81, 0x29, 0x5d, 0x02, 0x0e,
+       0x73, 0x34, 0x34, 0x54, 0x6c, 0x8f, 0xb1, 0x15, 0x36, 0x1e, 0x9b, 0x7a, 0x38, 0x9d, 0xb1, 0x5a},
+      &HostSincosf},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "expf",
+     {// sha256(fex:libm_expf)
+      {0x72, 0xba, 0x38, 0x32, 0x36, 0xee, 0x8d, 0x0c, 0x7b, 0x3e, 0x10, 0x59, 0x62, 0xa7, 0x4f, 0xa9,
+       0x16, 0x29, 0x5e, 0xab, 0x8f, 0x15, 0xf7, 0xac, 0xd3, 0xc3, 0x5c, 0x50, 0x3c, 0x1d, 0xa8, 0x2c},
+      &HostF32<::expf>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "__expf_finite",
+     {// sha256(fex:libm___expf_finite)
+      {0xc0, 0x84, 0xb7, 0x52, 0x25, 0x4a, 0x0a, 0xac, 0x27, 0x29, 0x98, 0xc1, 0x30, 0xbb, 0x47, 0x45,
+       0x66, 0x92, 0xb0, 0xe9, 0xfc, 0x81, 0xc1, 0x3f, 0xdb, 0x30, 0xb9, 0x67, 0x9f, 0x8b, 0xc2, 0x8e},
+      &HostF32<::expf>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "exp2f",
+     {// sha256(fex:libm_exp2f)
+      {0xae, 0x68, 0x21, 0x11, 0x7a, 0x8e, 0x39, 0xc7, 0xbf, 0x1f, 0x6c, 0x26, 0x44, 0xf3, 0x97, 0xca,
+       0xb2, 0x16, 0x46, 0x2b, 0x10, 0xf8, 0x3b, 0xf4, 0xca, 0x18, 0x8b, 0x6d, 0x36, 0xe8, 0x87, 0xd9},
+      &HostF32<::exp2f>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "__exp2f_finite",
+     {// sha256(fex:libm___exp2f_finite)
+      {0xf6, 0x63, 0x89, 0x35, 0x2a, 0x9b, 0xc9, 0x3d, 0x5a, 0x66, 0x2e, 0xe8, 0xbc, 0x3c, 0x7a, 0x46,
+       0x8d, 0x24, 0x2e, 0x9b, 0x9c, 0x34, 0x35, 0xa5, 0x8c, 0xdc, 0x9c, 0xf8, 0x30, 0x29, 0xd2, 0xf6},
+      &HostF32<::exp2f>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "logf",
+     {// sha256(fex:libm_logf)
+      {0x91, 0x5d, 0xba, 0xf0, 0xd6, 0x77, 0x87, 0x2c, 0x64, 0xa6, 0xd9, 0xf2, 0x94, 0x45, 0xc5, 0x58,
+       0x7b, 0x57, 0xd9, 0x38, 0x62, 0x35, 0x4f, 0x73, 0x85, 0x09, 0x7f, 0x50, 0x23, 0xb1, 0x8f, 0x8e},
+      &HostF32<::logf>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "__logf_finite",
+     {// sha256(fex:libm___logf_finite)
+      {0xec, 0xab, 0x36, 0x22, 0xb0, 0x40, 0xdf, 0x65, 0x8b, 0xba, 0x2e, 0x59, 0x20, 0x86, 0x6e, 0xc4,
+       0x06, 0x5b, 0x3a, 0xbf, 0x87, 0x85, 0x92, 0x8e, 0xd2, 0xc5, 0xe9, 0xe2, 0x70, 0x26, 0xbd, 0x47},
+      &HostF32<::logf>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "log2f",
+     {// sha256(fex:libm_log2f)
+      {0xfb, 0x62, 0x56, 0xde, 0x88, 0x50, 0x46, 0xe8, 0xb8, 0x70, 0x53, 0x22, 0xf5, 0x3c, 0x4a, 0x18,
+       0xbc, 0x14, 0xfe, 0x28, 0xed, 0x6e, 0x76, 0x4f, 0x10, 0x3f, 0x79, 0xe2, 0x99, 0x49, 0x46, 0xbf},
+      &HostF32<::log2f>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "__log2f_finite",
+     {// sha256(fex:libm___log2f_finite)
+      {0x67, 0x44, 0xf3, 0x44, 0x7a, 0x57, 0x3c, 0x2c, 0x95, 0x87, 0x7a, 0x2c, 0x7a, 0x30, 0x75, 0x11,
+       0x91, 0x24, 0x31, 0x56, 0x8c, 0x51, 0x26, 0x17, 0x87, 0x0c, 0x0b, 0xb6, 0xd7, 0x6c, 0x63, 0x9f},
+      &HostF32<::log2f>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "powf",
+     {// sha256(fex:libm_powf)
+      {0x21, 0x2e, 0xa8, 0x4f, 0xe0, 0xf1, 0x22, 0xfc, 0x8a, 0xd5, 0x35, 0x44, 0x61, 0x2d, 0xc0, 0x4b,
+       0x66, 0x0a, 0xa4, 0x98, 0x8e, 0xad, 0x11, 0x83, 0x1d, 0x5b, 0xea, 0x83, 0xae, 0x56, 0x7a, 0xdc},
+      &HostF32F32<::powf>},
+     HostFunctionABI::Vector},
+    {Library::Libm,
+     "__powf_finite",
+     {// sha256(fex:libm___powf_finite)
+      {0x22, 0x17, 0x37, 0x37, 0x48, 0x8e, 0x96, 0xc1, 0x5f, 0x52, 0x0e, 0x06, 0x04, 0xc6, 0x6f, 0x63,
+       0xbc, 0xc4, 0xd4, 0x30, 0xcc, 0x03, 0x3e, 0x87, 0x22, 0x0d, 0xad, 0x28, 0xe5, 0xba, 0xf8, 0xa0},
+      &HostF32F32<::powf>},
+     HostFunctionABI::Vector},
+    {Library::Libmvec,
+     "_ZGVbN2v_sin",
+     {// sha256(fex:libmvec__ZGVbN2v_sin)
+      {0x75, 0x18, 0x93, 0xaa, 0x1e, 0x7d, 0xf8, 0x96, 0x65, 0x88, 0xae, 0x71, 0xe3, 0x37, 0x68, 0x19,
+       0xb2, 0x79, 0x87, 0x47, 0x7d, 0x6c, 0xeb, 0xac, 0x07, 0x8d, 0x68, 0xfa, 0x07, 0xfb, 0xea, 0xbe},
+      &HostV2F64<::sin>},
+     HostFunctionABI::Vector},
+    {Library::Libmvec,
+     "_ZGVbN2v_cos",
+     {// sha256(fex:libmvec__ZGVbN2v_cos)
+      {0x0a, 0xda, 0xe1, 0x8d, 0x92, 0xbd, 0x39, 0xf1, 0x3f, 0x16, 0x9b, 0x5a, 0x25, 0xfc, 0x98, 0x37,
+       0x5d, 0xb8, 0x5e, 0x4b, 0xb5, 0x7b, 0x8e, 0x09, 0x86, 0xf1, 0xb6, 0x10, 0xfe, 0x80, 0xfc, 0x23},
+      &HostV2F64<::cos>},
+     HostFunctionABI::Vector},
+    {Library::Libmvec,
+     "_ZGVbN2v_exp",
+     {// sha256(fex:libmvec__ZGVbN2v_exp)
+      {0xfc, 0x86, 0x5c, 0x84, 0x53, 0xfd, 0x94, 0x79, 0x01, 0x4a, 0x71, 0xbb, 0xb9, 0xa6, 0x94, 0x8c,
+       0x0c, 0xc6, 0xe2, 0xf3, 0xe7, 0xc9, 0x66, 0x1a, 0x34, 0x7c, 0x48, 0xea, 0x5b, 0x16, 0x16, 0xd4},
+      &HostV2F64<::exp>},
+     HostFunctionABI::Vector},
+    {Library::Libmvec,
+     "_ZGVbN2v_log",
+     {// sha256(fex:libmvec__ZGVbN2v_log)
+      {0xbf, 0x19, 0xb9, 0x63, 0x20, 0x38, 0x20, 0xe2, 0x0d, 0x3d, 0x2e, 0x26, 0x93, 0x23, 0x95, 0x35,
+       0xb6, 0x0b, 0xf6, 0xa8, 0x6d, 0x2c, 0x7d, 0xbb, 0x07, 0x9d, 0x4c, 0xcd, 0x86, 0x1e, 0x0a, 0x22},
+      &HostV2F64<::log>},
+     HostFunctionABI::Vector},
+    {Library::Libmvec,
+     "_ZGVbN2vv_pow",
+     {// sha256(fex:libmvec__ZGVbN2vv_pow)
+      {0xbe, 0xe1, 0x28, 0x30, 0x23, 0x24, 0x8e, 0xb2, 0xdb, 0x30, 0x4d, 0x43, 0xb4, 0xba, 0xa2, 0xdf,
+       0x4b, 0xca, 0x28, 0x18, 0x55, 0x3a, 0x5c, 0xc6, 0x1a, 0x0c, 0x95, 0x07, 0xae, 0x4d, 0x26, 0xf6},
+      &HostV2F64F64<::pow>},
+     HostFunctionABI::Vector},
+    {Library::Libmvec,
+     "_ZGVbN2vvv_sincos",
+     {// sha256(fex:libmvec__ZGVbN2vvv_sincos)
+      {0x1c, 0x47, 0xbb, 0xdb, 0x23, 0xdb, 0x4b, 0x55, 0xa9, 0x08, 0x82, 0xab, 0xb6, 0x7e, 0x0b, 0xf2,
+       0xb0, 0x55, 0x1e, 0xe8, 0x69, 0x76, 0xb7, 0xbd, 0xff, 0x54, 0xd6, 0x35, 0x48, 0xa9, 0x69, 0xd6},
+      &HostV2Sincos},
+     HostFunctionABI::Vector},
+    {Library::Libmvec,
+     "_ZGVbN4v_sinf",
+     {// sha256(fex:libmvec__ZGVbN4v_sinf)
+      {0x0b, 0xfc, 0xaf, 0x92, 0x7b, 0xb7, 0x08, 0xbf, 0x7e, 0x72, 0x60, 0x20, 0xd1, 0xe0, 0x65, 0x35,
+       0x6a, 0x86, 0xee, 0xf0, 0xe4, 0x23, 0x3c, 0xb1, 0x2d, 0x2b, 0x99, 0x94, 0xb8, 0x28, 0xad, 0xd6},
+      &HostV4F32<::sinf>},
+     HostFunctionABI::Vector},
+    {Library::Libmvec,
+     "_ZGVbN4v_cosf",
+     {// sha256(fex:libmvec__ZGVbN4v_cosf)
+      {0x10, 0x54, 0xd3, 0xb9, 0x39, 0xaa, 0xe4, 0xd5, 0xee, 0xfc, 0x82, 0xbd, 0x39, 0xfc, 0x9e, 0x6e,
+       0xbd, 0xd5, 0x5e, 0x06, 0xd8, 0xed, 0x8a, 0xb0, 0xd2, 0xf5, 0x7a, 0x78, 0x49, 0xcd, 0xcd, 0x1d},
+      &HostV4F32<::cosf>},
+     HostFunctionABI::Vector},
+    {Library::Libmvec,
+     "_ZGVbN4v_expf",
+     {// sha256(fex:libmvec__ZGVbN4v_expf)
+      {0x68, 0x0a, 0xaf, 0x16, 0x64, 0x13, 0x96, 0xcd, 0xcf, 0x2b, 0x9e, 0xd9, 0x6c, 0x7f, 0x20, 0xc5,
+       0xe7, 0xf6, 0xb1, 0x71, 0xf8, 0x84, 0x1e, 0x38, 0x5e, 0xeb, 0x63, 0x6b, 0x86, 0x92, 0xd7, 0x40},
+      &HostV4F32<::expf>},
+     HostFunctionABI::Vector},
+    {Library::Libmvec,
+     "_ZGVbN4v_logf",
+     {// sha256(fex:libmvec__ZGVbN4v_logf)
+      {0xaf, 0xaf, 0x7f, 0x17, 0xcf, 0x1a, 0x16, 0xa5, 0x8d, 0x64, 0xa6, 0xe8, 0x17, 0xdc, 0x9d, 0x16,
+       0x6d, 0xca, 0xdd, 0x49, 0x55, 0x81, 0xdd, 0x72, 0x01, 0x4e, 0x4f, 0x1a, 0x77, 0x70, 0x44, 0x37},
+      &HostV4F32<::logf>},
+     HostFunctionABI::Vector},
+    {Library::Libmvec,
+     "_ZGVbN4vv_powf",
+     {// sha256(fex:libmvec__ZGVbN4vv_powf)
+      {0x4c, 0x10, 0xd3, 0xa7, 0x6a, 0x3a, 0xbb, 0x6f, 0xa4, 0xc1, 0xe9, 0xc8, 0xfc, 0xc0, 0x3d, 0x8f,
+       0xba, 0x1b, 0xc4, 0x31, 0x20, 0xab, 0xd1, 0x02, 0xdf, 0x68, 0xa5, 0x37, 0xf8, 0x1f, 0x00, 0xc4},
+      &HostV4F32F32<::powf>},
+     HostFunctionABI::Vector},
+  }};
+
+  // sha256(fex:libc_resolve)
+  constexpr FEXCore::IR::SHA256Sum ResolveSum = {0xcb, 0xa4, 0x1f, 0xbf, 0xd8, 0x55, 0xa8, 0x32, 0x87, 0xca, 0xa3,
+                                                 0x25, 0x27, 0x1f, 0xe1, 0xe8, 0x26, 0x3a, 0xe0, 0xfb, 0x47, 0x67,
+                                                 0x62, 0xde, 0xde, 0x2d, 0x03, 0x2d, 0x1d, 0xed, 0xb8, 0xbb};
+
+  // Entrypoints are spaced out so that no two share an instruction
+  constexpr uint64_t EntrypointStride = 16;
+  static_assert((Routines.size() * EntrypointStride) <= FEXCore::Utils::FEX_PAGE_SIZE);
+
+  template<typename T>
+  bool ReadVector(int FD, fextl::vector<T>& Data, size_t Count, off_t Offset) {
+    Data.resize(Count);
+    const auto Size = Count * sizeof(T);
+    return pread(FD, Data.data(), Size, Offset) == static_cast<ssize_t>(Size);
+  }
+} // namespace
+
+HostLibcRoutines::HostLibcRoutines(FEXCore::Context::Context* CTX, FEX::HLE::ThunkHandler* ThunkHandler)
+  : CTX {CTX} {
+  if ((!LibcRoutinesEnabled() && !LibmRoutinesEnabled()) || !Is64BitMode() || !ThunkHandler) {
+    return;
+  }
+
+  EntrypointPage = ::mmap(nullptr, FEXCore::Utils::FEX_PAGE_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (EntrypointPage == MAP_FAILED) {
+    LogMan::Msg::EFmt("Couldn't reserve host libc routine entrypoints");
+    EntrypointPage = nullptr;
+    return;
+  }
+
+  std::array<FEXCore::IR::ThunkDefinition, Routines.size() + 1> Definitions;
+  for (size_t i = 0; i < Routines.size(); ++i) {
+    Definitions[i] = Routines[i].Definition;
+    CTX->AddHostFunctionIRHandler(reinterpret_cast<uint64_t>(EntrypointPage) + i * EntrypointStride, Routines[i].Definition.Sum,
+                                  Routines[i].ABI);
+  }
+  Definitions[Routines.size()] = {ResolveSum, &Resolve};
+  ThunkHandler->AppendThunkDefinitions(Definitions);
+
+  LibcEnabled = LibcRoutinesEnabled();
+  LibmEnabled = LibmRoutinesEnabled();
+  Enabled = true;
+}
+
+HostLibcRoutines::~HostLibcRoutines() {
+  if (EntrypointPage) {
+    ::munmap(EntrypointPage, FEXCore::Utils::FEX_PAGE_SIZE);
+  }
+}
+
+void HostLibcRoutines::TrackMapping(std::string_view Filename, int FD, uint64_t Base) {
+  std::optional<Library> Lib;
+  if (LibcEnabled && Filename.starts_with("libc.so")) {
+    Lib = Library::Libc;
+  } else if (LibmEnabled && Filename.starts_with("libm.so")) {
+    Lib = Library::Libm;
+  } else if (LibmEnabled && Filename.starts_with("libmvec.so")) {
+    Lib = Library::Libmvec;
+  }
+
+  if (!Lib) {
+    return;
+  }
+
+  Elf64_Ehdr Header;
+  if (pread(FD, &Header, sizeof(Header), 0) != sizeof(Header) || memcmp(Header.e_ident, ELFMAG, SELFMAG) != 0 ||
+      Header.e_ident[EI_CLASS] != ELFCLASS64 || Header.e_machine != EM_X86_64 || Header.e_shentsize != sizeof(Elf64_Shdr)) {
+    return;
+  }
+
+  // The mapping is placed at the first loadable segment, which gives the load bias.
+  fextl::vector<Elf64_Phdr> ProgramHeaders;
+  if (!ReadVector(FD, ProgramHeaders, Header.e_phnum, Header.e_phoff)) {
+    return;
+  }
+  auto FirstLoad = std::ranges::find(ProgramHeaders, PT_LOAD, &Elf64_Phdr::p_type);
+  if (FirstLoad == ProgramHeaders.end()) {
+    return;
+  }
+  const uint64_t LoadBias = Base - (FirstLoad->p_vaddr & ~(FEXCore::Utils::FEX_PAGE_SIZE - 1));
+
+  fextl::vector<Elf64_Shdr> SectionHeaders;
+  if (!ReadVector(FD, SectionHeaders, Header.e_shnum, Header.e_shoff)) {
+    return;
+  }
+
+  auto DynSym = std::ranges::find(SectionHeaders, SHT_DYNSYM, &Elf64_Shdr::sh_type);
+  if (DynSym == SectionHeaders.end() || DynSym->sh_link >= SectionHeaders.size() || DynSym->sh_entsize != sizeof(Elf64_Sym)) {
+    return;
+  }
+  const auto& DynStr = SectionHeaders[DynSym->sh_link];
+
+  fextl::vector<Elf64_Sym> Symbols;
+  fextl::vector<char> Strings;
+  if (!ReadVector(FD, Symbols, DynSym->sh_size / sizeof(Elf64_Sym), DynSym->sh_offset) ||
+      !ReadVector(FD, Strings, DynStr.sh_size, DynStr.sh_offset)) {
+    return;
+  }
+
+  fextl::map<uint64_t, uint64_t> Hooks;
+  for (const auto& Symbol : Symbols) {
+    if (ELF64_ST_TYPE(Symbol.st_info) != STT_GNU_IFUNC || Symbol.st_shndx == SHN_UNDEF || Symbol.st_name >= Strings.size()) {
+      continue;
+    }
+
+    const std::string_view Name {&Strings[Symbol.st_name], strnlen(&Strings[Symbol.st_name], Strings.size() - Symbol.st_name)};
+    for (size_t i = 0; i < Routines.size(); ++i) {
+      if (Routines[i].Lib == *Lib && Routines[i].Name == Name) {
+        // Versioned aliases can share a resolver, the first one wins.
+        Hooks.emplace(LoadBias + Symbol.st_value, reinterpret_cast<uint64_t>(EntrypointPage) + i * EntrypointStride);
+        break;
+      }
+    }
+  }
+
+  if (Hooks.empty()) {
+    return;
+  }
+
+  LogMan::Msg::DFmt("Redirecting {} IFUNC resolvers in {} to host routines", Hooks.size(), Filename);
+
+  {
+    std::unique_lock lk(ResolverMutex);
+    Resolvers.insert(Hooks.begin(), Hooks.end());
+  }
+
+  for (const auto& [Resolver, Entrypoint] : Hooks) {
+    CTX->AddHostFunctionIRHandler(Resolver, ResolveSum);
+  }
+}
+
+void HostLibcRoutines::TrackUnmap(FEXCore::Core::InternalThreadState* Thread, uint64_t Base, uint64_t Length) {
+  if (!Enabled) {
+    return;
+  }
+
+  fextl::vector<uint64_t> Removed;
+  {
+    std::unique_lock lk(ResolverMutex);
+    auto Begin = Resolvers.lower_bound(Base);
+    auto End = Resolvers.lower_bound(Base + Length);
+    for (auto it = Begin; it != End; ++it) {
+      Removed.push_back(it->first);
+    }
+    Resolvers.erase(Begin, End);
+  }
+
+  for (auto Resolver : Removed) {
+    CTX->RemoveHostFunctionIRHandler(Thread, Resolver);
+  }
+}
+
+void HostLibcRoutines::Resolve(void* ArgsRV) {
+  // The return value slot holds the address of the resolver that was called.
+  auto Args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+  auto Self = FEX::HLE::_SyscallHandler->LibcRoutines.get();
+
+  std::shared_lock lk(Self->ResolverMutex);
+  auto it = Self->Resolvers.find(Args->rv);
+  if (it == Self->Resolvers.end()) {
+    ERROR_AND_DIE_FMT("Unknown IFUNC resolver {:#x}", Args->rv);
+  }
+  Args->rv = it->second;
+}
+} // namespace FEX::HLE
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Redirects hot guest glibc string and math routines to their host implementations
+$end_info$
+*/
+#pragma once
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/fextl/map.h>
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string_view>
+
+namespace FEXCore {
+namespace Context {
+  class Context;
+}
+namespace Core {
+  struct InternalThreadState;
+}
+} // namespace FEXCore
+
+namespace FEX::HLE {
+class ThunkHandler;
+
+/**
+ * Replaces glibc's memcpy, memmove, memset, strlen, memcmp and strchr with the host implementations.
+ * With HostLibmRoutines, libm's exp, log, pow, sin, cos and related functions and the SSE variants of their libmvec
+ * counterparts get replaced as well.
+ *
+ * glibc selects the implementation of these functions at load time through IFUNC resolvers. When a guest libc.so.6,
+ * libm.so.6 or libmvec.so.1 gets mapped, its dynamic symbol table is searched for the resolvers and each one gets a
+ * custom IR handler that returns the address of a FEX-provided entrypoint instead of the SSE/AVX2 implementation. Every
+ * call through the PLT or GOT then ends up in a host function that follows the x86-64 calling convention.
+ *
+ * The AVX2 and AVX-512 libmvec variants are left alone, their 256-bit and 512-bit arguments don't fit the argument block.
+ *
+ * Entrypoints live in a reserved host page that is never accessible to the guest, the IR handlers never read guest code
+ * from it.
+ */
+class HostLibcRoutines final {
+public:
+  HostLibcRoutines(FEXCore::Context::Context* CTX, FEX::HLE::ThunkHandler* ThunkHandler);
+  ~HostLibcRoutines();
+
+  // Hooks the IFUNC resolvers of a guest libc, libm or libmvec ELF file that was mapped at `Base`.
+  void TrackMapping(std::string_view Filename, int FD, uint64_t Base);
+  // Removes the hooks from the unmapped range.
+  void TrackUnmap(FEXCore::Core::InternalThreadState* Thread, uint64_t Base, uint64_t Length);
+
+private:
+  FEXCore::Context::Context* CTX;
+
+  FEX_CONFIG_OPT(LibcRoutinesEnabled, HOSTLIBCROUTINES);
+  FEX_CONFIG_OPT(LibmRoutinesEnabled, HOSTLIBMROUTINES);
+  FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
+  bool Enabled {};
+  bool LibcEnabled {};
+  bool LibmEnabled {};
+
+  void* EntrypointPage {};
+
+  // Protects Resolvers
+  std::shared_mutex ResolverMutex;
+  // Guest address of a hooked IFUNC resolver to the entrypoint that it returns
+  fextl::map<uint64_t, uint64_t> Resolvers;
+
+  static void Resolve(void* ArgsRV);
+};
+} // namespace FEX::HLE
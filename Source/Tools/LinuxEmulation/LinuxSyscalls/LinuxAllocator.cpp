@@ -2,13 +2,14 @@
 #include "LinuxSyscalls/LinuxAllocator.h"
 #include "LinuxSyscalls/Syscalls.h"
 
+#include <Common/PageRangeBitmap.h>
+
 #include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/Utils/TypeDefines.h>
 #include <FEXHeaderUtils/Syscalls.h>
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/memory.h>
 
-#include <bitset>
 #include <linux/mman.h>
 #include <unistd.h>
 #include <sys/user.h>
@@ -29,11 +30,9 @@ private:
 public:
   MemAllocator32Bit() {
     // First 16 pages are taken by the Linux kernel
-    for (size_t i = 0; i < 16; ++i) {
-      MappedPages.set(i);
-    }
+    MappedPages.Set(0, BASE_KEY);
     // Take the top page as well
-    MappedPages.set(TOP_KEY);
+    MappedPages.Set(TOP_KEY, 1);
     if (SearchDown) {
       LastScanLocation = TOP_KEY;
       LastKeyLocation = TOP_KEY;
@@ -57,24 +56,20 @@ public:
   // PagesLength is the number of pages
   void SetUsedPages(uint64_t PageAddr, size_t PagesLength) {
     // Set the range as mapped
-    for (size_t i = 0; i < PagesLength; ++i) {
-      MappedPages.set(PageAddr + i);
-    }
+    MappedPages.Set(PageAddr, PagesLength);
   }
 
   // PageAddr is a page already shifted to page index
   // PagesLength is the number of pages
   void SetFreePages(uint64_t PageAddr, size_t PagesLength) {
     // Set the range as unused
-    for (size_t i = 0; i < PagesLength; ++i) {
-      MappedPages.reset(PageAddr + i);
-    }
+    MappedPages.Clear(PageAddr, PagesLength);
   }
 
 private:
   // Set that contains 4k mapped pages
   // This is the full 32bit memory range
-  std::bitset<0x10'0000> MappedPages;
+  FEX::PageRangeBitmap<0x10'0000> MappedPages;
   fextl::map<uint32_t, int> PageToShm {};
   uint64_t LastScanLocation {};
   uint64_t LastKeyLocation {};
@@ -87,49 +82,13 @@ private:
 };
 
 uint64_t MemAllocator32Bit::FindPageRange(uint64_t Start, size_t Pages) const {
-  // Linear range scan
-  while (Start != TOP_KEY) {
-    bool Free = true;
-    if ((Start + Pages) > TOP_KEY) {
-      return 0;
-    }
-    uint64_t Offset = 0;
-    for (; Offset < Pages; ++Offset) {
-      if (MappedPages.test(Start + Offset)) {
-        Free = false;
-        break;
-      }
-    }
-
-    if (Free) {
-      return Start;
-    }
-    Start += Offset + 1;
-  }
-
-  return 0;
+  // Lowest free range starting at or above Start
+  return MappedPages.FindFirstFree(Start, TOP_KEY, Pages).value_or(0);
 }
 
 uint64_t MemAllocator32Bit::FindPageRange_TopDown(uint64_t Start, size_t Pages) const {
-  // Linear range scan
-  while (Start >= BASE_KEY && Start <= TOP_KEY) {
-    bool Free = true;
-
-    uint64_t Offset = 0;
-    for (; Offset < Pages; ++Offset) {
-      if (MappedPages.test(Start - Offset)) {
-        Free = false;
-        break;
-      }
-    }
-
-    if (Free) {
-      return Start - Offset;
-    }
-    Start -= Offset + 1;
-  }
-
-  return 0;
+  // Highest free range ending below Start
+  return MappedPages.FindLastFree(BASE_KEY, Start, Pages).value_or(0);
 }
 
 void* MemAllocator32Bit::Mmap(void* addr, size_t length, int prot, int flags, int fd, off_t offset) {
@@ -148,6 +107,10 @@ void* MemAllocator32Bit::Mmap(void* addr, size_t length, int prot, int flags, in
     return reinterpret_cast<void*>(-EINVAL);
   }
 
+  if (length == 0) {
+    return reinterpret_cast<void*>(-EINVAL);
+  }
+
   // If we do have an fd then offset must be page aligned
   if (fd != -1 && offset & ~FEXCore::Utils::FEX_PAGE_MASK) {
     return reinterpret_cast<void*>(-EINVAL);
@@ -176,61 +139,46 @@ void* MemAllocator32Bit::Mmap(void* addr, size_t length, int prot, int flags, in
   auto AllocateNoHint = [&]() -> void* {
     bool Wrapped = false;
     uint64_t BottomPage = Map32Bit && (LastScanLocation >= LastKeyLocation32Bit) ? LastKeyLocation32Bit : LastScanLocation;
-restart: {
-  // Linear range scan
-  uint64_t LowerPage = (this->*FindPageRangePtr)(BottomPage, PagesLength);
-  if (LowerPage == 0) {
-    // Try again but this time from the start
-    BottomPage = Map32Bit ? LastKeyLocation32Bit : LastKeyLocation;
-    LowerPage = (this->*FindPageRangePtr)(BottomPage, PagesLength);
-  }
-
-  uint64_t UpperPage = LowerPage + PagesLength;
-  if (LowerPage == 0) {
-    return reinterpret_cast<void*>(-ENOMEM);
-  }
-  {
-    // Try and map the range
-    void* MappedPtr =
-      ::mmap(reinterpret_cast<void*>(LowerPage << FEXCore::Utils::FEX_PAGE_SHIFT), length, prot, flags | FEX_MAP_FIXED_NOREPLACE, fd, offset);
+    while (true) {
+      uint64_t LowerPage = (this->*FindPageRangePtr)(BottomPage, PagesLength);
+      if (LowerPage == 0 && !Wrapped) {
+        // Try again but this time from the start
+        Wrapped = true;
+        BottomPage = Map32Bit ? LastKeyLocation32Bit : LastKeyLocation;
+        LowerPage = (this->*FindPageRangePtr)(BottomPage, PagesLength);
+      }
 
-    if (MappedPtr == MAP_FAILED && errno != EEXIST) {
-      return reinterpret_cast<void*>(-errno);
-    } else if (MappedPtr == MAP_FAILED || MappedPtr >= reinterpret_cast<void*>(TOP_KEY << FEXCore::Utils::FEX_PAGE_SHIFT)) {
-      // Handles the case where MAP_FIXED_NOREPLACE failed with MAP_FAILED
-      // or if the host system's kernel isn't new enough then it returns the wrong pointer
-      if (MappedPtr != MAP_FAILED && MappedPtr >= reinterpret_cast<void*>(TOP_KEY << FEXCore::Utils::FEX_PAGE_SHIFT)) {
-        // Make sure to munmap this so we don't leak memory
-        ::munmap(MappedPtr, length);
+      if (LowerPage == 0) {
+        return reinterpret_cast<void*>(-ENOMEM);
       }
 
-      if (UpperPage == TOP_KEY) {
-        BottomPage = BASE_KEY;
-        Wrapped = true;
-        goto restart;
-      } else if (Wrapped && LowerPage >= LastScanLocation) {
-        // We linear scanned the entire memory range. Give up
-        return (void*)(uintptr_t)-errno;
-      } else {
-        // Try again
-        if (SearchDown) {
-          --BottomPage;
-        } else {
-          ++BottomPage;
+      // Try and map the range
+      void* MappedPtr = ::mmap(reinterpret_cast<void*>(LowerPage << FEXCore::Utils::FEX_PAGE_SHIFT), length, prot,
+                               flags | FEX_MAP_FIXED_NOREPLACE, fd, offset);
+
+      if (MappedPtr == MAP_FAILED && errno != EEXIST) {
+        return reinterpret_cast<void*>(-errno);
+      } else if (MappedPtr == MAP_FAILED || MappedPtr >= reinterpret_cast<void*>(TOP_KEY << FEXCore::Utils::FEX_PAGE_SHIFT)) {
+        // Handles the case where MAP_FIXED_NOREPLACE failed with MAP_FAILED
+        // or if the host system's kernel isn't new enough then it returns the wrong pointer
+        if (MappedPtr != MAP_FAILED) {
+          // Make sure to munmap this so we don't leak memory
+          ::munmap(MappedPtr, length);
         }
-        goto restart;
+
+        // Something we aren't tracking is in the way, continue the search one page past this range.
+        BottomPage = SearchDown ? LowerPage + PagesLength - 1 : LowerPage + 1;
+        continue;
       }
-    } else {
+
       if (SearchDown) {
         LastScanLocation = LowerPage;
       } else {
-        LastScanLocation = UpperPage;
+        LastScanLocation = LowerPage + PagesLength;
       }
       SetUsedPages(LowerPage, PagesLength);
       return MappedPtr;
     }
-  }
-}
   };
 
   // Find a region that fits our address
@@ -263,8 +211,6 @@ int MemAllocator32Bit::Munmap(void* addr, size_t length) {
   uintptr_t Addr = reinterpret_cast<uintptr_t>(addr);
   uintptr_t PageAddr = Addr >> FEXCore::Utils::FEX_PAGE_SHIFT;
 
-  uintptr_t PageEnd = PageAddr + PagesLength;
-
   // Both Addr and length must be page aligned
   if (Addr & ~FEXCore::Utils::FEX_PAGE_MASK) {
     return -EINVAL;
@@ -284,20 +230,12 @@ int MemAllocator32Bit::Munmap(void* addr, size_t length) {
     return 0;
   }
 
-  while (PageAddr != PageEnd) {
-    // Always pass to munmap, it may be something allocated we aren't tracking
-    int Result = ::munmap(reinterpret_cast<void*>(PageAddr << FEXCore::Utils::FEX_PAGE_SHIFT), FEXCore::Utils::FEX_PAGE_SIZE);
-    if (Result != 0) {
-      return -errno;
-    }
-
-    if (MappedPages.test(PageAddr)) {
-      MappedPages.reset(PageAddr);
-    }
-
-    ++PageAddr;
+  // Always pass to munmap, it may be something allocated we aren't tracking
+  if (::munmap(addr, length) != 0) {
+    return -errno;
   }
 
+  SetFreePages(PageAddr, PagesLength);
   return 0;
 }
 
@@ -341,14 +279,7 @@ void* MemAllocator32Bit::Mremap(void* old_address, size_t old_size, size_t new_s
         }
       } else {
         // Scan the region forward from our first region's endd to see if it can be extended
-        bool CanExtend {true};
-
-        for (size_t i = OldPagesLength; i < NewPagesLength; ++i) {
-          if (MappedPages[OldPageAddr + i]) {
-            CanExtend = false;
-            break;
-          }
-        }
+        bool CanExtend = MappedPages.IsFree(OldPageAddr + OldPagesLength, NewPagesLength - OldPagesLength);
 
         if (CanExtend) {
           void* MappedPtr = ::mremap(old_address, old_size, new_size, flags & ~MREMAP_MAYMOVE);
@@ -452,41 +383,36 @@ uint64_t MemAllocator32Bit::Shmat(int shmid, const void* shmaddr, int shmflg, ui
 
     bool Wrapped = false;
     uint64_t BottomPage = LastScanLocation;
-restart: {
-  // Linear range scan
-  uint64_t LowerPage = (this->*FindPageRangePtr)(BottomPage, PagesLength);
-  if (LowerPage == 0) {
-    // Try again but this time from the start
-    BottomPage = LastKeyLocation;
-    LowerPage = (this->*FindPageRangePtr)(BottomPage, PagesLength);
-  }
+    while (true) {
+      uint64_t LowerPage = (this->*FindPageRangePtr)(BottomPage, PagesLength);
+      if (LowerPage == 0 && !Wrapped) {
+        // Try again but this time from the start
+        Wrapped = true;
+        BottomPage = LastKeyLocation;
+        LowerPage = (this->*FindPageRangePtr)(BottomPage, PagesLength);
+      }
 
-  uint64_t UpperPage = LowerPage + PagesLength;
-  if (LowerPage == 0) {
-    return -ENOMEM;
-  }
-  {
-    // Try and map the range
-    void* MappedPtr = ::shmat(shmid, reinterpret_cast<const void*>(LowerPage << FEXCore::Utils::FEX_PAGE_SHIFT), shmflg);
+      if (LowerPage == 0) {
+        return -ENOMEM;
+      }
 
-    if (MappedPtr == MAP_FAILED) {
-      if (UpperPage == TOP_KEY) {
-        BottomPage = LastKeyLocation;
-        Wrapped = true;
-        goto restart;
-      } else if (Wrapped && LowerPage >= LastScanLocation) {
-        // We linear scanned the entire memory range. Give up
-        return -errno;
-      } else {
-        // Try again
-        BottomPage += PagesLength;
-        goto restart;
+      // Try and map the range
+      void* MappedPtr = ::shmat(shmid, reinterpret_cast<const void*>(LowerPage << FEXCore::Utils::FEX_PAGE_SHIFT), shmflg);
+
+      if (MappedPtr == MAP_FAILED) {
+        if (errno != EINVAL) {
+          return -errno;
+        }
+
+        // Something we aren't tracking is in the way, continue the search one page past this range.
+        BottomPage = SearchDown ? LowerPage + PagesLength - 1 : LowerPage + 1;
+        continue;
       }
-    } else {
+
       if (SearchDown) {
         LastScanLocation = LowerPage;
       } else {
-        LastScanLocation = UpperPage;
+        LastScanLocation = LowerPage + PagesLength;
       }
       // Set the range as mapped
       SetUsedPages(LowerPage, PagesLength);
@@ -501,8 +427,7 @@ restart: {
     }
   }
 }
-  }
-}
+
 uint64_t MemAllocator32Bit::Shmdt(const void* shmaddr) {
   std::scoped_lock<std::mutex> lk {AllocMutex};
 
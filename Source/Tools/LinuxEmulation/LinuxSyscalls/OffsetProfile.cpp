@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Per-file lists of instruction offsets stored next to the code maps
+$end_info$
+*/
+
+#include "Common/Config.h"
+#include "LinuxSyscalls/OffsetProfile.h"
+
+#include <FEXCore/Core/CodeCache.h>
+#include <FEXCore/Utils/FileLoading.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXHeaderUtils/Filesystem.h>
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace FEX::HLE::OffsetProfile {
+static void Parse(const fextl::string& Data, fextl::set<uint64_t>& Offsets) {
+  const char* Begin = Data.c_str();
+  const char* End = Begin + Data.size();
+  while (Begin < End) {
+    char* LineEnd;
+    const auto Offset = std::strtoull(Begin, &LineEnd, 16);
+    if (LineEnd == Begin) {
+      // Skip anything that isn't an offset
+      ++Begin;
+      continue;
+    }
+
+    Offsets.insert(Offset);
+    Begin = LineEnd;
+  }
+}
+
+fextl::string GetPath(const FEXCore::ExecutableFileInfo& FileInfo, std::string_view Extension) {
+  const auto BaseFilename = FEXCore::CodeMap::GetBaseFilename(FileInfo, false);
+  if (BaseFilename.empty()) {
+    return {};
+  }
+
+  return fextl::fmt::format("{}codemap/{}{}", FEX::Config::GetCacheDirectory(), BaseFilename, Extension);
+}
+
+bool Load(const fextl::string& Path, fextl::set<uint64_t>& Offsets) {
+  fextl::string Data;
+  if (!FEXCore::FileLoading::LoadFile(Data, Path)) {
+    return false;
+  }
+
+  Parse(Data, Offsets);
+  return true;
+}
+
+bool Write(const fextl::string& Path, fextl::set<uint64_t>& Offsets, const fextl::set<uint64_t>* Exclude) {
+  Load(Path, Offsets);
+  if (Exclude) {
+    std::erase_if(Offsets, [Exclude](uint64_t Offset) { return Exclude->contains(Offset); });
+  }
+
+  fextl::string Data;
+  for (auto Offset : Offsets) {
+    Data += fextl::fmt::format("{:x}\n", Offset);
+  }
+
+  FHU::Filesystem::CreateDirectories(FHU::Filesystem::ParentPath(Path));
+
+  const auto TmpPath = fextl::fmt::format("{}.{}", Path, ::getpid());
+  int FD = open(TmpPath.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, 0644);
+  if (FD == -1) {
+    LogMan::Msg::EFmt("Couldn't write {}", TmpPath);
+    return false;
+  }
+
+  const bool Written = write(FD, Data.data(), Data.size()) == static_cast<ssize_t>(Data.size());
+  close(FD);
+
+  if (!Written || FHU::Filesystem::RenameFile(TmpPath, Path)) {
+    LogMan::Msg::EFmt("Couldn't write {}", Path);
+    unlink(TmpPath.c_str());
+    return false;
+  }
+
+  return true;
+}
+} // namespace FEX::HLE::OffsetProfile
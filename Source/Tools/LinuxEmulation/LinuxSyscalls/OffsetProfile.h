@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Per-file lists of instruction offsets stored next to the code maps
+$end_info$
+*/
+#pragma once
+
+#include <FEXCore/fextl/set.h>
+#include <FEXCore/fextl/string.h>
+
+#include <cstdint>
+#include <string_view>
+
+namespace FEXCore {
+struct ExecutableFileInfo;
+}
+
+/**
+ * Instruction offsets learned about an executable file are stored as `<codemap name><Extension>` next to the code maps,
+ * one hexadecimal file offset per line.
+ */
+namespace FEX::HLE::OffsetProfile {
+// Returns an empty string if the file has no stable identifier to store a profile with.
+fextl::string GetPath(const FEXCore::ExecutableFileInfo& FileInfo, std::string_view Extension);
+
+// Returns false if the profile doesn't exist.
+bool Load(const fextl::string& Path, fextl::set<uint64_t>& Offsets);
+
+// Merges the offsets with the ones on disk before writing them back, since another instance of the same executable may
+// have learned more in the meantime.
+// Offsets in Exclude are dropped after merging.
+bool Write(const fextl::string& Path, fextl::set<uint64_t>& Offsets, const fextl::set<uint64_t>* Exclude = nullptr);
+} // namespace FEX::HLE::OffsetProfile
@@ -14,9 +14,11 @@ $end_info$
 
 #include <CodeEmitter/Emitter.h>
 #include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Debug/InternalThreadState.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/HLE/SyscallHandler.h>
 #include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/SHMStats.h>
 
 #include <fcntl.h>
 #include <linux/audit.h>
@@ -196,6 +198,7 @@ struct SerializedFilter {
   size_t CodeSize;
   uint32_t FilterInstructions;
   bool ShouldLog;
+  SeccompVerdictCache VerdictCache;
   char Code[];
 };
 
@@ -236,6 +239,7 @@ std::optional<int> SeccompEmulator::SerializeFilters(FEXCore::Core::CpuStateFram
       .CodeSize = Filter->MappedSize,
       .FilterInstructions = Filter->FilterInstructions,
       .ShouldLog = Filter->ShouldLog,
+      .VerdictCache = Filter->VerdictCache,
     };
 
     Res = write(FD, &SFilter, sizeof(SFilter));
@@ -302,8 +306,8 @@ void SeccompEmulator::DeserializeFilters(FEXCore::Core::CpuStateFrame* Frame, in
 
     FEXCore::Allocator::VirtualName("FEXMem_Misc", reinterpret_cast<void*>(Ptr), SFilter.CodeSize);
 
-    auto& it =
-      Filters.emplace_back(SeccompFilterInfo {(SeccompFilterFunc)Ptr, 1, SFilter.CodeSize, SFilter.FilterInstructions, SFilter.ShouldLog});
+    auto& it = Filters.emplace_back(
+      SeccompFilterInfo {(SeccompFilterFunc)Ptr, 1, SFilter.CodeSize, SFilter.FilterInstructions, SFilter.ShouldLog, SFilter.VerdictCache});
     TotalFilterInstructions += SFilter.FilterInstructions;
 
     // Append the filter to the thread.
@@ -323,39 +327,55 @@ SeccompEmulator::ExecuteFilter(FEXCore::Core::CpuStateFrame* Frame, uint64_t JIT
     return {false, 0};
   }
 
-  // Reconstruct the RIP from the JITPC.
-  const uint64_t RIP = Thread->Thread->CTX->RestoreRIPFromHostPC(Frame->Thread, JITPC);
+  // Reconstructing the RIP from the JITPC is only needed when a filter gets executed or the result is reported.
+  std::optional<uint64_t> CachedRIP;
+  auto GetRIP = [&]() {
+    if (!CachedRIP) {
+      CachedRIP = Thread->Thread->CTX->RestoreRIPFromHostPC(Frame->Thread, JITPC);
+    }
+    return *CachedRIP;
+  };
 
   const auto Arch = Is64BitMode() ? AUDIT_ARCH_X86_64 : AUDIT_ARCH_I386;
   bool ShouldLog {};
   uint32_t SeccompResult {};
 
   {
-    BPFEmitter::WorkingBuffer Data {
-      .Data =
-        {
-          .nr = static_cast<int32_t>(Args->Argument[0]),
-          .arch = Arch,
-          .instruction_pointer = RIP,
-          .args =
-            {
-              Args->Argument[1],
-              Args->Argument[2],
-              Args->Argument[3],
-              Args->Argument[4],
-              Args->Argument[5],
-              Args->Argument[6],
-            },
-        },
-    };
+    std::optional<BPFEmitter::WorkingBuffer> Data;
 
     bool HasResult {};
     // seccomp filters are executed from latest added to oldest.
     for (auto it = Thread->Filters.rbegin(); it != Thread->Filters.rend(); ++it) {
-      // Explicitly zero scratch memory.
-      memset(&Data.ScratchMemory, 0, sizeof(Data.ScratchMemory));
-
-      uint32_t CurrentResult = (*it)->Func(0, 0, 0, 0, &Data);
+      uint32_t CurrentResult {};
+      if (auto Verdict = (*it)->VerdictCache.Lookup(Arch, Args->Argument[0])) {
+        // This filter only looks at the syscall number and architecture for this syscall.
+        CurrentResult = *Verdict;
+      } else {
+        if (!Data) {
+          Data.emplace(BPFEmitter::WorkingBuffer {
+            .Data =
+              {
+                .nr = static_cast<int32_t>(Args->Argument[0]),
+                .arch = Arch,
+                .instruction_pointer = GetRIP(),
+                .args =
+                  {
+                    Args->Argument[1],
+                    Args->Argument[2],
+                    Args->Argument[3],
+                    Args->Argument[4],
+                    Args->Argument[5],
+                    Args->Argument[6],
+                  },
+              },
+          });
+        }
+
+        // Explicitly zero scratch memory.
+        memset(&Data->ScratchMemory, 0, sizeof(Data->ScratchMemory));
+
+        CurrentResult = (*it)->Func(0, 0, 0, 0, &*Data);
+      }
 
       if (!HasResult) {
         SeccompResult = CurrentResult;
@@ -382,6 +402,12 @@ SeccompEmulator::ExecuteFilter(FEXCore::Core::CpuStateFrame* Frame, uint64_t JIT
         ShouldLog = (*it)->ShouldLog;
       }
     }
+
+    if (Data) {
+      FEXCORE_PROFILE_INSTANT_INCREMENT(Thread->Thread, AccumulatedSeccompFilterCount, 1);
+    } else {
+      FEXCORE_PROFILE_INSTANT_INCREMENT(Thread->Thread, AccumulatedSeccompCachedCount, 1);
+    }
   }
 
   const auto ActionMasked = SeccompResult & SECCOMP_RET_ACTION_FULL;
@@ -406,7 +432,7 @@ SeccompEmulator::ExecuteFilter(FEXCore::Core::CpuStateFrame* Frame, uint64_t JIT
     clock_gettime(CLOCK_MONOTONIC, &tp);
     LogMan::Msg::IFmt("audit: type={} audit({}.{:03}:{}): uid={} gid={} pid={} comm={} sig={} arch={:x} syscall={} ip=0x{:x} code=0x{:x}",
                       AUDIT_SECCOMP, tp.tv_sec, tp.tv_nsec / 1'000'000, AuditSerialIncrement(), ::getuid(), ::getgid(), ::getpid(),
-                      Filename(), Signal, Arch, Args->Argument[0], RIP, SeccompResult);
+                      Filename(), Signal, Arch, Args->Argument[0], GetRIP(), SeccompResult);
   }
 
   switch (ActionMasked) {
@@ -436,7 +462,7 @@ SeccompEmulator::ExecuteFilter(FEXCore::Core::CpuStateFrame* Frame, uint64_t JIT
       .si_code = 1, // SYS_SECCOMP
     };
 
-    Info.si_call_addr = reinterpret_cast<void*>(RIP);
+    Info.si_call_addr = reinterpret_cast<void*>(GetRIP());
     Info.si_syscall = Args->Argument[0];
     Info.si_arch = Arch;
 
@@ -666,7 +692,9 @@ uint64_t SeccompEmulator::SetModeFilter(FEXCore::Core::CpuStateFrame* Frame, uin
   const bool LoggingEnabled = flags & SECCOMP_FILTER_FLAG_LOG;
   auto Result = emit.JITFilter(flags, prog);
   if (Result == 0) {
-    auto& it = Filters.emplace_back(SeccompFilterInfo {(SeccompFilterFunc)emit.GetFunc(), 1, emit.AllocationSize(), prog->len, LoggingEnabled});
+    const auto Arch = Is64BitMode() ? AUDIT_ARCH_X86_64 : AUDIT_ARCH_I386;
+    auto& it = Filters.emplace_back(SeccompFilterInfo {(SeccompFilterFunc)emit.GetFunc(), 1, emit.AllocationSize(), prog->len,
+                                                       LoggingEnabled, BuildVerdictCache(prog, Arch)});
     TotalFilterInstructions += prog->len;
 
     // Append the filter to the thread.
@@ -10,6 +10,7 @@ $end_info$
 #include <FEXCore/fextl/list.h>
 #include <FEXCore/Utils/SignalScopeGuards.h>
 
+#include <array>
 #include <atomic>
 #include <csignal>
 #include <cstddef>
@@ -39,12 +40,37 @@ class SyscallHandler;
 struct ThreadStateObject;
 
 using SeccompFilterFunc = uint64_t (*)(uint32_t Acc, uint32_t Index, uint32_t Tmp, uint32_t Tmp2, void* Data);
+
+// Results of a filter for the syscalls where it only looks at the syscall number and architecture.
+// Kept trivial so it can be serialized along with the filter.
+struct SeccompVerdictCache final {
+  // Covers every x86 and x86-64 syscall.
+  constexpr static size_t MAX_SYSCALLS = 512;
+  // Verdicts only hold for the architecture the filter was evaluated with, filters survive an execve to the other one.
+  uint32_t Arch;
+  std::array<uint64_t, MAX_SYSCALLS / 64> Cached;
+  std::array<uint32_t, MAX_SYSCALLS> Verdicts;
+
+  void Set(uint32_t Syscall, uint32_t Verdict) {
+    Cached[Syscall / 64] |= 1ULL << (Syscall % 64);
+    Verdicts[Syscall] = Verdict;
+  }
+
+  std::optional<uint32_t> Lookup(uint32_t CurrentArch, uint64_t Syscall) const {
+    if (CurrentArch != Arch || Syscall >= MAX_SYSCALLS || !(Cached[Syscall / 64] & (1ULL << (Syscall % 64)))) {
+      return std::nullopt;
+    }
+    return Verdicts[Syscall];
+  }
+};
+
 struct SeccompFilterInfo final {
   SeccompFilterFunc Func;
   uint64_t RefCount;
   size_t MappedSize;
   uint32_t FilterInstructions;
   bool ShouldLog;
+  SeccompVerdictCache VerdictCache;
 };
 
 class SeccompEmulator final {
@@ -98,6 +124,10 @@ private:
 
   static void DumpProgram(const sock_fprog* prog);
 
+  // Evaluates the filter for every syscall number with the rest of seccomp_data unknown.
+  // Syscalls whose result doesn't depend on the unknown data get their verdict cached.
+  static SeccompVerdictCache BuildVerdictCache(const sock_fprog* prog, uint32_t Arch);
+
   // Multiple filter instruction count penalty.
   // When multiple filters are installed there is a penalty per filter counted towards the maximum number of instructions.
   constexpr static size_t BPF_MULTIFILTERPENALTY = 4;
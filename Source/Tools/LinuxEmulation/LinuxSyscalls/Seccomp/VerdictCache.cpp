@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|syscalls-shared
+$end_info$
+*/
+
+#include "LinuxSyscalls/Seccomp/SeccompEmulator.h"
+
+#include <cstddef>
+#include <linux/bpf_common.h>
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+
+namespace FEX::HLE {
+namespace {
+  // A BPF register or scratch word, unknown once it depends on anything other than the syscall number or architecture.
+  struct Value {
+    uint32_t Data;
+    bool Known;
+  };
+
+  // Matches the AArch64 instructions that BPFEmitter uses, including division by zero and out of range shifts.
+  uint32_t EvaluateALU(uint32_t Op, uint32_t A, uint32_t Src) {
+    switch (Op) {
+    case BPF_ADD: return A + Src;
+    case BPF_SUB: return A - Src;
+    case BPF_MUL: return A * Src;
+    case BPF_DIV: return Src ? A / Src : 0;
+    case BPF_OR: return A | Src;
+    case BPF_AND: return A & Src;
+    case BPF_LSH: return A << (Src & 31);
+    case BPF_RSH: return A >> (Src & 31);
+    case BPF_MOD: return Src ? A % Src : A;
+    case BPF_XOR: return A ^ Src;
+    default: return 0;
+    }
+  }
+
+  // Runs the filter for one syscall number.
+  // Returns nothing if the result depends on the instruction pointer or the syscall arguments.
+  std::optional<uint32_t> Evaluate(const sock_fprog* prog, uint32_t Syscall, uint32_t Arch) {
+    Value A {0, true};
+    Value X {0, true};
+    // FEX zeroes the scratch memory before executing a filter.
+    std::array<Value, BPF_MEMWORDS> Memory;
+    Memory.fill({0, true});
+
+    for (uint32_t IP = 0; IP < prog->len; ++IP) {
+      const sock_filter* Inst = &prog->filter[IP];
+      const uint16_t Code = Inst->code;
+
+      switch (BPF_CLASS(Code)) {
+      case BPF_LD:
+      case BPF_LDX: {
+        auto& Dest = BPF_CLASS(Code) == BPF_LD ? A : X;
+        switch (BPF_MODE(Code)) {
+        case BPF_IMM: Dest = {Inst->k, true}; break;
+        case BPF_ABS:
+          if (Inst->k == offsetof(seccomp_data, nr)) {
+            Dest = {Syscall, true};
+          } else if (Inst->k == offsetof(seccomp_data, arch)) {
+            Dest = {Arch, true};
+          } else {
+            Dest = {0, false};
+          }
+          break;
+        case BPF_MEM: Dest = Memory[Inst->k]; break;
+        case BPF_LEN: Dest = {sizeof(seccomp_data), true}; break;
+        default: return std::nullopt;
+        }
+        break;
+      }
+      case BPF_ST:
+      case BPF_STX: Memory[Inst->k] = BPF_CLASS(Code) == BPF_ST ? A : X; break;
+      case BPF_ALU: {
+        if (BPF_OP(Code) == BPF_NEG) {
+          A.Data = -A.Data;
+          break;
+        }
+
+        const Value Src = BPF_SRC(Code) == BPF_K ? Value {Inst->k, true} : X;
+        A = {EvaluateALU(BPF_OP(Code), A.Data, Src.Data), A.Known && Src.Known};
+        break;
+      }
+      case BPF_JMP: {
+        if (BPF_OP(Code) == BPF_JA) {
+          IP += Inst->k;
+          break;
+        }
+
+        const Value Src = BPF_SRC(Code) == BPF_K ? Value {Inst->k, true} : X;
+        if (!A.Known || !Src.Known) {
+          return std::nullopt;
+        }
+
+        bool Taken {};
+        switch (BPF_OP(Code)) {
+        case BPF_JEQ: Taken = A.Data == Src.Data; break;
+        case BPF_JGT: Taken = A.Data > Src.Data; break;
+        case BPF_JGE: Taken = A.Data >= Src.Data; break;
+        case BPF_JSET: Taken = (A.Data & Src.Data) != 0; break;
+        default: return std::nullopt;
+        }
+        IP += Taken ? Inst->jt : Inst->jf;
+        break;
+      }
+      case BPF_RET: {
+        Value Result {};
+        switch (BPF_RVAL(Code)) {
+        case BPF_K: Result = {Inst->k, true}; break;
+        case BPF_X: Result = X; break;
+        case BPF_A: Result = A; break;
+        default: return std::nullopt;
+        }
+
+        if (!Result.Known) {
+          return std::nullopt;
+        }
+        return Result.Data;
+      }
+      case BPF_MISC:
+        if (BPF_MISCOP(Code) == BPF_TAX) {
+          X = A;
+        } else {
+          A = X;
+        }
+        break;
+      default: return std::nullopt;
+      }
+    }
+
+    // Ran off the end of the program.
+    return std::nullopt;
+  }
+} // namespace
+
+SeccompVerdictCache SeccompEmulator::BuildVerdictCache(const sock_fprog* prog, uint32_t Arch) {
+  // Only called for filters that BPFEmitter accepted, so instructions and jump targets are known to be valid.
+  SeccompVerdictCache Cache {.Arch = Arch};
+  for (uint32_t Syscall = 0; Syscall < SeccompVerdictCache::MAX_SYSCALLS; ++Syscall) {
+    if (auto Verdict = Evaluate(prog, Syscall, Arch)) {
+      Cache.Set(Syscall, *Verdict);
+    }
+  }
+
+  return Cache;
+}
+} // namespace FEX::HLE
@@ -30,6 +30,7 @@ $end_info$
 #include <cstring>
 #include <functional>
 #include <linux/futex.h>
+#include <optional>
 #include <syscall.h>
 #include <sys/mman.h>
 #include <sys/signalfd.h>
@@ -109,7 +110,7 @@ void SignalDelegator::RegisterHostSignalHandler(int Signal, HostSignalDelegatorF
   FrontendRegisterHostSignalHandler(Signal, Required);
 }
 
-void SignalDelegator::SpillSRA(FEXCore::Core::InternalThreadState* Thread, void* ucontext, uint32_t IgnoreMask) {
+uint32_t SignalDelegator::SpillSRA(FEXCore::Core::InternalThreadState* Thread, void* ucontext, uint32_t IgnoreMask) {
 #ifdef _M_ARM_64
   Thread->CurrentFrame->State.rip = CTX->RestoreRIPFromHostPC(Thread, ArchHelpers::Context::GetPc(ucontext));
 
@@ -139,6 +140,9 @@ void SignalDelegator::SpillSRA(FEXCore::Core::InternalThreadState* Thread, void*
   uint32_t EFlags =
     CTX->ReconstructCompactedEFLAGS(Thread, true, ArchHelpers::Context::GetArmGPRs(ucontext), ArchHelpers::Context::GetArmPState(ucontext));
   CTX->SetFlagsFromCompactedEFLAGS(Thread, EFlags);
+  return EFlags;
+#else
+  return CTX->ReconstructCompactedEFLAGS(Thread, false, nullptr, 0);
 #endif
 }
 
@@ -299,6 +303,7 @@ bool SignalDelegator::HandleDispatcherGuestSignal(FEXCore::Core::InternalThreadS
 
   uint64_t OldPC = ArchHelpers::Context::GetPc(ucontext);
   const bool WasInJIT = CTX->IsAddressInCodeBuffer(Thread, OldPC);
+  std::optional<uint32_t> SpilledEFlags {};
 
   // Spill the SRA regardless of signal handler type
   // We are going to be returning to the top of the dispatcher which will fill again
@@ -319,7 +324,7 @@ bool SignalDelegator::HandleDispatcherGuestSignal(FEXCore::Core::InternalThreadS
 #endif
 
     // We are in jit, SRA must be spilled
-    SpillSRA(Thread, ucontext, IgnoreMask);
+    SpilledEFlags = SpillSRA(Thread, ucontext, IgnoreMask);
 
     ContextBackup->Flags |= ArchHelpers::Context::ContextFlags::CONTEXT_FLAG_INJIT;
 
@@ -362,7 +367,8 @@ bool SignalDelegator::HandleDispatcherGuestSignal(FEXCore::Core::InternalThreadS
   siginfo_t* HostSigInfo = reinterpret_cast<siginfo_t*>(info);
 
   ContextBackup->OriginalRIP = Thread->CurrentFrame->State.rip;
-  uint32_t eflags = CTX->ReconstructCompactedEFLAGS(Thread, false, nullptr, 0);
+  // Signals at safe points (dispatcher, syscalls) already have everything in the CPUState.
+  const uint32_t eflags = SpilledEFlags ? *SpilledEFlags : CTX->ReconstructCompactedEFLAGS(Thread, false, nullptr, 0);
 
   if (Is64BitMode) {
     NewGuestSP = SetupFrame_x64(Thread, ContextBackup, Frame, Signal, HostSigInfo, ucontext, GuestAction, GuestStack, NewGuestSP, eflags);
@@ -563,13 +569,8 @@ uint64_t SignalDelegator::GetNewSigMask(int Signal) const {
     NewMask |= (1ULL << (Signal - 1));
   }
 
-  // Walk our required signals and stop masking them if requested
-  for (size_t i = 0; i < MAX_SIGNALS; ++i) {
-    if (HostHandlers[i + 1].Required.load(std::memory_order_relaxed)) {
-      // Never mask our required signals
-      NewMask &= ~(1ULL << i);
-    }
-  }
+  // Never mask our required signals
+  NewMask &= ~RequiredSignalsMask.load(std::memory_order_relaxed);
 
   return NewMask;
 }
@@ -938,6 +939,10 @@ SignalDelegator::SignalDelegator(FEXCore::Context::Context* _CTX, const std::str
     true);
 
   const auto PauseHandler = [](FEXCore::Core::InternalThreadState* Thread, int Signal, void* info, void* ucontext) -> bool {
+    if (static_cast<siginfo_t*>(info)->si_code == SI_TIMER && FEX::HLE::_SyscallHandler->Sampler->IsEnabled()) {
+      // Guest profiler sampling timer
+      return FEX::HLE::_SyscallHandler->Sampler->HandleSample(Thread, ucontext);
+    }
     return FEX::HLE::ThreadManager::GetStateObjectFromFEXCoreThread(Thread)->SignalInfo.Delegator->HandleSignalPause(Thread, Signal, info, ucontext);
   };
 
@@ -1062,7 +1067,7 @@ void SignalDelegator::FrontendRegisterHostSignalHandler(int Signal, bool Require
   // Linux signal handlers are per-process rather than per thread
   // Multiple threads could be calling in to this
   std::lock_guard lk(HostDelegatorMutex);
-  HostHandlers[Signal].Required = Required;
+  SetRequired(Signal, Required);
   InstallHostThunk(Signal);
 }
 
@@ -1070,7 +1075,7 @@ void SignalDelegator::FrontendRegisterFrontendHostSignalHandler(int Signal, bool
   // Linux signal handlers are per-process rather than per thread
   // Multiple threads could be calling in to this
   std::lock_guard lk(HostDelegatorMutex);
-  HostHandlers[Signal].Required = Required;
+  SetRequired(Signal, Required);
   InstallHostThunk(Signal);
 }
 
@@ -1232,12 +1237,8 @@ uint64_t SignalDelegator::GuestSigProcMask(FEX::HLE::ThreadStateObject* Thread,
     uint64_t HostMask = Thread->SignalInfo.CurrentSignalMask.Val;
     // Now actually set the host mask
     // This will hide from the guest that we are not actually setting all of the masks it wants
-    for (size_t i = 0; i < MAX_SIGNALS; ++i) {
-      if (HostHandlers[i + 1].Required.load(std::memory_order_relaxed)) {
-        // If it is a required host signal then we can't mask it
-        HostMask &= ~(1ULL << i);
-      }
-    }
+    // If it is a required host signal then we can't mask it
+    HostMask &= ~RequiredSignalsMask.load(std::memory_order_relaxed);
 
     ::syscall(SYS_rt_sigprocmask, SIG_SETMASK, &HostMask, nullptr, 8);
   }
@@ -146,7 +146,8 @@ public:
 
   void SaveTelemetry();
 
-  void SpillSRA(FEXCore::Core::InternalThreadState* Thread, void* ucontext, uint32_t IgnoreMask);
+  // Returns the reconstructed EFLAGS, so callers that need them don't have to reconstruct them again.
+  uint32_t SpillSRA(FEXCore::Core::InternalThreadState* Thread, void* ucontext, uint32_t IgnoreMask);
 
 private:
   // Called from the thunk handler to handle the signal
@@ -168,6 +169,15 @@ private:
     HostHandlers[Signal].FrontendHandler = std::move(Func);
   }
 
+  void SetRequired(int Signal, bool Required) {
+    HostHandlers[Signal].Required = Required;
+    if (Required) {
+      RequiredSignalsMask.fetch_or(1ULL << (Signal - 1), std::memory_order_relaxed);
+    } else {
+      RequiredSignalsMask.fetch_and(~(1ULL << (Signal - 1)), std::memory_order_relaxed);
+    }
+  }
+
   FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
   const fextl::string ApplicationName;
   FEX_CONFIG_OPT(HalfBarrierTSOEnabled, HALFBARRIERTSOENABLED);
@@ -209,6 +219,8 @@ private:
   };
 
   std::array<SignalHandler, MAX_SIGNALS + 1> HostHandlers {};
+  // Bit (Signal - 1) for every signal that has Required set, so masks can be computed without walking every handler on each delivery.
+  std::atomic<uint64_t> RequiredSignalsMask {};
   bool InstallHostThunk(int Signal);
   bool UpdateHostThunk(int Signal);
 
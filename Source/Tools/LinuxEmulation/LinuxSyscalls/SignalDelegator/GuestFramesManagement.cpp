@@ -120,6 +120,31 @@ static void SetXStateInfo(T* xstate, bool is_avx_enabled) {
   }
 }
 
+// Matches XSAVE's init optimization, the YMM component is only marked as in use when one of the upper halves is non-zero.
+// Like on the kernel, sigreturn restores the upper halves as zero when a handler leaves the component marked as unused.
+template<typename T>
+static void SetYMMInUse(T* xstate, size_t NumRegisters) {
+  __uint128_t InUse {};
+  for (size_t i = 0; i < NumRegisters; ++i) {
+    InUse |= xstate->ymmh.ymmh_space[i];
+  }
+
+  if (InUse) {
+    xstate->xstate_hdr.xfeatures |= FEXCore::x86_64::fpx_sw_bytes::FEATURE_YMM;
+  }
+}
+
+// Upper halves for frames where the YMM component is in its initial state.
+static const __uint128_t InitYMMHigh[FEXCore::Core::CPUState::NUM_XMMS] {};
+
+template<typename T>
+static const __uint128_t* GetYMMHigh(const T* xstate) {
+  if (xstate->xstate_hdr.xfeatures & FEXCore::x86_64::fpx_sw_bytes::FEATURE_YMM) {
+    return xstate->ymmh.ymmh_space;
+  }
+  return InitYMMHigh;
+}
+
 void SignalDelegator::RestoreFrame_x64(FEXCore::Core::InternalThreadState* Thread, ArchHelpers::Context::ContextBackup* Context,
                                        FEXCore::Core::CpuStateFrame* Frame, void* ucontext) {
   auto* guest_uctx = reinterpret_cast<FEXCore::x86_64::ucontext_t*>(Context->UContextLocation);
@@ -173,7 +198,7 @@ void SignalDelegator::RestoreFrame_x64(FEXCore::Core::InternalThreadState* Threa
     auto* fpstate = &xstate->fpstate;
 
     if (SupportsAVX) {
-      CTX->SetXMMRegistersFromState(Thread, fpstate->_xmm, xstate->ymmh.ymmh_space);
+      CTX->SetXMMRegistersFromState(Thread, fpstate->_xmm, GetYMMHigh(xstate));
     } else {
       CTX->SetXMMRegistersFromState(Thread, fpstate->_xmm, nullptr);
     }
@@ -247,7 +272,7 @@ void SignalDelegator::RestoreFrame_ia32(FEXCore::Core::InternalThreadState* Thre
 
     // Extended XMM state
     if (SupportsAVX) {
-      CTX->SetXMMRegistersFromState(Thread, fpstate->_xmm, xstate->ymmh.ymmh_space);
+      CTX->SetXMMRegistersFromState(Thread, fpstate->_xmm, GetYMMHigh(xstate));
     } else {
       CTX->SetXMMRegistersFromState(Thread, fpstate->_xmm, nullptr);
     }
@@ -323,7 +348,7 @@ void SignalDelegator::RestoreRTFrame_ia32(FEXCore::Core::InternalThreadState* Th
 
     // Extended XMM state
     if (SupportsAVX) {
-      CTX->SetXMMRegistersFromState(Thread, fpstate->_xmm, xstate->ymmh.ymmh_space);
+      CTX->SetXMMRegistersFromState(Thread, fpstate->_xmm, GetYMMHigh(xstate));
     } else {
       CTX->SetXMMRegistersFromState(Thread, fpstate->_xmm, nullptr);
     }
@@ -465,6 +490,7 @@ uint64_t SignalDelegator::SetupFrame_x64(FEXCore::Core::InternalThreadState* Thr
 
   if (SupportsAVX) {
     CTX->ReconstructXMMRegisters(Thread, fpstate->_xmm, xstate->ymmh.ymmh_space);
+    SetYMMInUse(xstate, FEXCore::Core::CPUState::NUM_XMMS);
   } else {
     CTX->ReconstructXMMRegisters(Thread, fpstate->_xmm, nullptr);
   }
@@ -588,6 +614,7 @@ uint64_t SignalDelegator::SetupFrame_ia32(FEXCore::Core::InternalThreadState* Th
 
   if (SupportsAVX) {
     CTX->ReconstructXMMRegisters(Thread, fpstate->_xmm, xstate->ymmh.ymmh_space);
+    SetYMMInUse(xstate, 8);
   } else {
     CTX->ReconstructXMMRegisters(Thread, fpstate->_xmm, nullptr);
   }
@@ -724,6 +751,7 @@ uint64_t SignalDelegator::SetupRTFrame_ia32(FEXCore::Core::InternalThreadState*
 
   if (SupportsAVX) {
     CTX->ReconstructXMMRegisters(Thread, fpstate->_xmm, xstate->ymmh.ymmh_space);
+    SetYMMInUse(xstate, 8);
   } else {
     CTX->ReconstructXMMRegisters(Thread, fpstate->_xmm, nullptr);
   }
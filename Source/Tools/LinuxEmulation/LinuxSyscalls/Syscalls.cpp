@@ -8,6 +8,7 @@ $end_info$
 */
 
 #include "CodeLoader.h"
+#include "Common/StartupTrace.h"
 
 #include "FEXHeaderUtils/StringArgumentParser.h"
 #include "Linux/Utils/ELFContainer.h"
@@ -34,6 +35,7 @@ $end_info$
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/Utils/FileLoading.h>
+#include <FEXCore/Utils/SHMStats.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/sstream.h>
 #include <FEXCore/fextl/string.h>
@@ -198,6 +200,9 @@ static fextl::string GetShebangInterpFilename(const fextl::string& Filename) {
 uint64_t ExecveHandler(FEXCore::Core::CpuStateFrame* Frame, const char* pathname, char* const* argv, char* const* envp, ExecveAtArgs Args) {
   auto SyscallHandler = FEX::HLE::_SyscallHandler;
   Frame->Thread->CTX->FlushAndCloseCodeMap();
+  SyscallHandler->TSOTrainer->Persist();
+  SyscallHandler->UnalignedAtomics->Persist();
+  SyscallHandler->Sampler->Persist(Frame->Thread);
 
   fextl::string Filename {};
 
@@ -371,6 +376,7 @@ uint64_t ExecveHandler(FEXCore::Core::CpuStateFrame* Frame, const char* pathname
   }
 
   if (IsBinfmtCompatible || IsOtherELF || IsForeignShebang) {
+    FEX::StartupTrace::Write(FEX::StartupTrace::Phase::Execve);
     Result = ::syscall(SYS_execveat, Args.dirfd, Filename.c_str(), argv, EnvpPtr, Args.flags);
     CloseSeccompFD();
     CloseFDExecFD();
@@ -418,6 +424,7 @@ uint64_t ExecveHandler(FEXCore::Core::CpuStateFrame* Frame, const char* pathname
     ExecveArgs.emplace_back(nullptr);
   }
 
+  FEX::StartupTrace::Write(FEX::StartupTrace::Phase::Execve);
   Result = ::syscall(SYS_execveat, Args.dirfd, "/proc/self/exe", const_cast<char* const*>(ExecveArgs.data()), EnvpPtr, Args.flags);
   CloseSeccompFD();
   CloseFDExecFD();
@@ -775,6 +782,16 @@ SyscallHandler::SyscallHandler(FEXCore::Context::Context* _CTX, FEX::HLE::Signal
   SignalDelegation->RegisterHostSignalHandler(SIGSEGV, HandleSegfault, true);
 
   ExtendedMetaData = FEX::VolatileMetadata::ParseExtendedVolatileMetadata(FEXCore::Config::Get_EXTENDEDVOLATILEMETADATA()());
+  TSOTrainer = fextl::make_unique<FEX::HLE::TSOTraining>(CTX, this);
+  UnalignedAtomics = fextl::make_unique<FEX::HLE::UnalignedAtomicTracking>(this);
+  Sampler = fextl::make_unique<FEX::HLE::GuestSampler>(CTX, this);
+  LibcRoutines = fextl::make_unique<FEX::HLE::HostLibcRoutines>(CTX, ThunkHandler);
+
+  FEX_CONFIG_OPT(ProfileStats, PROFILESTATS);
+  FEX_CONFIG_OPT(StartupTrace, STARTUPTRACE);
+  FEX_CONFIG_OPT(TrimIdleCaches, TRIMIDLETHREADCACHES);
+  TrimIdleThreadCaches = TrimIdleCaches();
+  SyscallHooksEnabled = ProfileStats() || !StartupTrace().empty() || TSOTrainer->IsTrainingEnabled() || TrimIdleThreadCaches;
 }
 
 SyscallHandler::~SyscallHandler() {
@@ -805,6 +822,16 @@ uint32_t SyscallHandler::CalculateGuestKernelVersion() {
   return std::max(KernelVersion(5, 15), std::min(KernelVersion(6, 11), GetHostKernelVersion()));
 }
 
+// Threads that sit in the same syscall for this long are considered idle.
+constexpr uint64_t IdleSyscallNanoseconds = 1'000'000'000;
+
+static uint64_t CoarseMonotonicNanoseconds() {
+  // Coarse is enough to tell idle threads apart, and it's cheap enough to query on every syscall.
+  timespec Time {};
+  clock_gettime(CLOCK_MONOTONIC_COARSE, &Time);
+  return Time.tv_sec * 1'000'000'000ULL + Time.tv_nsec;
+}
+
 uint64_t SyscallHandler::HandleSyscall(FEXCore::Core::CpuStateFrame* Frame, FEXCore::HLE::SyscallArguments* Args) {
   // Grab the return address which will be inside the JIT.
   const uint64_t JITPC = reinterpret_cast<uint64_t>(__builtin_extract_return_addr(__builtin_return_address(0)));
@@ -819,6 +846,48 @@ uint64_t SyscallHandler::HandleSyscall(FEXCore::Core::CpuStateFrame* Frame, FEXC
     return -ENOSYS;
   }
 
+  if (SyscallHooksEnabled) [[unlikely]] {
+    return HandleSyscallWithHooks(Frame, Args);
+  }
+
+  return DispatchSyscall(Frame, Args);
+}
+
+uint64_t SyscallHandler::HandleSyscallWithHooks(FEXCore::Core::CpuStateFrame* Frame, FEXCore::HLE::SyscallArguments* Args) {
+  FEX::StartupTrace::Mark(FEX::StartupTrace::Phase::FirstSyscall);
+  FEXCORE_PROFILE_SYSCALL(Frame->Thread, Args->Argument[0]);
+
+  auto ThreadObject = FEX::HLE::ThreadManager::GetStateObjectFromCPUState(Frame);
+  const uint64_t SyscallNumber = Args->Argument[0];
+
+  const bool TSOTraining = TSOTrainer->IsTrainingEnabled();
+  if (TSOTraining) {
+    TSOTrainer->EnterSyscall(ThreadObject, Frame->State.gregs[FEXCore::X86State::REG_RSP], SyscallNumber, Args->Argument[2]);
+  }
+
+  uint64_t SyscallStart {};
+  if (TrimIdleThreadCaches) {
+    // The syscall blocked for long last time, it likely will again, so give the thread's lookup caches back meanwhile.
+    // They get refilled from L3 once the thread runs again.
+    if (ThreadObject->IdleSyscall == SyscallNumber) {
+      CTX->TrimThreadLocalCaches(Frame->Thread);
+    }
+    SyscallStart = CoarseMonotonicNanoseconds();
+  }
+
+  const auto Result = DispatchSyscall(Frame, Args);
+
+  if (TSOTraining) {
+    TSOTrainer->ExitSyscall(ThreadObject);
+  }
+
+  if (TrimIdleThreadCaches) {
+    ThreadObject->IdleSyscall = CoarseMonotonicNanoseconds() - SyscallStart >= IdleSyscallNanoseconds ? SyscallNumber : ~0ULL;
+  }
+  return Result;
+}
+
+uint64_t SyscallHandler::DispatchSyscall(FEXCore::Core::CpuStateFrame* Frame, FEXCore::HLE::SyscallArguments* Args) {
   auto& Def = Definitions[Args->Argument[0]];
   uint64_t Result {};
   switch (Def.NumArgs) {
@@ -835,12 +904,13 @@ uint64_t SyscallHandler::HandleSyscall(FEXCore::Core::CpuStateFrame* Frame, FEXC
                          Args->Argument[6]);
     break;
   // for missing syscalls
-  case 255: return std::invoke(Def.Ptr1, Frame, Args->Argument[0]);
+  case 255: Result = std::invoke(Def.Ptr1, Frame, Args->Argument[0]); break;
   default:
     LOGMAN_MSG_A_FMT("Unhandled syscall: {}", Args->Argument[0]);
-    return -1;
+    Result = -1;
     break;
   }
+
 #ifdef DEBUG_STRACE
   Strace(Args, Result);
 #endif
@@ -881,9 +951,16 @@ void SyscallHandler::LockBeforeFork(FEXCore::Core::InternalThreadState* Thread)
   TM.LockBeforeFork();
   Thread->CTX->LockBeforeFork(Thread);
   VMATracking.Mutex.lock();
+  TSOTrainer->LockBeforeFork();
+  UnalignedAtomics->LockBeforeFork();
+  Sampler->LockBeforeFork();
 }
 
 void SyscallHandler::UnlockAfterFork(FEXCore::Core::InternalThreadState* LiveThread, bool Child) {
+  Sampler->UnlockAfterFork(FEX::HLE::ThreadManager::GetStateObjectFromFEXCoreThread(LiveThread), Child);
+  TSOTrainer->UnlockAfterFork(Child);
+  UnalignedAtomics->UnlockAfterFork(Child);
+
   if (Child) {
     // Code maps are closed upon fork in the child
     FM.SetProtectedCodeMapFD(-1);
@@ -902,9 +979,11 @@ void SyscallHandler::UnlockAfterFork(FEXCore::Core::InternalThreadState* LiveThr
 void SyscallHandler::RegisterTLSState(FEX::HLE::ThreadStateObject* Thread) {
   SignalDelegation->RegisterTLSState(Thread);
   ThunkHandler->RegisterTLSState(Thread);
+  Sampler->RegisterThread(Thread);
 }
 
 void SyscallHandler::UninstallTLSState(FEX::HLE::ThreadStateObject* Thread) {
+  Sampler->UnregisterThread(Thread);
   SignalDelegation->UninstallTLSState(Thread);
 }
 
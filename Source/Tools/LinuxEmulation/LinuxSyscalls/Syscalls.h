@@ -10,10 +10,14 @@ $end_info$
 
 #include "Common/VolatileMetadata.h"
 #include "LinuxSyscalls/FileManagement.h"
+#include "LinuxSyscalls/GuestSampler.h"
+#include "LinuxSyscalls/HostLibcRoutines.h"
 #include "LinuxSyscalls/LinuxAllocator.h"
 #include "LinuxSyscalls/ThreadManager.h"
 #include "LinuxSyscalls/Seccomp/SeccompEmulator.h"
 #include "LinuxSyscalls/SyscallsVMATracking.h"
+#include "LinuxSyscalls/TSOTraining.h"
+#include "LinuxSyscalls/UnalignedAtomicTracking.h"
 #include "ArchHelpers/MContext.h"
 
 #include <FEXCore/Config/Config.h>
@@ -239,6 +243,8 @@ public:
   struct LateApplyExtendedVolatileMetadata {
     fextl::set<uint64_t> VolatileInstructions {};
     FEXCore::IntervalList<uint64_t> VolatileValidRanges {};
+    fextl::set<uint64_t> UnalignedAtomicInstructions {};
+    fextl::set<uint64_t> TSOFreeInstructions {};
   };
   std::optional<LateApplyExtendedVolatileMetadata>
   TrackMmap(FEXCore::Core::InternalThreadState* Thread, uint64_t addr, size_t length, int prot, int flags, int fd, off_t offset);
@@ -252,6 +258,9 @@ public:
   void InvalidateCodeRangeIfNecessary(FEXCore::Core::InternalThreadState* Thread, uint64_t Base, uint64_t Length) {
     if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
       TM.InvalidateGuestCodeRange(Thread, Base, Length);
+    } else {
+      // Compiled code is kept, but cached IR can't be validated against code that is no longer mapped.
+      CTX->InvalidateCachedIR(Base, Length);
     }
   }
 
@@ -269,6 +278,10 @@ public:
           TM.InvalidateGuestCodeRange(Thread, OldAddress + NewSize, OldSize - NewSize);
         }
       }
+    } else if (OldAddress != NewAddress) {
+      CTX->InvalidateCachedIR(OldAddress, OldSize);
+    } else if (OldSize > NewSize) {
+      CTX->InvalidateCachedIR(OldAddress + NewSize, OldSize - NewSize);
     }
   }
 
@@ -277,6 +290,7 @@ public:
   static bool HandleSegfault(FEXCore::Core::InternalThreadState* Thread, int Signal, void* info, void* ucontext);
   void MarkGuestExecutableRange(FEXCore::Core::InternalThreadState* Thread, uint64_t Start, uint64_t Length) override;
   void InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState* Thread, uint64_t Start, uint64_t Length) override;
+  void MarkUnalignedAtomic(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP) override;
   std::optional<FEXCore::ExecutableFileSectionInfo>
   LookupExecutableFileSection(FEXCore::Core::InternalThreadState& Thread, uint64_t GuestAddr) final override;
 
@@ -311,6 +325,10 @@ public:
   constexpr static size_t LDT_ENTRY_SIZE = sizeof(FEXCore::Core::CPUState::gdt_segment);
 
   VMATracking::VMATracking VMATracking;
+  fextl::unique_ptr<FEX::HLE::TSOTraining> TSOTrainer;
+  fextl::unique_ptr<FEX::HLE::UnalignedAtomicTracking> UnalignedAtomics;
+  fextl::unique_ptr<FEX::HLE::GuestSampler> Sampler;
+  fextl::unique_ptr<FEX::HLE::HostLibcRoutines> LibcRoutines;
 
   uint64_t read_ldt(FEXCore::Core::CpuStateFrame* Frame, void* ptr, unsigned long bytecount);
   uint64_t write_ldt(FEXCore::Core::CpuStateFrame* Frame, void* ptr, unsigned long bytecount, bool legacy);
@@ -347,6 +365,14 @@ private:
   FEX::CodeLoader* LocalLoader {};
   bool NeedToCheckXID {true};
 
+  // Set if any optional per-syscall work is enabled: profile stats, startup tracing, TSO training or idle cache trimming.
+  // Syscalls only take the slow path through HandleSyscallWithHooks when it is set.
+  bool SyscallHooksEnabled {};
+  bool TrimIdleThreadCaches {};
+
+  uint64_t HandleSyscallWithHooks(FEXCore::Core::CpuStateFrame* Frame, FEXCore::HLE::SyscallArguments* Args);
+  uint64_t DispatchSyscall(FEXCore::Core::CpuStateFrame* Frame, FEXCore::HLE::SyscallArguments* Args);
+
 #ifdef DEBUG_STRACE
   void Strace(FEXCore::HLE::SyscallArguments* Args, uint64_t Ret);
 #endif
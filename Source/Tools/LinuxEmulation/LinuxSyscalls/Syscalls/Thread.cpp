@@ -6,6 +6,7 @@ $end_info$
 */
 
 #include "CodeLoader.h"
+#include "Common/StartupTrace.h"
 
 #include "LinuxSyscalls/SignalDelegator.h"
 #include "LinuxSyscalls/Syscalls.h"
@@ -567,10 +568,14 @@ void RegisterThread(FEX::HLE::SyscallHandler* Handler) {
 
   REGISTER_SYSCALL_IMPL(exit_group, [](FEXCore::Core::CpuStateFrame* Frame, int status) -> uint64_t {
     Frame->Thread->CTX->FlushAndCloseCodeMap();
+    FEX::HLE::_SyscallHandler->TSOTrainer->Persist();
+    FEX::HLE::_SyscallHandler->UnalignedAtomics->Persist();
+    FEX::HLE::_SyscallHandler->Sampler->Persist(Frame->Thread);
 
     // Save telemetry if we're exiting.
     FEX::HLE::_SyscallHandler->GetSignalDelegator()->SaveTelemetry();
     FEX::HLE::_SyscallHandler->TM.CleanupForExit();
+    FEX::StartupTrace::Write(FEX::StartupTrace::Phase::Exit);
 
     syscall(SYSCALL_DEF(exit_group), status);
     // This will never be reached
@@ -40,6 +40,10 @@ bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState* Thread,
     return true;
   }
 
+  if (_SyscallHandler->TSOTrainer->IsTrainingEnabled() && _SyscallHandler->TSOTrainer->HandleSegfault(Thread, FaultAddress, ucontext)) {
+    return true;
+  }
+
   {
     // Can't use the deferred signal lock in the SIGSEGV handler.
     auto lk = FEXCore::MaskSignalsAndLockMutex<std::shared_lock>(_SyscallHandler->VMATracking.Mutex);
@@ -171,6 +175,10 @@ void SyscallHandler::InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState
   InvalidateCodeRangeIfNecessary(Thread, Start, Length);
 }
 
+void SyscallHandler::MarkUnalignedAtomic(FEXCore::Core::InternalThreadState* Thread, uint64_t GuestRIP) {
+  UnalignedAtomics->Record(GuestRIP);
+}
+
 std::optional<FEXCore::ExecutableFileSectionInfo>
 SyscallHandler::LookupExecutableFileSection(FEXCore::Core::InternalThreadState& Thread, uint64_t GuestAddr) {
   auto lk = FEXCore::GuardSignalDeferringSection<std::shared_lock>(VMATracking.Mutex, &Thread);
@@ -248,6 +256,10 @@ void* SyscallHandler::GuestMmap(bool Is64Bit, FEXCore::Core::InternalThreadState
   if (LateMetadata) {
     auto CodeInvalidationlk = GuardSignalDeferringSectionWithFallback(CTX->GetCodeInvalidationMutex(), Thread);
     CTX->AddForceTSOInformation(LateMetadata->VolatileValidRanges, std::move(LateMetadata->VolatileInstructions));
+    CTX->AddUnalignedAtomicInformation(std::move(LateMetadata->UnalignedAtomicInstructions));
+    if (!LateMetadata->TSOFreeInstructions.empty()) {
+      CTX->AddTSOFreeInstructions(std::move(LateMetadata->TSOFreeInstructions));
+    }
   }
 
   return reinterpret_cast<void*>(Result);
@@ -282,8 +294,11 @@ uint64_t SyscallHandler::GuestMunmap(bool Is64Bit, FEXCore::Core::InternalThread
   InvalidateCodeRangeIfNecessary(Thread, reinterpret_cast<uint64_t>(addr), Size);
 
   if (length) {
-    auto CodeInvalidationlk = GuardSignalDeferringSectionWithFallback(CTX->GetCodeInvalidationMutex(), Thread);
-    CTX->RemoveForceTSOInformation(reinterpret_cast<uint64_t>(addr), length);
+    {
+      auto CodeInvalidationlk = GuardSignalDeferringSectionWithFallback(CTX->GetCodeInvalidationMutex(), Thread);
+      CTX->RemoveForceTSOInformation(reinterpret_cast<uint64_t>(addr), length);
+    }
+    LibcRoutines->TrackUnmap(Thread, reinterpret_cast<uint64_t>(addr), length);
   }
 
   return Result;
@@ -465,6 +480,10 @@ std::optional<SyscallHandler::LateApplyExtendedVolatileMetadata> SyscallHandler:
           Resource->ProgramHeaders = ReadELFHeaders(fd, std::span {reinterpret_cast<std::byte*>(addr), length});
           LOGMAN_THROW_A_FMT(Resource->ProgramHeaders.empty() || offset == 0, "Expected file offset 0 for the first mapping of an ELF "
                                                                               "file");
+
+          if (!Resource->ProgramHeaders.empty()) {
+            LibcRoutines->TrackMapping(FHU::Filesystem::GetFilename(Resource->MappedFile->Filename), fd, addr);
+          }
         }
       } else if (ResourceIt->second.ProgramHeaders.empty()) {
         // Not an ELF file, so we don't need to distinguish between different base addresses
@@ -496,6 +515,26 @@ std::optional<SyscallHandler::LateApplyExtendedVolatileMetadata> SyscallHandler:
         if (!LateMetadata.VolatileInstructions.empty() || !LateMetadata.VolatileValidRanges.Empty()) {
           VolatileMetadata.emplace(std::move(LateMetadata));
         }
+      } else if (ProtMapping.Executable) {
+        // Fall back to what TSO training learned about this file.
+        fextl::set<uint64_t> TSOFreeInstructions;
+        TSOTrainer->ApplyToMapping(*Resource->MappedFile, addr, Size, offset, TSOFreeInstructions);
+        if (!TSOFreeInstructions.empty()) {
+          VolatileMetadata.emplace();
+          VolatileMetadata->TSOFreeInstructions = std::move(TSOFreeInstructions);
+        }
+      }
+
+      if (ProtMapping.Executable) {
+        // Instructions that needed SIGBUS backpatching in earlier runs.
+        fextl::set<uint64_t> UnalignedAtomicInstructions;
+        UnalignedAtomics->ApplyToMapping(*Resource->MappedFile, addr, Size, offset, UnalignedAtomicInstructions);
+        if (!UnalignedAtomicInstructions.empty()) {
+          if (!VolatileMetadata) {
+            VolatileMetadata.emplace();
+          }
+          VolatileMetadata->UnalignedAtomicInstructions = std::move(UnalignedAtomicInstructions);
+        }
       }
     }
   } else if (flags & MAP_SHARED) {
@@ -0,0 +1,509 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: TSO training mode, learns which guest instructions don't need memory ordering
+$end_info$
+*/
+
+#include "LinuxSyscalls/OffsetProfile.h"
+#include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/ThreadManager.h"
+#include "LinuxSyscalls/TSOTraining.h"
+#include "LinuxSyscalls/x32/SyscallsEnum.h"
+#include "LinuxSyscalls/x64/SyscallsEnum.h"
+
+#include <FEXCore/Core/CodeCache.h>
+#include <FEXCore/Core/Context.h>
+#include <FEXCore/Core/X86Enums.h>
+#include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/TypeDefines.h>
+
+#include <algorithm>
+#include <linux/futex.h>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace FEX::HLE {
+static int ToProt(VMATracking::VMAProt Prot) {
+  return (Prot.Readable ? PROT_READ : 0) | (Prot.Writable ? PROT_WRITE : 0) | (Prot.Executable ? PROT_EXEC : 0);
+}
+
+static void* ThreadHandler(void* Arg) {
+  FEXCore::Threads::SetThreadName("FEX:TSOTraining");
+  reinterpret_cast<TSOTraining*>(Arg)->SamplerLoop();
+  return nullptr;
+}
+
+TSOTraining::TSOTraining(FEXCore::Context::Context* CTX, SyscallHandler* Handler)
+  : CTX {CTX}
+  , Handler {Handler} {
+  FEX_CONFIG_OPT(TSOTrainingEnabled, TSOTRAINING);
+  FEX_CONFIG_OPT(TSOProfiles, TSOPROFILES);
+  FEX_CONFIG_OPT(LibcRoutinesEnabled, HOSTLIBCROUTINES);
+  TrainingEnabled = TSOEnabled() && TSOTrainingEnabled();
+  ProfilesEnabled = TSOEnabled() && TSOProfiles();
+
+  if (TrainingEnabled && LibcRoutinesEnabled()) {
+    // Host libc routines access guest memory outside of syscalls at any time.
+    LogMan::Msg::IFmt("TSO training is disabled while HostLibcRoutines is enabled");
+    TrainingEnabled = false;
+  }
+
+  if (TrainingEnabled) {
+    StartThread();
+  }
+}
+
+TSOTraining::~TSOTraining() {
+  ShouldStop = true;
+  if (SamplerThread && SamplerThread->joinable()) {
+    SamplerThread->join(nullptr);
+  }
+}
+
+void TSOTraining::StartThread() {
+  // The sampler must never receive a guest signal.
+  uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
+  SamplerThread = FEXCore::Threads::Thread::Create(ThreadHandler, this);
+  FEXCore::Threads::SetSignalMask(OldMask);
+}
+
+TSOTraining::ProfiledFile* TSOTraining::GetProfiledFile(const FEXCore::ExecutableFileInfo& FileInfo) {
+  auto [It, Inserted] = ProfiledFiles.try_emplace(FileInfo.FileId);
+  auto& File = It->second;
+  if (Inserted) {
+    File.PrivatePath = OffsetProfile::GetPath(FileInfo, ".tso-private");
+    File.SharedPath = OffsetProfile::GetPath(FileInfo, ".tso-shared");
+    if (!File.PrivatePath.empty()) {
+      OffsetProfile::Load(File.PrivatePath, File.PrivateOffsets);
+      OffsetProfile::Load(File.SharedPath, File.SharedOffsets);
+    }
+  }
+
+  if (File.PrivatePath.empty()) {
+    // No stable identifier to store a profile with.
+    return nullptr;
+  }
+
+  return &File;
+}
+
+void TSOTraining::ApplyToMapping(const FEXCore::ExecutableFileInfo& FileInfo, uint64_t Base, uint64_t Length, uint64_t Offset,
+                                 fextl::set<uint64_t>& TSOFreeInstructions) {
+  if (!ProfilesEnabled) {
+    return;
+  }
+
+  std::lock_guard lk(ProfileMutex);
+  auto File = GetProfiledFile(FileInfo);
+  if (!File) {
+    return;
+  }
+
+  // Only instructions that were observed and never seen on a shared page lose TSO, everything else keeps it.
+  for (auto It = File->PrivateOffsets.lower_bound(Offset); It != File->PrivateOffsets.end() && *It < Offset + Length; ++It) {
+    if (!File->SharedOffsets.contains(*It)) {
+      TSOFreeInstructions.insert(Base + *It - Offset);
+    }
+  }
+}
+
+bool TSOTraining::IsFutexWait(uint64_t Syscall, uint64_t FutexOp) const {
+  const bool IsFutex = Is64BitMode() ? Syscall == x64::SYSCALL_x64_futex :
+                                       Syscall == x32::SYSCALL_x86_futex || Syscall == x32::SYSCALL_x86_futex_time64;
+  if (IsFutex) {
+    const auto Cmd = FutexOp & FUTEX_CMD_MASK;
+    return Cmd == FUTEX_WAIT || Cmd == FUTEX_WAIT_BITSET;
+  }
+
+  return Is64BitMode() ? Syscall == x64::SYSCALL_x64_futex_wait : Syscall == x32::SYSCALL_x86_futex_wait;
+}
+
+bool TSOTraining::IsAsyncIOSetup(uint64_t Syscall) const {
+  // The kernel keeps accessing guest memory handed to these after the syscall returned.
+  if (Is64BitMode()) {
+    return Syscall == x64::SYSCALL_x64_io_uring_setup || Syscall == x64::SYSCALL_x64_io_submit || Syscall == x64::SYSCALL_x64_vmsplice;
+  }
+  return Syscall == x32::SYSCALL_x86_io_uring_setup || Syscall == x32::SYSCALL_x86_io_submit || Syscall == x32::SYSCALL_x86_vmsplice;
+}
+
+void TSOTraining::EnterSyscall(ThreadStateObject* Thread, uint64_t StackPointer, uint64_t Syscall, uint64_t FutexOp) {
+  auto& Info = Thread->TSOTrainingInfo;
+  Info.StackPointer.store(StackPointer, std::memory_order_relaxed);
+  Info.FutexWait.store(IsFutexWait(Syscall, FutexOp), std::memory_order_relaxed);
+
+  // Either the sampler sees this thread inside a syscall and doesn't arm any page, or this sees PagesArmed and waits for
+  // the sampler to finish before handing the pages back.
+  Info.SyscallSequence.fetch_add(1, std::memory_order_seq_cst);
+  if (PagesArmed.load(std::memory_order_seq_cst)) {
+    std::lock_guard lk(ArmMutex);
+    if (PagesArmed.load(std::memory_order_relaxed)) {
+      DisarmWatches();
+    }
+  }
+
+  if (IsAsyncIOSetup(Syscall)) {
+    StopSampling("asynchronous kernel I/O");
+  }
+}
+
+void TSOTraining::ExitSyscall(ThreadStateObject* Thread) {
+  // sigaltstack is a syscall, so the alternate signal stack of a thread can only change before this.
+  auto& Info = Thread->TSOTrainingInfo;
+  const auto& AltStack = Thread->SignalInfo.GuestAltStack;
+  const auto AltStackBase = (AltStack.ss_flags & SS_DISABLE) ? 0 : reinterpret_cast<uint64_t>(AltStack.ss_sp);
+  Info.AltStackBase.store(AltStackBase, std::memory_order_relaxed);
+  Info.AltStackEnd.store(AltStackBase ? AltStackBase + AltStack.ss_size : 0, std::memory_order_relaxed);
+  Info.SyscallSequence.fetch_add(1, std::memory_order_release);
+}
+
+void TSOTraining::StopSampling(std::string_view Reason) {
+  if (!TrainingEnabled || SamplingStopped.exchange(true)) {
+    return;
+  }
+
+  {
+    std::lock_guard lk(ArmMutex);
+    DisarmWatches();
+  }
+
+  LogMan::Msg::IFmt("TSO training stopped sampling: {}", Reason);
+}
+
+void TSOTraining::DisarmWatches() {
+  // Armed pages are always read-write data pages. Changing that needs a syscall, which disarms them first.
+  for (auto& W : Watches) {
+    if (const auto Page = W.Page.load(std::memory_order_relaxed)) {
+      mprotect(reinterpret_cast<void*>(Page), FEXCore::Utils::FEX_PAGE_SIZE, PROT_READ | PROT_WRITE);
+    }
+  }
+
+  PagesArmed.store(false, std::memory_order_relaxed);
+}
+
+bool TSOTraining::HandleSegfault(FEXCore::Core::InternalThreadState* Thread, uint64_t FaultAddress, void* ucontext) {
+  const auto FaultPage = FaultAddress & FEXCore::Utils::FEX_PAGE_MASK;
+
+  Watch* W {};
+  for (auto& It : Watches) {
+    if (It.Page.load(std::memory_order_relaxed) == FaultPage) {
+      W = &It;
+      break;
+    }
+  }
+
+  if (!W) {
+    return false;
+  }
+
+  // Only accesses from JIT code can be attributed to a guest instruction.
+  const auto PC = ArchHelpers::Context::GetPc(ucontext);
+  if (CTX->IsAddressInCodeBuffer(Thread, PC)) {
+    const auto Index = W->NumAccesses.fetch_add(1, std::memory_order_relaxed);
+    if (Index < W->Accesses.size()) {
+      W->Accesses[Index].RIP.store(CTX->RestoreRIPFromHostPC(Thread, PC), std::memory_order_relaxed);
+      W->Accesses[Index].TID.store(ThreadManager::GetStateObjectFromFEXCoreThread(Thread)->ThreadInfo.TID, std::memory_order_release);
+    }
+  }
+
+  // Hand the page back using whatever protection the guest currently expects.
+  auto lk = FEXCore::MaskSignalsAndLockMutex<std::shared_lock>(Handler->VMATracking.Mutex);
+  auto Entry = Handler->VMATracking.FindVMAEntry(FaultPage);
+  if (Entry == Handler->VMATracking.VMAs.end() || !Entry->second.Prot.Readable) {
+    // The guest changed the mapping underneath us, this fault is its own.
+    return false;
+  }
+
+  mprotect(reinterpret_cast<void*>(FaultPage), FEXCore::Utils::FEX_PAGE_SIZE, ToProt(Entry->second.Prot));
+  return true;
+}
+
+bool TSOTraining::IsOnAltStack(std::span<const Range> AltStacks, uint64_t Page) {
+  return std::ranges::any_of(AltStacks, [Page](const auto& AltStack) {
+    return Page < AltStack.End && Page + FEXCore::Utils::FEX_PAGE_SIZE > AltStack.Begin;
+  });
+}
+
+bool TSOTraining::PickPage(std::span<const uint64_t> StackPointers, std::span<const Range> AltStacks, uint64_t* Page) {
+  // Sampling a guest stack would fault on nearly every instruction and breaks guest signal delivery.
+  auto IsCandidate = [StackPointers](const VMATracking::VMAEntry& VMA) {
+    if (!VMA.Prot.Readable || !VMA.Prot.Writable || VMA.Prot.Executable) {
+      return false;
+    }
+
+    for (auto RSP : StackPointers) {
+      if (RSP >= VMA.Base && RSP < VMA.Base + VMA.Length) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  uint64_t CandidatePages {};
+  for (const auto& [Base, VMA] : Handler->VMATracking.VMAs) {
+    if (IsCandidate(VMA)) {
+      CandidatePages += VMA.Length / FEXCore::Utils::FEX_PAGE_SIZE;
+    }
+  }
+
+  if (!CandidatePages) {
+    return false;
+  }
+
+  // xorshift64
+  RandomState ^= RandomState << 13;
+  RandomState ^= RandomState >> 7;
+  RandomState ^= RandomState << 17;
+  uint64_t PageIndex = RandomState % CandidatePages;
+
+  for (const auto& [Base, VMA] : Handler->VMATracking.VMAs) {
+    if (!IsCandidate(VMA)) {
+      continue;
+    }
+
+    const auto Pages = VMA.Length / FEXCore::Utils::FEX_PAGE_SIZE;
+    if (PageIndex < Pages) {
+      *Page = VMA.Base + PageIndex * FEXCore::Utils::FEX_PAGE_SIZE;
+      if (IsOnAltStack(AltStacks, *Page)) {
+        return false;
+      }
+      for (const auto& Other : Watches) {
+        if (Other.Page.load(std::memory_order_relaxed) == *Page) {
+          return false;
+        }
+      }
+      return true;
+    }
+    PageIndex -= Pages;
+  }
+
+  return false;
+}
+
+void TSOTraining::RetireWatch(Watch& W, fextl::set<uint64_t>& SharedInstructions) {
+  const auto Page = W.Page.load(std::memory_order_relaxed);
+
+  // The page may still be protected if it wasn't touched since it was last armed.
+  auto Entry = Handler->VMATracking.FindVMAEntry(Page);
+  if (Entry != Handler->VMATracking.VMAs.end()) {
+    mprotect(reinterpret_cast<void*>(Page), FEXCore::Utils::FEX_PAGE_SIZE, ToProt(Entry->second.Prot));
+  }
+  W.Page.store(0, std::memory_order_relaxed);
+
+  const auto TotalAccesses = W.NumAccesses.load(std::memory_order_relaxed);
+  const auto NumAccesses = std::min<size_t>(TotalAccesses, W.Accesses.size());
+  uint32_t FirstTID {};
+  bool Shared {};
+  for (size_t i = 0; i < NumAccesses; ++i) {
+    const auto TID = W.Accesses[i].TID.load(std::memory_order_acquire);
+    if (!TID) {
+      continue;
+    }
+
+    if (!FirstTID) {
+      FirstTID = TID;
+    } else if (FirstTID != TID) {
+      Shared = true;
+    }
+  }
+
+  // A page is only known to be private if every access to it was recorded.
+  if (!Shared && TotalAccesses > W.Accesses.size()) {
+    return;
+  }
+
+  std::lock_guard lk(ProfileMutex);
+  for (size_t i = 0; i < NumAccesses; ++i) {
+    const auto RIP = W.Accesses[i].RIP.load(std::memory_order_relaxed);
+    auto CodeEntry = Handler->VMATracking.FindVMAEntry(RIP);
+    if (!W.Accesses[i].TID.load(std::memory_order_relaxed) || CodeEntry == Handler->VMATracking.VMAs.end()) {
+      continue;
+    }
+
+    const auto& VMA = CodeEntry->second;
+    if (!VMA.Resource || !VMA.Resource->MappedFile) {
+      // Anonymous code, JITs and the like, can't be persisted.
+      continue;
+    }
+
+    auto File = GetProfiledFile(*VMA.Resource->MappedFile);
+    if (!File) {
+      continue;
+    }
+
+    const auto FileOffset = RIP - VMA.Base + VMA.Offset;
+    if (Shared) {
+      // Every instruction that touched a page shared between threads needs ordering, even if it was private before.
+      File->Dirty |= File->SharedOffsets.insert(FileOffset).second;
+      if (File->PrivateOffsets.erase(FileOffset)) {
+        File->Dirty = true;
+        SharedInstructions.insert(RIP);
+      }
+    } else if (!File->SharedOffsets.contains(FileOffset)) {
+      // Only takes effect with the next run that loads the profile.
+      File->Dirty |= File->PrivateOffsets.insert(FileOffset).second;
+    }
+  }
+}
+
+bool TSOTraining::ArmWatches(std::span<const uint64_t> StackPointers, std::span<const Range> AltStacks, bool CanArm,
+                             fextl::set<uint64_t>& SharedInstructions) {
+  bool Armed {};
+
+  std::shared_lock lk(Handler->VMATracking.Mutex);
+  for (auto& W : Watches) {
+    if (W.Page.load(std::memory_order_relaxed)) {
+      if (++W.Rounds < RoundsPerWatch) {
+        if (!CanArm) {
+          continue;
+        }
+
+        const auto Page = W.Page.load(std::memory_order_relaxed);
+        auto Entry = Handler->VMATracking.FindVMAEntry(Page);
+        if (Entry != Handler->VMATracking.VMAs.end() && Entry->second.Prot.Readable && Entry->second.Prot.Writable &&
+            !Entry->second.Prot.Executable && !IsOnAltStack(AltStacks, Page)) {
+          mprotect(reinterpret_cast<void*>(Page), FEXCore::Utils::FEX_PAGE_SIZE, PROT_NONE);
+          Armed = true;
+          continue;
+        }
+      }
+
+      RetireWatch(W, SharedInstructions);
+    }
+
+    uint64_t Page {};
+    if (!CanArm || !PickPage(StackPointers, AltStacks, &Page)) {
+      continue;
+    }
+
+    W.Rounds = 0;
+    W.NumAccesses.store(0, std::memory_order_relaxed);
+    for (auto& Access : W.Accesses) {
+      Access.TID.store(0, std::memory_order_relaxed);
+    }
+    W.Page.store(Page, std::memory_order_release);
+    mprotect(reinterpret_cast<void*>(Page), FEXCore::Utils::FEX_PAGE_SIZE, PROT_NONE);
+    Armed = true;
+  }
+
+  return Armed;
+}
+
+void TSOTraining::EnableTSO(const fextl::set<uint64_t>& SharedInstructions) {
+  // Profiled instructions that turned out to touch shared pages get recompiled with TSO emulation enabled.
+  // Invalidation has to happen without VMATracking held, same lock ordering as fork.
+  {
+    auto CodeInvalidationlk = FEXCore::GuardSignalDeferringSectionWithFallback(CTX->GetCodeInvalidationMutex(), nullptr);
+    CTX->RemoveTSOFreeInstructions(SharedInstructions);
+  }
+
+  for (auto RIP : SharedInstructions) {
+    Handler->TM.InvalidateGuestCodeRange(nullptr, RIP, 1);
+  }
+
+  LogMan::Msg::DFmt("TSO training: {} private instructions turned out to be shared", SharedInstructions.size());
+}
+
+void TSOTraining::SamplerLoop() {
+  fextl::vector<uint64_t> StackPointers;
+  fextl::vector<Range> AltStacks;
+  fextl::vector<SyscallState> PreviousState;
+  fextl::vector<SyscallState> CurrentState;
+  fextl::set<uint64_t> SharedInstructions;
+
+  while (!ShouldStop.load(std::memory_order_relaxed)) {
+    const timespec Period {.tv_sec = 0, .tv_nsec = SamplePeriodNS};
+    nanosleep(&Period, nullptr);
+
+    {
+      std::lock_guard lk(ArmMutex);
+      if (SamplingStopped.load(std::memory_order_relaxed)) {
+        break;
+      }
+      PagesArmed.store(true, std::memory_order_seq_cst);
+
+      // Guest threads publish their state on syscalls, the stack pointer is the one of the last syscall.
+      // Snapshot the threads before VMATracking gets locked, same lock ordering as fork.
+      bool InSyscall {};
+      StackPointers.clear();
+      AltStacks.clear();
+      CurrentState.clear();
+      Handler->TM.ForEachThread([&](FEX::HLE::ThreadStateObject* Thread) {
+        auto& Info = Thread->TSOTrainingInfo;
+        const SyscallState State {
+          .TID = Thread->ThreadInfo.TID.load(std::memory_order_relaxed),
+          .Sequence = Info.SyscallSequence.load(std::memory_order_seq_cst),
+        };
+
+        if (State.Sequence & 1) {
+          // Futex waits only read guest memory before going to sleep, a thread still in the wait it was in last round is asleep.
+          const bool Asleep =
+            Info.FutexWait.load(std::memory_order_relaxed) && std::ranges::find(PreviousState, State) != PreviousState.end();
+          InSyscall |= !Asleep;
+        }
+
+        CurrentState.emplace_back(State);
+        StackPointers.emplace_back(Info.StackPointer.load(std::memory_order_relaxed));
+        if (const auto AltStackBase = Info.AltStackBase.load(std::memory_order_relaxed)) {
+          AltStacks.emplace_back(Range {AltStackBase, Info.AltStackEnd.load(std::memory_order_relaxed)});
+        }
+      });
+      std::swap(PreviousState, CurrentState);
+
+      // Nothing can be shared with only a single thread.
+      const bool CanArm = !InSyscall && StackPointers.size() > 1;
+      PagesArmed.store(ArmWatches(StackPointers, AltStacks, CanArm, SharedInstructions), std::memory_order_relaxed);
+    }
+
+    if (!SharedInstructions.empty()) {
+      EnableTSO(SharedInstructions);
+      SharedInstructions.clear();
+    }
+  }
+}
+
+void TSOTraining::Persist() {
+  std::lock_guard lk(ProfileMutex);
+
+  for (auto& [FileId, File] : ProfiledFiles) {
+    if (!File.Dirty) {
+      continue;
+    }
+
+    // Shared instructions get merged with what other runs learned first, so none of them can end up as private.
+    if (OffsetProfile::Write(File.SharedPath, File.SharedOffsets) &&
+        OffsetProfile::Write(File.PrivatePath, File.PrivateOffsets, &File.SharedOffsets)) {
+      File.Dirty = false;
+    }
+  }
+}
+
+void TSOTraining::LockBeforeFork() {
+  ProfileMutex.lock();
+}
+
+void TSOTraining::UnlockAfterFork(bool Child) {
+  if (!Child) {
+    ProfileMutex.unlock();
+    return;
+  }
+
+  ProfileMutex.StealAndDropActiveLocks();
+  ArmMutex.StealAndDropActiveLocks();
+
+  // The sampler thread doesn't exist in the child, pages that are still armed get handed back on their next fault.
+  // The stale thread object can't be joined, so it is leaked.
+  if (TrainingEnabled && !SamplingStopped) {
+    (void)SamplerThread.release();
+    ShouldStop = false;
+    StartThread();
+  }
+}
+
+} // namespace FEX::HLE
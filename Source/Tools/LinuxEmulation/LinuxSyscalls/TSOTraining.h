@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: TSO training mode, learns which guest instructions need memory ordering
+$end_info$
+*/
+#pragma once
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/SignalScopeGuards.h>
+#include <FEXCore/Utils/Threads.h>
+#include <FEXCore/fextl/map.h>
+#include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/set.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace FEXCore {
+struct ExecutableFileInfo;
+namespace Context {
+  class Context;
+}
+namespace Core {
+  struct InternalThreadState;
+}
+} // namespace FEXCore
+
+namespace FEX::HLE {
+class SyscallHandler;
+struct ThreadStateObject;
+
+/**
+ * Learns which guest instructions of an executable file don't need TSO memory ordering, so that later runs can get
+ * away with fewer barriers.
+ *
+ * Training doesn't change TSO emulation by itself. A sampling thread periodically removes access to a couple of random
+ * guest data pages and records which guest instructions touch them. Instructions only ever seen on pages that a single
+ * thread accessed are considered thread private, instructions seen on a page accessed by more than one thread are
+ * shared for good.
+ *
+ * Host code must never see a sampled page, since it can't be faulted on behalf of the guest:
+ * - Syscalls hand all sampled pages back before they run and pages only get sampled while no thread is inside a
+ *   syscall.
+ * - Guest stacks and alternate signal stacks are never sampled, FEX writes signal frames to them.
+ * - Sampling stops for good once the kernel or host libraries can access guest memory outside of a syscall, which is
+ *   the case with io_uring, AIO, vmsplice, thunks and HostLibcRoutines.
+ *
+ * The learned instructions are persisted next to the code maps as `<codemap name>.tso-private` and
+ * `<codemap name>.tso-shared`, one file offset per line.
+ * With the TSOProfiles option, TSO is disabled for the private instructions that were never seen shared. Everything
+ * else keeps TSO emulation.
+ */
+class TSOTraining final {
+public:
+  TSOTraining(FEXCore::Context::Context* CTX, SyscallHandler* Handler);
+  ~TSOTraining();
+
+  bool IsTrainingEnabled() const {
+    return TrainingEnabled;
+  }
+
+  // Fills in the instructions of the executable mapping at [Base, Base + Length) with file offset `Offset` that can run
+  // without TSO emulation. Only does anything with TSOProfiles enabled.
+  // - VMATracking.Mutex must be unique_locked before calling
+  void ApplyToMapping(const FEXCore::ExecutableFileInfo& FileInfo, uint64_t Base, uint64_t Length, uint64_t Offset,
+                      fextl::set<uint64_t>& TSOFreeInstructions);
+
+  // Hands the sampled pages back before a syscall accesses guest memory and publishes the thread state for the sampler.
+  // - Only called while training is enabled
+  void EnterSyscall(ThreadStateObject* Thread, uint64_t StackPointer, uint64_t Syscall, uint64_t FutexOp);
+  void ExitSyscall(ThreadStateObject* Thread);
+
+  // Hands the sampled pages back and never samples again, for when host code may access guest memory at any time.
+  void StopSampling(std::string_view Reason);
+
+  // Checks if the fault is from an access to a sampled page, returns true if it was handled.
+  bool HandleSegfault(FEXCore::Core::InternalThreadState* Thread, uint64_t FaultAddress, void* ucontext);
+
+  // Writes all learned instructions to disk.
+  void Persist();
+
+  void LockBeforeFork();
+  void UnlockAfterFork(bool Child);
+
+  // Public for threading
+  void SamplerLoop();
+
+private:
+  struct ProfiledFile {
+    fextl::string PrivatePath;
+    fextl::string SharedPath;
+    // File offsets of instructions that were only seen accessing pages of a single thread
+    fextl::set<uint64_t> PrivateOffsets;
+    // File offsets of instructions that were seen accessing a page shared between threads, these always keep TSO
+    fextl::set<uint64_t> SharedOffsets;
+    // Set if instructions were learned that aren't on disk yet
+    bool Dirty;
+  };
+
+  struct Access {
+    std::atomic<uint32_t> TID;
+    std::atomic<uint64_t> RIP;
+  };
+
+  struct Watch {
+    // Guest page that is currently sampled, 0 if the watch is unused
+    std::atomic<uint64_t> Page;
+    std::atomic<uint32_t> NumAccesses;
+    uint32_t Rounds;
+    std::array<Access, 8> Accesses;
+  };
+
+  // Number of pages that are sampled at the same time
+  constexpr static size_t NumWatches = 4;
+  // How often a sampled page has its access removed again before picking a new page
+  constexpr static uint32_t RoundsPerWatch = 16;
+  constexpr static uint64_t SamplePeriodNS = 2'000'000;
+
+  struct SyscallState {
+    uint32_t TID;
+    uint32_t Sequence;
+    bool operator==(const SyscallState&) const = default;
+  };
+
+  struct Range {
+    uint64_t Begin;
+    uint64_t End;
+  };
+
+  void StartThread();
+  bool IsFutexWait(uint64_t Syscall, uint64_t FutexOp) const;
+  bool IsAsyncIOSetup(uint64_t Syscall) const;
+  static bool IsOnAltStack(std::span<const Range> AltStacks, uint64_t Page);
+  // Returns true if any page was left without access.
+  // - ArmMutex must be locked before calling
+  bool ArmWatches(std::span<const uint64_t> StackPointers, std::span<const Range> AltStacks, bool CanArm,
+                  fextl::set<uint64_t>& SharedInstructions);
+  // - ArmMutex must be locked before calling
+  void DisarmWatches();
+  void EnableTSO(const fextl::set<uint64_t>& SharedInstructions);
+  void RetireWatch(Watch& W, fextl::set<uint64_t>& SharedInstructions);
+  bool PickPage(std::span<const uint64_t> StackPointers, std::span<const Range> AltStacks, uint64_t* Page);
+  ProfiledFile* GetProfiledFile(const FEXCore::ExecutableFileInfo& FileInfo);
+
+  FEXCore::Context::Context* CTX;
+  SyscallHandler* Handler;
+
+  FEX_CONFIG_OPT(TSOEnabled, TSOENABLED);
+  FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
+  bool TrainingEnabled {};
+  bool ProfilesEnabled {};
+
+  // Protects ProfiledFiles
+  FEXCore::ForkableUniqueMutex ProfileMutex;
+  fextl::map<uint64_t, ProfiledFile> ProfiledFiles;
+
+  std::array<Watch, NumWatches> Watches {};
+  // Serializes the sampler changing page protections against syscalls handing the pages back
+  FEXCore::ForkableUniqueMutex ArmMutex;
+  // Set before the sampler looks at the syscall state of threads, cleared once no page is left without access
+  std::atomic<bool> PagesArmed {};
+  // Set once host code may access guest memory outside of syscalls, checked with ArmMutex held
+  std::atomic<bool> SamplingStopped {};
+  uint64_t RandomState {0x9E37'79B9'7F4A'7C15ULL};
+
+  std::atomic<bool> ShouldStop {};
+  fextl::unique_ptr<FEXCore::Threads::Thread> SamplerThread;
+};
+} // namespace FEX::HLE
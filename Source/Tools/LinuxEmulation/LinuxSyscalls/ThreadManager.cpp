@@ -42,10 +42,10 @@ void ThreadManager::StatAlloc::Initialize() {
   }
 
   // Reserve a region of MAX_STATS_SIZE so we can grow the allocation buffer.
-  // Number of thread slots when ThreadStatsHeader == 64bytes and ThreadStats == 40bytes:
-  // 1 page: 99 slots
-  // 1 MB: 26211 slots
-  // 128 MB: 3355440 slots
+  // Number of thread slots when ThreadStatsHeader == 64bytes and ThreadStats == 144bytes:
+  // 1 page: 27 slots
+  // 1 MB: 7280 slots
+  // 4 MB: 29125 slots
   Base = FEXCore::Allocator::mmap(nullptr, MAX_STATS_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
   if (Base == MAP_FAILED) {
     LogMan::Msg::EFmt("[StatAlloc] mmap base failed");
@@ -68,6 +68,24 @@ void ThreadManager::StatAlloc::Initialize() {
 
 err:
   close(fd);
+
+  // The syscall tables start out empty and get grown as slots start using them.
+  if (Base) {
+    fd = shm_open(fextl::fmt::format("fex-{}-syscall-stats", ::getpid()).c_str(), O_CREAT | O_TRUNC | O_RDWR, USER_PERMS);
+    if (fd != -1) {
+      close(fd);
+    }
+  }
+}
+
+void ThreadManager::StatAlloc::UnmapSyscallStats() {
+  for (auto& Chunk : SyscallStatsChunks) {
+    if (Chunk) {
+      FEXCore::Allocator::munmap(Chunk, SYSCALL_STATS_CHUNK_SIZE);
+      Chunk = nullptr;
+    }
+  }
+  SyscallStatsSize = 0;
 }
 
 uint32_t ThreadManager::StatAlloc::FrontendAllocateSlots(uint32_t NewSize) {
@@ -117,8 +135,54 @@ void ThreadManager::StatAlloc::DeallocateSlot(FEXCore::SHMStats::ThreadStats* Al
   StatAllocBase::DeallocateSlot(AllocatedSlot);
 }
 
+FEXCore::SHMStats::ThreadSyscallStats* ThreadManager::StatAlloc::AllocateSyscallStats(FEXCore::SHMStats::ThreadStats* AllocatedSlot) {
+  if (!AllocatedSlot) {
+    return nullptr;
+  }
+
+  std::scoped_lock lk(StatMutex);
+  const auto SlotIndex = SlotIndexFromOffset(OffsetFromStat(AllocatedSlot));
+  const auto ChunkIndex = SlotIndex / SYSCALL_STATS_PER_CHUNK;
+  auto& Chunk = SyscallStatsChunks[ChunkIndex];
+
+  if (!Chunk) {
+    int fd = shm_open(fextl::fmt::format("fex-{}-syscall-stats", ::getpid()).c_str(), O_RDWR, USER_PERMS);
+    if (fd == -1) {
+      return nullptr;
+    }
+
+    // Chunks can get mapped out of order when slots get reused, so the region only ever grows.
+    const uint32_t NewSize = (ChunkIndex + 1) * SYSCALL_STATS_CHUNK_SIZE;
+    if (NewSize > SyscallStatsSize) {
+      if (ftruncate(fd, NewSize) == -1) {
+        LogMan::Msg::EFmt("[StatAlloc] ftruncate syscall stats failed");
+        close(fd);
+        return nullptr;
+      }
+      SyscallStatsSize = NewSize;
+    }
+
+    auto ChunkBase = FEXCore::Allocator::mmap(nullptr, SYSCALL_STATS_CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                                              ChunkIndex * SYSCALL_STATS_CHUNK_SIZE);
+    close(fd);
+    if (ChunkBase == MAP_FAILED) {
+      LogMan::Msg::EFmt("[StatAlloc] mmap syscall stats failed");
+      return nullptr;
+    }
+
+    FEXCore::Allocator::VirtualName("FEXMem_Misc", ChunkBase, SYSCALL_STATS_CHUNK_SIZE);
+    Chunk = reinterpret_cast<FEXCore::SHMStats::ThreadSyscallStats*>(ChunkBase);
+  }
+
+  // Slot might be reused, just zero it now.
+  auto SyscallStats = &Chunk[SlotIndex % SYSCALL_STATS_PER_CHUNK];
+  memset(SyscallStats, 0, sizeof(*SyscallStats));
+  return SyscallStats;
+}
+
 void ThreadManager::StatAlloc::CleanupForExit() {
   shm_unlink(fextl::fmt::format("fex-{}-stats", ::getpid()).c_str());
+  shm_unlink(fextl::fmt::format("fex-{}-syscall-stats", ::getpid()).c_str());
 }
 
 void ThreadManager::StatAlloc::LockBeforeFork() {
@@ -143,6 +207,7 @@ void ThreadManager::StatAlloc::UnlockAfterFork(FEXCore::Core::InternalThreadStat
   // shm_memory ownership is retained by the parent process, so the child must replace it with its own one.
   // Otherwise this process will keep reporting in the original parent thread's stats region.
   FEXCore::Allocator::munmap(Base, MAX_STATS_SIZE);
+  UnmapSyscallStats();
   Base = nullptr;
   CurrentSize = 0;
   Head = nullptr;
@@ -151,6 +216,7 @@ void ThreadManager::StatAlloc::UnlockAfterFork(FEXCore::Core::InternalThreadStat
   RemainingSlots = 0;
 
   Thread->ThreadStats = nullptr;
+  Thread->SyscallStats = nullptr;
 
   Initialize();
   SaveHeader(Is64BitMode() ? FEXCore::SHMStats::AppType::LINUX_64 : FEXCore::SHMStats::AppType::LINUX_32);
@@ -158,6 +224,7 @@ void ThreadManager::StatAlloc::UnlockAfterFork(FEXCore::Core::InternalThreadStat
   // Update this thread's ThreadStats object
   auto ThreadObject = FEX::HLE::ThreadManager::GetStateObjectFromFEXCoreThread(Thread);
   ThreadObject->Thread->ThreadStats = AllocateSlot(ThreadObject->ThreadInfo.TID);
+  ThreadObject->Thread->SyscallStats = AllocateSyscallStats(ThreadObject->Thread->ThreadStats);
 }
 
 constexpr size_t CALLRET_STACK_ALLOC_SIZE = FEXCore::Core::InternalThreadState::CALLRET_STACK_SIZE + 2 * FEXCore::Utils::FEX_PAGE_SIZE;
@@ -188,6 +255,7 @@ FEX::HLE::ThreadStateObject* ThreadManager::CreateThread(uint64_t InitialRIP, ui
   ThreadStateObject->Thread->FrontendPtr = ThreadStateObject;
   if (ProfileStats()) {
     ThreadStateObject->Thread->ThreadStats = Stat.AllocateSlot(ThreadStateObject->ThreadInfo.TID);
+    ThreadStateObject->Thread->SyscallStats = Stat.AllocateSyscallStats(ThreadStateObject->Thread->ThreadStats);
   }
 
   // GDT and LDT are tracked per thread.
@@ -240,6 +308,7 @@ FEX::HLE::ThreadStateObject* ThreadManager::CreateThread(uint64_t InitialRIP, ui
 }
 
 void ThreadManager::DestroyThread(FEX::HLE::ThreadStateObject* Thread, bool NeedsTLSUninstall) {
+  bool LastThread {};
   {
     std::lock_guard lk(ThreadCreationMutex);
     auto It = std::find(Threads.begin(), Threads.end(), Thread);
@@ -247,9 +316,17 @@ void ThreadManager::DestroyThread(FEX::HLE::ThreadStateObject* Thread, bool Need
     Threads.erase(It);
     if (Threads.empty()) {
       Thread->Thread->CTX->FlushAndCloseCodeMap();
+      FEX::HLE::_SyscallHandler->TSOTrainer->Persist();
+      FEX::HLE::_SyscallHandler->UnalignedAtomics->Persist();
+      LastThread = true;
     }
   }
 
+  if (LastThread) {
+    // Takes VMATracking.Mutex, which can't be nested inside ThreadCreationMutex.
+    FEX::HLE::_SyscallHandler->Sampler->Persist(nullptr);
+  }
+
   Stat.DeallocateSlot(Thread->Thread->ThreadStats);
 
   HandleThreadDeletion(Thread, NeedsTLSUninstall);
@@ -450,6 +527,7 @@ void ThreadManager::UnlockAfterFork(FEXCore::Core::InternalThreadState* LiveThre
   for (auto& DeadThread : Threads) {
     // The fork parent retains ownership of ThreadStats
     DeadThread->Thread->ThreadStats = nullptr;
+    DeadThread->Thread->SyscallStats = nullptr;
 
     if (DeadThread->Thread == LiveThread) {
       continue;
@@ -21,6 +21,7 @@ $end_info$
 #include <FEXCore/Utils/Threads.h>
 #include <FEXCore/Utils/TypeDefines.h>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
@@ -35,6 +36,7 @@ $end_info$
 namespace FEX::HLE {
 class SignalDelegator;
 class SyscallHandler;
+struct GuestSampleRing;
 struct SeccompFilterInfo;
 
 enum class SignalEvent : uint32_t {
@@ -91,6 +93,27 @@ struct ThreadStateObject : public FEXCore::Allocator::FEXAllocOperators {
   // personality emulation.
   uint32_t persona {};
 
+  // Guest profiler samples, owned by GuestSampler
+  GuestSampleRing* SamplerRing {};
+
+  // Published for TSOTraining's sampler thread on every syscall while training.
+  struct {
+    // Guest stack pointer at the last syscall
+    std::atomic<uint64_t> StackPointer {};
+    // Incremented on syscall entry and exit, odd while the thread is inside a syscall
+    std::atomic<uint32_t> SyscallSequence {};
+    // Set if the current or last syscall is a futex wait
+    std::atomic<bool> FutexWait {};
+    // Guest alternate signal stack as of the last syscall, [0, 0) if disabled
+    std::atomic<uint64_t> AltStackBase {};
+    std::atomic<uint64_t> AltStackEnd {};
+  } TSOTrainingInfo {};
+
+  // Syscall that blocked the thread for at least IdleSyscallNanoseconds the last time it ran, ~0 otherwise.
+  // Only tracked with TrimIdleThreadCaches enabled.
+  // The thread's lookup caches are trimmed the next time it makes that syscall.
+  uint64_t IdleSyscall {~0ULL};
+
   FEXCore::Core::NonMovableUniquePtr<FEXCore::Threads::Thread> ExecutionThread;
 
   // Thread signaling information
@@ -148,8 +171,12 @@ public:
     FEXCore::SHMStats::ThreadStats* AllocateSlot(uint32_t TID);
     void DeallocateSlot(FEXCore::SHMStats::ThreadStats* AllocatedSlot);
 
+    ///< Returns the zeroed syscall table that belongs to an allocated slot, or nullptr if it couldn't be mapped.
+    FEXCore::SHMStats::ThreadSyscallStats* AllocateSyscallStats(FEXCore::SHMStats::ThreadStats* AllocatedSlot);
+
   private:
     void Initialize();
+    void UnmapSyscallStats();
 
     uint32_t FrontendAllocateSlots(uint32_t NewSize) override;
     FEX_CONFIG_OPT(ProfileStats, PROFILESTATS);
@@ -157,6 +184,18 @@ public:
 
     constexpr static int USER_PERMS = S_IRWXU | S_IRWXG | S_IRWXO;
     FEXCore::ForkableUniqueMutex StatMutex;
+
+    // Syscall tables are mapped in chunks the first time a slot inside of a chunk is used.
+    // Chunks never move, so threads can keep a pointer to their table.
+    // 256 tables are 192KB, which keeps every chunk offset aligned to the largest page size.
+    constexpr static uint32_t SYSCALL_STATS_PER_CHUNK = 256;
+    constexpr static uint32_t SYSCALL_STATS_CHUNK_SIZE = SYSCALL_STATS_PER_CHUNK * sizeof(FEXCore::SHMStats::ThreadSyscallStats);
+    static_assert(SYSCALL_STATS_CHUNK_SIZE % 65536 == 0, "Chunk offsets need to be page aligned");
+    constexpr static uint32_t MAX_STATS_SLOTS =
+      (MAX_STATS_SIZE - sizeof(FEXCore::SHMStats::ThreadStatsHeader)) / sizeof(FEXCore::SHMStats::ThreadStats);
+    constexpr static uint32_t MAX_SYSCALL_STATS_CHUNKS = (MAX_STATS_SLOTS + SYSCALL_STATS_PER_CHUNK - 1) / SYSCALL_STATS_PER_CHUNK;
+    std::array<FEXCore::SHMStats::ThreadSyscallStats*, MAX_SYSCALL_STATS_CHUNKS> SyscallStatsChunks {};
+    uint32_t SyscallStatsSize {};
   };
 
   void CleanupForExit() {
@@ -235,6 +274,14 @@ public:
     return &Threads;
   }
 
+  template<typename Fn>
+  void ForEachThread(Fn&& Func) {
+    std::lock_guard lk(ThreadCreationMutex);
+    for (auto& Thread : Threads) {
+      Func(Thread);
+    }
+  }
+
 private:
   StatAlloc Stat;
   FEXCore::Context::Context* CTX;
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Remembers guest instructions that performed unaligned atomic accesses across runs
+$end_info$
+*/
+
+#include "LinuxSyscalls/OffsetProfile.h"
+#include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/UnalignedAtomicTracking.h"
+
+#include <FEXCore/Core/CodeCache.h>
+
+#include <mutex>
+#include <shared_mutex>
+
+namespace FEX::HLE {
+UnalignedAtomicTracking::TrackedFile* UnalignedAtomicTracking::GetTrackedFile(const FEXCore::ExecutableFileInfo& FileInfo) {
+  auto [It, Inserted] = Files.try_emplace(FileInfo.FileId);
+  auto& File = It->second;
+  if (Inserted) {
+    File.Path = OffsetProfile::GetPath(FileInfo, ".unaligned");
+    if (!File.Path.empty()) {
+      OffsetProfile::Load(File.Path, File.Offsets);
+    }
+  }
+
+  if (File.Path.empty()) {
+    // No stable identifier to store the offsets with.
+    return nullptr;
+  }
+
+  return &File;
+}
+
+void UnalignedAtomicTracking::ApplyToMapping(const FEXCore::ExecutableFileInfo& FileInfo, uint64_t Base, uint64_t Length,
+                                             uint64_t Offset, fextl::set<uint64_t>& Instructions) {
+  if (!TSOEnabled()) {
+    return;
+  }
+
+  std::lock_guard lk(Mutex);
+  auto File = GetTrackedFile(FileInfo);
+  if (!File) {
+    return;
+  }
+
+  for (auto It = File->Offsets.lower_bound(Offset); It != File->Offsets.end() && *It < Offset + Length; ++It) {
+    Instructions.insert(Base + *It - Offset);
+  }
+}
+
+void UnalignedAtomicTracking::Record(uint64_t GuestRIP) {
+  auto lk = FEXCore::MaskSignalsAndLockMutex<std::shared_lock>(Handler->VMATracking.Mutex);
+  auto CodeEntry = Handler->VMATracking.FindVMAEntry(GuestRIP);
+  if (CodeEntry == Handler->VMATracking.VMAs.end()) {
+    return;
+  }
+
+  const auto& VMA = CodeEntry->second;
+  if (!VMA.Resource || !VMA.Resource->MappedFile) {
+    // Anonymous code, can't be persisted.
+    return;
+  }
+
+  std::lock_guard FileLock(Mutex);
+  auto File = GetTrackedFile(*VMA.Resource->MappedFile);
+  if (File && File->Offsets.insert(GuestRIP - VMA.Base + VMA.Offset).second) {
+    File->Dirty = true;
+  }
+}
+
+void UnalignedAtomicTracking::Persist() {
+  std::lock_guard lk(Mutex);
+
+  for (auto& [FileId, File] : Files) {
+    if (File.Dirty && OffsetProfile::Write(File.Path, File.Offsets)) {
+      File.Dirty = false;
+    }
+  }
+}
+
+void UnalignedAtomicTracking::LockBeforeFork() {
+  Mutex.lock();
+}
+
+void UnalignedAtomicTracking::UnlockAfterFork(bool Child) {
+  if (Child) {
+    Mutex.StealAndDropActiveLocks();
+  } else {
+    Mutex.unlock();
+  }
+}
+} // namespace FEX::HLE
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Remembers guest instructions that performed unaligned atomic accesses across runs
+$end_info$
+*/
+#pragma once
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/SignalScopeGuards.h>
+#include <FEXCore/fextl/map.h>
+#include <FEXCore/fextl/set.h>
+#include <FEXCore/fextl/string.h>
+
+#include <cstdint>
+
+namespace FEXCore {
+struct ExecutableFileInfo;
+}
+
+namespace FEX::HLE {
+class SyscallHandler;
+
+/**
+ * Instructions whose atomic accesses had to be backpatched by the SIGBUS handler are persisted next to the code maps as
+ * `<codemap name>.unaligned`, one file offset per line. Later runs compile them to the unaligned-safe sequence directly.
+ *
+ * Only matters with TSO emulation, without it atomics aren't emitted for regular loads and stores.
+ */
+class UnalignedAtomicTracking final {
+public:
+  explicit UnalignedAtomicTracking(SyscallHandler* Handler)
+    : Handler {Handler} {}
+
+  // Fills in the instructions of the executable mapping at [Base, Base + Length) with file offset `Offset` that are known
+  // to perform unaligned atomic accesses.
+  // - VMATracking.Mutex must be unique_locked before calling
+  void ApplyToMapping(const FEXCore::ExecutableFileInfo& FileInfo, uint64_t Base, uint64_t Length, uint64_t Offset,
+                      fextl::set<uint64_t>& Instructions);
+
+  // Records a guest instruction whose atomic access had to be backpatched.
+  // - Must not be called from a signal handler
+  void Record(uint64_t GuestRIP);
+
+  // Writes all recorded instructions to disk.
+  void Persist();
+
+  void LockBeforeFork();
+  void UnlockAfterFork(bool Child);
+
+private:
+  struct TrackedFile {
+    fextl::string Path;
+    fextl::set<uint64_t> Offsets;
+    // Set if instructions were recorded that aren't on disk yet
+    bool Dirty;
+  };
+
+  // - Mutex must be locked before calling
+  TrackedFile* GetTrackedFile(const FEXCore::ExecutableFileInfo& FileInfo);
+
+  SyscallHandler* Handler;
+  FEX_CONFIG_OPT(TSOEnabled, TSOENABLED);
+
+  // Protects Files
+  FEXCore::ForkableUniqueMutex Mutex;
+  fextl::map<uint64_t, TrackedFile> Files;
+};
+} // namespace FEX::HLE
@@ -9,6 +9,7 @@ $end_info$
 #include "Thunks.h"
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/ThreadManager.h"
+#include "LinuxSyscalls/TSOTraining.h"
 
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Core/CoreState.h>
@@ -20,6 +21,7 @@ $end_info$
 #include <FEXCore/fextl/set.h>
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/unordered_set.h>
 
 #include <cstdint>
 #include <dlfcn.h>
@@ -162,6 +164,12 @@ struct ThunkHandler_impl final : public FEX::HLE::ThunkHandler {
     }
   }
 
+  bool IsLeafThunk(const FEXCore::IR::SHA256Sum& sha256) override {
+    std::shared_lock lk(ThunksMutex);
+
+    return LeafThunks.contains(sha256);
+  }
+
   void RegisterTLSState(FEX::HLE::ThreadStateObject* _ThreadObject) override {
     ThreadObject = _ThreadObject;
   }
@@ -169,6 +177,9 @@ struct ThunkHandler_impl final : public FEX::HLE::ThunkHandler {
   void AppendThunkDefinitions(std::span<const FEXCore::IR::ThunkDefinition> Definitions) override {
     for (auto& Definition : Definitions) {
       Thunks.emplace(Definition.Sum, Definition.ThunkFunction);
+      if (Definition.Leaf) {
+        LeafThunks.insert(Definition.Sum);
+      }
     }
   }
 
@@ -205,6 +216,9 @@ private:
      &ThunkFunctions::AllocateHostTrampolineForGuestFunction},
   };
 
+  // Thunks exported with fexgen::leaf
+  fextl::unordered_set<FEXCore::IR::SHA256Sum, TruncatingSHA256Hash> LeafThunks;
+
   FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
   FEX_CONFIG_OPT(ThunkHostLibsPath, THUNKHOSTLIBS);
 };
@@ -218,6 +232,9 @@ void ThunkHandler_impl::LoadLib(std::string_view Name) {
 
   LogMan::Msg::DFmt("LoadLib: {} -> {}", Name, SOName);
 
+  // Host libraries access guest memory without going through syscalls.
+  FEX::HLE::_SyscallHandler->TSOTrainer->StopSampling("thunks are in use");
+
   auto Handle = dlopen(SOName.c_str(), RTLD_LOCAL | RTLD_NOW);
   if (!Handle) {
     ERROR_AND_DIE_FMT("LoadLib: Failed to dlopen thunk library {}: {}", SOName, dlerror());
@@ -231,6 +248,7 @@ void ThunkHandler_impl::LoadLib(std::string_view Name) {
   struct ExportEntry {
     uint8_t* sha256;
     FEXCore::ThunkedFunction* Fn;
+    bool Leaf;
   };
 
   ExportEntry* (*InitFN)();
@@ -254,7 +272,11 @@ void ThunkHandler_impl::LoadLib(std::string_view Name) {
 
     int i;
     for (i = 0; Exports[i].sha256; i++) {
-      Thunks[*reinterpret_cast<FEXCore::IR::SHA256Sum*>(Exports[i].sha256)] = Exports[i].Fn;
+      const auto& Sum = *reinterpret_cast<FEXCore::IR::SHA256Sum*>(Exports[i].sha256);
+      Thunks[Sum] = Exports[i].Fn;
+      if (Exports[i].Leaf) {
+        LeafThunks.insert(Sum);
+      }
     }
 
     LogMan::Msg::DFmt("Loaded {} syms", i);
@@ -3,6 +3,7 @@
 
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/x32/Types.h"
+#include "Thunks.h"
 
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Core/Context.h>
@@ -206,6 +207,31 @@ namespace x64 {
     }
   } // namespace VDSO
 
+  // Handlers that get installed at the guest VDSO entrypoints with AddHostFunctionIRHandler.
+  // They receive the guest argument registers directly, so neither the guest-side argument packing nor the thunk stub runs.
+  namespace HostFunction {
+    struct ArgsRV_t {
+      uint64_t Args[6];
+      uint64_t rv;
+    };
+
+    static void time(void* ArgsRV) {
+      auto args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+      args->rv = VDSOHandlers::TimePtr(reinterpret_cast<time_t*>(args->Args[0]));
+    }
+
+    static void gettimeofday(void* ArgsRV) {
+      auto args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+      args->rv =
+        VDSOHandlers::GetTimeOfDayPtr(reinterpret_cast<struct timeval*>(args->Args[0]), reinterpret_cast<struct timezone*>(args->Args[1]));
+    }
+
+    static void clock_gettime(void* ArgsRV) {
+      auto args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+      args->rv = VDSOHandlers::ClockGetTimePtr(static_cast<clockid_t>(args->Args[0]), reinterpret_cast<struct timespec*>(args->Args[1]));
+    }
+  } // namespace HostFunction
+
   HandlerPtr Handler_time = FEX::VDSO::x64::glibc::time;
   HandlerPtr Handler_gettimeofday = FEX::VDSO::x64::glibc::gettimeofday;
   HandlerPtr Handler_clock_gettime = FEX::VDSO::x64::glibc::clock_gettime;
@@ -560,24 +586,28 @@ void LoadHostVDSO() {
   }
 }
 
+// None of the VDSO functions call back in to guest code, so they all use the leaf thunk transition.
 static std::array<FEXCore::IR::ThunkDefinition, 7> VDSODefinitions = {{
   {
     // sha256(libVDSO:time)
     {0x37, 0x63, 0x46, 0xb0, 0x79, 0x06, 0x5f, 0x9d, 0x00, 0xb6, 0x8d, 0xfd, 0x9e, 0x4a, 0x62, 0xcd,
      0x1e, 0x6c, 0xcc, 0x22, 0xcd, 0xb2, 0xc0, 0x17, 0x7d, 0x42, 0x6a, 0x40, 0xd1, 0xeb, 0xfa, 0xe0},
     nullptr,
+    true,
   },
   {
     // sha256(libVDSO:gettimeofday)
     {0x77, 0x2a, 0xde, 0x1c, 0x13, 0x2d, 0xe9, 0x48, 0xaf, 0xe0, 0xba, 0xcc, 0x6a, 0x89, 0xff, 0xca,
      0x4a, 0xdc, 0xd5, 0x63, 0x2c, 0xc5, 0x62, 0x8b, 0x5d, 0xde, 0x0b, 0x15, 0x35, 0xc6, 0xc7, 0x14},
     nullptr,
+    true,
   },
   {
     // sha256(libVDSO:clock_gettime)
     {0x3c, 0x96, 0x9b, 0x2d, 0xc3, 0xad, 0x2b, 0x3b, 0x9c, 0x4e, 0x4d, 0xca, 0x1c, 0xe8, 0x18, 0x4a,
      0x12, 0x8a, 0xe4, 0xc1, 0x56, 0x92, 0x73, 0xce, 0x65, 0x85, 0x5f, 0x65, 0x7e, 0x94, 0x26, 0xbe},
     nullptr,
+    true,
   },
 
   {
@@ -585,6 +615,7 @@ static std::array<FEXCore::IR::ThunkDefinition, 7> VDSODefinitions = {{
     {0xba, 0xe9, 0x6d, 0x30, 0xc0, 0x68, 0xc6, 0xd7, 0x59, 0x04, 0xf7, 0x10, 0x06, 0x72, 0x88, 0xfd,
      0x4c, 0x57, 0x0f, 0x31, 0xa5, 0xea, 0xa9, 0xb9, 0xd3, 0x8d, 0x03, 0x81, 0x50, 0x16, 0x22, 0x71},
     nullptr,
+    true,
   },
 
   {
@@ -592,18 +623,45 @@ static std::array<FEXCore::IR::ThunkDefinition, 7> VDSODefinitions = {{
     {0xe4, 0xa1, 0xf6, 0x23, 0x35, 0xae, 0xb7, 0xb6, 0xb0, 0x37, 0xc5, 0xc3, 0xa3, 0xfd, 0xbf, 0xa2,
      0xa1, 0xc8, 0x95, 0x78, 0xe5, 0x76, 0x86, 0xdb, 0x3e, 0x6c, 0x54, 0xd5, 0x02, 0x60, 0xd8, 0x6d},
     nullptr,
+    true,
   },
   {
     // sha256(libVDSO:getcpu)
     {0x39, 0x83, 0x39, 0x36, 0x0f, 0x68, 0xd6, 0xfc, 0xc2, 0x3a, 0x97, 0x11, 0x85, 0x09, 0xc7, 0x25,
      0xbb, 0x50, 0x49, 0x55, 0x6b, 0x0c, 0x9f, 0x50, 0x37, 0xf5, 0x9d, 0xb0, 0x38, 0x58, 0x57, 0x12},
     nullptr,
+    true,
   },
   {
     // sha256(libVDSO:getrandom)
     {0xf8, 0x03, 0xe2, 0x70, 0xe3, 0xf1, 0xbb, 0xc1, 0x7d, 0xa7, 0x8b, 0xb3, 0x1f, 0x3e, 0xbd, 0xc6,
      0x8a, 0x50, 0xd3, 0x4a, 0x1f, 0xb3, 0x4b, 0x7e, 0x32, 0xcb, 0x1e, 0x18, 0x3b, 0x7c, 0xeb, 0x4b},
     nullptr,
+    true,
+  },
+}};
+
+static constexpr std::array<FEXCore::IR::ThunkDefinition, 3> HostFunctionDefinitions = {{
+  {
+    // sha256(fex:vdso_time)
+    {0x45, 0x81, 0xc3, 0x55, 0xd1, 0x05, 0xe5, 0xe5, 0xff, 0x99, 0x4a, 0xd4, 0x3d, 0xc0, 0x8c, 0x78,
+     0xe9, 0x58, 0x40, 0xfe, 0x2d, 0x71, 0x4b, 0x92, 0xee, 0x13, 0xf5, 0x8b, 0x8f, 0xe0, 0x80, 0x00},
+    FEX::VDSO::x64::HostFunction::time,
+    true,
+  },
+  {
+    // sha256(fex:vdso_gettimeofday)
+    {0x9e, 0x65, 0x7a, 0x60, 0x44, 0x00, 0xdd, 0x7c, 0xb1, 0xef, 0x30, 0x65, 0x8a, 0xd0, 0x09, 0x28,
+     0xf8, 0xfd, 0x3e, 0x2e, 0x01, 0xc8, 0x46, 0x59, 0x5e, 0xac, 0x29, 0xce, 0x1b, 0x9c, 0x2f, 0x3d},
+    FEX::VDSO::x64::HostFunction::gettimeofday,
+    true,
+  },
+  {
+    // sha256(fex:vdso_clock_gettime)
+    {0x54, 0x82, 0xe0, 0xbc, 0x12, 0x9f, 0x21, 0xe5, 0x09, 0x0c, 0x04, 0x1b, 0x97, 0xad, 0x83, 0x13,
+     0x55, 0x5d, 0x49, 0xec, 0xb6, 0x4f, 0x03, 0xf4, 0x61, 0xe4, 0x3a, 0x32, 0x08, 0xa5, 0xe7, 0xc6},
+    FEX::VDSO::x64::HostFunction::clock_gettime,
+    true,
   },
 }};
 
@@ -613,13 +671,12 @@ void LoadGuestVDSOSymbols(char* VDSOBase) {
   using ELFSHeaderType = std::conditional_t<Is64Bit, Elf64_Shdr, Elf32_Shdr>;
   using ELFSymbolType = std::conditional_t<Is64Bit, Elf64_Sym, Elf32_Sym>;
 
-  // We need to load symbols we care about.
-  if (Is64Bit) {
-    // We don't care about any 64-bit symbols right now.
+  if (!VDSOBase) {
     return;
   }
 
-  // 32-bit symbol loading.
+  // We need to load symbols we care about.
+  // 64-bit only cares about the time functions that get redirected to the host VDSO, 32-bit about the signal return handlers.
   auto Header = reinterpret_cast<const ELFHeaderType*>(VDSOBase);
 
   // First walk the section headers to find the symbol table.
@@ -661,7 +718,19 @@ void LoadGuestVDSOSymbols(char* VDSOBase) {
       auto Symbol = reinterpret_cast<const ELFSymbolType*>(VDSOBase + offset);
       if (ELF32_ST_VISIBILITY(Symbol->st_other) != STV_HIDDEN && Symbol->st_value != 0) {
         const char* Name = &StrTab[Symbol->st_name];
-        if (Name[0] != '\0') {
+        if (Name[0] == '\0') {
+          continue;
+        }
+
+        if constexpr (Is64Bit) {
+          if (strcmp(Name, "__vdso_time") == 0) {
+            VDSOPointers.VDSO_time = VDSOBase + Symbol->st_value;
+          } else if (strcmp(Name, "__vdso_gettimeofday") == 0) {
+            VDSOPointers.VDSO_gettimeofday = VDSOBase + Symbol->st_value;
+          } else if (strcmp(Name, "__vdso_clock_gettime") == 0) {
+            VDSOPointers.VDSO_clock_gettime = VDSOBase + Symbol->st_value;
+          }
+        } else {
           if (strcmp(Name, "__kernel_sigreturn") == 0) {
             VDSOPointers.VDSO_kernel_sigreturn = VDSOBase + Symbol->st_value;
           } else if (strcmp(Name, "__kernel_rt_sigreturn") == 0) {
@@ -871,6 +940,25 @@ const std::span<FEXCore::IR::ThunkDefinition> GetVDSOThunkDefinitions(bool Is64B
   return std::span(VDSODefinitions.begin(), VDSODefinitions.end() - (Is64Bit ? 0 : 1));
 }
 
+void InstallHostFunctionHandlers(FEXCore::Context::Context* CTX, FEX::HLE::ThunkHandler* ThunkHandler) {
+  const std::array<std::pair<void*, bool>, HostFunctionDefinitions.size()> Entrypoints = {{
+    {VDSOPointers.VDSO_time, VDSOHandlers::TimePtr != nullptr},
+    {VDSOPointers.VDSO_gettimeofday, VDSOHandlers::GetTimeOfDayPtr != nullptr},
+    {VDSOPointers.VDSO_clock_gettime, VDSOHandlers::ClockGetTimePtr != nullptr},
+  }};
+
+  ThunkHandler->AppendThunkDefinitions(HostFunctionDefinitions);
+
+  for (size_t i = 0; i < Entrypoints.size(); ++i) {
+    const auto [GuestEntrypoint, HasHostVDSO] = Entrypoints[i];
+    // Without a host VDSO the thunk library falls back to glibc, which reports errors through errno instead.
+    if (GuestEntrypoint && HasHostVDSO) {
+      CTX->AddHostFunctionIRHandler(reinterpret_cast<uint64_t>(GuestEntrypoint), HostFunctionDefinitions[i].Sum,
+                                    FEXCore::Context::HostFunctionABI::Integer);
+    }
+  }
+}
+
 const VDSOEntrypoints& GetVDSOSymbols() {
   return VDSOPointers;
 }
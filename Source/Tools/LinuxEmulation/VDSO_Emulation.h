@@ -7,9 +7,14 @@
 #include <cstdint>
 #include <span>
 
+namespace FEXCore::Context {
+class Context;
+}
+
 namespace FEX::HLE {
 class SyscallHandler;
-}
+class ThunkHandler;
+} // namespace FEX::HLE
 
 namespace FEX::VDSO {
 struct VDSOMapping {
@@ -23,6 +28,11 @@ struct VDSOEntrypoints {
   void* VDSO_kernel_sigreturn;
   void* VDSO_kernel_rt_sigreturn;
   void* VDSO_FEX_CallbackRET;
+
+  // 64-bit time functions that are redirected to the host VDSO
+  void* VDSO_time;
+  void* VDSO_gettimeofday;
+  void* VDSO_clock_gettime;
 };
 VDSOMapping LoadVDSOThunks(bool Is64Bit, FEX::HLE::SyscallHandler* const Handler);
 void UnloadVDSOMapping(const VDSOMapping& Mapping);
@@ -30,5 +40,9 @@ void UnloadVDSOMapping(const VDSOMapping& Mapping);
 uint64_t GetVSyscallEntry(const void* VDSOBase);
 
 const std::span<FEXCore::IR::ThunkDefinition> GetVDSOThunkDefinitions(bool Is64Bit);
+
+// Installs IR handlers at the 64-bit guest VDSO time functions that call the host VDSO directly.
+// This skips the guest-side argument packing and thunk stub that a call through the VDSO thunk library goes through.
+void InstallHostFunctionHandlers(FEXCore::Context::Context* CTX, FEX::HLE::ThunkHandler* ThunkHandler);
 const VDSOEntrypoints& GetVDSOSymbols();
 } // namespace FEX::VDSO
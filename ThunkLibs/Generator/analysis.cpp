@@ -78,6 +78,8 @@ struct Annotations {
 
   bool returns_guest_pointer = false;
 
+  bool leaf = false;
+
   std::optional<clang::QualType> uniform_va_type;
 
   CallbackStrategy callback_strategy = CallbackStrategy::Default;
@@ -97,6 +99,8 @@ static Annotations GetAnnotations(clang::ASTContext& context, clang::CXXRecordDe
       ret.callback_strategy = CallbackStrategy::Stub;
     } else if (annotation == "fexgen::custom_guest_entrypoint") {
       ret.custom_guest_entrypoint = true;
+    } else if (annotation == "fexgen::leaf") {
+      ret.leaf = true;
     } else {
       throw report_error(base.getSourceRange().getBegin(), "Unknown annotation");
     }
@@ -352,6 +356,7 @@ void AnalysisAction::ParseInterface(clang::ASTContext& context) {
           data.decl = emitted_function;
 
           data.custom_host_impl = annotations.custom_host_impl;
+          data.leaf = annotations.leaf;
 
           data.param_annotations = param_annotations[emitted_function];
 
@@ -418,6 +423,9 @@ void AnalysisAction::ParseInterface(clang::ASTContext& context) {
               callback.is_variadic = funcptr->isVariadic();
 
               data.callbacks.emplace(param_idx, callback);
+              if (!callback.is_stub && data.leaf) {
+                throw report_error(template_arg_loc, "Leaf functions may not take guest callbacks");
+              }
               if (!callback.is_stub && !data.custom_host_impl) {
                 thunked_funcptrs[emitted_function->getNameAsString() + "_cb" + std::to_string(param_idx)] =
                   std::pair {context.getCanonicalType(funcptr), no_param_annotations};
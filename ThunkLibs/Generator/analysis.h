@@ -49,6 +49,10 @@ struct ThunkedFunction : FunctionParams {
   // This is implied e.g. for thunks generated for variadic functions
   bool custom_host_impl = false;
 
+  // If true, the host function never calls back in to guest code and the
+  // guest->host transition may skip preserving guest caller-saved registers
+  bool leaf = false;
+
   std::string GetOriginalFunctionName() const {
     const std::string suffix = "_internal";
     assert(function_name.length() > suffix.size());
@@ -729,8 +729,8 @@ void GenerateThunkLibsAction::OnAnalysisComplete(clang::ASTContext& context) {
     for (auto& thunk : thunks) {
       const auto& function_name = thunk.function_name;
       auto sha256 = get_sha256(function_name, true);
-      fmt::print(file, "  {{(uint8_t*)\"\\x{:02x}\", (void(*)(void *))&fexfn_unpack_{}_{}}}, // {}:{}\n", fmt::join(sha256, "\\x"), libname,
-                 function_name, libname, function_name);
+      fmt::print(file, "  {{(uint8_t*)\"\\x{:02x}\", (void(*)(void *))&fexfn_unpack_{}_{}, {}}}, // {}:{}\n", fmt::join(sha256, "\\x"),
+                 libname, function_name, thunk.leaf, libname, function_name);
     }
 
     // Endpoints for Guest->Host invocation of runtime host-function pointers
@@ -49,6 +49,8 @@ static typename function_traits<decltype(Fn)>::result_t fexfn_type_erased_unpack
 struct ExportEntry {
   uint8_t* sha256;
   void (*fn)(void*);
+  // Set for functions annotated with fexgen::leaf
+  bool leaf;
 };
 
 typedef void fex_call_callback_t(uintptr_t callback, void* arg0, void* arg1);
@@ -70,6 +70,8 @@ template<>
 struct fex_gen_type<Visual> : fexgen::opaque_type {}; // Used in XVisualInfo; treat as opaque
 
 // Symbols queryable through glXGetProcAddr
+// The glUniform* and glProgramUniform* setters are among the most frequent GL calls and are annotated with fexgen::leaf.
+// They can't call back in to guest code, the only GL callbacks are the debug message callbacks which are stubbed out.
 namespace internal {
 template<auto>
 struct fex_gen_config : fexgen::generate_guest_symtable, fexgen::indirect_guest_calls {};
@@ -4067,281 +4069,281 @@ struct fex_gen_config<glProgramStringARB> {};
 template<>
 struct fex_gen_config<glProgramSubroutineParametersuivNV> {};
 template<>
-struct fex_gen_config<glProgramUniform1dEXT> {};
+struct fex_gen_config<glProgramUniform1dEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1d> {};
+struct fex_gen_config<glProgramUniform1d> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1dvEXT> {};
+struct fex_gen_config<glProgramUniform1dvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1dv> {};
+struct fex_gen_config<glProgramUniform1dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1fEXT> {};
+struct fex_gen_config<glProgramUniform1fEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1f> {};
+struct fex_gen_config<glProgramUniform1f> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1fvEXT> {};
+struct fex_gen_config<glProgramUniform1fvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1fv> {};
+struct fex_gen_config<glProgramUniform1fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1i64ARB> {};
+struct fex_gen_config<glProgramUniform1i64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1i64NV> {};
+struct fex_gen_config<glProgramUniform1i64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1i64vARB> {};
+struct fex_gen_config<glProgramUniform1i64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1i64vNV> {};
+struct fex_gen_config<glProgramUniform1i64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1iEXT> {};
+struct fex_gen_config<glProgramUniform1iEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1i> {};
+struct fex_gen_config<glProgramUniform1i> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1ivEXT> {};
+struct fex_gen_config<glProgramUniform1ivEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1iv> {};
+struct fex_gen_config<glProgramUniform1iv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1ui64ARB> {};
+struct fex_gen_config<glProgramUniform1ui64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1ui64NV> {};
+struct fex_gen_config<glProgramUniform1ui64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1ui64vARB> {};
+struct fex_gen_config<glProgramUniform1ui64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1ui64vNV> {};
+struct fex_gen_config<glProgramUniform1ui64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1uiEXT> {};
+struct fex_gen_config<glProgramUniform1uiEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1ui> {};
+struct fex_gen_config<glProgramUniform1ui> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1uivEXT> {};
+struct fex_gen_config<glProgramUniform1uivEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform1uiv> {};
+struct fex_gen_config<glProgramUniform1uiv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2dEXT> {};
+struct fex_gen_config<glProgramUniform2dEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2d> {};
+struct fex_gen_config<glProgramUniform2d> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2dvEXT> {};
+struct fex_gen_config<glProgramUniform2dvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2dv> {};
+struct fex_gen_config<glProgramUniform2dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2fEXT> {};
+struct fex_gen_config<glProgramUniform2fEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2f> {};
+struct fex_gen_config<glProgramUniform2f> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2fvEXT> {};
+struct fex_gen_config<glProgramUniform2fvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2fv> {};
+struct fex_gen_config<glProgramUniform2fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2i64ARB> {};
+struct fex_gen_config<glProgramUniform2i64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2i64NV> {};
+struct fex_gen_config<glProgramUniform2i64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2i64vARB> {};
+struct fex_gen_config<glProgramUniform2i64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2i64vNV> {};
+struct fex_gen_config<glProgramUniform2i64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2iEXT> {};
+struct fex_gen_config<glProgramUniform2iEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2i> {};
+struct fex_gen_config<glProgramUniform2i> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2ivEXT> {};
+struct fex_gen_config<glProgramUniform2ivEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2iv> {};
+struct fex_gen_config<glProgramUniform2iv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2ui64ARB> {};
+struct fex_gen_config<glProgramUniform2ui64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2ui64NV> {};
+struct fex_gen_config<glProgramUniform2ui64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2ui64vARB> {};
+struct fex_gen_config<glProgramUniform2ui64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2ui64vNV> {};
+struct fex_gen_config<glProgramUniform2ui64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2uiEXT> {};
+struct fex_gen_config<glProgramUniform2uiEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2ui> {};
+struct fex_gen_config<glProgramUniform2ui> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2uivEXT> {};
+struct fex_gen_config<glProgramUniform2uivEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform2uiv> {};
+struct fex_gen_config<glProgramUniform2uiv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3dEXT> {};
+struct fex_gen_config<glProgramUniform3dEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3d> {};
+struct fex_gen_config<glProgramUniform3d> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3dvEXT> {};
+struct fex_gen_config<glProgramUniform3dvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3dv> {};
+struct fex_gen_config<glProgramUniform3dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3fEXT> {};
+struct fex_gen_config<glProgramUniform3fEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3f> {};
+struct fex_gen_config<glProgramUniform3f> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3fvEXT> {};
+struct fex_gen_config<glProgramUniform3fvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3fv> {};
+struct fex_gen_config<glProgramUniform3fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3i64ARB> {};
+struct fex_gen_config<glProgramUniform3i64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3i64NV> {};
+struct fex_gen_config<glProgramUniform3i64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3i64vARB> {};
+struct fex_gen_config<glProgramUniform3i64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3i64vNV> {};
+struct fex_gen_config<glProgramUniform3i64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3iEXT> {};
+struct fex_gen_config<glProgramUniform3iEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3i> {};
+struct fex_gen_config<glProgramUniform3i> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3ivEXT> {};
+struct fex_gen_config<glProgramUniform3ivEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3iv> {};
+struct fex_gen_config<glProgramUniform3iv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3ui64ARB> {};
+struct fex_gen_config<glProgramUniform3ui64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3ui64NV> {};
+struct fex_gen_config<glProgramUniform3ui64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3ui64vARB> {};
+struct fex_gen_config<glProgramUniform3ui64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3ui64vNV> {};
+struct fex_gen_config<glProgramUniform3ui64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3uiEXT> {};
+struct fex_gen_config<glProgramUniform3uiEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3ui> {};
+struct fex_gen_config<glProgramUniform3ui> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3uivEXT> {};
+struct fex_gen_config<glProgramUniform3uivEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform3uiv> {};
+struct fex_gen_config<glProgramUniform3uiv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4dEXT> {};
+struct fex_gen_config<glProgramUniform4dEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4d> {};
+struct fex_gen_config<glProgramUniform4d> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4dvEXT> {};
+struct fex_gen_config<glProgramUniform4dvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4dv> {};
+struct fex_gen_config<glProgramUniform4dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4fEXT> {};
+struct fex_gen_config<glProgramUniform4fEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4f> {};
+struct fex_gen_config<glProgramUniform4f> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4fvEXT> {};
+struct fex_gen_config<glProgramUniform4fvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4fv> {};
+struct fex_gen_config<glProgramUniform4fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4i64ARB> {};
+struct fex_gen_config<glProgramUniform4i64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4i64NV> {};
+struct fex_gen_config<glProgramUniform4i64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4i64vARB> {};
+struct fex_gen_config<glProgramUniform4i64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4i64vNV> {};
+struct fex_gen_config<glProgramUniform4i64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4iEXT> {};
+struct fex_gen_config<glProgramUniform4iEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4i> {};
+struct fex_gen_config<glProgramUniform4i> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4ivEXT> {};
+struct fex_gen_config<glProgramUniform4ivEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4iv> {};
+struct fex_gen_config<glProgramUniform4iv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4ui64ARB> {};
+struct fex_gen_config<glProgramUniform4ui64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4ui64NV> {};
+struct fex_gen_config<glProgramUniform4ui64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4ui64vARB> {};
+struct fex_gen_config<glProgramUniform4ui64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4ui64vNV> {};
+struct fex_gen_config<glProgramUniform4ui64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4uiEXT> {};
+struct fex_gen_config<glProgramUniform4uiEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4ui> {};
+struct fex_gen_config<glProgramUniform4ui> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4uivEXT> {};
+struct fex_gen_config<glProgramUniform4uivEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniform4uiv> {};
+struct fex_gen_config<glProgramUniform4uiv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformHandleui64ARB> {};
+struct fex_gen_config<glProgramUniformHandleui64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformHandleui64NV> {};
+struct fex_gen_config<glProgramUniformHandleui64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformHandleui64vARB> {};
+struct fex_gen_config<glProgramUniformHandleui64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformHandleui64vNV> {};
+struct fex_gen_config<glProgramUniformHandleui64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix2dvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix2dvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix2dv> {};
+struct fex_gen_config<glProgramUniformMatrix2dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix2fvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix2fvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix2fv> {};
+struct fex_gen_config<glProgramUniformMatrix2fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix2x3dvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix2x3dvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix2x3dv> {};
+struct fex_gen_config<glProgramUniformMatrix2x3dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix2x3fvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix2x3fvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix2x3fv> {};
+struct fex_gen_config<glProgramUniformMatrix2x3fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix2x4dvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix2x4dvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix2x4dv> {};
+struct fex_gen_config<glProgramUniformMatrix2x4dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix2x4fvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix2x4fvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix2x4fv> {};
+struct fex_gen_config<glProgramUniformMatrix2x4fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix3dvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix3dvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix3dv> {};
+struct fex_gen_config<glProgramUniformMatrix3dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix3fvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix3fvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix3fv> {};
+struct fex_gen_config<glProgramUniformMatrix3fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix3x2dvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix3x2dvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix3x2dv> {};
+struct fex_gen_config<glProgramUniformMatrix3x2dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix3x2fvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix3x2fvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix3x2fv> {};
+struct fex_gen_config<glProgramUniformMatrix3x2fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix3x4dvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix3x4dvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix3x4dv> {};
+struct fex_gen_config<glProgramUniformMatrix3x4dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix3x4fvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix3x4fvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix3x4fv> {};
+struct fex_gen_config<glProgramUniformMatrix3x4fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix4dvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix4dvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix4dv> {};
+struct fex_gen_config<glProgramUniformMatrix4dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix4fvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix4fvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix4fv> {};
+struct fex_gen_config<glProgramUniformMatrix4fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix4x2dvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix4x2dvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix4x2dv> {};
+struct fex_gen_config<glProgramUniformMatrix4x2dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix4x2fvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix4x2fvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix4x2fv> {};
+struct fex_gen_config<glProgramUniformMatrix4x2fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix4x3dvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix4x3dvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix4x3dv> {};
+struct fex_gen_config<glProgramUniformMatrix4x3dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix4x3fvEXT> {};
+struct fex_gen_config<glProgramUniformMatrix4x3fvEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformMatrix4x3fv> {};
+struct fex_gen_config<glProgramUniformMatrix4x3fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformui64NV> {};
+struct fex_gen_config<glProgramUniformui64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glProgramUniformui64vNV> {};
+struct fex_gen_config<glProgramUniformui64vNV> : fexgen::leaf {};
 template<>
 struct fex_gen_config<glProgramVertexLimitNV> {};
 template<>
@@ -5228,241 +5230,241 @@ struct fex_gen_config<glTranslatef> {};
 template<>
 struct fex_gen_config<glTranslatexOES> {};
 template<>
-struct fex_gen_config<glUniform1d> {};
+struct fex_gen_config<glUniform1d> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1dv> {};
+struct fex_gen_config<glUniform1dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1fARB> {};
+struct fex_gen_config<glUniform1fARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1f> {};
+struct fex_gen_config<glUniform1f> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1fvARB> {};
+struct fex_gen_config<glUniform1fvARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1fv> {};
+struct fex_gen_config<glUniform1fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1i64ARB> {};
+struct fex_gen_config<glUniform1i64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1i64NV> {};
+struct fex_gen_config<glUniform1i64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1i64vARB> {};
+struct fex_gen_config<glUniform1i64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1i64vNV> {};
+struct fex_gen_config<glUniform1i64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1iARB> {};
+struct fex_gen_config<glUniform1iARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1i> {};
+struct fex_gen_config<glUniform1i> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1ivARB> {};
+struct fex_gen_config<glUniform1ivARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1iv> {};
+struct fex_gen_config<glUniform1iv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1ui64ARB> {};
+struct fex_gen_config<glUniform1ui64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1ui64NV> {};
+struct fex_gen_config<glUniform1ui64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1ui64vARB> {};
+struct fex_gen_config<glUniform1ui64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1ui64vNV> {};
+struct fex_gen_config<glUniform1ui64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1uiEXT> {};
+struct fex_gen_config<glUniform1uiEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1ui> {};
+struct fex_gen_config<glUniform1ui> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1uivEXT> {};
+struct fex_gen_config<glUniform1uivEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform1uiv> {};
+struct fex_gen_config<glUniform1uiv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2d> {};
+struct fex_gen_config<glUniform2d> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2dv> {};
+struct fex_gen_config<glUniform2dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2fARB> {};
+struct fex_gen_config<glUniform2fARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2f> {};
+struct fex_gen_config<glUniform2f> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2fvARB> {};
+struct fex_gen_config<glUniform2fvARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2fv> {};
+struct fex_gen_config<glUniform2fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2i64ARB> {};
+struct fex_gen_config<glUniform2i64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2i64NV> {};
+struct fex_gen_config<glUniform2i64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2i64vARB> {};
+struct fex_gen_config<glUniform2i64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2i64vNV> {};
+struct fex_gen_config<glUniform2i64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2iARB> {};
+struct fex_gen_config<glUniform2iARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2i> {};
+struct fex_gen_config<glUniform2i> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2ivARB> {};
+struct fex_gen_config<glUniform2ivARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2iv> {};
+struct fex_gen_config<glUniform2iv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2ui64ARB> {};
+struct fex_gen_config<glUniform2ui64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2ui64NV> {};
+struct fex_gen_config<glUniform2ui64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2ui64vARB> {};
+struct fex_gen_config<glUniform2ui64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2ui64vNV> {};
+struct fex_gen_config<glUniform2ui64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2uiEXT> {};
+struct fex_gen_config<glUniform2uiEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2ui> {};
+struct fex_gen_config<glUniform2ui> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2uivEXT> {};
+struct fex_gen_config<glUniform2uivEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform2uiv> {};
+struct fex_gen_config<glUniform2uiv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3d> {};
+struct fex_gen_config<glUniform3d> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3dv> {};
+struct fex_gen_config<glUniform3dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3fARB> {};
+struct fex_gen_config<glUniform3fARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3f> {};
+struct fex_gen_config<glUniform3f> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3fvARB> {};
+struct fex_gen_config<glUniform3fvARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3fv> {};
+struct fex_gen_config<glUniform3fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3i64ARB> {};
+struct fex_gen_config<glUniform3i64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3i64NV> {};
+struct fex_gen_config<glUniform3i64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3i64vARB> {};
+struct fex_gen_config<glUniform3i64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3i64vNV> {};
+struct fex_gen_config<glUniform3i64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3iARB> {};
+struct fex_gen_config<glUniform3iARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3i> {};
+struct fex_gen_config<glUniform3i> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3ivARB> {};
+struct fex_gen_config<glUniform3ivARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3iv> {};
+struct fex_gen_config<glUniform3iv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3ui64ARB> {};
+struct fex_gen_config<glUniform3ui64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3ui64NV> {};
+struct fex_gen_config<glUniform3ui64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3ui64vARB> {};
+struct fex_gen_config<glUniform3ui64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3ui64vNV> {};
+struct fex_gen_config<glUniform3ui64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3uiEXT> {};
+struct fex_gen_config<glUniform3uiEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3ui> {};
+struct fex_gen_config<glUniform3ui> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3uivEXT> {};
+struct fex_gen_config<glUniform3uivEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform3uiv> {};
+struct fex_gen_config<glUniform3uiv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4d> {};
+struct fex_gen_config<glUniform4d> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4dv> {};
+struct fex_gen_config<glUniform4dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4fARB> {};
+struct fex_gen_config<glUniform4fARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4f> {};
+struct fex_gen_config<glUniform4f> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4fvARB> {};
+struct fex_gen_config<glUniform4fvARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4fv> {};
+struct fex_gen_config<glUniform4fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4i64ARB> {};
+struct fex_gen_config<glUniform4i64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4i64NV> {};
+struct fex_gen_config<glUniform4i64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4i64vARB> {};
+struct fex_gen_config<glUniform4i64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4i64vNV> {};
+struct fex_gen_config<glUniform4i64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4iARB> {};
+struct fex_gen_config<glUniform4iARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4i> {};
+struct fex_gen_config<glUniform4i> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4ivARB> {};
+struct fex_gen_config<glUniform4ivARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4iv> {};
+struct fex_gen_config<glUniform4iv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4ui64ARB> {};
+struct fex_gen_config<glUniform4ui64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4ui64NV> {};
+struct fex_gen_config<glUniform4ui64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4ui64vARB> {};
+struct fex_gen_config<glUniform4ui64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4ui64vNV> {};
+struct fex_gen_config<glUniform4ui64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4uiEXT> {};
+struct fex_gen_config<glUniform4uiEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4ui> {};
+struct fex_gen_config<glUniform4ui> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4uivEXT> {};
+struct fex_gen_config<glUniform4uivEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniform4uiv> {};
+struct fex_gen_config<glUniform4uiv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformBlockBinding> {};
+struct fex_gen_config<glUniformBlockBinding> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformBufferEXT> {};
+struct fex_gen_config<glUniformBufferEXT> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformHandleui64ARB> {};
+struct fex_gen_config<glUniformHandleui64ARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformHandleui64NV> {};
+struct fex_gen_config<glUniformHandleui64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformHandleui64vARB> {};
+struct fex_gen_config<glUniformHandleui64vARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformHandleui64vNV> {};
+struct fex_gen_config<glUniformHandleui64vNV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix2dv> {};
+struct fex_gen_config<glUniformMatrix2dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix2fvARB> {};
+struct fex_gen_config<glUniformMatrix2fvARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix2fv> {};
+struct fex_gen_config<glUniformMatrix2fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix2x3dv> {};
+struct fex_gen_config<glUniformMatrix2x3dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix2x3fv> {};
+struct fex_gen_config<glUniformMatrix2x3fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix2x4dv> {};
+struct fex_gen_config<glUniformMatrix2x4dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix2x4fv> {};
+struct fex_gen_config<glUniformMatrix2x4fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix3dv> {};
+struct fex_gen_config<glUniformMatrix3dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix3fvARB> {};
+struct fex_gen_config<glUniformMatrix3fvARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix3fv> {};
+struct fex_gen_config<glUniformMatrix3fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix3x2dv> {};
+struct fex_gen_config<glUniformMatrix3x2dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix3x2fv> {};
+struct fex_gen_config<glUniformMatrix3x2fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix3x4dv> {};
+struct fex_gen_config<glUniformMatrix3x4dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix3x4fv> {};
+struct fex_gen_config<glUniformMatrix3x4fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix4dv> {};
+struct fex_gen_config<glUniformMatrix4dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix4fvARB> {};
+struct fex_gen_config<glUniformMatrix4fvARB> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix4fv> {};
+struct fex_gen_config<glUniformMatrix4fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix4x2dv> {};
+struct fex_gen_config<glUniformMatrix4x2dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix4x2fv> {};
+struct fex_gen_config<glUniformMatrix4x2fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix4x3dv> {};
+struct fex_gen_config<glUniformMatrix4x3dv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformMatrix4x3fv> {};
+struct fex_gen_config<glUniformMatrix4x3fv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformSubroutinesuiv> {};
+struct fex_gen_config<glUniformSubroutinesuiv> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformui64NV> {};
+struct fex_gen_config<glUniformui64NV> : fexgen::leaf {};
 template<>
-struct fex_gen_config<glUniformui64vNV> {};
+struct fex_gen_config<glUniformui64vNV> : fexgen::leaf {};
 template<>
 struct fex_gen_config<glUnlockArraysEXT> {};
 template<>
@@ -0,0 +1,35 @@
+/**
+ * Backend of the FEX OpenSSL provider.
+ *
+ * The guest side is an OpenSSL 3 provider module, its algorithm contexts wrap these host objects which are backed by
+ * the host libcrypto.
+ */
+#pragma once
+
+#include <cstddef>
+
+extern "C" {
+
+struct fex_crypto_digest;
+struct fex_crypto_cipher;
+
+/// Digests, Name is one of the host libcrypto's algorithm names
+fex_crypto_digest* fex_crypto_digest_new(const char* Name);
+fex_crypto_digest* fex_crypto_digest_dup(const fex_crypto_digest* Digest);
+void fex_crypto_digest_free(fex_crypto_digest* Digest);
+int fex_crypto_digest_init(fex_crypto_digest* Digest);
+int fex_crypto_digest_update(fex_crypto_digest* Digest, const unsigned char* In, size_t InLen);
+int fex_crypto_digest_final(fex_crypto_digest* Digest, unsigned char* Out, unsigned int* OutLen);
+
+/// Symmetric ciphers
+fex_crypto_cipher* fex_crypto_cipher_new(const char* Name);
+fex_crypto_cipher* fex_crypto_cipher_dup(const fex_crypto_cipher* Cipher);
+void fex_crypto_cipher_free(fex_crypto_cipher* Cipher);
+// Key and IV may be null to keep the current ones, IVLen only matters for AEAD ciphers
+int fex_crypto_cipher_init(fex_crypto_cipher* Cipher, int Encrypt, const unsigned char* Key, const unsigned char* IV, size_t IVLen);
+// Out may be null to pass additional authenticated data
+int fex_crypto_cipher_update(fex_crypto_cipher* Cipher, unsigned char* Out, size_t* OutLen, const unsigned char* In, size_t InLen);
+int fex_crypto_cipher_final(fex_crypto_cipher* Cipher, unsigned char* Out, size_t* OutLen);
+// Forwarded to EVP_CIPHER_CTX_ctrl, used for tags and TLS record handling
+int fex_crypto_cipher_ctrl(fex_crypto_cipher* Cipher, int Type, int Arg, void* Ptr);
+}
@@ -0,0 +1,540 @@
+/*
+$info$
+tags: thunklibs|crypto
+desc: OpenSSL provider that runs digests and ciphers in the host libcrypto
+$end_info$
+*/
+
+// libcrypto exports thousands of functions and hands its objects between all of them, which rules out overlaying
+// the whole library. Instead this is an OpenSSL 3 provider module that the guest libcrypto loads through its
+// configuration, so every EVP user in the guest (including libssl) picks up the host implementations:
+//
+//   [provider_sect]
+//   default = default_sect
+//   fex = fex_sect
+//   [fex_sect]
+//   module = <FEX data directory>/GuestThunks/libcrypto-guest.so
+//   activate = 1
+//   [evp_properties]
+//   default_properties = ?provider=fex
+//
+// Contexts are opaque host objects, only parameter handling happens on the guest side.
+
+#include <openssl/core.h>
+#include <openssl/core_dispatch.h>
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
+
+#include <stdint.h>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include "common/Guest.h"
+
+#include "api.h"
+
+#include "thunkgen_guest_libcrypto.inl"
+
+namespace {
+// The guest libcrypto's OSSL_PARAM helpers can't be linked against from here
+OSSL_PARAM* FindParam(OSSL_PARAM* Params, const char* Key) {
+  for (; Params && Params->key; ++Params) {
+    if (strcmp(Params->key, Key) == 0) {
+      return Params;
+    }
+  }
+  return nullptr;
+}
+
+const OSSL_PARAM* FindParam(const OSSL_PARAM* Params, const char* Key) {
+  return FindParam(const_cast<OSSL_PARAM*>(Params), Key);
+}
+
+bool SetNumber(OSSL_PARAM* Param, uint64_t Value) {
+  if (!Param) {
+    return true;
+  }
+
+  if (Param->data_type != OSSL_PARAM_INTEGER && Param->data_type != OSSL_PARAM_UNSIGNED_INTEGER) {
+    return false;
+  }
+
+  Param->return_size = Param->data_size;
+  if (Param->data_size == sizeof(uint64_t)) {
+    memcpy(Param->data, &Value, sizeof(uint64_t));
+  } else if (Param->data_size == sizeof(uint32_t)) {
+    uint32_t Value32 = Value;
+    memcpy(Param->data, &Value32, sizeof(uint32_t));
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool GetNumber(const OSSL_PARAM* Param, uint64_t* Value) {
+  if (Param->data_type != OSSL_PARAM_INTEGER && Param->data_type != OSSL_PARAM_UNSIGNED_INTEGER) {
+    return false;
+  }
+
+  if (Param->data_size == sizeof(uint64_t)) {
+    memcpy(Value, Param->data, sizeof(uint64_t));
+  } else if (Param->data_size == sizeof(uint32_t)) {
+    uint32_t Value32;
+    memcpy(&Value32, Param->data, sizeof(uint32_t));
+    *Value = Value32;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool SetString(OSSL_PARAM* Param, const char* Value) {
+  if (!Param) {
+    return true;
+  }
+
+  if (Param->data_type != OSSL_PARAM_UTF8_PTR) {
+    return false;
+  }
+
+  *static_cast<const char**>(Param->data) = Value;
+  Param->return_size = strlen(Value);
+  return true;
+}
+
+template<typename F>
+void (*Fn(F* Function))(void) {
+  return reinterpret_cast<void (*)(void)>(Function);
+}
+
+/// Digests
+struct DigestInfo {
+  const char* Names;
+  const char* HostName;
+  size_t Size;
+  size_t BlockSize;
+};
+
+constexpr DigestInfo Digests[] = {
+  {"SHA1:SHA-1:SSL3-SHA1:1.3.14.3.2.26", "SHA1", 20, 64},
+  {"SHA2-224:SHA-224:SHA224:2.16.840.1.101.3.4.2.4", "SHA2-224", 28, 64},
+  {"SHA2-256:SHA-256:SHA256:2.16.840.1.101.3.4.2.1", "SHA2-256", 32, 64},
+  {"SHA2-384:SHA-384:SHA384:2.16.840.1.101.3.4.2.2", "SHA2-384", 48, 128},
+  {"SHA2-512:SHA-512:SHA512:2.16.840.1.101.3.4.2.3", "SHA2-512", 64, 128},
+};
+
+template<size_t Index>
+void* DigestNewCtx(void*) {
+  return fex_crypto_digest_new(Digests[Index].HostName);
+}
+
+void* DigestDupCtx(void* Ctx) {
+  return fex_crypto_digest_dup(static_cast<fex_crypto_digest*>(Ctx));
+}
+
+void DigestFreeCtx(void* Ctx) {
+  fex_crypto_digest_free(static_cast<fex_crypto_digest*>(Ctx));
+}
+
+int DigestInit(void* Ctx, const OSSL_PARAM[]) {
+  return fex_crypto_digest_init(static_cast<fex_crypto_digest*>(Ctx));
+}
+
+int DigestUpdate(void* Ctx, const unsigned char* In, size_t InLen) {
+  return fex_crypto_digest_update(static_cast<fex_crypto_digest*>(Ctx), In, InLen);
+}
+
+template<size_t Index>
+int DigestFinal(void* Ctx, unsigned char* Out, size_t* OutLen, size_t OutSize) {
+  if (OutSize < Digests[Index].Size) {
+    return 0;
+  }
+
+  unsigned int Written {};
+  if (!fex_crypto_digest_final(static_cast<fex_crypto_digest*>(Ctx), Out, &Written)) {
+    return 0;
+  }
+
+  *OutLen = Written;
+  return 1;
+}
+
+template<size_t Index>
+int DigestGetParams(OSSL_PARAM Params[]) {
+  return SetNumber(FindParam(Params, OSSL_DIGEST_PARAM_BLOCK_SIZE), Digests[Index].BlockSize) &&
+         SetNumber(FindParam(Params, OSSL_DIGEST_PARAM_SIZE), Digests[Index].Size) &&
+         SetNumber(FindParam(Params, OSSL_DIGEST_PARAM_XOF), 0) && SetNumber(FindParam(Params, OSSL_DIGEST_PARAM_ALGID_ABSENT), 0);
+}
+
+const OSSL_PARAM DigestGettableParams[] = {
+  {OSSL_DIGEST_PARAM_BLOCK_SIZE, OSSL_PARAM_UNSIGNED_INTEGER, nullptr, sizeof(size_t), 0},
+  {OSSL_DIGEST_PARAM_SIZE, OSSL_PARAM_UNSIGNED_INTEGER, nullptr, sizeof(size_t), 0},
+  {OSSL_DIGEST_PARAM_XOF, OSSL_PARAM_INTEGER, nullptr, sizeof(int), 0},
+  {OSSL_DIGEST_PARAM_ALGID_ABSENT, OSSL_PARAM_INTEGER, nullptr, sizeof(int), 0},
+  {nullptr, 0, nullptr, 0, 0},
+};
+
+const OSSL_PARAM* DigestGettable(void*) {
+  return DigestGettableParams;
+}
+
+template<size_t Index>
+const OSSL_DISPATCH DigestFunctions[] = {
+  {OSSL_FUNC_DIGEST_NEWCTX, Fn(DigestNewCtx<Index>)},
+  {OSSL_FUNC_DIGEST_DUPCTX, Fn(DigestDupCtx)},
+  {OSSL_FUNC_DIGEST_FREECTX, Fn(DigestFreeCtx)},
+  {OSSL_FUNC_DIGEST_INIT, Fn(DigestInit)},
+  {OSSL_FUNC_DIGEST_UPDATE, Fn(DigestUpdate)},
+  {OSSL_FUNC_DIGEST_FINAL, Fn(DigestFinal<Index>)},
+  {OSSL_FUNC_DIGEST_GET_PARAMS, Fn(DigestGetParams<Index>)},
+  {OSSL_FUNC_DIGEST_GETTABLE_PARAMS, Fn(DigestGettable)},
+  {0, nullptr},
+};
+
+/// Ciphers
+struct CipherInfo {
+  const char* Names;
+  const char* HostName;
+  unsigned Mode;
+  size_t KeyLen;
+  size_t IVLen;
+  bool AEAD;
+};
+
+constexpr CipherInfo Ciphers[] = {
+  {"AES-128-GCM:id-aes128-GCM:2.16.840.1.101.3.4.1.6", "AES-128-GCM", EVP_CIPH_GCM_MODE, 16, 12, true},
+  {"AES-192-GCM:id-aes192-GCM:2.16.840.1.101.3.4.1.26", "AES-192-GCM", EVP_CIPH_GCM_MODE, 24, 12, true},
+  {"AES-256-GCM:id-aes256-GCM:2.16.840.1.101.3.4.1.46", "AES-256-GCM", EVP_CIPH_GCM_MODE, 32, 12, true},
+  {"AES-128-CTR", "AES-128-CTR", EVP_CIPH_CTR_MODE, 16, 16, false},
+  {"AES-192-CTR", "AES-192-CTR", EVP_CIPH_CTR_MODE, 24, 16, false},
+  {"AES-256-CTR", "AES-256-CTR", EVP_CIPH_CTR_MODE, 32, 16, false},
+};
+
+// GCM and CTR are stream modes, ciphertext is never longer than the plaintext
+constexpr size_t CipherBlockSize = 1;
+constexpr size_t GCMTagLen = 16;
+
+struct CipherCtx {
+  fex_crypto_cipher* Host;
+  const CipherInfo* Info;
+  size_t IVLen;
+  size_t TagLen;
+  // Tag length that a TLS record grows by, returned after setting the TLS AAD
+  size_t TLSAADPad;
+};
+
+template<size_t Index>
+void* CipherNewCtx(void*) {
+  auto Host = fex_crypto_cipher_new(Ciphers[Index].HostName);
+  if (!Host) {
+    return nullptr;
+  }
+
+  return new CipherCtx {Host, &Ciphers[Index], Ciphers[Index].IVLen, GCMTagLen, 0};
+}
+
+void* CipherDupCtx(void* Ctx) {
+  auto Source = static_cast<CipherCtx*>(Ctx);
+  auto Host = fex_crypto_cipher_dup(Source->Host);
+  if (!Host) {
+    return nullptr;
+  }
+
+  auto Dup = new CipherCtx {*Source};
+  Dup->Host = Host;
+  return Dup;
+}
+
+void CipherFreeCtx(void* Ctx) {
+  auto Cipher = static_cast<CipherCtx*>(Ctx);
+  if (!Cipher) {
+    return;
+  }
+
+  fex_crypto_cipher_free(Cipher->Host);
+  delete Cipher;
+}
+
+int CipherSetCtxParams(void* Ctx, const OSSL_PARAM Params[]) {
+  auto Cipher = static_cast<CipherCtx*>(Ctx);
+  if (!Cipher->Info->AEAD) {
+    return 1;
+  }
+
+  if (auto Param = FindParam(Params, OSSL_CIPHER_PARAM_AEAD_IVLEN)) {
+    uint64_t IVLen;
+    if (!GetNumber(Param, &IVLen) || IVLen == 0) {
+      return 0;
+    }
+    // Applied by the next init with an IV
+    Cipher->IVLen = IVLen;
+  }
+
+  if (auto Param = FindParam(Params, OSSL_CIPHER_PARAM_AEAD_TAG)) {
+    if (Param->data_type != OSSL_PARAM_OCTET_STRING || Param->data_size == 0 || Param->data_size > GCMTagLen) {
+      return 0;
+    }
+    if (fex_crypto_cipher_ctrl(Cipher->Host, EVP_CTRL_AEAD_SET_TAG, Param->data_size, Param->data) <= 0) {
+      return 0;
+    }
+    Cipher->TagLen = Param->data_size;
+  }
+
+  if (auto Param = FindParam(Params, OSSL_CIPHER_PARAM_AEAD_TLS1_AAD)) {
+    if (Param->data_type != OSSL_PARAM_OCTET_STRING) {
+      return 0;
+    }
+    const int Pad = fex_crypto_cipher_ctrl(Cipher->Host, EVP_CTRL_AEAD_TLS1_AAD, Param->data_size, Param->data);
+    if (Pad <= 0) {
+      return 0;
+    }
+    Cipher->TLSAADPad = Pad;
+  }
+
+  if (auto Param = FindParam(Params, OSSL_CIPHER_PARAM_AEAD_TLS1_IV_FIXED)) {
+    if (Param->data_type != OSSL_PARAM_OCTET_STRING ||
+        fex_crypto_cipher_ctrl(Cipher->Host, EVP_CTRL_AEAD_SET_IV_FIXED, Param->data_size, Param->data) <= 0) {
+      return 0;
+    }
+  }
+
+  if (auto Param = FindParam(Params, OSSL_CIPHER_PARAM_AEAD_TLS1_SET_IV_INV)) {
+    if (Param->data_type != OSSL_PARAM_OCTET_STRING ||
+        fex_crypto_cipher_ctrl(Cipher->Host, EVP_CTRL_GCM_SET_IV_INV, Param->data_size, Param->data) <= 0) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+int CipherGetCtxParams(void* Ctx, OSSL_PARAM Params[]) {
+  auto Cipher = static_cast<CipherCtx*>(Ctx);
+
+  if (!SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_KEYLEN), Cipher->Info->KeyLen) ||
+      !SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_IVLEN), Cipher->IVLen) ||
+      !SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_PADDING), 0)) {
+    return 0;
+  }
+
+  if (!Cipher->Info->AEAD) {
+    return 1;
+  }
+
+  if (!SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_AEAD_TAGLEN), Cipher->TagLen) ||
+      !SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_AEAD_TLS1_AAD_PAD), Cipher->TLSAADPad)) {
+    return 0;
+  }
+
+  if (auto Param = FindParam(Params, OSSL_CIPHER_PARAM_AEAD_TAG)) {
+    if (Param->data_type != OSSL_PARAM_OCTET_STRING || Param->data_size == 0 || Param->data_size > GCMTagLen ||
+        fex_crypto_cipher_ctrl(Cipher->Host, EVP_CTRL_AEAD_GET_TAG, Param->data_size, Param->data) <= 0) {
+      return 0;
+    }
+    Param->return_size = Param->data_size;
+  }
+
+  if (auto Param = FindParam(Params, OSSL_CIPHER_PARAM_AEAD_TLS1_GET_IV_GEN)) {
+    if (Param->data_type != OSSL_PARAM_OCTET_STRING ||
+        fex_crypto_cipher_ctrl(Cipher->Host, EVP_CTRL_GCM_IV_GEN, Param->data_size, Param->data) <= 0) {
+      return 0;
+    }
+    Param->return_size = Param->data_size;
+  }
+
+  return 1;
+}
+
+int CipherInit(void* Ctx, int Encrypt, const unsigned char* Key, size_t KeyLen, const unsigned char* IV, size_t IVLen,
+               const OSSL_PARAM Params[]) {
+  auto Cipher = static_cast<CipherCtx*>(Ctx);
+  if (Key && KeyLen != Cipher->Info->KeyLen) {
+    return 0;
+  }
+
+  if (!CipherSetCtxParams(Ctx, Params)) {
+    return 0;
+  }
+
+  if (IV) {
+    if (!Cipher->Info->AEAD && IVLen != Cipher->Info->IVLen) {
+      return 0;
+    }
+    Cipher->IVLen = IVLen;
+  }
+
+  return fex_crypto_cipher_init(Cipher->Host, Encrypt, Key, IV, Cipher->IVLen);
+}
+
+int CipherEncryptInit(void* Ctx, const unsigned char* Key, size_t KeyLen, const unsigned char* IV, size_t IVLen,
+                      const OSSL_PARAM Params[]) {
+  return CipherInit(Ctx, 1, Key, KeyLen, IV, IVLen, Params);
+}
+
+int CipherDecryptInit(void* Ctx, const unsigned char* Key, size_t KeyLen, const unsigned char* IV, size_t IVLen,
+                      const OSSL_PARAM Params[]) {
+  return CipherInit(Ctx, 0, Key, KeyLen, IV, IVLen, Params);
+}
+
+int CipherUpdate(void* Ctx, unsigned char* Out, size_t* OutLen, size_t OutSize, const unsigned char* In, size_t InLen) {
+  auto Cipher = static_cast<CipherCtx*>(Ctx);
+  // Stream modes produce at most as many bytes as they consume, TLS records are processed in place
+  if (Out && OutSize < InLen) {
+    return 0;
+  }
+
+  return fex_crypto_cipher_update(Cipher->Host, Out, OutLen, In, InLen);
+}
+
+int CipherFinal(void* Ctx, unsigned char* Out, size_t* OutLen, size_t) {
+  return fex_crypto_cipher_final(static_cast<CipherCtx*>(Ctx)->Host, Out, OutLen);
+}
+
+template<size_t Index>
+int CipherGetParams(OSSL_PARAM Params[]) {
+  const auto& Info = Ciphers[Index];
+  return SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_MODE), Info.Mode) &&
+         SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_KEYLEN), Info.KeyLen) &&
+         SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_IVLEN), Info.IVLen) &&
+         SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_BLOCK_SIZE), CipherBlockSize) &&
+         SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_AEAD), Info.AEAD) &&
+         SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_CUSTOM_IV), Info.AEAD) && SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_CTS), 0) &&
+         SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_TLS1_MULTIBLOCK), 0) &&
+         SetNumber(FindParam(Params, OSSL_CIPHER_PARAM_HAS_RAND_KEY), 0);
+}
+
+const OSSL_PARAM CipherGettableParams[] = {
+  {OSSL_CIPHER_PARAM_MODE, OSSL_PARAM_UNSIGNED_INTEGER, nullptr, sizeof(unsigned int), 0},
+  {OSSL_CIPHER_PARAM_KEYLEN, OSSL_PARAM_UNSIGNED_INTEGER, nullptr, sizeof(size_t), 0},
+  {OSSL_CIPHER_PARAM_IVLEN, OSSL_PARAM_UNSIGNED_INTEGER, nullptr, sizeof(size_t), 0},
+  {OSSL_CIPHER_PARAM_BLOCK_SIZE, OSSL_PARAM_UNSIGNED_INTEGER, nullptr, sizeof(size_t), 0},
+  {OSSL_CIPHER_PARAM_AEAD, OSSL_PARAM_INTEGER, nullptr, sizeof(int), 0},
+  {OSSL_CIPHER_PARAM_CUSTOM_IV, OSSL_PARAM_INTEGER, nullptr, sizeof(int), 0},
+  {OSSL_CIPHER_PARAM_CTS, OSSL_PARAM_INTEGER, nullptr, sizeof(int), 0},
+  {OSSL_CIPHER_PARAM_TLS1_MULTIBLOCK, OSSL_PARAM_INTEGER, nullptr, sizeof(int), 0},
+  {OSSL_CIPHER_PARAM_HAS_RAND_KEY, OSSL_PARAM_INTEGER, nullptr, sizeof(int), 0},
+  {nullptr, 0, nullptr, 0, 0},
+};
+
+const OSSL_PARAM CipherGettableCtxParams[] = {
+  {OSSL_CIPHER_PARAM_KEYLEN, OSSL_PARAM_UNSIGNED_INTEGER, nullptr, sizeof(size_t), 0},
+  {OSSL_CIPHER_PARAM_IVLEN, OSSL_PARAM_UNSIGNED_INTEGER, nullptr, sizeof(size_t), 0},
+  {OSSL_CIPHER_PARAM_PADDING, OSSL_PARAM_UNSIGNED_INTEGER, nullptr, sizeof(unsigned int), 0},
+  {OSSL_CIPHER_PARAM_AEAD_TAGLEN, OSSL_PARAM_UNSIGNED_INTEGER, nullptr, sizeof(size_t), 0},
+  {OSSL_CIPHER_PARAM_AEAD_TAG, OSSL_PARAM_OCTET_STRING, nullptr, 0, 0},
+  {OSSL_CIPHER_PARAM_AEAD_TLS1_AAD_PAD, OSSL_PARAM_UNSIGNED_INTEGER, nullptr, sizeof(size_t), 0},
+  {OSSL_CIPHER_PARAM_AEAD_TLS1_GET_IV_GEN, OSSL_PARAM_OCTET_STRING, nullptr, 0, 0},
+  {nullptr, 0, nullptr, 0, 0},
+};
+
+const OSSL_PARAM CipherSettableCtxParams[] = {
+  {OSSL_CIPHER_PARAM_AEAD_IVLEN, OSSL_PARAM_UNSIGNED_INTEGER, nullptr, sizeof(size_t), 0},
+  {OSSL_CIPHER_PARAM_AEAD_TAG, OSSL_PARAM_OCTET_STRING, nullptr, 0, 0},
+  {OSSL_CIPHER_PARAM_AEAD_TLS1_AAD, OSSL_PARAM_OCTET_STRING, nullptr, 0, 0},
+  {OSSL_CIPHER_PARAM_AEAD_TLS1_IV_FIXED, OSSL_PARAM_OCTET_STRING, nullptr, 0, 0},
+  {OSSL_CIPHER_PARAM_AEAD_TLS1_SET_IV_INV, OSSL_PARAM_OCTET_STRING, nullptr, 0, 0},
+  {nullptr, 0, nullptr, 0, 0},
+};
+
+const OSSL_PARAM* CipherGettable(void*) {
+  return CipherGettableParams;
+}
+
+const OSSL_PARAM* CipherGettableCtx(void*, void*) {
+  return CipherGettableCtxParams;
+}
+
+const OSSL_PARAM* CipherSettableCtx(void*, void*) {
+  return CipherSettableCtxParams;
+}
+
+template<size_t Index>
+const OSSL_DISPATCH CipherFunctions[] = {
+  {OSSL_FUNC_CIPHER_NEWCTX, Fn(CipherNewCtx<Index>)},
+  {OSSL_FUNC_CIPHER_DUPCTX, Fn(CipherDupCtx)},
+  {OSSL_FUNC_CIPHER_FREECTX, Fn(CipherFreeCtx)},
+  {OSSL_FUNC_CIPHER_ENCRYPT_INIT, Fn(CipherEncryptInit)},
+  {OSSL_FUNC_CIPHER_DECRYPT_INIT, Fn(CipherDecryptInit)},
+  {OSSL_FUNC_CIPHER_UPDATE, Fn(CipherUpdate)},
+  {OSSL_FUNC_CIPHER_FINAL, Fn(CipherFinal)},
+  {OSSL_FUNC_CIPHER_GET_PARAMS, Fn(CipherGetParams<Index>)},
+  {OSSL_FUNC_CIPHER_GET_CTX_PARAMS, Fn(CipherGetCtxParams)},
+  {OSSL_FUNC_CIPHER_SET_CTX_PARAMS, Fn(CipherSetCtxParams)},
+  {OSSL_FUNC_CIPHER_GETTABLE_PARAMS, Fn(CipherGettable)},
+  {OSSL_FUNC_CIPHER_GETTABLE_CTX_PARAMS, Fn(CipherGettableCtx)},
+  {OSSL_FUNC_CIPHER_SETTABLE_CTX_PARAMS, Fn(CipherSettableCtx)},
+  {0, nullptr},
+};
+
+/// Provider
+constexpr const char* ProviderProperties = "provider=fex";
+
+template<size_t... Indices>
+auto MakeDigestAlgorithms(std::index_sequence<Indices...>) {
+  return std::array<OSSL_ALGORITHM, sizeof...(Indices) + 1> {{
+    {Digests[Indices].Names, ProviderProperties, DigestFunctions<Indices>, nullptr}...,
+    {nullptr, nullptr, nullptr, nullptr},
+  }};
+}
+
+template<size_t... Indices>
+auto MakeCipherAlgorithms(std::index_sequence<Indices...>) {
+  return std::array<OSSL_ALGORITHM, sizeof...(Indices) + 1> {{
+    {Ciphers[Indices].Names, ProviderProperties, CipherFunctions<Indices>, nullptr}...,
+    {nullptr, nullptr, nullptr, nullptr},
+  }};
+}
+
+const auto DigestAlgorithms = MakeDigestAlgorithms(std::make_index_sequence<std::size(Digests)> {});
+const auto CipherAlgorithms = MakeCipherAlgorithms(std::make_index_sequence<std::size(Ciphers)> {});
+
+const OSSL_ALGORITHM* ProviderQuery(void*, int OperationID, int* NoCache) {
+  *NoCache = 0;
+  switch (OperationID) {
+  case OSSL_OP_DIGEST: return DigestAlgorithms.data();
+  case OSSL_OP_CIPHER: return CipherAlgorithms.data();
+  default: return nullptr;
+  }
+}
+
+const OSSL_PARAM ProviderGettableParams[] = {
+  {OSSL_PROV_PARAM_NAME, OSSL_PARAM_UTF8_PTR, nullptr, 0, 0},
+  {OSSL_PROV_PARAM_STATUS, OSSL_PARAM_INTEGER, nullptr, sizeof(int), 0},
+  {nullptr, 0, nullptr, 0, 0},
+};
+
+const OSSL_PARAM* ProviderGettable(void*) {
+  return ProviderGettableParams;
+}
+
+int ProviderGetParams(void*, OSSL_PARAM Params[]) {
+  return SetString(FindParam(Params, OSSL_PROV_PARAM_NAME), "FEX host libcrypto provider") &&
+         SetNumber(FindParam(Params, OSSL_PROV_PARAM_STATUS), 1);
+}
+
+void ProviderTeardown(void*) {}
+
+const OSSL_DISPATCH ProviderFunctions[] = {
+  {OSSL_FUNC_PROVIDER_QUERY_OPERATION, Fn(ProviderQuery)},
+  {OSSL_FUNC_PROVIDER_GETTABLE_PARAMS, Fn(ProviderGettable)},
+  {OSSL_FUNC_PROVIDER_GET_PARAMS, Fn(ProviderGetParams)},
+  {OSSL_FUNC_PROVIDER_TEARDOWN, Fn(ProviderTeardown)},
+  {0, nullptr},
+};
+} // namespace
+
+extern "C" __attribute__((visibility("default"))) int
+OSSL_provider_init(const OSSL_CORE_HANDLE* Handle, const OSSL_DISPATCH*, const OSSL_DISPATCH** Out, void** ProvCtx) {
+  // Let libcrypto fall back to its own implementations if the host side is missing
+  if (!IsLibLoaded("libcrypto")) {
+    return 0;
+  }
+
+  *Out = ProviderFunctions;
+  *ProvCtx = const_cast<OSSL_CORE_HANDLE*>(Handle);
+  return 1;
+}
+
+LOAD_LIB(libcrypto)
@@ -0,0 +1,190 @@
+/*
+$info$
+tags: thunklibs|crypto
+$end_info$
+*/
+
+#include <openssl/evp.h>
+
+#include "common/Host.h"
+#include <dlfcn.h>
+
+#include <algorithm>
+#include <climits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "api.h"
+
+#include "thunkgen_host_libcrypto.inl"
+
+struct fex_crypto_digest {
+  const EVP_MD* MD;
+  EVP_MD_CTX* Ctx;
+};
+
+struct fex_crypto_cipher {
+  const EVP_CIPHER* Cipher;
+  EVP_CIPHER_CTX* Ctx;
+  bool Initialized;
+};
+
+// Algorithms are fetched from a private library context.
+// The default one would load the configuration from OPENSSL_CONF, which is meant for the guest and may load this
+// provider again.
+static OSSL_LIB_CTX* GetLibCtx() {
+  static OSSL_LIB_CTX* LibCtx = OSSL_LIB_CTX_new();
+  return LibCtx;
+}
+
+// Fetching an algorithm walks the provider store, cache them since TLS creates contexts for every connection.
+// Fetched algorithms are never freed, the set of names is fixed by the guest provider.
+template<typename T, auto Fetch>
+static T* FetchCached(const char* Name) {
+  static std::mutex Mutex;
+  static std::unordered_map<std::string, T*> Cache;
+
+  std::scoped_lock lk {Mutex};
+  auto [It, Inserted] = Cache.try_emplace(Name, nullptr);
+  if (Inserted || !It->second) {
+    It->second = Fetch(GetLibCtx(), Name, nullptr);
+  }
+  return It->second;
+}
+
+static fex_crypto_digest* fexfn_impl_libcrypto_fex_crypto_digest_new(const char* Name) {
+  auto MD = FetchCached<EVP_MD, EVP_MD_fetch>(Name);
+  if (!MD) {
+    return nullptr;
+  }
+
+  auto Ctx = EVP_MD_CTX_new();
+  if (!Ctx) {
+    return nullptr;
+  }
+
+  return new fex_crypto_digest {MD, Ctx};
+}
+
+static fex_crypto_digest* fexfn_impl_libcrypto_fex_crypto_digest_dup(const fex_crypto_digest* Digest) {
+  auto Ctx = EVP_MD_CTX_new();
+  if (!Ctx || !EVP_MD_CTX_copy_ex(Ctx, Digest->Ctx)) {
+    EVP_MD_CTX_free(Ctx);
+    return nullptr;
+  }
+
+  return new fex_crypto_digest {Digest->MD, Ctx};
+}
+
+static void fexfn_impl_libcrypto_fex_crypto_digest_free(fex_crypto_digest* Digest) {
+  if (!Digest) {
+    return;
+  }
+
+  EVP_MD_CTX_free(Digest->Ctx);
+  delete Digest;
+}
+
+static int fexfn_impl_libcrypto_fex_crypto_digest_init(fex_crypto_digest* Digest) {
+  return EVP_DigestInit_ex(Digest->Ctx, Digest->MD, nullptr);
+}
+
+static int fexfn_impl_libcrypto_fex_crypto_digest_update(fex_crypto_digest* Digest, const unsigned char* In, size_t InLen) {
+  return EVP_DigestUpdate(Digest->Ctx, In, InLen);
+}
+
+static int fexfn_impl_libcrypto_fex_crypto_digest_final(fex_crypto_digest* Digest, unsigned char* Out, unsigned int* OutLen) {
+  return EVP_DigestFinal_ex(Digest->Ctx, Out, OutLen);
+}
+
+static fex_crypto_cipher* fexfn_impl_libcrypto_fex_crypto_cipher_new(const char* Name) {
+  auto Cipher = FetchCached<EVP_CIPHER, EVP_CIPHER_fetch>(Name);
+  if (!Cipher) {
+    return nullptr;
+  }
+
+  auto Ctx = EVP_CIPHER_CTX_new();
+  if (!Ctx) {
+    return nullptr;
+  }
+
+  return new fex_crypto_cipher {Cipher, Ctx, false};
+}
+
+static fex_crypto_cipher* fexfn_impl_libcrypto_fex_crypto_cipher_dup(const fex_crypto_cipher* Cipher) {
+  auto Ctx = EVP_CIPHER_CTX_new();
+  if (!Ctx || (Cipher->Initialized && !EVP_CIPHER_CTX_copy(Ctx, Cipher->Ctx))) {
+    EVP_CIPHER_CTX_free(Ctx);
+    return nullptr;
+  }
+
+  return new fex_crypto_cipher {Cipher->Cipher, Ctx, Cipher->Initialized};
+}
+
+static void fexfn_impl_libcrypto_fex_crypto_cipher_free(fex_crypto_cipher* Cipher) {
+  if (!Cipher) {
+    return;
+  }
+
+  EVP_CIPHER_CTX_free(Cipher->Ctx);
+  delete Cipher;
+}
+
+static int fexfn_impl_libcrypto_fex_crypto_cipher_init(fex_crypto_cipher* Cipher, int Encrypt, const unsigned char* Key,
+                                                        const unsigned char* IV, size_t IVLen) {
+  if (!Cipher->Initialized) {
+    if (!EVP_CipherInit_ex(Cipher->Ctx, Cipher->Cipher, nullptr, nullptr, nullptr, Encrypt)) {
+      return 0;
+    }
+    Cipher->Initialized = true;
+  }
+
+  // AEAD modes allow non-default IV lengths, which need to be set before the IV itself
+  if (IV && (EVP_CIPHER_get_flags(Cipher->Cipher) & EVP_CIPH_FLAG_AEAD_CIPHER) &&
+      IVLen != static_cast<size_t>(EVP_CIPHER_CTX_get_iv_length(Cipher->Ctx))) {
+    if (IVLen > INT_MAX || EVP_CIPHER_CTX_ctrl(Cipher->Ctx, EVP_CTRL_AEAD_SET_IVLEN, static_cast<int>(IVLen), nullptr) <= 0) {
+      return 0;
+    }
+  }
+
+  return EVP_CipherInit_ex(Cipher->Ctx, nullptr, nullptr, Key, IV, Encrypt);
+}
+
+static int fexfn_impl_libcrypto_fex_crypto_cipher_update(fex_crypto_cipher* Cipher, unsigned char* Out, size_t* OutLen,
+                                                          const unsigned char* In, size_t InLen) {
+  // EVP works on int lengths, split larger requests
+  constexpr size_t MaxChunk = 1U << 30;
+  size_t Total {};
+
+  do {
+    const int Chunk = static_cast<int>(std::min(InLen, MaxChunk));
+    int Written {};
+    if (!EVP_CipherUpdate(Cipher->Ctx, Out ? Out + Total : nullptr, &Written, In, Chunk)) {
+      return 0;
+    }
+
+    Total += Written;
+    In += Chunk;
+    InLen -= Chunk;
+  } while (InLen);
+
+  *OutLen = Total;
+  return 1;
+}
+
+static int fexfn_impl_libcrypto_fex_crypto_cipher_final(fex_crypto_cipher* Cipher, unsigned char* Out, size_t* OutLen) {
+  int Written {};
+  if (!EVP_CipherFinal_ex(Cipher->Ctx, Out, &Written)) {
+    return 0;
+  }
+
+  *OutLen = Written;
+  return 1;
+}
+
+static int fexfn_impl_libcrypto_fex_crypto_cipher_ctrl(fex_crypto_cipher* Cipher, int Type, int Arg, void* Ptr) {
+  return EVP_CIPHER_CTX_ctrl(Cipher->Ctx, Type, Arg, Ptr);
+}
+
+EXPORTS(libcrypto)
@@ -0,0 +1,45 @@
+#include <common/GeneratorInterface.h>
+
+#include "api.h"
+
+template<auto>
+struct fex_gen_config {
+  unsigned version = 3;
+};
+
+template<typename>
+struct fex_gen_type {};
+
+// Host libcrypto objects, the guest provider only ever passes them back
+template<>
+struct fex_gen_type<fex_crypto_digest> : fexgen::opaque_type {};
+template<>
+struct fex_gen_type<fex_crypto_cipher> : fexgen::opaque_type {};
+
+template<>
+struct fex_gen_config<fex_crypto_digest_new> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<fex_crypto_digest_dup> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<fex_crypto_digest_free> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<fex_crypto_digest_init> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<fex_crypto_digest_update> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<fex_crypto_digest_final> : fexgen::custom_host_impl {};
+
+template<>
+struct fex_gen_config<fex_crypto_cipher_new> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<fex_crypto_cipher_dup> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<fex_crypto_cipher_free> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<fex_crypto_cipher_init> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<fex_crypto_cipher_update> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<fex_crypto_cipher_final> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<fex_crypto_cipher_ctrl> : fexgen::custom_host_impl {};
@@ -106,4 +106,12 @@ struct TestStruct2 {
 };
 
 int ReadData1(TestStruct1*, int depth);
+
+
+/// Interfaces used to measure the cost of the guest->host transition
+
+void EmptyFunction();
+
+// Same as EmptyFunction, but annotated with fexgen::leaf
+void EmptyLeafFunction();
 }
@@ -83,4 +83,8 @@ int ReadData1(TestStruct1* data, int depth) {
   }
 }
 
+void EmptyFunction() {}
+
+void EmptyLeafFunction() {}
+
 } // extern "C"
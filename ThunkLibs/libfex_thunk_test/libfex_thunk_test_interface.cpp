@@ -63,3 +63,8 @@ struct fex_gen_config<&TestStruct2::Next> : fexgen::custom_repack {};
 
 template<>
 struct fex_gen_config<ReadData1> {};
+
+template<>
+struct fex_gen_config<EmptyFunction> {};
+template<>
+struct fex_gen_config<EmptyLeafFunction> : fexgen::leaf {};
@@ -0,0 +1,128 @@
+/*
+$info$
+tags: thunklibs|lzma
+$end_info$
+*/
+
+#include <lzma.h>
+
+#include <stdlib.h>
+#include <cstring>
+
+#include "common/Guest.h"
+
+#include "thunkgen_guest_liblzma.inl"
+
+extern "C" {
+void FEX_malloc_free_on_host(void* Ptr) {
+  struct {
+    void* p;
+  } args;
+  args.p = Ptr;
+  fexthunks_liblzma_FEX_free_on_host(&args);
+}
+
+size_t FEX_malloc_usable_size(void* Ptr) {
+  struct {
+    void* p;
+    size_t rv;
+  } args;
+  args.p = Ptr;
+  fexthunks_liblzma_FEX_usable_size(&args);
+  return args.rv;
+}
+}
+
+// Moves a host allocation to guest memory, so that the caller can release it with its own allocator
+static void* CopyToGuest(void* HostPtr, const lzma_allocator* allocator) {
+  // Usable size, this will be a bit wasteful but the size isn't known otherwise
+  size_t Usable = FEX_malloc_usable_size(HostPtr);
+
+  void* NewPtr = allocator && allocator->alloc ? allocator->alloc(allocator->opaque, 1, Usable) : malloc(Usable);
+  if (NewPtr) {
+    memcpy(NewPtr, HostPtr, Usable);
+  }
+
+  FEX_malloc_free_on_host(HostPtr);
+  return NewPtr;
+}
+
+static void FreeOnGuest(void* Ptr, const lzma_allocator* allocator) {
+  if (allocator && allocator->free) {
+    allocator->free(allocator->opaque, Ptr);
+  } else {
+    free(Ptr);
+  }
+}
+
+extern "C" {
+// Filter options handed out by the thunks always live in guest memory, so they are freed here
+void lzma_filters_free(lzma_filter* filters, const lzma_allocator* allocator) {
+  if (!filters) {
+    return;
+  }
+
+  for (size_t i = 0; i < LZMA_FILTERS_MAX && filters[i].id != LZMA_VLI_UNKNOWN; ++i) {
+    FreeOnGuest(filters[i].options, allocator);
+    filters[i].options = nullptr;
+    filters[i].id = LZMA_VLI_UNKNOWN;
+  }
+}
+
+lzma_ret lzma_properties_decode(lzma_filter* filter, const lzma_allocator* allocator, const uint8_t* props, size_t props_size) {
+  auto ret = fexfn_pack_lzma_properties_decode(filter, nullptr, props, props_size);
+  if (ret == LZMA_OK && filter->options) {
+    filter->options = CopyToGuest(filter->options, allocator);
+    if (!filter->options) {
+      return LZMA_MEM_ERROR;
+    }
+  }
+
+  return ret;
+}
+
+lzma_ret lzma_block_header_decode(lzma_block* block, const lzma_allocator* allocator, const uint8_t* in) {
+  auto ret = fexfn_pack_lzma_block_header_decode(block, nullptr, in);
+  if (ret != LZMA_OK) {
+    return ret;
+  }
+
+  bool CopyFailed = false;
+  for (size_t i = 0; i < LZMA_FILTERS_MAX && block->filters[i].id != LZMA_VLI_UNKNOWN; ++i) {
+    if (!block->filters[i].options) {
+      continue;
+    }
+
+    if (CopyFailed) {
+      FEX_malloc_free_on_host(block->filters[i].options);
+      block->filters[i].options = nullptr;
+      continue;
+    }
+
+    block->filters[i].options = CopyToGuest(block->filters[i].options, allocator);
+    CopyFailed = !block->filters[i].options;
+  }
+
+  if (CopyFailed) {
+    // Same state liblzma leaves the filters in on failure
+    lzma_filters_free(block->filters, allocator);
+    return LZMA_MEM_ERROR;
+  }
+
+  return ret;
+}
+
+lzma_ret lzma_str_from_filters(char** str, const lzma_filter* filters, uint32_t flags, const lzma_allocator* allocator) {
+  auto ret = fexfn_pack_lzma_str_from_filters(str, filters, flags, nullptr);
+  if (ret == LZMA_OK) {
+    *str = static_cast<char*>(CopyToGuest(*str, allocator));
+    if (!*str) {
+      return LZMA_MEM_ERROR;
+    }
+  }
+
+  return ret;
+}
+}
+
+LOAD_LIB(liblzma)
@@ -0,0 +1,85 @@
+/*
+$info$
+tags: thunklibs|lzma
+$end_info$
+*/
+
+#include <lzma.h>
+
+#include "common/Host.h"
+#include <dlfcn.h>
+#include <malloc.h>
+
+#include "thunkgen_host_liblzma.inl"
+
+#define LDR_PTR(fn) fexldr_ptr_liblzma_##fn
+
+static size_t fexfn_impl_liblzma_FEX_usable_size(void* a_0) {
+  return malloc_usable_size(a_0);
+}
+
+static void fexfn_impl_liblzma_FEX_free_on_host(void* a_0) {
+  free(a_0);
+}
+
+// Guest allocation callbacks can't be invoked from the host, so liblzma always uses the host allocator
+static auto fexfn_impl_liblzma_lzma_index_end(lzma_index* i, const lzma_allocator*) -> void {
+  LDR_PTR(lzma_index_end)(i, nullptr);
+}
+
+static auto fexfn_impl_liblzma_lzma_block_header_decode(lzma_block* block, const lzma_allocator*, const uint8_t* in) -> lzma_ret {
+  return LDR_PTR(lzma_block_header_decode)(block, nullptr, in);
+}
+
+static auto fexfn_impl_liblzma_lzma_easy_buffer_encode(uint32_t preset, lzma_check check, const lzma_allocator*, const uint8_t* in,
+                                                       size_t in_size, uint8_t* out, size_t* out_pos, size_t out_size) -> lzma_ret {
+  return LDR_PTR(lzma_easy_buffer_encode)(preset, check, nullptr, in, in_size, out, out_pos, out_size);
+}
+
+static auto fexfn_impl_liblzma_lzma_stream_buffer_encode(lzma_filter* filters, lzma_check check, const lzma_allocator*, const uint8_t* in,
+                                                         size_t in_size, uint8_t* out, size_t* out_pos, size_t out_size) -> lzma_ret {
+  return LDR_PTR(lzma_stream_buffer_encode)(filters, check, nullptr, in, in_size, out, out_pos, out_size);
+}
+
+static auto fexfn_impl_liblzma_lzma_stream_buffer_decode(uint64_t* memlimit, uint32_t flags, const lzma_allocator*, const uint8_t* in,
+                                                         size_t* in_pos, size_t in_size, uint8_t* out, size_t* out_pos, size_t out_size)
+  -> lzma_ret {
+  return LDR_PTR(lzma_stream_buffer_decode)(memlimit, flags, nullptr, in, in_pos, in_size, out, out_pos, out_size);
+}
+
+static auto fexfn_impl_liblzma_lzma_raw_buffer_encode(const lzma_filter* filters, const lzma_allocator*, const uint8_t* in, size_t in_size,
+                                                      uint8_t* out, size_t* out_pos, size_t out_size) -> lzma_ret {
+  return LDR_PTR(lzma_raw_buffer_encode)(filters, nullptr, in, in_size, out, out_pos, out_size);
+}
+
+static auto fexfn_impl_liblzma_lzma_raw_buffer_decode(const lzma_filter* filters, const lzma_allocator*, const uint8_t* in, size_t* in_pos,
+                                                      size_t in_size, uint8_t* out, size_t* out_pos, size_t out_size) -> lzma_ret {
+  return LDR_PTR(lzma_raw_buffer_decode)(filters, nullptr, in, in_pos, in_size, out, out_pos, out_size);
+}
+
+// Stream coders allocate through lzma_stream::allocator until lzma_end, it's reset before initializing them
+#define STREAM_INIT(fn, Params, Args)                    \
+  static auto fexfn_impl_liblzma_##fn Params->lzma_ret { \
+    strm->allocator = nullptr;                           \
+    return LDR_PTR(fn) Args;                             \
+  }
+
+STREAM_INIT(lzma_easy_encoder, (lzma_stream * strm, uint32_t preset, lzma_check check), (strm, preset, check))
+STREAM_INIT(lzma_stream_encoder, (lzma_stream * strm, const lzma_filter* filters, lzma_check check), (strm, filters, check))
+STREAM_INIT(lzma_stream_encoder_mt, (lzma_stream * strm, const lzma_mt* options), (strm, options))
+STREAM_INIT(lzma_alone_encoder, (lzma_stream * strm, const lzma_options_lzma* options), (strm, options))
+STREAM_INIT(lzma_raw_encoder, (lzma_stream * strm, const lzma_filter* filters), (strm, filters))
+STREAM_INIT(lzma_stream_decoder, (lzma_stream * strm, uint64_t memlimit, uint32_t flags), (strm, memlimit, flags))
+STREAM_INIT(lzma_stream_decoder_mt, (lzma_stream * strm, const lzma_mt* options), (strm, options))
+STREAM_INIT(lzma_auto_decoder, (lzma_stream * strm, uint64_t memlimit, uint32_t flags), (strm, memlimit, flags))
+STREAM_INIT(lzma_alone_decoder, (lzma_stream * strm, uint64_t memlimit), (strm, memlimit))
+STREAM_INIT(lzma_lzip_decoder, (lzma_stream * strm, uint64_t memlimit, uint32_t flags), (strm, memlimit, flags))
+STREAM_INIT(lzma_raw_decoder, (lzma_stream * strm, const lzma_filter* filters), (strm, filters))
+STREAM_INIT(lzma_file_info_decoder, (lzma_stream * strm, lzma_index** dest_index, uint64_t memlimit, uint64_t file_size),
+            (strm, dest_index, memlimit, file_size))
+STREAM_INIT(lzma_index_encoder, (lzma_stream * strm, const lzma_index* i), (strm, i))
+STREAM_INIT(lzma_index_decoder, (lzma_stream * strm, lzma_index** i, uint64_t memlimit), (strm, i, memlimit))
+
+#undef STREAM_INIT
+
+EXPORTS(liblzma)
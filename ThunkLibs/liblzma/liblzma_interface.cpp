@@ -0,0 +1,232 @@
+#include <common/GeneratorInterface.h>
+
+#include <lzma.h>
+
+template<auto>
+struct fex_gen_config {
+  unsigned version = 5;
+};
+
+template<typename>
+struct fex_gen_type {};
+
+// liblzma's public structs have the same data layout on x86-64 and AArch64
+template<>
+struct fex_gen_type<lzma_stream> : fexgen::assume_compatible_data_layout {};
+template<>
+struct fex_gen_type<lzma_filter> : fexgen::assume_compatible_data_layout {};
+template<>
+struct fex_gen_type<lzma_options_lzma> : fexgen::assume_compatible_data_layout {};
+template<>
+struct fex_gen_type<lzma_mt> : fexgen::assume_compatible_data_layout {};
+template<>
+struct fex_gen_type<lzma_block> : fexgen::assume_compatible_data_layout {};
+template<>
+struct fex_gen_type<lzma_stream_flags> : fexgen::assume_compatible_data_layout {};
+template<>
+struct fex_gen_type<lzma_index_iter> : fexgen::assume_compatible_data_layout {};
+
+// Only ever accessed through liblzma
+template<>
+struct fex_gen_type<lzma_index> : fexgen::opaque_type {};
+template<>
+struct fex_gen_type<lzma_internal> : fexgen::opaque_type {};
+
+// Guest allocation callbacks can't be called from the host.
+// Functions that take an allocator have custom host implementations that make liblzma use the host allocator instead.
+template<>
+struct fex_gen_type<lzma_allocator> : fexgen::opaque_type {};
+
+size_t FEX_usable_size(void*);
+void FEX_free_on_host(void*);
+
+template<>
+struct fex_gen_config<FEX_usable_size> : fexgen::custom_host_impl, fexgen::custom_guest_entrypoint {};
+template<>
+struct fex_gen_config<FEX_free_on_host> : fexgen::custom_host_impl, fexgen::custom_guest_entrypoint {};
+
+// Version and hardware information
+template<>
+struct fex_gen_config<lzma_version_number> {};
+template<>
+struct fex_gen_config<lzma_version_string> {};
+template<>
+struct fex_gen_config<lzma_physmem> {};
+template<>
+struct fex_gen_config<lzma_cputhreads> {};
+
+// Coding
+template<>
+struct fex_gen_config<lzma_code> {};
+template<>
+struct fex_gen_config<lzma_end> {};
+template<>
+struct fex_gen_config<lzma_get_progress> {};
+template<>
+struct fex_gen_config<lzma_memusage> {};
+template<>
+struct fex_gen_config<lzma_memlimit_get> {};
+template<>
+struct fex_gen_config<lzma_memlimit_set> {};
+template<>
+struct fex_gen_config<lzma_get_check> {};
+
+// Integrity checks
+template<>
+struct fex_gen_config<lzma_check_is_supported> {};
+template<>
+struct fex_gen_config<lzma_check_size> {};
+template<>
+struct fex_gen_config<lzma_crc32> {};
+template<>
+struct fex_gen_config<lzma_crc64> {};
+
+// Filters
+template<>
+struct fex_gen_config<lzma_lzma_preset> {};
+template<>
+struct fex_gen_config<lzma_filter_encoder_is_supported> {};
+template<>
+struct fex_gen_config<lzma_filter_decoder_is_supported> {};
+template<>
+struct fex_gen_config<lzma_mf_is_supported> {};
+template<>
+struct fex_gen_config<lzma_mode_is_supported> {};
+template<>
+struct fex_gen_config<lzma_filters_update> {};
+template<>
+struct fex_gen_config<lzma_raw_encoder_memusage> {};
+template<>
+struct fex_gen_config<lzma_raw_decoder_memusage> {};
+template<>
+struct fex_gen_config<lzma_properties_size> {};
+template<>
+struct fex_gen_config<lzma_properties_encode> {};
+
+// Filter options are allocated on the host and copied to guest memory, lzma_filters_free is implemented on the guest
+template<>
+struct fex_gen_config<lzma_properties_decode> : fexgen::custom_guest_entrypoint {};
+template<>
+struct fex_gen_config<lzma_str_from_filters> : fexgen::custom_guest_entrypoint {};
+
+// Stream encoders and decoders, these reset lzma_stream::allocator
+template<>
+struct fex_gen_config<lzma_easy_encoder> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_stream_encoder> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_stream_encoder_mt> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_alone_encoder> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_raw_encoder> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_stream_decoder> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_stream_decoder_mt> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_auto_decoder> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_alone_decoder> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_lzip_decoder> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_raw_decoder> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_file_info_decoder> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_index_encoder> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_index_decoder> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_easy_encoder_memusage> {};
+template<>
+struct fex_gen_config<lzma_easy_decoder_memusage> {};
+template<>
+struct fex_gen_config<lzma_stream_encoder_mt_memusage> {};
+
+// Single-call buffer encoders and decoders
+template<>
+struct fex_gen_config<lzma_stream_buffer_bound> {};
+template<>
+struct fex_gen_config<lzma_easy_buffer_encode> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_stream_buffer_encode> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_stream_buffer_decode> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_raw_buffer_encode> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<lzma_raw_buffer_decode> : fexgen::custom_host_impl {};
+
+// .xz container
+template<>
+struct fex_gen_config<lzma_stream_header_encode> {};
+template<>
+struct fex_gen_config<lzma_stream_header_decode> {};
+template<>
+struct fex_gen_config<lzma_stream_footer_encode> {};
+template<>
+struct fex_gen_config<lzma_stream_footer_decode> {};
+template<>
+struct fex_gen_config<lzma_stream_flags_compare> {};
+template<>
+struct fex_gen_config<lzma_block_header_size> {};
+template<>
+struct fex_gen_config<lzma_block_header_encode> {};
+template<>
+struct fex_gen_config<lzma_block_compressed_size> {};
+template<>
+struct fex_gen_config<lzma_block_unpadded_size> {};
+template<>
+struct fex_gen_config<lzma_block_total_size> {};
+template<>
+struct fex_gen_config<lzma_vli_encode> {};
+template<>
+struct fex_gen_config<lzma_vli_decode> {};
+template<>
+struct fex_gen_config<lzma_vli_size> {};
+template<>
+struct fex_gen_config<lzma_block_header_decode> : fexgen::custom_host_impl, fexgen::custom_guest_entrypoint {};
+
+// .xz index
+template<>
+struct fex_gen_config<lzma_index_memusage> {};
+template<>
+struct fex_gen_config<lzma_index_memused> {};
+template<>
+struct fex_gen_config<lzma_index_block_count> {};
+template<>
+struct fex_gen_config<lzma_index_stream_count> {};
+template<>
+struct fex_gen_config<lzma_index_size> {};
+template<>
+struct fex_gen_config<lzma_index_stream_size> {};
+template<>
+struct fex_gen_config<lzma_index_total_size> {};
+template<>
+struct fex_gen_config<lzma_index_file_size> {};
+template<>
+struct fex_gen_config<lzma_index_uncompressed_size> {};
+template<>
+struct fex_gen_config<lzma_index_checks> {};
+template<>
+struct fex_gen_config<lzma_index_stream_flags> {};
+template<>
+struct fex_gen_config<lzma_index_stream_padding> {};
+template<>
+struct fex_gen_config<lzma_index_iter_init> {};
+template<>
+struct fex_gen_config<lzma_index_iter_rewind> {};
+template<>
+struct fex_gen_config<lzma_index_iter_next> {};
+template<>
+struct fex_gen_config<lzma_index_iter_locate> {};
+template<>
+struct fex_gen_config<lzma_index_end> : fexgen::custom_host_impl {};
+
+// Not thunked:
+// - lzma_filters_copy, lzma_str_to_filters and lzma_str_list_filters hand out allocations that callers may free with
+//   their own allocator.
+// - Index construction (lzma_index_init/append/cat/dup/buffer_*) and lzma_index_hash_*.
+// - Block, MicroLZMA and filter flags encoders and decoders.
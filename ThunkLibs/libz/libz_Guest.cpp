@@ -0,0 +1,42 @@
+/*
+$info$
+tags: thunklibs|zlib
+$end_info$
+*/
+
+#include <zlib.h>
+// zlib.h shadows the gzgetc function with a macro
+#undef gzgetc
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common/Guest.h"
+
+#include "thunkgen_guest_libz.inl"
+
+extern "C" {
+// Variadic functions can't be thunked, format on the guest side and hand the result to gzwrite.
+int gzvprintf(gzFile file, const char* format, va_list va) {
+  char* Buffer {};
+  int Length = vasprintf(&Buffer, format, va);
+  if (Length < 0) {
+    return Z_MEM_ERROR;
+  }
+
+  int Result = Length ? gzwrite(file, Buffer, Length) : 0;
+  free(Buffer);
+  return Result;
+}
+
+int gzprintf(gzFile file, const char* format, ...) {
+  va_list va;
+  va_start(va, format);
+  int Result = gzvprintf(file, format, va);
+  va_end(va);
+  return Result;
+}
+}
+
+LOAD_LIB(libz)
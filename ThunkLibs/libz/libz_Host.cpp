@@ -0,0 +1,42 @@
+/*
+$info$
+tags: thunklibs|zlib
+$end_info$
+*/
+
+#include <zlib.h>
+
+#include "common/Host.h"
+#include <dlfcn.h>
+
+#include "thunkgen_host_libz.inl"
+
+// Guest allocation callbacks can't be invoked from the host, so streams always use the host allocator.
+static void ResetAllocator(z_streamp strm) {
+  strm->zalloc = Z_NULL;
+  strm->zfree = Z_NULL;
+  strm->opaque = Z_NULL;
+}
+
+static auto fexfn_impl_libz_deflateInit_(z_streamp strm, int level, const char* version, int stream_size) -> int {
+  ResetAllocator(strm);
+  return fexldr_ptr_libz_deflateInit_(strm, level, version, stream_size);
+}
+
+static auto fexfn_impl_libz_deflateInit2_(z_streamp strm, int level, int method, int windowBits, int memLevel, int strategy,
+                                          const char* version, int stream_size) -> int {
+  ResetAllocator(strm);
+  return fexldr_ptr_libz_deflateInit2_(strm, level, method, windowBits, memLevel, strategy, version, stream_size);
+}
+
+static auto fexfn_impl_libz_inflateInit_(z_streamp strm, const char* version, int stream_size) -> int {
+  ResetAllocator(strm);
+  return fexldr_ptr_libz_inflateInit_(strm, version, stream_size);
+}
+
+static auto fexfn_impl_libz_inflateInit2_(z_streamp strm, int windowBits, const char* version, int stream_size) -> int {
+  ResetAllocator(strm);
+  return fexldr_ptr_libz_inflateInit2_(strm, windowBits, version, stream_size);
+}
+
+EXPORTS(libz)
@@ -0,0 +1,200 @@
+#include <common/GeneratorInterface.h>
+
+#include <zlib.h>
+
+template<auto>
+struct fex_gen_config {
+  unsigned version = 1;
+};
+
+template<typename>
+struct fex_gen_type {};
+
+// zlib's public structs have the same data layout on x86-64 and AArch64.
+// Streams must never be repacked since zlib checks that the internal state points back to the stream it belongs to.
+template<>
+struct fex_gen_type<z_stream_s> : fexgen::assume_compatible_data_layout {};
+template<>
+struct fex_gen_type<gz_header_s> : fexgen::assume_compatible_data_layout {};
+template<>
+struct fex_gen_type<gzFile_s> : fexgen::assume_compatible_data_layout {};
+template<>
+struct fex_gen_type<internal_state> : fexgen::opaque_type {};
+
+// Guest allocation callbacks can't be called from the host, these make zlib use the host allocator instead.
+template<>
+struct fex_gen_config<deflateInit_> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<deflateInit2_> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<inflateInit_> : fexgen::custom_host_impl {};
+template<>
+struct fex_gen_config<inflateInit2_> : fexgen::custom_host_impl {};
+
+// Basic and advanced functions
+template<>
+struct fex_gen_config<zlibVersion> {};
+template<>
+struct fex_gen_config<zlibCompileFlags> {};
+template<>
+struct fex_gen_config<zError> {};
+template<>
+struct fex_gen_config<deflate> {};
+template<>
+struct fex_gen_config<deflateEnd> {};
+template<>
+struct fex_gen_config<deflateSetDictionary> {};
+template<>
+struct fex_gen_config<deflateGetDictionary> {};
+template<>
+struct fex_gen_config<deflateCopy> {};
+template<>
+struct fex_gen_config<deflateReset> {};
+template<>
+struct fex_gen_config<deflateResetKeep> {};
+template<>
+struct fex_gen_config<deflateParams> {};
+template<>
+struct fex_gen_config<deflateTune> {};
+template<>
+struct fex_gen_config<deflateBound> {};
+template<>
+struct fex_gen_config<deflatePending> {};
+template<>
+struct fex_gen_config<deflatePrime> {};
+template<>
+struct fex_gen_config<deflateSetHeader> {};
+template<>
+struct fex_gen_config<inflate> {};
+template<>
+struct fex_gen_config<inflateEnd> {};
+template<>
+struct fex_gen_config<inflateSetDictionary> {};
+template<>
+struct fex_gen_config<inflateGetDictionary> {};
+template<>
+struct fex_gen_config<inflateSync> {};
+template<>
+struct fex_gen_config<inflateCopy> {};
+template<>
+struct fex_gen_config<inflateReset> {};
+template<>
+struct fex_gen_config<inflateReset2> {};
+template<>
+struct fex_gen_config<inflateResetKeep> {};
+template<>
+struct fex_gen_config<inflatePrime> {};
+template<>
+struct fex_gen_config<inflateMark> {};
+template<>
+struct fex_gen_config<inflateGetHeader> {};
+template<>
+struct fex_gen_config<inflateSyncPoint> {};
+template<>
+struct fex_gen_config<inflateUndermine> {};
+template<>
+struct fex_gen_config<inflateValidate> {};
+template<>
+struct fex_gen_config<inflateCodesUsed> {};
+
+// Utility functions
+template<>
+struct fex_gen_config<compress> {};
+template<>
+struct fex_gen_config<compress2> {};
+template<>
+struct fex_gen_config<compressBound> {};
+template<>
+struct fex_gen_config<uncompress> {};
+template<>
+struct fex_gen_config<uncompress2> {};
+
+// Checksums
+template<>
+struct fex_gen_config<adler32> {};
+template<>
+struct fex_gen_config<adler32_z> {};
+template<>
+struct fex_gen_config<adler32_combine> {};
+template<>
+struct fex_gen_config<crc32> {};
+template<>
+struct fex_gen_config<crc32_z> {};
+template<>
+struct fex_gen_config<crc32_combine> {};
+template<>
+struct fex_gen_config<get_crc_table> {};
+
+// gzip file access
+template<>
+struct fex_gen_config<gzdopen> {};
+template<>
+struct fex_gen_config<gzopen> {};
+template<>
+struct fex_gen_config<gzbuffer> {};
+template<>
+struct fex_gen_config<gzsetparams> {};
+template<>
+struct fex_gen_config<gzread> {};
+template<>
+struct fex_gen_config<gzfread> {};
+template<>
+struct fex_gen_config<gzwrite> {};
+template<>
+struct fex_gen_config<gzfwrite> {};
+template<>
+struct fex_gen_config<gzputs> {};
+template<>
+struct fex_gen_config<gzgets> {};
+template<>
+struct fex_gen_config<gzputc> {};
+template<>
+struct fex_gen_config<gzgetc> {};
+template<>
+struct fex_gen_config<gzgetc_> {};
+template<>
+struct fex_gen_config<gzungetc> {};
+template<>
+struct fex_gen_config<gzflush> {};
+template<>
+struct fex_gen_config<gzseek> {};
+template<>
+struct fex_gen_config<gzrewind> {};
+template<>
+struct fex_gen_config<gztell> {};
+template<>
+struct fex_gen_config<gzoffset> {};
+template<>
+struct fex_gen_config<gzeof> {};
+template<>
+struct fex_gen_config<gzdirect> {};
+template<>
+struct fex_gen_config<gzclose> {};
+template<>
+struct fex_gen_config<gzclose_r> {};
+template<>
+struct fex_gen_config<gzclose_w> {};
+template<>
+struct fex_gen_config<gzerror> {};
+template<>
+struct fex_gen_config<gzclearerr> {};
+
+// Large file variants, the regular names are aliased to these when _FILE_OFFSET_BITS is 64
+#if defined(Z_LARGE64) && !defined(Z_WANT64)
+template<>
+struct fex_gen_config<gzopen64> {};
+template<>
+struct fex_gen_config<gzseek64> {};
+template<>
+struct fex_gen_config<gztell64> {};
+template<>
+struct fex_gen_config<gzoffset64> {};
+template<>
+struct fex_gen_config<adler32_combine64> {};
+template<>
+struct fex_gen_config<crc32_combine64> {};
+#endif
+
+// Not thunked:
+// - gzprintf/gzvprintf are variadic, the guest library implements them on top of gzwrite.
+// - inflateBackInit_/inflateBack/inflateBackEnd call two guest callbacks per invocation.
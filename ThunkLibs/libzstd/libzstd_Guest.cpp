@@ -0,0 +1,13 @@
+/*
+$info$
+tags: thunklibs|zstd
+$end_info$
+*/
+
+#include <zstd.h>
+
+#include "common/Guest.h"
+
+#include "thunkgen_guest_libzstd.inl"
+
+LOAD_LIB(libzstd)
@@ -0,0 +1,14 @@
+/*
+$info$
+tags: thunklibs|zstd
+$end_info$
+*/
+
+#include <zstd.h>
+
+#include "common/Host.h"
+#include <dlfcn.h>
+
+#include "thunkgen_host_libzstd.inl"
+
+EXPORTS(libzstd)
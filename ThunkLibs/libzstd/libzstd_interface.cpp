@@ -0,0 +1,175 @@
+#include <common/GeneratorInterface.h>
+
+#include <zstd.h>
+
+template<auto>
+struct fex_gen_config {
+  unsigned version = 1;
+};
+
+template<typename>
+struct fex_gen_type {};
+
+// Contexts and dictionaries are only ever accessed through libzstd
+template<>
+struct fex_gen_type<ZSTD_CCtx_s> : fexgen::opaque_type {};
+template<>
+struct fex_gen_type<ZSTD_DCtx_s> : fexgen::opaque_type {};
+template<>
+struct fex_gen_type<ZSTD_CDict_s> : fexgen::opaque_type {};
+template<>
+struct fex_gen_type<ZSTD_DDict_s> : fexgen::opaque_type {};
+
+template<>
+struct fex_gen_type<ZSTD_inBuffer_s> : fexgen::assume_compatible_data_layout {};
+template<>
+struct fex_gen_type<ZSTD_outBuffer_s> : fexgen::assume_compatible_data_layout {};
+template<>
+struct fex_gen_type<ZSTD_bounds> : fexgen::assume_compatible_data_layout {};
+
+// Only the stable API is thunked.
+// The ZSTD_STATIC_LINKING_ONLY API isn't ABI stable between libzstd releases, so guest and host library could disagree.
+
+// Simple API
+template<>
+struct fex_gen_config<ZSTD_versionNumber> {};
+template<>
+struct fex_gen_config<ZSTD_versionString> {};
+template<>
+struct fex_gen_config<ZSTD_compress> {};
+template<>
+struct fex_gen_config<ZSTD_decompress> {};
+template<>
+struct fex_gen_config<ZSTD_getFrameContentSize> {};
+template<>
+struct fex_gen_config<ZSTD_getDecompressedSize> {};
+template<>
+struct fex_gen_config<ZSTD_findFrameCompressedSize> {};
+template<>
+struct fex_gen_config<ZSTD_compressBound> {};
+template<>
+struct fex_gen_config<ZSTD_isError> {};
+template<>
+struct fex_gen_config<ZSTD_getErrorName> {};
+template<>
+struct fex_gen_config<ZSTD_minCLevel> {};
+template<>
+struct fex_gen_config<ZSTD_maxCLevel> {};
+template<>
+struct fex_gen_config<ZSTD_defaultCLevel> {};
+
+// Explicit context
+template<>
+struct fex_gen_config<ZSTD_createCCtx> {};
+template<>
+struct fex_gen_config<ZSTD_freeCCtx> {};
+template<>
+struct fex_gen_config<ZSTD_compressCCtx> {};
+template<>
+struct fex_gen_config<ZSTD_createDCtx> {};
+template<>
+struct fex_gen_config<ZSTD_freeDCtx> {};
+template<>
+struct fex_gen_config<ZSTD_decompressDCtx> {};
+
+// Advanced compression and decompression parameters
+template<>
+struct fex_gen_config<ZSTD_cParam_getBounds> {};
+template<>
+struct fex_gen_config<ZSTD_CCtx_setParameter> {};
+template<>
+struct fex_gen_config<ZSTD_CCtx_setPledgedSrcSize> {};
+template<>
+struct fex_gen_config<ZSTD_CCtx_reset> {};
+template<>
+struct fex_gen_config<ZSTD_compress2> {};
+template<>
+struct fex_gen_config<ZSTD_dParam_getBounds> {};
+template<>
+struct fex_gen_config<ZSTD_DCtx_setParameter> {};
+template<>
+struct fex_gen_config<ZSTD_DCtx_reset> {};
+
+// Streaming
+template<>
+struct fex_gen_config<ZSTD_createCStream> {};
+template<>
+struct fex_gen_config<ZSTD_freeCStream> {};
+template<>
+struct fex_gen_config<ZSTD_compressStream2> {};
+template<>
+struct fex_gen_config<ZSTD_CStreamInSize> {};
+template<>
+struct fex_gen_config<ZSTD_CStreamOutSize> {};
+template<>
+struct fex_gen_config<ZSTD_initCStream> {};
+template<>
+struct fex_gen_config<ZSTD_compressStream> {};
+template<>
+struct fex_gen_config<ZSTD_flushStream> {};
+template<>
+struct fex_gen_config<ZSTD_endStream> {};
+template<>
+struct fex_gen_config<ZSTD_createDStream> {};
+template<>
+struct fex_gen_config<ZSTD_freeDStream> {};
+template<>
+struct fex_gen_config<ZSTD_initDStream> {};
+template<>
+struct fex_gen_config<ZSTD_decompressStream> {};
+template<>
+struct fex_gen_config<ZSTD_DStreamInSize> {};
+template<>
+struct fex_gen_config<ZSTD_DStreamOutSize> {};
+
+// Dictionaries
+template<>
+struct fex_gen_config<ZSTD_compress_usingDict> {};
+template<>
+struct fex_gen_config<ZSTD_decompress_usingDict> {};
+template<>
+struct fex_gen_config<ZSTD_createCDict> {};
+template<>
+struct fex_gen_config<ZSTD_freeCDict> {};
+template<>
+struct fex_gen_config<ZSTD_compress_usingCDict> {};
+template<>
+struct fex_gen_config<ZSTD_createDDict> {};
+template<>
+struct fex_gen_config<ZSTD_freeDDict> {};
+template<>
+struct fex_gen_config<ZSTD_decompress_usingDDict> {};
+template<>
+struct fex_gen_config<ZSTD_getDictID_fromDict> {};
+template<>
+struct fex_gen_config<ZSTD_getDictID_fromCDict> {};
+template<>
+struct fex_gen_config<ZSTD_getDictID_fromDDict> {};
+template<>
+struct fex_gen_config<ZSTD_getDictID_fromFrame> {};
+template<>
+struct fex_gen_config<ZSTD_CCtx_loadDictionary> {};
+template<>
+struct fex_gen_config<ZSTD_CCtx_refCDict> {};
+template<>
+struct fex_gen_config<ZSTD_CCtx_refPrefix> {};
+template<>
+struct fex_gen_config<ZSTD_DCtx_loadDictionary> {};
+template<>
+struct fex_gen_config<ZSTD_DCtx_refDDict> {};
+template<>
+struct fex_gen_config<ZSTD_DCtx_refPrefix> {};
+
+// Memory usage
+template<>
+struct fex_gen_config<ZSTD_sizeof_CCtx> {};
+template<>
+struct fex_gen_config<ZSTD_sizeof_DCtx> {};
+template<>
+struct fex_gen_config<ZSTD_sizeof_CStream> {};
+template<>
+struct fex_gen_config<ZSTD_sizeof_DStream> {};
+template<>
+struct fex_gen_config<ZSTD_sizeof_CDict> {};
+template<>
+struct fex_gen_config<ZSTD_sizeof_DDict> {};
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: MIT
+#include <catch2/catch_all.hpp>
+#include <Common/PageRangeBitmap.h>
+
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace {
+// Same size as the 32-bit guest allocator uses.
+constexpr size_t GUEST_PAGES = 0x10'0000;
+
+// Small enough for the reference searches to stay quick, large enough for multiple summary words.
+constexpr size_t TEST_PAGES = 0x4000;
+
+struct Reference {
+  std::vector<bool> Used = std::vector<bool>(TEST_PAGES);
+
+  bool IsFree(uint64_t Page, uint64_t Count) const {
+    for (uint64_t i = Page; i < Page + Count; ++i) {
+      if (i >= TEST_PAGES || Used[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::optional<uint64_t> FindFirstFree(uint64_t Begin, uint64_t End, uint64_t Count) const {
+    for (uint64_t Page = Begin; Page + Count <= End; ++Page) {
+      if (IsFree(Page, Count)) {
+        return Page;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::optional<uint64_t> FindLastFree(uint64_t Begin, uint64_t End, uint64_t Count) const {
+    if (Begin + Count > End) {
+      return std::nullopt;
+    }
+    for (uint64_t Page = End - Count + 1; Page-- > Begin;) {
+      if (IsFree(Page, Count)) {
+        return Page;
+      }
+    }
+    return std::nullopt;
+  }
+};
+} // anonymous namespace
+
+TEST_CASE("PageRangeBitmap - Empty") {
+  auto Bitmap = std::make_unique<FEX::PageRangeBitmap<GUEST_PAGES>>();
+
+  CHECK(Bitmap->FindFirstFree(0, GUEST_PAGES, 1) == 0);
+  CHECK(Bitmap->FindLastFree(0, GUEST_PAGES, 1) == GUEST_PAGES - 1);
+  CHECK(Bitmap->FindFirstFree(0, GUEST_PAGES, GUEST_PAGES) == 0);
+  CHECK(Bitmap->FindLastFree(0, GUEST_PAGES, GUEST_PAGES) == 0);
+  CHECK(!Bitmap->FindFirstFree(0, GUEST_PAGES, GUEST_PAGES + 1));
+  CHECK(!Bitmap->FindLastFree(0, GUEST_PAGES, GUEST_PAGES + 1));
+  CHECK(Bitmap->IsFree(0, GUEST_PAGES));
+  CHECK(!Bitmap->IsFree(GUEST_PAGES - 1, 2));
+  CHECK(Bitmap->Test(GUEST_PAGES));
+}
+
+TEST_CASE("PageRangeBitmap - Ranges") {
+  auto Bitmap = std::make_unique<FEX::PageRangeBitmap<GUEST_PAGES>>();
+
+  // Crosses partial words at both ends and a full word in the middle.
+  Bitmap->Set(10, 200);
+  CHECK(!Bitmap->Test(9));
+  CHECK(Bitmap->Test(10));
+  CHECK(Bitmap->Test(209));
+  CHECK(!Bitmap->Test(210));
+  CHECK(Bitmap->IsFree(0, 10));
+  CHECK(!Bitmap->IsFree(0, 11));
+  CHECK(Bitmap->FindFirstFree(0, GUEST_PAGES, 11) == 210);
+  CHECK(Bitmap->FindLastFree(0, 210, 10) == 0);
+  CHECK(!Bitmap->FindLastFree(0, 210, 11));
+
+  Bitmap->Clear(64, 64);
+  CHECK(Bitmap->FindFirstFree(0, GUEST_PAGES, 64) == 64);
+  CHECK(Bitmap->FindLastFree(0, 210, 64) == 64);
+  CHECK(!Bitmap->FindFirstFree(0, 210, 65));
+
+  // Everything but one page in the middle of the range.
+  Bitmap->Set(0, GUEST_PAGES);
+  Bitmap->Clear(GUEST_PAGES / 2, 1);
+  CHECK(Bitmap->FindFirstFree(0, GUEST_PAGES, 1) == GUEST_PAGES / 2);
+  CHECK(Bitmap->FindLastFree(0, GUEST_PAGES, 1) == GUEST_PAGES / 2);
+  CHECK(!Bitmap->FindFirstFree(0, GUEST_PAGES, 2));
+  CHECK(!Bitmap->FindLastFree(0, GUEST_PAGES / 2, 1));
+  CHECK(!Bitmap->FindFirstFree(GUEST_PAGES / 2 + 1, GUEST_PAGES, 1));
+
+  // Ranges past the end are clamped.
+  Bitmap->Clear(GUEST_PAGES - 4, 8);
+  CHECK(Bitmap->FindLastFree(0, GUEST_PAGES + 8, 4) == GUEST_PAGES - 4);
+}
+
+TEST_CASE("PageRangeBitmap - Matches reference") {
+  FEX::PageRangeBitmap<TEST_PAGES> Bitmap;
+  Reference Ref;
+  std::mt19937_64 Random {0x4645'5850'4147'4553ULL};
+
+  auto RandomRange = [&](uint64_t MaxCount) {
+    uint64_t Page = Random() % TEST_PAGES;
+    uint64_t Count = 1 + Random() % std::min<uint64_t>(MaxCount, TEST_PAGES - Page);
+    return std::pair {Page, Count};
+  };
+
+  for (size_t i = 0; i < 2000; ++i) {
+    // Bias towards setting so the bitmap ends up mostly used and fragmented.
+    auto [Page, Count] = RandomRange(i % 3 ? 300 : 40);
+    const bool Set = Random() % 4 != 0;
+    if (Set) {
+      Bitmap.Set(Page, Count);
+    } else {
+      Bitmap.Clear(Page, Count);
+    }
+    for (uint64_t j = Page; j < Page + Count; ++j) {
+      Ref.Used[j] = Set;
+    }
+
+    auto [Begin, Length] = RandomRange(TEST_PAGES);
+    const uint64_t End = Begin + Length;
+    // Also covers the searches for large ranges that skip through the summary.
+    const uint64_t FindCount = 1 + Random() % (i % 2 ? 24 : 400);
+    CHECK(Bitmap.FindFirstFree(Begin, End, FindCount) == Ref.FindFirstFree(Begin, End, FindCount));
+    CHECK(Bitmap.FindLastFree(Begin, End, FindCount) == Ref.FindLastFree(Begin, End, FindCount));
+    CHECK(Bitmap.IsFree(Begin, FindCount) == Ref.IsFree(Begin, FindCount));
+  }
+
+  for (uint64_t Page = 0; Page < TEST_PAGES; ++Page) {
+    CHECK(Bitmap.Test(Page) == Ref.Used[Page]);
+  }
+}
+
+// Hidden from the regular run, use `PageRangeBitmap "[benchmark]"` to run it.
+TEST_CASE("PageRangeBitmap - Stress", "[.][benchmark]") {
+  // Allocates top-down the same way the 32-bit guest allocator does until the space is nearly exhausted,
+  // then keeps freeing and allocating small ranges. A linear scan degrades to walking most of the 4GB space per allocation here.
+  auto Bitmap = std::make_unique<FEX::PageRangeBitmap<GUEST_PAGES>>();
+  std::mt19937_64 Random {0x4645'5850'4147'4553ULL};
+  std::vector<std::pair<uint64_t, uint64_t>> Allocations;
+
+  while (true) {
+    const uint64_t Count = 1 + Random() % 16;
+    auto Page = Bitmap->FindLastFree(16, GUEST_PAGES - 1, Count);
+    if (!Page) {
+      break;
+    }
+    Bitmap->Set(*Page, Count);
+    Allocations.emplace_back(*Page, Count);
+  }
+
+  // Leave scattered holes behind.
+  for (size_t i = 0; i < Allocations.size(); i += 7) {
+    Bitmap->Clear(Allocations[i].first, Allocations[i].second);
+  }
+
+  BENCHMARK("Allocate and free near exhaustion") {
+    const uint64_t Count = 1 + Random() % 8;
+    auto Page = Bitmap->FindLastFree(16, GUEST_PAGES - 1, Count);
+    if (Page) {
+      Bitmap->Set(*Page, Count);
+      Bitmap->Clear(*Page, Count);
+    }
+    return Page;
+  };
+
+  BENCHMARK("Failed search for a large range") {
+    return Bitmap->FindLastFree(16, GUEST_PAGES - 1, 4096);
+  };
+}
@@ -0,0 +1,46 @@
+%ifdef CONFIG
+{
+  "Match": "All",
+  "RegData": {
+    "RAX": "0x1",
+    "RBX": "0x2233",
+    "RCX": "0x1"
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+; Spin-wait loops get a host wait on their back edge. Make sure that the loops still exit when the memory they are
+; waiting on already holds the expected value.
+mov rdi, 0x100000000
+mov dword [rdi], 1
+mov word [rdi + 9], 0x2233
+mov rax, -1
+mov rcx, 0
+
+loop1:
+pause
+cmp dword [rdi], 0
+je loop1
+
+; Load through a register, then test.
+loop2:
+pause
+mov eax, [rdi]
+test eax, eax
+jz loop2
+
+; Unaligned memory
+loop3:
+pause
+movzx ebx, word [rdi + 9]
+cmp ebx, 0x2233
+jne loop3
+
+; Flags from the loop's compare need to survive.
+setnz cl
+xor cl, 1
+
+hlt
@@ -0,0 +1,85 @@
+%ifdef CONFIG
+{
+  "Match": "All",
+  "RegData": {
+    "RAX": "0x1",
+    "RBX": "0x2233",
+    "RCX": "0x0"
+  },
+  "MemoryRegions": {
+    "0x100000000": "65536"
+  }
+}
+%endif
+
+; Spin-wait loops get a host wait on their back edge. Make sure that the loops wake up and exit when another thread
+; only releases the watched word after a delay.
+mov r15, 0x100000000
+mov dword [r15], 0
+; Child TID, cleared by the exiting child thread.
+mov dword [r15 + 4], 1
+mov dword [r15 + 8], 0
+; 10ms timespec for nanosleep
+mov qword [r15 + 16], 0
+mov qword [r15 + 24], 10000000
+
+; clone(CLONE_VM | CLONE_FS | CLONE_FILES | CLONE_SIGHAND | CLONE_THREAD | CLONE_SYSVSEM | CLONE_CHILD_CLEARTID,
+;       stack, NULL, &tid, 0)
+mov eax, 56
+mov edi, 0x250F00
+mov rsi, 0x100010000
+xor edx, edx
+lea r10, [r15 + 4]
+xor r8d, r8d
+syscall
+test rax, rax
+jz child
+
+loop1:
+pause
+cmp dword [r15], 0
+je loop1
+
+; Load through a register, then compare.
+loop2:
+pause
+mov eax, [r15 + 8]
+cmp eax, 0x2233
+jne loop2
+
+; Wait for the child to exit.
+wait_child:
+mov edx, [r15 + 4]
+test edx, edx
+jz done
+; futex(&tid, FUTEX_WAIT, tid, NULL)
+mov eax, 202
+lea rdi, [r15 + 4]
+xor esi, esi
+xor r10d, r10d
+syscall
+jmp wait_child
+
+done:
+mov eax, [r15]
+mov ebx, [r15 + 8]
+mov ecx, [r15 + 4]
+hlt
+
+child:
+mov eax, 35
+lea rdi, [r15 + 16]
+xor esi, esi
+syscall
+mov dword [r15], 1
+
+mov eax, 35
+lea rdi, [r15 + 16]
+xor esi, esi
+syscall
+mov dword [r15 + 8], 0x2233
+
+; exit(0) only ends this thread.
+mov eax, 60
+xor edi, edi
+syscall
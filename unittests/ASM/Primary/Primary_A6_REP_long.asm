@@ -0,0 +1,37 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x9700",
+    "RCX": "0x5CB",
+    "RDI": "0x10001245",
+    "RSI": "0x10002635"
+  },
+  "MemoryRegions": {
+    "0x10000000": "12288"
+  }
+}
+%endif
+
+; Checks REPE CMPSB over strings that are long enough to span multiple 16-byte chunks and page boundaries,
+; with the two strings having a different alignment inside of their pages.
+
+; Fill all pages with 'A'
+mov rdi, 0x10000000
+mov rcx, 0x3000
+mov al, 0x41
+cld
+rep stosb
+
+mov rdx, 0x10000000
+mov byte [rdx + 0x10 + 0x1234], 0x42
+
+lea rdi, [rdx + 0x10]
+lea rsi, [rdx + 0x1400]
+mov rcx, 0x1800
+cmp rcx, 0
+
+repe cmpsb ; rdi cmp rsi
+mov rax, 0
+lahf
+
+hlt
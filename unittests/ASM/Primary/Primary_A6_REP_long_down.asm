@@ -0,0 +1,39 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x9700",
+    "RCX": "0xB7F",
+    "RDI": "0x10001F7F",
+    "RSI": "0x10000D8F"
+  },
+  "MemoryRegions": {
+    "0x10000000": "12288"
+  }
+}
+%endif
+
+; Checks REPE CMPSB with DF set over strings that span multiple 16-byte chunks and page boundaries,
+; with the two strings having a different alignment inside of their pages.
+
+; Fill all pages with 'A'
+mov rdi, 0x10000000
+mov rcx, 0x3000
+mov al, 0x41
+cld
+rep stosb
+
+mov rdx, 0x10000000
+mov byte [rdx + 0x1F80], 0x42
+
+lea rdi, [rdx + 0x2C00]
+lea rsi, [rdx + 0x1A10]
+mov rcx, 0x1800
+cmp rcx, 0
+
+std
+repe cmpsb ; rdi cmp rsi
+cld
+mov rax, 0
+lahf
+
+hlt
@@ -0,0 +1,37 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x200",
+    "RCX": "0x15E",
+    "RDI": "0x1000128B",
+    "RSI": "0x10002A79"
+  },
+  "MemoryRegions": {
+    "0x10000000": "12288"
+  }
+}
+%endif
+
+; Checks REPE CMPSD over strings that span multiple 16-byte chunks and page boundaries,
+; with elements that straddle the page boundaries.
+
+; Fill all pages with 'A'
+mov rdi, 0x10000000
+mov rcx, 0x3000
+mov al, 0x41
+cld
+rep stosb
+
+mov rdx, 0x10000000
+mov dword [rdx + 0x403 + 4 * 0x3A1], 0x41414140
+
+lea rdi, [rdx + 0x403]
+lea rsi, [rdx + 0x1BF1]
+mov rcx, 0x500
+cmp rcx, 0
+
+repe cmpsd ; rdi cmp rsi
+mov rax, 0
+lahf
+
+hlt
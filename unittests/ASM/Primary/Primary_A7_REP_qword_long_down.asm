@@ -0,0 +1,39 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x8700",
+    "RCX": "0x3E",
+    "RDI": "0x100019E8",
+    "RSI": "0x100001F4"
+  },
+  "MemoryRegions": {
+    "0x10000000": "12288"
+  }
+}
+%endif
+
+; Checks REPE CMPSQ with DF set over strings that span multiple 16-byte chunks and page boundaries.
+
+; Fill all pages with 'A'
+mov rdi, 0x10000000
+mov rcx, 0x3000
+mov al, 0x41
+cld
+rep stosb
+
+mov rdx, 0x10000000
+mov rax, 0x4141414141414241
+mov qword [rdx + 0x2FF8 - 8 * 0x2C1], rax
+
+lea rdi, [rdx + 0x2FF8]
+lea rsi, [rdx + 0x1804]
+mov rcx, 0x300
+cmp rcx, 0
+
+std
+repe cmpsq ; rdi cmp rsi
+cld
+mov rax, 0
+lahf
+
+hlt
@@ -0,0 +1,37 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x9700",
+    "RCX": "0x4CC",
+    "RDI": "0x10000E7A",
+    "RSI": "0x1000226A"
+  },
+  "MemoryRegions": {
+    "0x10000000": "12288"
+  }
+}
+%endif
+
+; Checks REPE CMPSW over strings that span multiple 16-byte chunks and page boundaries,
+; with the two strings having a different alignment inside of their pages.
+
+; Fill all pages with 'A'
+mov rdi, 0x10000000
+mov rcx, 0x3000
+mov al, 0x41
+cld
+rep stosb
+
+mov rdx, 0x10000000
+mov word [rdx + 0x12 + 2 * 0x733], 0x4142
+
+lea rdi, [rdx + 0x12]
+lea rsi, [rdx + 0x1402]
+mov rcx, 0xC00
+cmp rcx, 0
+
+repe cmpsw ; rdi cmp rsi
+mov rax, 0
+lahf
+
+hlt
@@ -0,0 +1,36 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x4600",
+    "RCX": "0x7FD",
+    "RDI": "0x10001006"
+  },
+  "MemoryRegions": {
+    "0x10000000": "8192"
+  }
+}
+%endif
+
+; Checks REPNE SCASB over a string that is long enough to span multiple 16-byte chunks and a page boundary,
+; with the match starting at an unaligned address in the second page.
+
+; Fill both pages with 'A'
+mov rdi, 0x10000000
+mov rcx, 0x2000
+mov al, 0x41
+cld
+rep stosb
+
+mov rdx, 0x10000000
+mov byte [rdx + 0x1005], 0x5A
+
+lea rdi, [rdx + 3]
+mov rcx, 0x1800
+mov al, 0x5A
+cmp al, 0
+
+repne scasb
+mov rax, 0
+lahf
+
+hlt
@@ -0,0 +1,38 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x4600",
+    "RCX": "0x7F6",
+    "RDI": "0x10000FF2"
+  },
+  "MemoryRegions": {
+    "0x10000000": "8192"
+  }
+}
+%endif
+
+; Checks REPNE SCASB with DF set over a string that spans multiple 16-byte chunks and a page boundary,
+; with the match at an unaligned address in the first page.
+
+; Fill both pages with 'A'
+mov rdi, 0x10000000
+mov rcx, 0x2000
+mov al, 0x41
+cld
+rep stosb
+
+mov rdx, 0x10000000
+mov byte [rdx + 0xFF3], 0x5A
+
+lea rdi, [rdx + 0x1FFC]
+mov rcx, 0x1800
+mov al, 0x5A
+cmp al, 0
+
+std
+repne scasb
+cld
+mov rax, 0
+lahf
+
+hlt
@@ -0,0 +1,38 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x4600",
+    "RCX": "0xDF",
+    "RDI": "0x10000B6D"
+  },
+  "MemoryRegions": {
+    "0x10000000": "8192"
+  }
+}
+%endif
+
+; Checks REPNE SCASD with DF set over a string that spans multiple 16-byte chunks and a page boundary,
+; with elements that straddle the page boundary.
+
+; Fill both pages with 'A'
+mov rdi, 0x10000000
+mov rcx, 0x2000
+mov al, 0x41
+cld
+rep stosb
+
+mov rdx, 0x10000000
+mov dword [rdx + 0x1FF1 - 4 * 0x520], 0x5A5A5A5A
+
+lea rdi, [rdx + 0x1FF1]
+mov rcx, 0x600
+mov eax, 0x5A5A5A5A
+cmp rax, 0
+
+std
+repne scasd
+cld
+mov rax, 0
+lahf
+
+hlt
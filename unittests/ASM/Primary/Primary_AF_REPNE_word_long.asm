@@ -0,0 +1,37 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x4600",
+    "RCX": "0x3FD",
+    "RDI": "0x10001008"
+  },
+  "MemoryRegions": {
+    "0x10000000": "8192"
+  }
+}
+%endif
+
+; Checks REPNE SCASW over a string that spans multiple 16-byte chunks and a page boundary.
+
+; Fill both pages with 'A'
+mov rdi, 0x10000000
+mov rcx, 0x2000
+mov al, 0x41
+cld
+rep stosb
+
+mov rdx, 0x10000000
+; Only matches at an element boundary, the bytes before it must not be picked up.
+mov word [rdx + 0x1001], 0x5A5A
+mov word [rdx + 0x1006], 0x5A5A
+
+lea rdi, [rdx + 2]
+mov rcx, 0xC00
+mov rax, 0x5A5A
+cmp rax, 0
+
+repne scasw
+mov rax, 0
+lahf
+
+hlt
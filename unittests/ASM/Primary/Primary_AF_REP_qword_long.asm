@@ -0,0 +1,35 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x200",
+    "RCX": "0x6F",
+    "RDI": "0x10001C0E"
+  },
+  "MemoryRegions": {
+    "0x10000000": "8192"
+  }
+}
+%endif
+
+; Checks REPE SCASQ over a string that spans multiple 16-byte chunks and a page boundary.
+
+; Fill both pages with 'A'
+mov rdi, 0x10000000
+mov rcx, 0x2000
+mov al, 0x41
+cld
+rep stosb
+
+mov rdx, 0x10000000
+mov byte [rdx + 0x1C06], 0x40
+
+lea rdi, [rdx + 0x6]
+mov rcx, 0x3F0
+mov rax, 0x4141414141414141
+cmp rax, 0
+
+repe scasq
+mov rax, 0
+lahf
+
+hlt
@@ -0,0 +1,53 @@
+%ifdef CONFIG
+{
+  "Match": "All",
+  "RegData": {
+    "R12": "0x1",
+    "R13": "0x2",
+    "R14": "0x3"
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  },
+  "Env": { "FEX_IRCACHESIZE": "16" }
+}
+%endif
+
+; Blocks compiled again after their guest code was modified or replaced must not use the cached IR of the old code.
+mov r15, 0x100000000
+
+; mov eax, 1; ret
+mov dword [r15], 0x000001B8
+mov word [r15 + 4], 0xC300
+call r15
+mov r12d, eax
+
+; Patch to mov eax, 2
+mov byte [r15 + 1], 2
+call r15
+mov r13d, eax
+
+; Unmap the code and map fresh memory in its place.
+; munmap(code, 4096)
+mov eax, 11
+mov rdi, r15
+mov esi, 4096
+syscall
+
+; mmap(code, 4096, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_FIXED | MAP_ANONYMOUS, -1, 0)
+mov eax, 9
+mov rdi, r15
+mov esi, 4096
+mov edx, 7
+mov r10d, 0x32
+mov r8, -1
+xor r9d, r9d
+syscall
+
+; mov eax, 3; ret
+mov dword [r15], 0x000003B8
+mov word [r15 + 4], 0xC300
+call r15
+mov r14d, eax
+
+hlt
@@ -0,0 +1,228 @@
+// Checks the precision of the libm and libmvec functions that HostLibmRoutines redirects to the host.
+// Run with "[throughput]" to print the throughput of the scalar and vector variants instead.
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <immintrin.h>
+#include <limits>
+
+extern "C" {
+__m128d _ZGVbN2v_sin(__m128d);
+__m128d _ZGVbN2v_cos(__m128d);
+__m128d _ZGVbN2v_exp(__m128d);
+__m128d _ZGVbN2v_log(__m128d);
+__m128d _ZGVbN2vv_pow(__m128d, __m128d);
+void _ZGVbN2vvv_sincos(__m128d, __m128i, __m128i);
+__m128 _ZGVbN4v_sinf(__m128);
+__m128 _ZGVbN4v_cosf(__m128);
+__m128 _ZGVbN4v_expf(__m128);
+__m128 _ZGVbN4v_logf(__m128);
+__m128 _ZGVbN4vv_powf(__m128, __m128);
+}
+
+// glibc's scalar functions are within 1 ULP of the exact result, libmvec documents 4 ULP.
+constexpr double ScalarULP = 1.0;
+constexpr double VectorULP = 4.0;
+constexpr size_t NumInputs = 4096;
+
+// Deterministic inputs in [Min, Max)
+struct Inputs {
+  Inputs(double Min, double Max, uint64_t State = 0x9E37'79B9'7F4A'7C15ULL) {
+    for (auto& Value : Values) {
+      State = State * 6364136223846793005ULL + 1442695040888963407ULL;
+      Value = Min + (Max - Min) * (static_cast<double>(State >> 11) / static_cast<double>(1ULL << 53));
+    }
+  }
+
+  double Values[NumInputs];
+};
+
+template<typename T>
+double ErrorInULP(T Result, long double Reference) {
+  if (std::isnan(Result) || std::isnan(Reference)) {
+    return std::isnan(Result) == std::isnan(Reference) ? 0.0 : std::numeric_limits<double>::infinity();
+  }
+  const T Rounded = static_cast<T>(Reference);
+  if (std::isinf(Rounded)) {
+    return Result == Rounded ? 0.0 : std::numeric_limits<double>::infinity();
+  }
+  const long double ULP = std::nextafter(std::fabs(Rounded), std::numeric_limits<T>::infinity()) - std::fabs(Rounded);
+  return static_cast<double>(std::fabs(static_cast<long double>(Result) - Reference) / ULP);
+}
+
+// Largest error of a scalar function over inputs in [Min, Max)
+template<typename T, typename FnType, typename ReferenceType>
+double MaxError(double Min, double Max, FnType&& Fn, ReferenceType&& Reference) {
+  const Inputs In(Min, Max);
+  double Error {};
+  for (auto X : In.Values) {
+    const auto Input = static_cast<T>(X);
+    Error = std::max(Error, ErrorInULP(Fn(Input), Reference(Input)));
+  }
+  return Error;
+}
+
+// Largest error of a two operand scalar function, the operands are drawn independently
+template<typename T, typename FnType, typename ReferenceType>
+double MaxError(double MinX, double MaxX, double MinY, double MaxY, FnType&& Fn, ReferenceType&& Reference) {
+  const Inputs InX(MinX, MaxX);
+  const Inputs InY(MinY, MaxY, 0x2545'F491'4F6C'DD1DULL);
+  double Error {};
+  for (size_t i = 0; i < NumInputs; ++i) {
+    const auto X = static_cast<T>(InX.Values[i]);
+    const auto Y = static_cast<T>(InY.Values[i]);
+    Error = std::max(Error, ErrorInULP(Fn(X, Y), Reference(X, Y)));
+  }
+  return Error;
+}
+
+template<typename FnType, typename ReferenceType>
+double MaxErrorV2F64(double Min, double Max, FnType&& Fn, ReferenceType&& Reference) {
+  const Inputs In(Min, Max);
+  double Error {};
+  for (size_t i = 0; i < NumInputs; i += 2) {
+    double Result[2];
+    _mm_storeu_pd(Result, Fn(_mm_loadu_pd(&In.Values[i])));
+    for (size_t Lane = 0; Lane < 2; ++Lane) {
+      Error = std::max(Error, ErrorInULP(Result[Lane], Reference(In.Values[i + Lane])));
+    }
+  }
+  return Error;
+}
+
+template<typename FnType, typename ReferenceType>
+double MaxErrorV4F32(double Min, double Max, FnType&& Fn, ReferenceType&& Reference) {
+  const Inputs In(Min, Max);
+  double Error {};
+  for (size_t i = 0; i < NumInputs; i += 4) {
+    float X[4], Result[4];
+    for (size_t Lane = 0; Lane < 4; ++Lane) {
+      X[Lane] = static_cast<float>(In.Values[i + Lane]);
+    }
+    _mm_storeu_ps(Result, Fn(_mm_loadu_ps(X)));
+    for (size_t Lane = 0; Lane < 4; ++Lane) {
+      Error = std::max(Error, ErrorInULP(Result[Lane], Reference(X[Lane])));
+    }
+  }
+  return Error;
+}
+
+TEST_CASE("libm - double precision") {
+  CHECK(MaxError<double>(-100.0, 100.0, [](double X) { return ::sin(X); }, [](double X) { return sinl(X); }) <= ScalarULP);
+  CHECK(MaxError<double>(-100.0, 100.0, [](double X) { return ::cos(X); }, [](double X) { return cosl(X); }) <= ScalarULP);
+  CHECK(MaxError<double>(-1.5, 1.5, [](double X) { return ::tan(X); }, [](double X) { return tanl(X); }) <= ScalarULP);
+  CHECK(MaxError<double>(-100.0, 100.0, [](double X) { return ::atan(X); }, [](double X) { return atanl(X); }) <= ScalarULP);
+  CHECK(MaxError<double>(-1.0, 1.0, [](double X) { return ::asin(X); }, [](double X) { return asinl(X); }) <= ScalarULP);
+  CHECK(MaxError<double>(-1.0, 1.0, [](double X) { return ::acos(X); }, [](double X) { return acosl(X); }) <= ScalarULP);
+  CHECK(MaxError<double>(-700.0, 700.0, [](double X) { return ::exp(X); }, [](double X) { return expl(X); }) <= ScalarULP);
+  CHECK(MaxError<double>(-10.0, 10.0, [](double X) { return ::expm1(X); }, [](double X) { return expm1l(X); }) <= ScalarULP);
+  CHECK(MaxError<double>(1e-300, 1e300, [](double X) { return ::log(X); }, [](double X) { return logl(X); }) <= ScalarULP);
+  CHECK(MaxError<double>(1e-300, 1e300, [](double X) { return ::log2(X); }, [](double X) { return log2l(X); }) <= ScalarULP);
+
+  CHECK(MaxError<double>(
+          -100.0, 100.0, -100.0, 100.0, [](double Y, double X) { return ::atan2(Y, X); },
+          [](double Y, double X) { return atan2l(Y, X); }) <= ScalarULP);
+  CHECK(MaxError<double>(
+          0.0, 100.0, -10.0, 10.0, [](double X, double Y) { return ::pow(X, Y); },
+          [](double X, double Y) { return powl(X, Y); }) <= ScalarULP);
+
+  const Inputs In(-100.0, 100.0);
+  for (auto X : In.Values) {
+    double Sin, Cos;
+    ::sincos(X, &Sin, &Cos);
+    CHECK(Sin == ::sin(X));
+    CHECK(Cos == ::cos(X));
+  }
+}
+
+TEST_CASE("libm - single precision") {
+  CHECK(MaxError<float>(-100.0, 100.0, [](float X) { return ::sinf(X); }, [](float X) { return sinl(X); }) <= ScalarULP);
+  CHECK(MaxError<float>(-100.0, 100.0, [](float X) { return ::cosf(X); }, [](float X) { return cosl(X); }) <= ScalarULP);
+  CHECK(MaxError<float>(-80.0, 80.0, [](float X) { return ::expf(X); }, [](float X) { return expl(X); }) <= ScalarULP);
+  CHECK(MaxError<float>(-120.0, 120.0, [](float X) { return ::exp2f(X); }, [](float X) { return exp2l(X); }) <= ScalarULP);
+  CHECK(MaxError<float>(1e-30, 1e30, [](float X) { return ::logf(X); }, [](float X) { return logl(X); }) <= ScalarULP);
+  CHECK(MaxError<float>(1e-30, 1e30, [](float X) { return ::log2f(X); }, [](float X) { return log2l(X); }) <= ScalarULP);
+
+  CHECK(MaxError<float>(
+          0.0, 10.0, -30.0, 30.0, [](float X, float Y) { return ::powf(X, Y); }, [](float X, float Y) { return powl(X, Y); }) <= ScalarULP);
+
+  const Inputs In(-100.0, 100.0);
+  for (auto X : In.Values) {
+    const auto XF = static_cast<float>(X);
+    float Sin, Cos;
+    ::sincosf(XF, &Sin, &Cos);
+    CHECK(Sin == ::sinf(XF));
+    CHECK(Cos == ::cosf(XF));
+  }
+}
+
+TEST_CASE("libmvec - SSE variants") {
+  CHECK(MaxErrorV2F64(-100.0, 100.0, _ZGVbN2v_sin, [](double X) { return sinl(X); }) <= VectorULP);
+  CHECK(MaxErrorV2F64(-100.0, 100.0, _ZGVbN2v_cos, [](double X) { return cosl(X); }) <= VectorULP);
+  CHECK(MaxErrorV2F64(-700.0, 700.0, _ZGVbN2v_exp, [](double X) { return expl(X); }) <= VectorULP);
+  CHECK(MaxErrorV2F64(1e-300, 1e300, _ZGVbN2v_log, [](double X) { return logl(X); }) <= VectorULP);
+  CHECK(MaxErrorV4F32(-100.0, 100.0, _ZGVbN4v_sinf, [](float X) { return sinl(X); }) <= VectorULP);
+  CHECK(MaxErrorV4F32(-100.0, 100.0, _ZGVbN4v_cosf, [](float X) { return cosl(X); }) <= VectorULP);
+  CHECK(MaxErrorV4F32(-80.0, 80.0, _ZGVbN4v_expf, [](float X) { return expl(X); }) <= VectorULP);
+  CHECK(MaxErrorV4F32(1e-30, 1e30, _ZGVbN4v_logf, [](float X) { return logl(X); }) <= VectorULP);
+
+  // The second operand of pow is 1.5 in every lane.
+  CHECK(MaxErrorV2F64(
+          0.0, 1e100, [](__m128d X) { return _ZGVbN2vv_pow(X, _mm_set1_pd(1.5)); }, [](double X) { return powl(X, 1.5L); }) <= VectorULP);
+  CHECK(MaxErrorV4F32(
+          0.0, 1e20, [](__m128 X) { return _ZGVbN4vv_powf(X, _mm_set1_ps(1.5f)); }, [](float X) { return powl(X, 1.5L); }) <= VectorULP);
+
+  const Inputs In(-100.0, 100.0);
+  for (size_t i = 0; i < NumInputs; i += 2) {
+    double Sin[2], Cos[2];
+    _ZGVbN2vvv_sincos(_mm_loadu_pd(&In.Values[i]), _mm_set_epi64x(reinterpret_cast<int64_t>(&Sin[1]), reinterpret_cast<int64_t>(&Sin[0])),
+                      _mm_set_epi64x(reinterpret_cast<int64_t>(&Cos[1]), reinterpret_cast<int64_t>(&Cos[0])));
+    for (size_t Lane = 0; Lane < 2; ++Lane) {
+      CHECK(ErrorInULP(Sin[Lane], sinl(In.Values[i + Lane])) <= VectorULP);
+      CHECK(ErrorInULP(Cos[Lane], cosl(In.Values[i + Lane])) <= VectorULP);
+    }
+  }
+}
+
+template<typename FnType>
+void Measure(const char* Name, int ValuesPerCall, FnType&& Fn) {
+  constexpr int Iterations = 1'000'000;
+  const auto Start = std::chrono::steady_clock::now();
+  for (int i = 0; i < Iterations; ++i) {
+    Fn(i);
+  }
+  const std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+  printf("%-16s %10.2f M values/s\n", Name, Iterations * ValuesPerCall / Elapsed.count() / 1e6);
+}
+
+TEST_CASE("libm - throughput", "[.][throughput]") {
+  // Results feed back in to the inputs so the calls can't be hoisted out of the loops, scaled down so they stay finite.
+  volatile double SinkF64 = 0.5;
+  volatile float SinkF32 = 0.5f;
+  __m128d SinkV2 = _mm_set1_pd(0.5);
+  __m128 SinkV4 = _mm_set1_ps(0.5f);
+
+  Measure("sin", 1, [&](int i) { SinkF64 = ::sin(SinkF64 + i); });
+  Measure("cos", 1, [&](int i) { SinkF64 = ::cos(SinkF64 + i); });
+  Measure("exp", 1, [&](int i) { SinkF64 = ::exp(SinkF64 * 1e-3 - (i & 0xff)); });
+  Measure("log", 1, [&](int i) { SinkF64 = ::log(SinkF64 + i + 1.0); });
+  Measure("pow", 1, [&](int i) { SinkF64 = ::pow(SinkF64 * 1e-3 + (i & 0xff), 1.5); });
+  Measure("sinf", 1, [&](int i) { SinkF32 = ::sinf(SinkF32 + static_cast<float>(i & 0xff)); });
+  Measure("expf", 1, [&](int i) { SinkF32 = ::expf(SinkF32 * 1e-3f - static_cast<float>(i & 0x3f)); });
+  Measure("logf", 1, [&](int i) { SinkF32 = ::logf(SinkF32 + static_cast<float>(i & 0xff) + 1.0f); });
+  Measure("powf", 1, [&](int i) { SinkF32 = ::powf(SinkF32 * 1e-3f + static_cast<float>(i & 0xff), 1.5f); });
+  Measure("_ZGVbN2v_sin", 2, [&](int i) { SinkV2 = _ZGVbN2v_sin(_mm_add_pd(SinkV2, _mm_set1_pd(i))); });
+  Measure("_ZGVbN2v_exp", 2,
+          [&](int i) { SinkV2 = _ZGVbN2v_exp(_mm_sub_pd(_mm_mul_pd(SinkV2, _mm_set1_pd(1e-3)), _mm_set1_pd(i & 0xff))); });
+  Measure("_ZGVbN2v_log", 2, [&](int i) { SinkV2 = _ZGVbN2v_log(_mm_add_pd(SinkV2, _mm_set1_pd(i + 1.0))); });
+  Measure("_ZGVbN4v_sinf", 4, [&](int i) { SinkV4 = _ZGVbN4v_sinf(_mm_add_ps(SinkV4, _mm_set1_ps(static_cast<float>(i & 0xff)))); });
+  Measure("_ZGVbN4v_expf", 4, [&](int i) {
+    SinkV4 = _ZGVbN4v_expf(_mm_sub_ps(_mm_mul_ps(SinkV4, _mm_set1_ps(1e-3f)), _mm_set1_ps(static_cast<float>(i & 0x3f))));
+  });
+
+  CHECK(std::isfinite(SinkF64 + SinkF32 + _mm_cvtsd_f64(SinkV2) + _mm_cvtss_f32(SinkV4)));
+}
@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <linux/audit.h>
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+#include <string>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef __x86_64__
+constexpr uint32_t NATIVE_ARCH = AUDIT_ARCH_X86_64;
+#else
+constexpr uint32_t NATIVE_ARCH = AUDIT_ARCH_I386;
+#endif
+
+// getpid on i386, the 64-bit getpid is 39.
+constexpr uint32_t I386_GETPID = 20;
+constexpr const char* CHILD_ENV = "FEX_SECCOMP_VERDICTS_CHILD";
+
+static bool InstallFilter(sock_filter* Filter, unsigned short Length) {
+  sock_fprog Prog {
+    .len = Length,
+    .filter = Filter,
+  };
+  return prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) == 0 && syscall(SYS_seccomp, SECCOMP_SET_MODE_FILTER, 0, &Prog) == 0;
+}
+
+// Filters stay installed for the lifetime of a process, so each test runs in its own.
+template<typename F>
+static int RunInChild(F Func) {
+  pid_t Child = fork();
+  if (Child == 0) {
+    _exit(Func());
+  }
+
+  int Status {};
+  waitpid(Child, &Status, 0);
+  return WIFEXITED(Status) ? WEXITSTATUS(Status) : -1;
+}
+
+TEST_CASE("seccomp verdicts - nr and args") {
+  const int Result = RunInChild([] {
+    sock_filter Filter[] = {
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, arch)),
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, NATIVE_ARCH, 1, 0),
+      BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_KILL_PROCESS),
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, nr)),
+      // Only depends on the syscall number.
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_getppid, 0, 1),
+      BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | EPERM),
+      // Depends on the first argument.
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_getpgid, 0, 3),
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, args[0])),
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 1, 0),
+      BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | EACCES),
+      BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW),
+    };
+
+    if (!InstallFilter(Filter, std::size(Filter))) {
+      return 1;
+    }
+
+    // Repeat to go through the cached verdicts more than once.
+    for (int i = 0; i < 4; ++i) {
+      if (syscall(SYS_getppid) != -1 || errno != EPERM) {
+        return 2;
+      }
+      if (syscall(SYS_getpgid, 0) == -1) {
+        return 3;
+      }
+      if (syscall(SYS_getpgid, 1) != -1 || errno != EACCES) {
+        return 4;
+      }
+      if (syscall(SYS_getpid) == -1) {
+        return 5;
+      }
+    }
+    return 0;
+  });
+
+  CHECK(Result == 0);
+}
+
+#ifdef __x86_64__
+TEST_CASE("seccomp verdicts - execve to i386") {
+  // The 32-bit build of this test lives next to the 64-bit one.
+  char Path[PATH_MAX] {};
+  REQUIRE(realpath("/proc/self/exe", Path) != nullptr);
+  std::string ChildPath = Path;
+  const auto Dir = ChildPath.rfind("FEXLinuxTests_64/");
+  if (Dir == std::string::npos || access((ChildPath.substr(0, Dir) + "FEXLinuxTests_32/seccomp_verdicts.32").c_str(), X_OK) != 0) {
+    WARN("32-bit build of the test not found, skipping");
+    return;
+  }
+  ChildPath = ChildPath.substr(0, Dir) + "FEXLinuxTests_32/seccomp_verdicts.32";
+
+  const int Result = RunInChild([&ChildPath] {
+    // Allows everything for x86-64, including syscall 20 (writev). Verdicts evaluated for x86-64 must not be used after the execve.
+    sock_filter Filter[] = {
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, arch)),
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, AUDIT_ARCH_I386, 0, 3),
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, nr)),
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, I386_GETPID, 0, 1),
+      BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | EPERM),
+      BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW),
+    };
+
+    if (!InstallFilter(Filter, std::size(Filter))) {
+      return 1;
+    }
+
+    const char* Args[] = {ChildPath.c_str(), "seccomp verdicts - i386 child", nullptr};
+    setenv(CHILD_ENV, "1", 1);
+    execv(ChildPath.c_str(), const_cast<char* const*>(Args));
+    return 2;
+  });
+
+  CHECK(Result == 0);
+}
+#else
+TEST_CASE("seccomp verdicts - i386 child") {
+  if (!getenv(CHILD_ENV)) {
+    // Only meaningful when started by the 64-bit test with its filter installed.
+    return;
+  }
+
+  CHECK(syscall(SYS_getpid) == -1);
+  CHECK(errno == EPERM);
+}
+#endif
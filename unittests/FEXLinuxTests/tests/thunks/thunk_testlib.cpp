@@ -2,6 +2,9 @@
 
 #include <dlfcn.h>
 
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <stdexcept>
 
 #include <catch2/catch_test_macros.hpp>
@@ -38,6 +41,9 @@ struct Fixture {
   GET_SYMBOL(FunctionWithDivergentSignature);
 
   GET_SYMBOL(ReadData1);
+
+  GET_SYMBOL(EmptyFunction);
+  GET_SYMBOL(EmptyLeafFunction);
 };
 
 TEST_CASE_METHOD(Fixture, "Trivial") {
@@ -112,3 +118,54 @@ TEST_CASE_METHOD(Fixture, "Assisted repacking of linked lists") {
   CHECK(ReadData1(&s1, 0) == s1_data);
   CHECK(ReadData1(&s1, 1) == s2_data);
 }
+
+TEST_CASE_METHOD(Fixture, "Leaf functions") {
+#ifdef __x86_64__
+  // Guest callee-saved registers must survive the reduced guest->host transition.
+  // RBX, R12 and R13 live in host caller-saved registers, R15 holds the stack pointer to restore.
+  auto Fn = EmptyLeafFunction;
+  uint64_t Result[4];
+  asm volatile("mov %[Fn], %%rax\n"
+               "mov $0x1111, %%rbx\n"
+               "mov $0x2222, %%r12\n"
+               "mov $0x3333, %%r13\n"
+               "mov $0x4444, %%r14\n"
+               "mov %%rsp, %%r15\n"
+               "sub $128, %%rsp\n" // Skip the red zone
+               "and $-16, %%rsp\n"
+               "call *%%rax\n"
+               "mov %%r15, %%rsp\n"
+               "mov %%rbx, %[Result0]\n"
+               "mov %%r12, %[Result1]\n"
+               "mov %%r13, %[Result2]\n"
+               "mov %%r14, %[Result3]\n"
+               : [Result0] "=m"(Result[0]), [Result1] "=m"(Result[1]), [Result2] "=m"(Result[2]), [Result3] "=m"(Result[3])
+               : [Fn] "m"(Fn)
+               : "rax", "rcx", "rdx", "rsi", "rdi", "r8", "r9", "r10", "r11", "rbx", "r12", "r13", "r14", "r15", "xmm0", "xmm1",
+                 "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14", "xmm15", "cc",
+                 "memory");
+
+  CHECK(Result[0] == 0x1111);
+  CHECK(Result[1] == 0x2222);
+  CHECK(Result[2] == 0x3333);
+  CHECK(Result[3] == 0x4444);
+#else
+  EmptyLeafFunction();
+#endif
+}
+
+// Run with "[throughput]" to print the number of empty thunk calls per second
+TEST_CASE_METHOD(Fixture, "Empty thunk throughput", "[.][throughput]") {
+  auto Measure = [](const char* Name, void (*Fn)()) {
+    constexpr int Iterations = 10'000'000;
+    const auto Start = std::chrono::steady_clock::now();
+    for (int i = 0; i < Iterations; ++i) {
+      Fn();
+    }
+    const std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+    printf("%-20s %10.2f M calls/s\n", Name, Iterations / Elapsed.count() / 1e6);
+  };
+
+  Measure("EmptyFunction", EmptyFunction);
+  Measure("EmptyLeafFunction", EmptyLeafFunction);
+}
@@ -0,0 +1,29 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RCX": "0"
+  },
+  "HostFeatures": ["AVX"],
+  "Benchmark": {
+    "Iterations": "10000000",
+    "InstructionsPerIteration": "10"
+  }
+}
+%endif
+
+; 256-bit AVX float and shuffle operations.
+mov rcx, 10000000
+
+.loop:
+vaddps ymm0, ymm0, ymm1
+vmulps ymm2, ymm2, ymm3
+vblendps ymm4, ymm0, ymm2, 0x5a
+vperm2f128 ymm5, ymm4, ymm0, 0x21
+vshufps ymm6, ymm5, ymm4, 0x1b
+vandps ymm7, ymm6, ymm1
+vmaxps ymm1, ymm7, ymm3
+vxorps ymm3, ymm3, ymm5
+dec rcx
+jnz .loop
+
+hlt
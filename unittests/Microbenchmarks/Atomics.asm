@@ -0,0 +1,32 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RCX": "0"
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  },
+  "Benchmark": {
+    "Iterations": "5000000",
+    "InstructionsPerIteration": "8"
+  }
+}
+%endif
+
+; Locked read-modify-write operations on naturally aligned memory.
+mov rdi, 0x100000000
+mov rax, 1
+mov rbx, 2
+mov rcx, 5000000
+
+.loop:
+lock xadd [rdi], rax
+lock inc qword [rdi + 8]
+mov rdx, [rdi]
+lock cmpxchg [rdi + 16], rdx
+xchg [rdi + 24], rbx
+lock or qword [rdi + 32], rax
+dec rcx
+jnz .loop
+
+hlt
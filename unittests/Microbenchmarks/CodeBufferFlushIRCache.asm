@@ -0,0 +1,49 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x17fffa0000"
+  },
+  "MemoryRegions": {
+    "0x100000000": "4194304"
+  },
+  "Benchmark": {
+    "Iterations": "786432",
+    "InstructionsPerIteration": "6",
+    "Unit": "calls"
+  },
+  "Env": { "FEX_IRCACHESIZE": "512" }
+}
+%endif
+
+; Same kernel as CodeBufferFlush.asm with the IR cache enabled, blocks recompiled after a code buffer flush only
+; need the backend.
+; Each of the 262144 functions is `add rax, <index>; ret` in its own 16 bytes.
+mov rdi, 0x100000000
+xor ecx, ecx
+
+.gen:
+mov word [rdi], 0x0548
+mov dword [rdi + 2], ecx
+mov byte [rdi + 6], 0xC3
+add rdi, 16
+inc ecx
+cmp ecx, 262144
+jne .gen
+
+xor eax, eax
+mov r12, 3
+
+.sweep:
+mov rsi, 0x100000000
+mov ecx, 262144
+
+.call:
+call rsi
+add rsi, 16
+dec ecx
+jnz .call
+
+dec r12
+jnz .sweep
+
+hlt
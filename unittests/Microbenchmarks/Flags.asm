@@ -0,0 +1,32 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RCX": "0"
+  },
+  "Benchmark": {
+    "Iterations": "10000000",
+    "InstructionsPerIteration": "10"
+  }
+}
+%endif
+
+; Flag producers feeding flag consumers, including partial flag updates from inc and rcl.
+mov rax, 0
+mov rbx, 0x8000000000000001
+mov rdx, 0
+mov rdi, 0
+mov rcx, 10000000
+
+.loop:
+add rbx, rbx
+adc rax, 0
+sbb rdx, rax
+setc sil
+cmp rax, rdx
+cmovb rax, rdx
+inc rdi
+rcl rbx, 1
+dec rcx
+jnz .loop
+
+hlt
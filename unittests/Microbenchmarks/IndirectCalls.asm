@@ -0,0 +1,52 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RCX": "0"
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  },
+  "Benchmark": {
+    "Iterations": "5000000",
+    "InstructionsPerIteration": "16"
+  }
+}
+%endif
+
+; Indirect calls through registers and through a memory table with a changing index.
+lea r8, [rel .func1]
+lea r9, [rel .func2]
+lea r10, [rel .func3]
+
+mov rdi, 0x100000000
+mov [rdi], r8
+mov [rdi + 8], r9
+mov [rdi + 16], r10
+mov [rdi + 24], r8
+
+mov rax, 0
+mov rcx, 5000000
+
+.loop:
+call r8
+call r9
+call r10
+mov rdx, rcx
+and rdx, 3
+call qword [rdi + rdx * 8]
+dec rcx
+jnz .loop
+
+hlt
+
+.func1:
+add rax, 1
+ret
+
+.func2:
+xor rsi, rax
+ret
+
+.func3:
+lea rbx, [rbx + rax]
+ret
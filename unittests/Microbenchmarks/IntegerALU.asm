@@ -0,0 +1,32 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RCX": "0"
+  },
+  "Benchmark": {
+    "Iterations": "10000000",
+    "InstructionsPerIteration": "10"
+  }
+}
+%endif
+
+; Integer ALU operations whose flag results are never consumed.
+mov rax, 1
+mov rbx, 2
+mov rdx, 3
+mov rsi, 4
+mov rcx, 10000000
+
+.loop:
+add rax, rbx
+sub rdx, rsi
+xor rbx, rax
+imul rsi, rdx
+shl rax, 3
+lea rdx, [rax + rbx * 2]
+and rsi, 0xffff
+or rbx, rdx
+dec rcx
+jnz .loop
+
+hlt
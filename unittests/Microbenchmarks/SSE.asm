@@ -0,0 +1,28 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RCX": "0"
+  },
+  "Benchmark": {
+    "Iterations": "10000000",
+    "InstructionsPerIteration": "10"
+  }
+}
+%endif
+
+; Mixed SSE float, integer and shuffle operations.
+mov rcx, 10000000
+
+.loop:
+addps xmm0, xmm1
+mulps xmm2, xmm3
+paddd xmm4, xmm5
+pshufd xmm6, xmm4, 0x1b
+shufps xmm7, xmm0, 0x44
+pmaddwd xmm5, xmm6
+minps xmm1, xmm2
+cvtdq2ps xmm3, xmm4
+dec rcx
+jnz .loop
+
+hlt
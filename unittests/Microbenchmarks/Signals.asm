@@ -0,0 +1,72 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "R12": "0",
+    "R13": "100000"
+  },
+  "HostFeatures": ["Linux"],
+  "Benchmark": {
+    "Iterations": "100000",
+    "InstructionsPerIteration": "11",
+    "Unit": "signals"
+  }
+}
+%endif
+
+; Signal delivery round-trips, a thread sending SIGUSR1 to itself with a handler that only counts it.
+; This measures signal frame setup and sigreturn with the upper halves of the YMM registers unused.
+; Signals are raised by a syscall, so they are always delivered at a safe point and never interrupt JIT code.
+; The loop runs seven instructions, the handler and restorer two each. r13 ends up with the number of handled signals.
+sub rsp, 64
+
+; Handled signal counter
+lea rbx, [rsp + 32]
+mov qword [rbx], 0
+
+; rt_sigaction(SIGUSR1, {handler, SA_RESTORER, restorer, 0}, nullptr, 8)
+lea rax, [rel handler]
+mov [rsp], rax
+mov qword [rsp + 8], 0x04000000
+lea rax, [rel restorer]
+mov [rsp + 16], rax
+mov qword [rsp + 24], 0
+mov eax, 13
+mov edi, 10
+mov rsi, rsp
+xor edx, edx
+mov r10d, 8
+syscall
+
+; getpid, gettid
+mov eax, 39
+syscall
+mov r14, rax
+mov eax, 186
+syscall
+mov r15, rax
+
+mov r12, 100000
+
+.loop:
+; tgkill(pid, tid, SIGUSR1)
+mov eax, 234
+mov rdi, r14
+mov rsi, r15
+mov edx, 10
+syscall
+dec r12
+jnz .loop
+
+mov r13, [rbx]
+add rsp, 64
+hlt
+
+handler:
+; rbx still points at the counter, signals only arrive during the tgkill.
+inc qword [rbx]
+ret
+
+restorer:
+; rt_sigreturn
+mov eax, 15
+syscall
@@ -0,0 +1,39 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "R8": "0"
+  },
+  "MemoryRegions": {
+    "0x100000000": "0x20000"
+  },
+  "Benchmark": {
+    "Iterations": "20000",
+    "InstructionsPerIteration": "14"
+  }
+}
+%endif
+
+; rep prefixed copies, fills and scans over 4KB buffers.
+; A rep prefixed instruction counts as a single guest instruction.
+mov r8, 20000
+
+.loop:
+mov rsi, 0x100000000
+mov rdi, 0x100008000
+mov rcx, 512
+rep movsq
+
+mov rdi, 0x100010000
+mov rcx, 4096
+mov al, 0x55
+rep stosb
+
+mov rdi, 0x100010000
+mov rcx, 4096
+mov al, 0
+repne scasb
+
+dec r8
+jnz .loop
+
+hlt
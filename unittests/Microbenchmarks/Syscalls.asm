@@ -0,0 +1,28 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "R12": "0"
+  },
+  "HostFeatures": ["Linux"],
+  "Benchmark": {
+    "Iterations": "200000",
+    "InstructionsPerIteration": "6"
+  }
+}
+%endif
+
+; Cheap syscalls, this measures the guest to host syscall transition.
+; rcx and r11 get clobbered by syscall, r12 is the loop counter.
+mov r12, 200000
+
+.loop:
+; getpid
+mov eax, 39
+syscall
+; gettid
+mov eax, 186
+syscall
+dec r12
+jnz .loop
+
+hlt
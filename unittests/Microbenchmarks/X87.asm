@@ -0,0 +1,30 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RCX": "0"
+  },
+  "Benchmark": {
+    "Iterations": "5000000",
+    "InstructionsPerIteration": "10"
+  }
+}
+%endif
+
+; x87 arithmetic and stack manipulation, the stack depth is the same at the end of every iteration.
+fld1
+fldz
+mov rcx, 5000000
+
+.loop:
+fadd st0, st1
+fxch st1
+fmul st0, st0
+fxch st1
+fabs
+fchs
+fld st0
+faddp st1
+dec rcx
+jnz .loop
+
+hlt
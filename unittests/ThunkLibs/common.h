@@ -93,6 +93,7 @@ run_tool(clang::tooling::ToolAction& action, std::string_view code, bool silent
   const char* common_header_code = R"(namespace fexgen {
 struct returns_guest_pointer {};
 struct custom_host_impl {};
+struct leaf {};
 struct callback_annotation_base { bool prevent_multiple; };
 struct callback_stub : callback_annotation_base {};
 
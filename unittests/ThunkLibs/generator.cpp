@@ -290,7 +290,7 @@ SourceWithAST Fixture::run_thunkgen_host(std::string_view prelude, std::string_v
     "struct GuestWrapperForHostFunction {\n"
     "  template<ParameterAnnotations...> static void Call(void*);\n"
     "};\n"
-    "struct ExportEntry { uint8_t* sha256; void(*fn)(void *); };\n"
+    "struct ExportEntry { uint8_t* sha256; void(*fn)(void *); bool leaf; };\n"
     "void *dlsym_default(void* handle, const char* symbol);\n"
     "template<typename T> inline constexpr bool has_compatible_data_layout = std::is_integral_v<T> || std::is_enum_v<T>;\n"
     "template<typename T>\n"
@@ -552,6 +552,25 @@ TEST_CASE_METHOD(Fixture, "ReturnFunctionPointer") {
                                               "template<> struct fex_gen_config<func> : fexgen::returns_guest_pointer {};\n"));
 }
 
+// Leaf functions should be flagged in the host export table
+TEST_CASE_METHOD(Fixture, "LeafFunction") {
+  const auto output = run_thunkgen_host("", "#include <thunks_common.h>\n"
+                                            "void func();\n"
+                                            "template<auto> struct fex_gen_config {};\n"
+                                            "template<> struct fex_gen_config<func> : fexgen::leaf {};\n");
+
+  CHECK_THAT(output, matches(varDecl(hasName("exports"),
+                                     hasInitializer(initListExpr(hasInit(0, initListExpr(hasInit(2, cxxBoolLiteral(equals(true))))))))));
+
+  // Leaf functions can't call back in to guest code
+  REQUIRE_THROWS(run_thunkgen_host("",
+                                   "#include <thunks_common.h>\n"
+                                   "void func(int (*funcptr)(char, char));\n"
+                                   "template<auto> struct fex_gen_config {};\n"
+                                   "template<> struct fex_gen_config<func> : fexgen::leaf {};\n",
+                                   GuestABI::X86_64, true));
+}
+
 TEST_CASE_METHOD(Fixture, "VariadicFunction") {
   const std::string prelude = "void func(int arg, ...);\n";
 